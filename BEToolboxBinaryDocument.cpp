@@ -0,0 +1,368 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#include "stdafx.h"
+#include "BEToolboxBinaryDocument.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+static const char gs_Signature[8] = { 'B','E','T','B','I','N','\r','\n' };
+
+static Uint64 PaddedSize(Uint64 size)
+{
+   return (size + 7) & ~(Uint64)7;
+}
+
+CBinaryDocumentWriter::CBinaryDocumentWriter()
+{
+   m_nChunks = 0;
+}
+
+CBinaryDocumentWriter::~CBinaryDocumentWriter()
+{
+}
+
+HRESULT CBinaryDocumentWriter::Open(LPCTSTR lpszPathName,LPCSTR lpszDocumentType,Float64 version)
+{
+   ATLASSERT(strlen(lpszDocumentType) < sizeof(BINARYDOCUMENTHEADER::DocumentType));
+
+   m_File.open(lpszPathName,std::ios::out | std::ios::binary | std::ios::trunc);
+   if ( !m_File.is_open() )
+   {
+      return E_FAIL;
+   }
+
+   // the chunk count is written when the document is closed
+   BINARYDOCUMENTHEADER header;
+   memset(&header,0,sizeof(header));
+   memcpy(header.Signature,gs_Signature,sizeof(gs_Signature));
+   header.FormatVersion = BINARY_DOCUMENT_FORMAT_VERSION;
+   strncpy_s(header.DocumentType,lpszDocumentType,_TRUNCATE);
+   header.Version = version;
+
+   m_nChunks = 0;
+   m_File.write((const char*)&header,sizeof(header));
+   return m_File.good() ? S_OK : E_FAIL;
+}
+
+HRESULT CBinaryDocumentWriter::WriteFloat64Array(LPCSTR lpszName,const Float64* pValues,IndexType nValues)
+{
+   return WriteChunk(lpszName,bctFloat64,nValues,pValues,nValues*sizeof(Float64));
+}
+
+HRESULT CBinaryDocumentWriter::WriteInt32Array(LPCSTR lpszName,const Int32* pValues,IndexType nValues)
+{
+   return WriteChunk(lpszName,bctInt32,nValues,pValues,nValues*sizeof(Int32));
+}
+
+HRESULT CBinaryDocumentWriter::WriteStringArray(LPCSTR lpszName,const std::vector<std::_tstring>& vStrings)
+{
+   std::vector<Uint32> vLengths;
+   vLengths.reserve(vStrings.size());
+   std::wstring strCharacters;
+   for ( const auto& str : vStrings )
+   {
+      CT2CW strW(str.c_str());
+      Uint32 length = (Uint32)wcslen(strW);
+      vLengths.push_back(length);
+      strCharacters.append((LPCWSTR)strW,length);
+   }
+
+   std::vector<BYTE> vData(vLengths.size()*sizeof(Uint32) + strCharacters.size()*sizeof(wchar_t));
+   if ( !vData.empty() )
+   {
+      memcpy(&vData[0],vLengths.data(),vLengths.size()*sizeof(Uint32));
+      memcpy(&vData[vLengths.size()*sizeof(Uint32)],strCharacters.data(),strCharacters.size()*sizeof(wchar_t));
+   }
+
+   return WriteChunk(lpszName,bctString,vStrings.size(),vData.data(),vData.size());
+}
+
+HRESULT CBinaryDocumentWriter::Close()
+{
+   if ( !m_File.is_open() )
+   {
+      return E_FAIL;
+   }
+
+   m_File.seekp(offsetof(BINARYDOCUMENTHEADER,ChunkCount));
+   m_File.write((const char*)&m_nChunks,sizeof(m_nChunks));
+
+   bool bGood = m_File.good();
+   m_File.close();
+   return bGood ? S_OK : E_FAIL;
+}
+
+HRESULT CBinaryDocumentWriter::WriteChunk(LPCSTR lpszName,BINARYCHUNKTYPE type,IndexType count,const void* pData,Uint64 size)
+{
+   ATLASSERT(strlen(lpszName) < sizeof(BINARYCHUNKHEADER::Name));
+   ATLASSERT(count <= UINT32_MAX);
+
+   BINARYCHUNKHEADER chunk;
+   memset(&chunk,0,sizeof(chunk));
+   strncpy_s(chunk.Name,lpszName,_TRUNCATE);
+   chunk.Type = type;
+   chunk.Count = (Uint32)count;
+   chunk.Size = size;
+
+   m_File.write((const char*)&chunk,sizeof(chunk));
+   if ( 0 < size )
+   {
+      m_File.write((const char*)pData,(std::streamsize)size);
+   }
+
+   static const char padding[8] = {0,0,0,0,0,0,0,0};
+   m_File.write(padding,(std::streamsize)(PaddedSize(size) - size));
+
+   m_nChunks++;
+   return m_File.good() ? S_OK : E_FAIL;
+}
+
+////////////////////////////////////////////////////////////
+
+CBinaryDocumentReader::CBinaryDocumentReader()
+{
+   m_hFile = INVALID_HANDLE_VALUE;
+   m_hMapping = nullptr;
+   m_pView = nullptr;
+   m_pHeader = nullptr;
+}
+
+CBinaryDocumentReader::~CBinaryDocumentReader()
+{
+   Close();
+}
+
+BOOL CBinaryDocumentReader::IsBinaryDocument(LPCTSTR lpszPathName)
+{
+   std::ifstream file(lpszPathName,std::ios::in | std::ios::binary);
+   if ( !file.is_open() )
+   {
+      return FALSE;
+   }
+
+   char signature[sizeof(gs_Signature)];
+   file.read(signature,sizeof(signature));
+   return (file.gcount() == sizeof(signature) && memcmp(signature,gs_Signature,sizeof(gs_Signature)) == 0) ? TRUE : FALSE;
+}
+
+HRESULT CBinaryDocumentReader::Open(LPCTSTR lpszPathName)
+{
+   Close();
+
+   m_hFile = ::CreateFile(lpszPathName,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,nullptr);
+   if ( m_hFile == INVALID_HANDLE_VALUE )
+   {
+      return HRESULT_FROM_WIN32(::GetLastError());
+   }
+
+   LARGE_INTEGER fileSize;
+   if ( !::GetFileSizeEx(m_hFile,&fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(BINARYDOCUMENTHEADER) )
+   {
+      Close();
+      return E_FAIL;
+   }
+
+   m_hMapping = ::CreateFileMapping(m_hFile,nullptr,PAGE_READONLY,0,0,nullptr);
+   if ( m_hMapping == nullptr )
+   {
+      HRESULT hr = HRESULT_FROM_WIN32(::GetLastError());
+      Close();
+      return hr;
+   }
+
+   m_pView = (const BYTE*)::MapViewOfFile(m_hMapping,FILE_MAP_READ,0,0,0);
+   if ( m_pView == nullptr )
+   {
+      HRESULT hr = HRESULT_FROM_WIN32(::GetLastError());
+      Close();
+      return hr;
+   }
+
+   m_pHeader = (const BINARYDOCUMENTHEADER*)m_pView;
+   if ( memcmp(m_pHeader->Signature,gs_Signature,sizeof(gs_Signature)) != 0 || BINARY_DOCUMENT_FORMAT_VERSION < m_pHeader->FormatVersion )
+   {
+      Close();
+      return E_FAIL;
+   }
+
+   // index the chunks so they can be found by name
+   Uint64 size = (Uint64)fileSize.QuadPart;
+   Uint64 offset = sizeof(BINARYDOCUMENTHEADER);
+   for ( Uint32 chunkIdx = 0; chunkIdx < m_pHeader->ChunkCount; chunkIdx++ )
+   {
+      if ( size < offset + sizeof(BINARYCHUNKHEADER) )
+      {
+         Close();
+         return E_FAIL;
+      }
+
+      const BINARYCHUNKHEADER* pChunk = (const BINARYCHUNKHEADER*)(m_pView + offset);
+      offset += sizeof(BINARYCHUNKHEADER);
+      if ( size - offset < pChunk->Size )
+      {
+         Close();
+         return E_FAIL;
+      }
+
+      std::string strName(pChunk->Name,strnlen(pChunk->Name,sizeof(pChunk->Name)));
+      m_Chunks.insert(std::make_pair(strName,pChunk));
+
+      offset += PaddedSize(pChunk->Size);
+   }
+
+   return S_OK;
+}
+
+void CBinaryDocumentReader::Close()
+{
+   m_Chunks.clear();
+   m_pHeader = nullptr;
+
+   if ( m_pView != nullptr )
+   {
+      ::UnmapViewOfFile(m_pView);
+      m_pView = nullptr;
+   }
+
+   if ( m_hMapping != nullptr )
+   {
+      ::CloseHandle(m_hMapping);
+      m_hMapping = nullptr;
+   }
+
+   if ( m_hFile != INVALID_HANDLE_VALUE )
+   {
+      ::CloseHandle(m_hFile);
+      m_hFile = INVALID_HANDLE_VALUE;
+   }
+}
+
+LPCSTR CBinaryDocumentReader::GetDocumentType() const
+{
+   ATLASSERT(m_pHeader != nullptr);
+   return m_pHeader->DocumentType;
+}
+
+Float64 CBinaryDocumentReader::GetVersion() const
+{
+   ATLASSERT(m_pHeader != nullptr);
+   return m_pHeader->Version;
+}
+
+BOOL CBinaryDocumentReader::HasChunk(LPCSTR lpszName) const
+{
+   return m_Chunks.find(lpszName) == m_Chunks.end() ? FALSE : TRUE;
+}
+
+HRESULT CBinaryDocumentReader::GetFloat64Array(LPCSTR lpszName,const Float64** ppValues,IndexType* pnValues) const
+{
+   const BINARYCHUNKHEADER* pChunk;
+   HRESULT hr = GetChunk(lpszName,bctFloat64,&pChunk);
+   if ( FAILED(hr) )
+   {
+      return hr;
+   }
+
+   if ( pChunk->Size != pChunk->Count*sizeof(Float64) )
+   {
+      return E_FAIL;
+   }
+
+   *ppValues = (const Float64*)(pChunk + 1);
+   *pnValues = pChunk->Count;
+   return S_OK;
+}
+
+HRESULT CBinaryDocumentReader::GetInt32Array(LPCSTR lpszName,const Int32** ppValues,IndexType* pnValues) const
+{
+   const BINARYCHUNKHEADER* pChunk;
+   HRESULT hr = GetChunk(lpszName,bctInt32,&pChunk);
+   if ( FAILED(hr) )
+   {
+      return hr;
+   }
+
+   if ( pChunk->Size != pChunk->Count*sizeof(Int32) )
+   {
+      return E_FAIL;
+   }
+
+   *ppValues = (const Int32*)(pChunk + 1);
+   *pnValues = pChunk->Count;
+   return S_OK;
+}
+
+HRESULT CBinaryDocumentReader::GetStringArray(LPCSTR lpszName,std::vector<std::_tstring>* pvStrings) const
+{
+   const BINARYCHUNKHEADER* pChunk;
+   HRESULT hr = GetChunk(lpszName,bctString,&pChunk);
+   if ( FAILED(hr) )
+   {
+      return hr;
+   }
+
+   Uint64 lengthSize = pChunk->Count*sizeof(Uint32);
+   if ( pChunk->Size < lengthSize )
+   {
+      return E_FAIL;
+   }
+
+   const Uint32* pLengths = (const Uint32*)(pChunk + 1);
+   const wchar_t* pCharacters = (const wchar_t*)((const BYTE*)pLengths + lengthSize);
+   Uint64 nCharacters = (pChunk->Size - lengthSize)/sizeof(wchar_t);
+
+   pvStrings->clear();
+   pvStrings->reserve(pChunk->Count);
+   for ( Uint32 idx = 0; idx < pChunk->Count; idx++ )
+   {
+      if ( nCharacters < pLengths[idx] )
+      {
+         return E_FAIL;
+      }
+
+      std::wstring str(pCharacters,pLengths[idx]);
+      pvStrings->push_back(std::_tstring(CW2CT(str.c_str())));
+
+      pCharacters += pLengths[idx];
+      nCharacters -= pLengths[idx];
+   }
+
+   return S_OK;
+}
+
+HRESULT CBinaryDocumentReader::GetChunk(LPCSTR lpszName,BINARYCHUNKTYPE type,const BINARYCHUNKHEADER** ppChunk) const
+{
+   auto found = m_Chunks.find(lpszName);
+   if ( found == m_Chunks.end() || found->second->Type != (Uint32)type )
+   {
+      return E_FAIL;
+   }
+
+   *ppChunk = found->second;
+   return S_OK;
+}
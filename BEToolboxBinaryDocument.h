@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <fstream>
+#include <map>
+
+// Compact binary document format
+//
+// The binary format is an alternative to the XML that is written with IStructuredSave. A document is a header followed
+// by a sequence of named chunks. Each chunk is an array of numbers or strings. The document type and version in the
+// header serve the same purpose as the root unit of an XML document. Chunks start on 8 byte boundaries and the reader maps
+// the file into memory so arrays of numbers can be read without being parsed. A document that keeps its data in
+// its own structures still copies the arrays out of the mapped file. All values are little-endian, as written on Windows.
+//
+// File layout
+//   BINARYDOCUMENTHEADER
+//   BINARYCHUNKHEADER, data, padding to an 8 byte boundary
+//   BINARYCHUNKHEADER, data, padding to an 8 byte boundary
+//   ...
+
+#define BINARY_DOCUMENT_FORMAT_VERSION 1 // version of the container. the version of the document content is in the header
+
+typedef enum BINARYCHUNKTYPE
+{
+   bctFloat64 = 1, // array of Float64
+   bctInt32   = 2, // array of Int32
+   bctString  = 3  // array of strings. Uint32 length of each string, followed by the UTF-16 characters of all the strings
+} BINARYCHUNKTYPE;
+
+struct BINARYDOCUMENTHEADER
+{
+   char Signature[8];     // identifies a binary document
+   Uint32 FormatVersion;  // BINARY_DOCUMENT_FORMAT_VERSION
+   Uint32 ChunkCount;
+   char DocumentType[32]; // tool that wrote the document (null terminated)
+   Float64 Version;       // version of the BEToolbox document (same as the root unit of an XML document)
+};
+
+struct BINARYCHUNKHEADER
+{
+   char Name[24]; // null terminated
+   Uint32 Type;   // BINARYCHUNKTYPE
+   Uint32 Count;  // number of values or strings
+   Uint64 Size;   // size of the data in bytes, without padding
+};
+
+// Writes a binary document
+class CBinaryDocumentWriter
+{
+public:
+   CBinaryDocumentWriter();
+   ~CBinaryDocumentWriter();
+
+   HRESULT Open(LPCTSTR lpszPathName,LPCSTR lpszDocumentType,Float64 version);
+
+   HRESULT WriteFloat64Array(LPCSTR lpszName,const Float64* pValues,IndexType nValues);
+   HRESULT WriteInt32Array(LPCSTR lpszName,const Int32* pValues,IndexType nValues);
+   HRESULT WriteStringArray(LPCSTR lpszName,const std::vector<std::_tstring>& vStrings);
+
+   // Finishes the document. The document is not valid until it is closed.
+   HRESULT Close();
+
+private:
+   std::ofstream m_File;
+   Uint32 m_nChunks;
+
+   HRESULT WriteChunk(LPCSTR lpszName,BINARYCHUNKTYPE type,IndexType count,const void* pData,Uint64 size);
+};
+
+// Reads a binary document. The file is mapped into memory while the reader is open. Arrays returned by
+// the reader point into the mapped file and are valid until the reader is closed.
+class CBinaryDocumentReader
+{
+public:
+   CBinaryDocumentReader();
+   ~CBinaryDocumentReader();
+
+   // Returns TRUE if a file is a binary document
+   static BOOL IsBinaryDocument(LPCTSTR lpszPathName);
+
+   HRESULT Open(LPCTSTR lpszPathName);
+   void Close();
+
+   LPCSTR GetDocumentType() const;
+   Float64 GetVersion() const;
+
+   BOOL HasChunk(LPCSTR lpszName) const;
+   HRESULT GetFloat64Array(LPCSTR lpszName,const Float64** ppValues,IndexType* pnValues) const;
+   HRESULT GetInt32Array(LPCSTR lpszName,const Int32** ppValues,IndexType* pnValues) const;
+   HRESULT GetStringArray(LPCSTR lpszName,std::vector<std::_tstring>* pvStrings) const;
+
+private:
+   HANDLE m_hFile;
+   HANDLE m_hMapping;
+   const BYTE* m_pView;
+   const BINARYDOCUMENTHEADER* m_pHeader;
+   std::map<std::string,const BINARYCHUNKHEADER*> m_Chunks;
+
+   HRESULT GetChunk(LPCSTR lpszName,BINARYCHUNKTYPE type,const BINARYCHUNKHEADER** ppChunk) const;
+};
@@ -30,6 +30,9 @@
 #include "BEToolboxStatusBar.h"
 #include "BEToolboxPlugin.h"
 #include "AboutDlg.h"
+#include "BEToolboxBinaryDocument.h"
+
+#include <chrono>
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -50,6 +53,7 @@ static const Float64 FILE_VERSION = 1.0;
 CBEToolboxDoc::CBEToolboxDoc()
 {
    m_pMyToolBar = nullptr;
+   m_bBinaryFormat = FALSE;
 
    // Reserve command IDs for document plug ins
    UINT nCommands = GetPluginCommandManager()->ReserveCommandIDRange(PLUGIN_COMMAND_COUNT);
@@ -63,6 +67,8 @@ CBEToolboxDoc::~CBEToolboxDoc()
 
 BEGIN_MESSAGE_MAP(CBEToolboxDoc, CEAFDocument)
    ON_COMMAND(ID_HELP_ABOUTBETOOLBOX,OnAbout)
+   ON_COMMAND(ID_FILE_BINARY_FORMAT,OnBinaryFormat)
+   ON_UPDATE_COMMAND_UI(ID_FILE_BINARY_FORMAT,OnUpdateBinaryFormat)
 END_MESSAGE_MAP()
 
 void CBEToolboxDoc::OnAbout()
@@ -72,6 +78,30 @@ void CBEToolboxDoc::OnAbout()
    dlg.DoModal();
 }
 
+void CBEToolboxDoc::OnBinaryFormat()
+{
+   // the document has to be saved for the change in format to take effect
+   SetBinaryFormat(!m_bBinaryFormat);
+   SetModifiedFlag();
+}
+
+void CBEToolboxDoc::OnUpdateBinaryFormat(CCmdUI* pCmdUI)
+{
+   pCmdUI->Enable(SupportsBinaryFormat());
+   pCmdUI->SetCheck(m_bBinaryFormat ? 1 : 0);
+}
+
+BOOL CBEToolboxDoc::IsBinaryFormat() const
+{
+   return m_bBinaryFormat;
+}
+
+void CBEToolboxDoc::SetBinaryFormat(BOOL bBinaryFormat)
+{
+   ATLASSERT(!bBinaryFormat || SupportsBinaryFormat());
+   m_bBinaryFormat = bBinaryFormat;
+}
+
 
 // CBoxGdrDoc diagnostics
 
@@ -141,6 +171,11 @@ BOOL CBEToolboxDoc::OnOpenDocument(LPCTSTR lpszPathName)
 
    is.close();
 
+   if ( CBinaryDocumentReader::IsBinaryDocument(lpszPathName) )
+   {
+      return CEAFDocument::OnOpenDocument(lpszPathName);
+   }
+
    if ( strHeader != _T("<?xml") )
    {
       OnOldFormat(lpszPathName);
@@ -157,6 +192,116 @@ void CBEToolboxDoc::OnOldFormat(LPCTSTR lpszPathName)
    // Do nothing by default
 }
 
+BOOL CBEToolboxDoc::OpenTheDocument(LPCTSTR lpszPathName)
+{
+#if defined _DEBUG
+   std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::now());
+#endif
+
+   BOOL bResult;
+   m_bBinaryFormat = CBinaryDocumentReader::IsBinaryDocument(lpszPathName);
+   if ( m_bBinaryFormat )
+   {
+      CBinaryDocumentReader reader;
+      HRESULT hr = reader.Open(lpszPathName);
+      if ( SUCCEEDED(hr) )
+      {
+         hr = LoadBinaryDocument(reader);
+      }
+
+      if ( FAILED(hr) )
+      {
+         CString strError;
+         strError.Format(_T("Error reading %s"),lpszPathName);
+         AfxMessageBox(strError);
+      }
+      bResult = SUCCEEDED(hr) ? TRUE : FALSE;
+   }
+   else
+   {
+      bResult = CEAFDocument::OpenTheDocument(lpszPathName);
+   }
+
+#if defined _DEBUG
+   Float64 loadTime = std::chrono::duration<Float64,std::milli>(std::chrono::steady_clock::now() - startTime).count();
+   WATCH(lpszPathName << _T(" loaded in ") << loadTime << (m_bBinaryFormat ? _T(" ms (binary)") : _T(" ms (XML)")));
+#endif
+
+   return bResult;
+}
+
+BOOL CBEToolboxDoc::SaveTheDocument(LPCTSTR lpszPathName)
+{
+#if defined _DEBUG
+   std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::now());
+#endif
+
+   BOOL bResult;
+   if ( m_bBinaryFormat )
+   {
+      // The document is written to a temporary file next to the original. The original is
+      // replaced only after the new document is completely written so a failed save doesn't
+      // destroy the user's file.
+      CString strTempFile(lpszPathName);
+      strTempFile += _T(".tmp");
+
+      CBinaryDocumentWriter writer;
+      HRESULT hr = writer.Open(strTempFile,CT2CA(GetToolbarSectionName()),FILE_VERSION);
+      if ( SUCCEEDED(hr) )
+      {
+         hr = WriteBinaryDocument(writer);
+      }
+
+      // the temporary file is closed even if writing failed so it can be deleted
+      HRESULT hrClose = writer.Close();
+      if ( SUCCEEDED(hr) )
+      {
+         hr = hrClose;
+      }
+
+      if ( SUCCEEDED(hr) && !::MoveFileEx(strTempFile,lpszPathName,MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) )
+      {
+         hr = HRESULT_FROM_WIN32(::GetLastError());
+      }
+
+      if ( FAILED(hr) )
+      {
+         ::DeleteFile(strTempFile);
+
+         CString strError;
+         strError.Format(_T("Error writing %s"),lpszPathName);
+         AfxMessageBox(strError);
+      }
+      bResult = SUCCEEDED(hr) ? TRUE : FALSE;
+   }
+   else
+   {
+      bResult = CEAFDocument::SaveTheDocument(lpszPathName);
+   }
+
+#if defined _DEBUG
+   Float64 saveTime = std::chrono::duration<Float64,std::milli>(std::chrono::steady_clock::now() - startTime).count();
+   WATCH(lpszPathName << _T(" saved in ") << saveTime << (m_bBinaryFormat ? _T(" ms (binary)") : _T(" ms (XML)")));
+#endif
+
+   return bResult;
+}
+
+BOOL CBEToolboxDoc::SupportsBinaryFormat() const
+{
+   return FALSE;
+}
+
+HRESULT CBEToolboxDoc::WriteBinaryDocument(CBinaryDocumentWriter& writer)
+{
+   return E_NOTIMPL;
+}
+
+HRESULT CBEToolboxDoc::LoadBinaryDocument(CBinaryDocumentReader& reader)
+{
+   return E_NOTIMPL;
+}
+
 HINSTANCE CBEToolboxDoc::GetResourceInstance()
 {
    AFX_MANAGE_STATE(AfxGetStaticModuleState());
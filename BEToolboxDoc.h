@@ -26,6 +26,9 @@
 #include "BEToolboxLib.h"
 #include <EAF\EAFDocument.h>
 
+class CBinaryDocumentWriter;
+class CBinaryDocumentReader;
+
 class BETCLASS CBEToolboxDoc : public CEAFDocument
 {
 	DECLARE_DYNAMIC(CBEToolboxDoc)
@@ -38,6 +41,11 @@ public:
    virtual BOOL GetStatusBarMessageString(UINT nID,CString& rMessage) const override;
    virtual BOOL GetToolTipMessageString(UINT nID, CString& rMessage) const override;
 
+   // Returns TRUE if the document is saved in the compact binary format. Documents are saved
+   // in the format they were opened in, unless the format is changed.
+   BOOL IsBinaryFormat() const;
+   void SetBinaryFormat(BOOL bBinaryFormat);
+
 #ifdef _DEBUG
 	virtual void AssertValid() const override;
 #ifndef _WIN32_WCE
@@ -53,6 +61,8 @@ protected:
    virtual void SaveToolbarState() override;
 
    afx_msg void OnAbout();
+   afx_msg void OnBinaryFormat();
+   afx_msg void OnUpdateBinaryFormat(CCmdUI* pCmdUI);
 
 	DECLARE_MESSAGE_MAP()
 public:
@@ -66,6 +76,16 @@ protected:
 
    virtual void OnOldFormat(LPCTSTR lpszPathName);
 
+   virtual BOOL OpenTheDocument(LPCTSTR lpszPathName) override;
+   virtual BOOL SaveTheDocument(LPCTSTR lpszPathName) override;
+
+   // Tools that support the compact binary format return TRUE from SupportsBinaryFormat and
+   // override WriteBinaryDocument and LoadBinaryDocument. The default implementations return E_NOTIMPL.
+   virtual BOOL SupportsBinaryFormat() const;
+   virtual HRESULT WriteBinaryDocument(CBinaryDocumentWriter& writer);
+   virtual HRESULT LoadBinaryDocument(CBinaryDocumentReader& reader);
+   BOOL m_bBinaryFormat;
+
    virtual UINT GetToolbarID();
    virtual void LoadToolbarResource();
    virtual HINSTANCE GetResourceInstance() override;
@@ -72,6 +72,9 @@ BOOL CBEToolboxPlugin::Init(CEAFApp* pParent)
 void CBEToolboxPlugin::Terminate()
 {
    m_Tools.UnloadPlugins();
+
+   // Curvel and GenComp documents are closed by now
+   TerminateXMLRuntime();
 }
 
 void CBEToolboxPlugin::IntegrateWithUI(BOOL bIntegrate)
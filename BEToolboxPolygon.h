@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Native section property kernel for polygons. This is used in place of the WBFL PolyShape
+// and CompositeSection objects when a section is defined by a large number of points.
+// The kernel is part of the portable engine (see Engine\SectionProperties.h).
+
+#include "Engine\SectionProperties.h"
+
+using BEToolboxEngine::POLYGONPROPERTIES;
+using BEToolboxEngine::InitPolygonProperties;
+using BEToolboxEngine::ComputePolygonProperties;
+using BEToolboxEngine::AddPolygonProperties;
+using BEToolboxEngine::ComputeTransformedProperties;
+using BEToolboxEngine::ClipPolygon;
+using BEToolboxEngine::ComputeEqualAreaProperties;
+using BEToolboxEngine::ComputeCrackedProperties;
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+// BEToolboxProgressDlg.cpp : implementation file
+//
+
+#include "stdafx.h"
+#include "resource.h"
+#include "BEToolboxProgressDlg.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+#define WM_TASK_DONE (WM_APP+1)
+#define PROGRESS_TIMER 1
+
+// CBEToolboxProgressDlg dialog
+
+IMPLEMENT_DYNAMIC(CBEToolboxProgressDlg, CDialog)
+
+CBEToolboxProgressDlg::CBEToolboxProgressDlg(LPCTSTR lpszMessage,CWnd* pParent /*=nullptr*/)
+	: CDialog(CBEToolboxProgressDlg::IDD, pParent),
+   m_strMessage(lpszMessage),
+   m_Percent(0),
+   m_bCancelled(false),
+   m_bResult(false)
+{
+}
+
+CBEToolboxProgressDlg::~CBEToolboxProgressDlg()
+{
+   ATLASSERT(!m_Worker.joinable());
+}
+
+void CBEToolboxProgressDlg::DoDataExchange(CDataExchange* pDX)
+{
+	CDialog::DoDataExchange(pDX);
+   DDX_Control(pDX,IDC_PROGRESS_BAR,m_Progress);
+}
+
+BEGIN_MESSAGE_MAP(CBEToolboxProgressDlg, CDialog)
+   ON_WM_TIMER()
+   ON_MESSAGE(WM_TASK_DONE, OnTaskDone)
+END_MESSAGE_MAP()
+
+bool CBEToolboxProgressDlg::Run(const Task& task,bool* pbCancelled)
+{
+   m_Task = task;
+   m_Percent = 0;
+   m_bCancelled = false;
+   m_bResult = false;
+   m_Exception = nullptr;
+
+   DoModal();
+
+   *pbCancelled = m_bCancelled;
+   if ( m_Exception )
+   {
+      std::rethrow_exception(m_Exception);
+   }
+
+   return m_bResult;
+}
+
+// CBEToolboxProgressDlg message handlers
+
+BOOL CBEToolboxProgressDlg::OnInitDialog()
+{
+   CDialog::OnInitDialog();
+
+   GetDlgItem(IDC_PROGRESS_MESSAGE)->SetWindowText(m_strMessage);
+   m_Progress.SetRange(0,100);
+   SetTimer(PROGRESS_TIMER,100,nullptr);
+
+   HWND hWnd = GetSafeHwnd();
+   m_Worker = std::thread([this,hWnd]()
+   {
+      auto progress = [this](Float64 fraction)
+      {
+         m_Percent = (int)(100*fraction);
+         return !m_bCancelled;
+      };
+
+      try
+      {
+         m_bResult = m_Task(progress);
+      }
+      catch(...)
+      {
+         m_Exception = std::current_exception();
+      }
+
+      ::PostMessage(hWnd,WM_TASK_DONE,0,0);
+   });
+
+   return TRUE;  // return TRUE unless you set the focus to a control
+   // EXCEPTION: OCX Property Pages should return FALSE
+}
+
+void CBEToolboxProgressDlg::OnOK()
+{
+   // the dialog closes when the task is done, not when Enter is pressed
+}
+
+void CBEToolboxProgressDlg::OnCancel()
+{
+   // tell the task to stop... the dialog closes when the worker thread finishes
+   m_bCancelled = true;
+   GetDlgItem(IDCANCEL)->EnableWindow(FALSE);
+   GetDlgItem(IDC_PROGRESS_MESSAGE)->SetWindowText(_T("Cancelling..."));
+}
+
+void CBEToolboxProgressDlg::OnTimer(UINT_PTR nIDEvent)
+{
+   if ( nIDEvent == PROGRESS_TIMER )
+   {
+      m_Progress.SetPos(m_Percent);
+   }
+
+   CDialog::OnTimer(nIDEvent);
+}
+
+LRESULT CBEToolboxProgressDlg::OnTaskDone(WPARAM wParam,LPARAM lParam)
+{
+   m_Worker.join();
+   KillTimer(PROGRESS_TIMER);
+   EndDialog(IDOK);
+   return 0;
+}
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <exception>
+
+// CBEToolboxProgressDlg dialog
+//
+// Runs a lengthy computation on a worker thread while a modal progress dialog is displayed.
+// The dialog runs its own message loop so the application keeps painting, and the user
+// can stop the computation with the Cancel button.
+class CBEToolboxProgressDlg : public CDialog
+{
+	DECLARE_DYNAMIC(CBEToolboxProgressDlg)
+
+public:
+   // Called by the task to report the fraction of the work that is complete (0 to 1).
+   // Returns false when the user has pressed Cancel. The task should stop as soon as practical.
+   // The callback can be called from any thread.
+   typedef std::function<bool(Float64 fraction)> ProgressCallback;
+
+   // The task runs on a worker thread and must not access any windows.
+   // Returns true if it ran to completion.
+   typedef std::function<bool(const ProgressCallback& progress)> Task;
+
+	CBEToolboxProgressDlg(LPCTSTR lpszMessage,CWnd* pParent = nullptr);   // standard constructor
+	virtual ~CBEToolboxProgressDlg();
+
+   // Runs the task and returns the value returned by the task. *pbCancelled is set to
+   // true if the user pressed Cancel. Exceptions thrown by the task are re-thrown here.
+   bool Run(const Task& task,bool* pbCancelled);
+
+// Dialog Data
+	enum { IDD = IDD_BETOOLBOX_PROGRESS };
+
+protected:
+	virtual void DoDataExchange(CDataExchange* pDX) override;    // DDX/DDV support
+	virtual BOOL OnInitDialog() override;
+   virtual void OnOK() override;
+   virtual void OnCancel() override;
+
+   CString m_strMessage;
+   CProgressCtrl m_Progress;
+
+   Task m_Task;
+   std::thread m_Worker;
+   std::atomic<int> m_Percent;
+   std::atomic<bool> m_bCancelled;
+   bool m_bResult;
+   std::exception_ptr m_Exception;
+
+	DECLARE_MESSAGE_MAP()
+   afx_msg void OnTimer(UINT_PTR nIDEvent);
+   afx_msg LRESULT OnTaskDone(WPARAM wParam,LPARAM lParam);
+};
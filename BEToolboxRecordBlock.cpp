@@ -0,0 +1,309 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#include "stdafx.h"
+#include "BEToolboxRecordBlock.h"
+
+#include <atlenc.h>
+#include <algorithm>
+#include <climits>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+HRESULT WriteRecordBlock(IStructuredSave* pStrSave,LPCTSTR lpszName,const std::vector<std::_tstring>& vFields,const Float64* pRecords,IndexType nRecords)
+{
+   IndexType nFields = vFields.size();
+   IndexType nBytes = nRecords*nFields*sizeof(Float64);
+   if ( INT_MAX/2 < nBytes )
+   {
+      ATLASSERT(false); // block is too big to encode
+      return E_FAIL;
+   }
+
+   HRESULT hr = pStrSave->BeginUnit(lpszName,1.0);
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("RecordCount"),CComVariant(nRecords));
+   if ( FAILED(hr) )
+      return hr;
+
+   std::_tstring strFields;
+   for ( const auto& strField : vFields )
+   {
+      ATLASSERT(strField.find(_T(' ')) == std::_tstring::npos);
+      if ( !strFields.empty() )
+      {
+         strFields += _T(" ");
+      }
+      strFields += strField;
+   }
+
+   hr = pStrSave->put_Property(_T("Fields"),CComVariant(strFields.c_str()));
+   if ( FAILED(hr) )
+      return hr;
+
+   int nLength = Base64EncodeGetRequiredLength((int)nBytes,ATL_BASE64_FLAG_NOCRLF);
+   std::vector<char> vText(nLength+1);
+   if ( !Base64Encode((const BYTE*)pRecords,(int)nBytes,vText.data(),&nLength,ATL_BASE64_FLAG_NOCRLF) )
+   {
+      return E_FAIL;
+   }
+
+   // hand the string to the variant instead of copying it
+   CComBSTR bstrRecords(nLength,vText.data());
+   CComVariant varRecords;
+   varRecords.vt = VT_BSTR;
+   varRecords.bstrVal = bstrRecords.Detach();
+   hr = pStrSave->put_Property(_T("Records"),varRecords);
+   if ( FAILED(hr) )
+      return hr;
+
+   return pStrSave->EndUnit();
+}
+
+HRESULT ReadRecordBlock(IStructuredLoad* pStrLoad,LPCTSTR lpszName,const std::vector<std::_tstring>& vFields,std::vector<Float64>* pvRecords,IndexType* pnRecords)
+{
+   pvRecords->clear();
+   *pnRecords = 0;
+
+   HRESULT hr = pStrLoad->BeginUnit(lpszName);
+   if ( FAILED(hr) )
+      return hr;
+
+   CComVariant var;
+   var.vt = VT_INDEX;
+   hr = pStrLoad->get_Property(_T("RecordCount"),&var);
+   if ( FAILED(hr) )
+      return hr;
+
+   IndexType nRecords = VARIANT2INDEX(var);
+
+   var.Clear();
+   var.vt = VT_BSTR;
+   hr = pStrLoad->get_Property(_T("Fields"),&var);
+   if ( FAILED(hr) )
+      return hr;
+
+   // locate the requested fields in the records
+   std::vector<std::_tstring> vBlockFields;
+   CString strBlockFields(var.bstrVal);
+   int pos = 0;
+   CString strField = strBlockFields.Tokenize(_T(" "),pos);
+   while ( !strField.IsEmpty() )
+   {
+      vBlockFields.push_back(std::_tstring(strField));
+      strField = strBlockFields.Tokenize(_T(" "),pos);
+   }
+
+   IndexType nFields = vFields.size();
+   IndexType nBlockFields = vBlockFields.size();
+   std::vector<IndexType> vColumns;
+   vColumns.reserve(nFields);
+   bool bSameFields = (nFields == nBlockFields);
+   for ( IndexType fieldIdx = 0; fieldIdx < nFields; fieldIdx++ )
+   {
+      auto found = std::find(vBlockFields.begin(),vBlockFields.end(),vFields[fieldIdx]);
+      if ( found == vBlockFields.end() )
+      {
+         return E_FAIL;
+      }
+
+      IndexType column = std::distance(vBlockFields.begin(),found);
+      bSameFields = bSameFields && (column == fieldIdx);
+      vColumns.push_back(column);
+   }
+
+   var.Clear();
+   var.vt = VT_BSTR;
+   hr = pStrLoad->get_Property(_T("Records"),&var);
+   if ( FAILED(hr) )
+      return hr;
+
+   int nLength = (int)::SysStringLen(var.bstrVal);
+   std::string strText;
+   strText.reserve(nLength);
+   for ( int i = 0; i < nLength; i++ )
+   {
+      strText += (char)var.bstrVal[i];
+   }
+   var.Clear();
+
+   IndexType nValues = nRecords*nBlockFields;
+   int nBytes = Base64DecodeGetRequiredLength(nLength);
+   std::vector<Float64> vBlock((nBytes + sizeof(Float64) - 1)/sizeof(Float64));
+   if ( !Base64Decode(strText.c_str(),nLength,(BYTE*)vBlock.data(),&nBytes) || (IndexType)nBytes != nValues*sizeof(Float64) )
+   {
+      return E_FAIL;
+   }
+   vBlock.resize(nValues);
+
+   if ( bSameFields )
+   {
+      // the records are used as they are
+      pvRecords->swap(vBlock);
+   }
+   else
+   {
+      pvRecords->resize(nRecords*nFields);
+      for ( IndexType recordIdx = 0; recordIdx < nRecords; recordIdx++ )
+      {
+         const Float64* pBlockRecord = &vBlock[recordIdx*nBlockFields];
+         Float64* pRecord = pvRecords->data() + recordIdx*nFields;
+         for ( IndexType fieldIdx = 0; fieldIdx < nFields; fieldIdx++ )
+         {
+            pRecord[fieldIdx] = pBlockRecord[vColumns[fieldIdx]];
+         }
+      }
+   }
+
+   *pnRecords = nRecords;
+
+   return pStrLoad->EndUnit();
+}
+
+HRESULT WriteStringBlock(IStructuredSave* pStrSave,LPCTSTR lpszName,const std::vector<std::_tstring>& vStrings)
+{
+   // each string is its length in bytes followed by its UTF-8 text
+   std::vector<BYTE> vBytes;
+   for ( const auto& str : vStrings )
+   {
+      CT2A strUTF8(str.c_str(),CP_UTF8);
+      Uint32 nChars = (Uint32)strlen(strUTF8);
+      const BYTE* pLength = (const BYTE*)&nChars;
+      const BYTE* pChars = (const BYTE*)(LPCSTR)strUTF8;
+      vBytes.insert(vBytes.end(),pLength,pLength + sizeof(Uint32));
+      vBytes.insert(vBytes.end(),pChars,pChars + nChars);
+   }
+
+   IndexType nBytes = vBytes.size();
+   if ( INT_MAX/2 < nBytes )
+   {
+      ATLASSERT(false); // block is too big to encode
+      return E_FAIL;
+   }
+
+   HRESULT hr = pStrSave->BeginUnit(lpszName,1.0);
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("Count"),CComVariant(vStrings.size()));
+   if ( FAILED(hr) )
+      return hr;
+
+   if ( 0 < nBytes )
+   {
+      int nLength = Base64EncodeGetRequiredLength((int)nBytes,ATL_BASE64_FLAG_NOCRLF);
+      std::vector<char> vText(nLength+1);
+      if ( !Base64Encode(vBytes.data(),(int)nBytes,vText.data(),&nLength,ATL_BASE64_FLAG_NOCRLF) )
+      {
+         return E_FAIL;
+      }
+
+      CComBSTR bstrStrings(nLength,vText.data());
+      CComVariant varStrings;
+      varStrings.vt = VT_BSTR;
+      varStrings.bstrVal = bstrStrings.Detach();
+      hr = pStrSave->put_Property(_T("Strings"),varStrings);
+      if ( FAILED(hr) )
+         return hr;
+   }
+
+   return pStrSave->EndUnit();
+}
+
+HRESULT ReadStringBlock(IStructuredLoad* pStrLoad,LPCTSTR lpszName,std::vector<std::_tstring>* pvStrings)
+{
+   pvStrings->clear();
+
+   HRESULT hr = pStrLoad->BeginUnit(lpszName);
+   if ( FAILED(hr) )
+      return hr;
+
+   CComVariant var;
+   var.vt = VT_INDEX;
+   hr = pStrLoad->get_Property(_T("Count"),&var);
+   if ( FAILED(hr) )
+      return hr;
+
+   IndexType nStrings = VARIANT2INDEX(var);
+
+   if ( 0 < nStrings )
+   {
+      // there is always text in the block when it has strings because each string has a length
+      var.Clear();
+      var.vt = VT_BSTR;
+      hr = pStrLoad->get_Property(_T("Strings"),&var);
+      if ( FAILED(hr) )
+         return hr;
+
+      int nLength = (int)::SysStringLen(var.bstrVal);
+      std::string strText;
+      strText.reserve(nLength);
+      for ( int i = 0; i < nLength; i++ )
+      {
+         strText += (char)var.bstrVal[i];
+      }
+      var.Clear();
+
+      int nBytes = Base64DecodeGetRequiredLength(nLength);
+      std::vector<BYTE> vBytes(nBytes);
+      if ( !Base64Decode(strText.c_str(),nLength,vBytes.data(),&nBytes) )
+      {
+         return E_FAIL;
+      }
+
+      pvStrings->reserve(nStrings);
+      IndexType pos = 0;
+      while ( pos < (IndexType)nBytes )
+      {
+         Uint32 nChars;
+         if ( (IndexType)nBytes - pos < sizeof(Uint32) )
+         {
+            return E_FAIL;
+         }
+         memcpy(&nChars,&vBytes[pos],sizeof(Uint32));
+         pos += sizeof(Uint32);
+
+         if ( (IndexType)nBytes - pos < nChars )
+         {
+            return E_FAIL;
+         }
+         std::string strUTF8((const char*)vBytes.data() + pos,nChars);
+         pos += nChars;
+
+         pvStrings->push_back(std::_tstring(CA2T(strUTF8.c_str(),CP_UTF8)));
+      }
+   }
+
+   if ( pvStrings->size() != nStrings )
+   {
+      return E_FAIL;
+   }
+
+   return pStrLoad->EndUnit();
+}
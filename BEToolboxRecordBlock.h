@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <vector>
+
+// Record blocks
+//
+// A record block is a counted array of fixed size numeric records that is saved as a single unit with IStructuredSave.
+// Large problem lists are saved as a record block instead of a unit with a property for every value, so the number
+// of IStructuredSave/IStructuredLoad calls doesn't depend on the number of problems. The records are packed Float64
+// values (little-endian, as written on Windows) encoded as base64 text.
+//
+// The field names are saved with the block. When a block is read, the requested fields are matched by name so fields
+// can be added to the records in later versions. It is an error to request a field that isn't in the block.
+//
+// Unit layout
+//   <Name version="1">
+//      <RecordCount>  number of records
+//      <Fields>       field names, separated by spaces
+//      <Records>      base64 encoded records
+//   </Name>
+//
+// A string block is a counted list of strings that is saved as a single unit. Each string is saved as its length
+// in bytes (Uint32) followed by its UTF-8 text and the list is encoded as base64 text, the same as the records of a
+// record block. Empty strings and white space are kept exactly. Strings is omitted when there are no strings.
+//
+// Unit layout
+//   <Name version="1">
+//      <Count>    number of strings
+//      <Strings>  base64 encoded strings
+//   </Name>
+
+// Writes nRecords records. pRecords has vFields.size() values for each record, record by record.
+HRESULT WriteRecordBlock(IStructuredSave* pStrSave,LPCTSTR lpszName,const std::vector<std::_tstring>& vFields,const Float64* pRecords,IndexType nRecords);
+
+// Reads a record block. pvRecords receives vFields.size() values for each record, record by record, in the order of vFields.
+HRESULT ReadRecordBlock(IStructuredLoad* pStrLoad,LPCTSTR lpszName,const std::vector<std::_tstring>& vFields,std::vector<Float64>* pvRecords,IndexType* pnRecords);
+
+HRESULT WriteStringBlock(IStructuredSave* pStrSave,LPCTSTR lpszName,const std::vector<std::_tstring>& vStrings);
+HRESULT ReadStringBlock(IStructuredLoad* pStrLoad,LPCTSTR lpszName,std::vector<std::_tstring>* pvStrings);
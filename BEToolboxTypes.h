@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include "Engine\VerticalCurves.h"
+
 struct IndividualStation
 {
    Float64 Station;
@@ -36,13 +38,24 @@ struct StationRange
    Float64 Offset;
 };
 
-struct SuperelevationProfilePoint
+struct ProfileCurve
 {
-   Float64 Station;
-   Float64 LeftSlope;
-   Float64 RightSlope;
+   // A vertical curve that follows another vertical curve. The entry grade is the exit grade of
+   // the previous curve and the PVI is on the exit grade of the previous curve
+   Float64 PVIStation;
+   Float64 g2;
+   Float64 Length;
+};
+
+struct HorizontalCurve
+{
+   Float64 PIStation;
+   Float64 FwdTangent; // bearing of the forward tangent, radians measured counter-clockwise from east
+   Float64 Radius; // zero for an angle point
 };
 
+using BEToolboxEngine::SuperelevationProfilePoint;
+
 struct SkewLine
 {
    enum Type { RadialFromCrownLine, // 992 - all offsets are taken normal to and measured from the crown line
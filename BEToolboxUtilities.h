@@ -22,5 +22,13 @@
 
 #pragma once
 
+#include "Engine\EngineUtilities.h"
+
 Float64 GetOffset(CString strOffset,const unitmgtLengthData& displayUnit);
 CString GetOffset(Float64 value,const unitmgtLengthData& displayUnit);
+
+// The thread pool and segment search are part of the portable engine so they can be used
+// by the engines on any platform
+using BEToolboxEngine::GetWorkerThreadCount;
+using BEToolboxEngine::ParallelFor;
+using BEToolboxEngine::FindSegment;
@@ -25,6 +25,7 @@
 
 #include "stdafx.h"
 #include "BEToolboxXMLApp.h"
+#include "XMLRuntime.h"
 
 #include <initguid.h>
 #include <WBFLUnitServer.h>
@@ -92,3 +93,8 @@ BOOL CBEToolboxXMLApp::InitInstance()
 
 	return TRUE;
 }
+
+void TerminateXMLRuntime()
+{
+	CXMLRuntime::Terminate();
+}
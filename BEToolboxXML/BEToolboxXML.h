@@ -43,3 +43,8 @@
 #endif
 
 #include "AutoLib.h"
+
+// Releases the XML parser, the compiled XSL Transforms, and the cached schemas. Call once during
+// application shutdown, after the last document has been loaded. Xerces and Xalan can't be
+// terminated safely while this module is being unloaded.
+void BETOOLBOXXMLFUNC TerminateXMLRuntime();
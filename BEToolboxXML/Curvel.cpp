@@ -24,12 +24,17 @@
 #include "resource.h"
 #include "Curvel.h"
 #include <WBFLUnitServer\OpenBridgeML.h>
-#include "Helpers.h"
+#include "DocumentMigration.h"
+#include "XMLRuntime.h"
+#include "UnitNormalizer.h"
 
 #include <fstream>
+#include <chrono>
 
 #include <xalanc/Include/PlatformDefinitions.hpp>
 #include <xercesc/dom/DOMDocument.hpp>
+#include <xercesc/dom/DOMElement.hpp>
+#include <xercesc/util/XMLUniDefs.hpp>
 #include <xercesc/dom/DOMImplementation.hpp>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <xercesc/framework/LocalFileInputSource.hpp>
@@ -50,12 +55,6 @@ static char THIS_FILE[] = __FILE__;
 #endif
 
 
-//XALAN_USING_XERCES(DOMDocument)
-
-XALAN_USING_XALAN(XalanCompiledStylesheet)
-XALAN_USING_XALAN(XalanParsedSource)
-XALAN_USING_XALAN(XalanTransformer)
-
 std::unique_ptr<Curvel> CreateCurvelModel()
 {
    std::unique_ptr<Curvel> curvelXML(std::make_unique<Curvel>(VerticalCurveDataType(0.0,0.0,0.0,0.0,0.0)));
@@ -75,29 +74,56 @@ BOOL ConvertToBaseUnits(Curvel* pCurvel,IUnitServer* pDocUnitServer)
    // 2) Walk document and convert all units to Consistent Base Units
    // 3) Do all work in consistent base units
    // 4) Save document with consistent base units
-   CComPtr<IUnitServer> xmlDocUnitServer;
-   HRESULT hr = xmlDocUnitServer.CoCreateInstance(CLSID_UnitServer);
-
+   // The conversion factors are computed once for each unit of measure in the document
+   CUnitNormalizer normalizer(pDocUnitServer);
    Curvel::UnitsDeclaration_optional& unitsDeclaration(pCurvel->UnitsDeclaration());
-   if ( unitsDeclaration.present())
+   if ( !normalizer.Init(unitsDeclaration.present() ? &unitsDeclaration.get() : nullptr) )
    {
-      if ( !InitializeWBFLUnitServer(&unitsDeclaration.get(),xmlDocUnitServer) )
-      {
-         return FALSE;
-      }
+      return FALSE;
    }
 
    // Convert Vertical Curve Parameters
    VerticalCurveDataType& vc(pCurvel->VerticalCurveData());
-   ConvertBetweenBaseUnits(vc.Length(),       xmlDocUnitServer, pDocUnitServer);
-   ConvertBetweenBaseUnits(vc.PVIStation(),   xmlDocUnitServer, pDocUnitServer);
-   ConvertBetweenBaseUnits(vc.PVIElevation(), xmlDocUnitServer, pDocUnitServer);
+   normalizer.Convert(vc.Length());
+   normalizer.Convert(vc.PVIStation());
+   normalizer.Convert(vc.PVIElevation());
+
+   Curvel::VerticalCurves_optional& verticalCurvesOptional(pCurvel->VerticalCurves());
+   if ( verticalCurvesOptional.present() )
+   {
+      VerticalCurvesType::VerticalCurve_sequence& verticalCurves(verticalCurvesOptional->VerticalCurve());
+      VerticalCurvesType::VerticalCurve_iterator iter(verticalCurves.begin());
+      VerticalCurvesType::VerticalCurve_iterator end(verticalCurves.end());
+      for ( ; iter != end; iter++ )
+      {
+         ProfileCurveType& verticalCurve(*iter);
+
+         normalizer.Convert(verticalCurve.PVIStation());
+         normalizer.Convert(verticalCurve.Length());
+      }
+   }
+
+   // Horizontal Alignment
+   Curvel::HorizontalAlignment_optional& alignmentOptional(pCurvel->HorizontalAlignment());
+   if ( alignmentOptional.present() )
+   {
+      HorizontalAlignmentType::HorizontalCurve_sequence& horizontalCurves(alignmentOptional->HorizontalCurve());
+      HorizontalAlignmentType::HorizontalCurve_iterator iter(horizontalCurves.begin());
+      HorizontalAlignmentType::HorizontalCurve_iterator end(horizontalCurves.end());
+      for ( ; iter != end; iter++ )
+      {
+         HorizontalCurveType& horizontalCurve(*iter);
+
+         normalizer.Convert(horizontalCurve.PIStation());
+         normalizer.Convert(horizontalCurve.Radius());
+      }
+   }
    
    // Superelevation Data
    Curvel::SuperelevationData_optional& seData(pCurvel->SuperelevationData());
    if ( seData.present() )
    {
-      ConvertBetweenBaseUnits(seData->ProfileGradeOffset(), xmlDocUnitServer, pDocUnitServer);
+      normalizer.Convert(seData->ProfileGradeOffset());
 
       CrownSlopeType& crownSlope( seData->CrownSlope() );
       CrownSlopeType::SuperelevationProfilePoint_sequence& superPP(crownSlope.SuperelevationProfilePoint());
@@ -105,7 +131,7 @@ BOOL ConvertToBaseUnits(Curvel* pCurvel,IUnitServer* pDocUnitServer)
       ATLASSERT(superPP.size() == 3);
       for ( int i = 0; i < 3; i++ )
       {
-         ConvertBetweenBaseUnits(superPP[i].Station(), xmlDocUnitServer, pDocUnitServer);
+         normalizer.Convert(superPP[i].Station());
       }
    }
    
@@ -120,8 +146,8 @@ BOOL ConvertToBaseUnits(Curvel* pCurvel,IUnitServer* pDocUnitServer)
       {
          IndividualStationType& individualStation(*iter);
 
-         ConvertBetweenBaseUnits(individualStation.Station(), xmlDocUnitServer, pDocUnitServer);
-         ConvertBetweenBaseUnits(individualStation.Offset(),  xmlDocUnitServer, pDocUnitServer);
+         normalizer.Convert(individualStation.Station());
+         normalizer.Convert(individualStation.Offset());
       }
    }
 
@@ -136,9 +162,9 @@ BOOL ConvertToBaseUnits(Curvel* pCurvel,IUnitServer* pDocUnitServer)
       {
          StationRangeType& stationRange(*iter);
 
-         ConvertBetweenBaseUnits(stationRange.StartStation(), xmlDocUnitServer, pDocUnitServer);
-         ConvertBetweenBaseUnits(stationRange.EndStation(),   xmlDocUnitServer, pDocUnitServer);
-         ConvertBetweenBaseUnits(stationRange.Offset(),       xmlDocUnitServer, pDocUnitServer);
+         normalizer.Convert(stationRange.StartStation());
+         normalizer.Convert(stationRange.EndStation());
+         normalizer.Convert(stationRange.Offset());
       }
    }
 
@@ -153,127 +179,54 @@ BOOL ConvertToBaseUnits(Curvel* pCurvel,IUnitServer* pDocUnitServer)
       {
          SkewLineType& skewLine(*iter);
 
-         ConvertBetweenBaseUnits(skewLine.Station(),     xmlDocUnitServer, pDocUnitServer);
-         ConvertBetweenBaseUnits(skewLine.Offset(),      xmlDocUnitServer, pDocUnitServer);
-         ConvertBetweenBaseUnits(skewLine.Radius(),      xmlDocUnitServer, pDocUnitServer);
-         ConvertBetweenBaseUnits(skewLine.CrownOffset(), xmlDocUnitServer, pDocUnitServer);
+         normalizer.Convert(skewLine.Station());
+         normalizer.Convert(skewLine.Offset());
+         normalizer.Convert(skewLine.Radius());
+         normalizer.Convert(skewLine.CrownOffset());
       }
    }
 
    return TRUE;
 }
 
-std::unique_ptr<Curvel> CreateCurvelModel(LPCTSTR lpszFilePath,IUnitServer* pDocUnitServer)
+// Steps that migrate older Curvel documents to the current version. When the
+// Curvel schema is versioned, add a step for the new XSL Transform to the end of the table.
+static const MIGRATIONSTEP gs_CurvelMigration[] =
 {
-   ATLASSERT(lpszFilePath != nullptr);
-   ATLASSERT(pDocUnitServer != nullptr);
+   { 1.0, 2.0, IDR_CURVEL_10_TO_20_XSLT },
+   { 2.0, 3.0, IDR_CURVEL_20_TO_30_XSLT },
+};
 
-   USES_CONVERSION;
+#define CURVEL_VERSION 3.0 // version of the current Curvel format
 
+// Upgrades a document in an older format to the current format with the migration
+// pipeline and binds the upgraded document to the object model
+static std::unique_ptr<Curvel> UpgradeCurvelModel(LPCTSTR lpszFilePath,Float64 version)
+{
    // Creating is a two phase process.
-   // Step 1 is to run the document through the Xalan XSLT engine,
+   // Step 1 is to run the document through the migration pipeline,
    // applying XSL Transforms to bring the document model up to
    // the most current version.
    // Step 2 is to run the document through the C++\Tree binding
    // to populate the object model.
-   //
-   // Most of this code is taken from the TransformToXercesDOM example
-   // from the Xalan distribution.
    std::unique_ptr<Curvel> curvelXML;
    try
    {
-      XALAN_USING_XERCES(XMLPlatformUtils)
-      XMLPlatformUtils::Initialize();
-      XalanTransformer::initialize();
+      XALAN_USING_XERCES(DOMDocument)
+      XALAN_USING_XALAN(XalanAutoPtr)
 
+      CString strError;
+      const XalanAutoPtr<DOMDocument> theDocument(MigrateDocument(_T("Curvel"),lpszFilePath,version,gs_CurvelMigration,_countof(gs_CurvelMigration),strError));
+      if ( theDocument.get() == nullptr )
       {
-      XalanTransformer  theTransformer;
-      const XalanParsedSource* theParsedSource = 0;
-
-      int theResult = theTransformer.parseSource(lpszFilePath, theParsedSource);
-
-      if (theResult != 0)
-      {
-         CString strMsg;
-         strMsg.Format(_T("Error parsing source document: %s"),A2T(theTransformer.getLastError()));
-         AfxMessageBox(strMsg);
+         AfxMessageBox(strError);
          return std::unique_ptr<Curvel>();
       }
-      else
-      {
-           assert(theParsedSource != 0);
-
-           const XalanCompiledStylesheet*  theCompiledStylesheet = 0;
-
-           const char* lpstrXSLT = nullptr;
-           DWORD size = 0;
-#pragma Reminder("UPDATE: add error handling")
-           if ( !LoadXMLResource(IDR_CURVEL_10_TO_20_XSLT,XSLTFILE,size,lpstrXSLT) )
-           {
-              AfxMessageBox(_T("Error loading XSL Transform resource"));
-              return std::unique_ptr<Curvel>();
-           }
-
-           std::string strXSLT(lpstrXSLT,size);
-           std::istringstream xsltStream(strXSLT);
-
-           theResult = theTransformer.compileStylesheet(xsltStream, theCompiledStylesheet);
-           // Note: create multiple XalanTransformer objects, one for each transformation
-           // Version 1.0 -> Version 2.0
-           // Version 2.0 -> Version 2.1
-           // etc
-
-           if (theResult != 0)
-           {
-              CString strMsg;
-              strMsg.Format(_T("Error compiling stylesheet: %s"),A2T(theTransformer.getLastError()));
-              AfxMessageBox(strMsg);
-              return std::unique_ptr<Curvel>();
-           }
-           else
-           {
-                XALAN_USING_XERCES(DOMDocument)
-                XALAN_USING_XERCES(DOMImplementation)
-                XALAN_USING_XALAN(FormatterToXercesDOM)
-                XALAN_USING_XALAN(XalanAutoPtr)
-
-                // This is the document which we'll build...
-                const XalanAutoPtr<DOMDocument>     theDocument(DOMImplementation::getImplementation()->createDocument());
-                assert(theDocument.get() != nullptr);
-
-                // This is a class derived from FormatterListener, which
-                // we'll hook up to Xalan's output stage...
-                FormatterToXercesDOM    theFormatter(theDocument.get(), 0);
-
-                // Do the transformation...
-                int     theResult =
-                    theTransformer.transform(
-                        *theParsedSource,
-                        theCompiledStylesheet,
-                        theFormatter);
-                // NOTE: do the transformation for each transformer
-
-                if (theResult != 0)
-                {
-                    CString strMsg;
-                    strMsg.Format(_T("Error transforming: %s"),theTransformer.getLastError());
-                    AfxMessageBox(strMsg);
-                    return std::unique_ptr<Curvel>();
-                }
-                else
-                {
-                   // Now that theDocument has been converted to the latest format
-                   // create the C++ binding
-#pragma Reminder("UPDATE: try to make the schema be a resource that is compiled into this dll")
-                     xml_schema::properties props;
-                     props.no_namespace_schema_location(_T("Curvel_Version_2.0.xsd"));
-                     curvelXML = Curvel_(*theDocument.get()/*lpszPathName*/,0,props);
-                }
-           }
-      }
-      }
-      XalanTransformer::terminate();
-      XMLPlatformUtils::Terminate();
+
+      // Now that theDocument has been converted to the latest format
+      // create the C++ binding
+      // The transforms produce documents in the current format so the migrated document isn't validated again
+      curvelXML = Curvel_(*theDocument.get(),xml_schema::flags::dont_initialize);
    }
    catch(const xml_schema::exception& /*e*/)
    {
@@ -288,6 +241,75 @@ std::unique_ptr<Curvel> CreateCurvelModel(LPCTSTR lpszFilePath,IUnitServer* pDoc
       return std::unique_ptr<Curvel>();
    }
 
+   return curvelXML;
+}
+
+std::unique_ptr<Curvel> CreateCurvelModel(LPCTSTR lpszFilePath,IUnitServer* pDocUnitServer)
+{
+   ATLASSERT(lpszFilePath != nullptr);
+   ATLASSERT(pDocUnitServer != nullptr);
+
+#if defined _DEBUG
+   std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::now());
+#endif
+
+   // Documents in the current format don't need to be upgraded. The version of the document
+   // is read from the root element and current documents are bound directly from the file.
+   // Version 3 only adds optional elements to version 2 so version 2 documents are bound directly as well.
+   // Only older documents go through the migration pipeline.
+   std::unique_ptr<Curvel> curvelXML;
+   Float64 version = GetDocumentVersion(lpszFilePath,"Curvel");
+   bool bVersion2 = IsEqual(version,2.0);
+   bool bCurrentFormat = IsEqual(version,CURVEL_VERSION) || bVersion2;
+   if ( bCurrentFormat )
+   {
+      try
+      {
+         // Documents are validated against the schema for their version that is compiled into this module.
+         // The grammar is parsed once and cached by the XML runtime.
+         XALAN_USING_XERCES(DOMDocument)
+         XALAN_USING_XALAN(XalanAutoPtr)
+
+         CString strError;
+         const XalanAutoPtr<DOMDocument> theDocument(CXMLRuntime::GetInstance().ParseDocument(lpszFilePath,bVersion2 ? IDR_CURVEL_20_XSD : IDR_CURVEL_30_XSD,strError));
+         if ( theDocument.get() == nullptr )
+         {
+            AfxMessageBox(strError);
+            return std::unique_ptr<Curvel>();
+         }
+
+         if ( bVersion2 )
+         {
+            // This is all the 2.0 to 3.0 transform does. Updating the version in place saves the XSLT round trip.
+            static const XMLCh strVersion[] = { XERCES_CPP_NAMESPACE::chLatin_v, XERCES_CPP_NAMESPACE::chLatin_e, XERCES_CPP_NAMESPACE::chLatin_r, XERCES_CPP_NAMESPACE::chLatin_s, XERCES_CPP_NAMESPACE::chLatin_i, XERCES_CPP_NAMESPACE::chLatin_o, XERCES_CPP_NAMESPACE::chLatin_n, XERCES_CPP_NAMESPACE::chNull };
+            static const XMLCh strCurrentVersion[] = { XERCES_CPP_NAMESPACE::chDigit_3, XERCES_CPP_NAMESPACE::chNull };
+            theDocument->getDocumentElement()->setAttribute(strVersion,strCurrentVersion);
+         }
+
+         curvelXML = Curvel_(*theDocument.get(),xml_schema::flags::dont_initialize);
+      }
+      catch(...)
+      {
+#pragma Reminder("UPDATE: provide better error handling")
+         AfxMessageBox(_T("An error occured while loading the file"));
+         curvelXML.reset();
+      }
+   }
+   else
+   {
+      curvelXML = UpgradeCurvelModel(lpszFilePath,version);
+   }
+
+   if ( curvelXML.get() == nullptr )
+   {
+      return std::unique_ptr<Curvel>();
+   }
+
+#if defined _DEBUG
+   Float64 loadTime = std::chrono::duration<Float64,std::milli>(std::chrono::steady_clock::now() - startTime).count();
+   WATCH(lpszFilePath << _T(" loaded in ") << loadTime << (bCurrentFormat ? _T(" ms (current format)") : _T(" ms (upgraded)")));
+#endif
+
    if ( !ConvertToBaseUnits(curvelXML.get(),pDocUnitServer) )
    {
       // something went wrong in the unit conversion
@@ -23,7 +23,7 @@
 #pragma once
 
 #include <BEToolboxXML.h>
-#include <Curvel_Version_2.0.hxx>
+#include <Curvel_Version_3.0.hxx>
 #include <WBFLUnitServer.h>
 
 // Creates a Curvel data model. If lpszFileName is nullptr, a default
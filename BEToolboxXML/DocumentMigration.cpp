@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#include "stdafx.h"
+#include "DocumentMigration.h"
+#include "Helpers.h"
+#include "XMLRuntime.h"
+
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+#include <xercesc/dom/DOMImplementation.hpp>
+#include <xalanc/XercesParserLiaison/FormatterToXercesDOM.hpp>
+#include <xalanc/XalanTransformer/XalanTransformer.hpp>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+XALAN_USING_XERCES(DOMDocument)
+XALAN_USING_XERCES(DOMImplementation)
+XALAN_USING_XALAN(FormatterToXercesDOM)
+XALAN_USING_XALAN(XalanCompiledStylesheet)
+XALAN_USING_XALAN(XalanParsedSource)
+XALAN_USING_XALAN(XalanTransformer)
+XALAN_USING_XALAN(XSLTInputSource)
+XALAN_USING_XALAN(XSLTResultTarget)
+
+Float64 GetDocumentVersion(LPCTSTR lpszFilePath,LPCSTR lpszRootElement)
+{
+   std::string strRootElement;
+   Float64 version;
+   if ( ReadRootElementVersion(lpszFilePath,strRootElement,version) && strRootElement == lpszRootElement )
+   {
+      return version;
+   }
+
+   return 0;
+}
+
+DOMDocument* MigrateDocument(LPCTSTR lpszDocumentType,LPCTSTR lpszFilePath,Float64 sourceVersion,const MIGRATIONSTEP* pSteps,IndexType nSteps,CString& strError)
+{
+   USES_CONVERSION;
+   strError.Empty();
+
+   // Compose the migration from the steps that are needed for this document
+   std::vector<const MIGRATIONSTEP*> vSteps;
+   for ( IndexType stepIdx = 0; stepIdx < nSteps; stepIdx++ )
+   {
+      const MIGRATIONSTEP& step(pSteps[stepIdx]);
+      ATLASSERT(step.FromVersion < step.ToVersion);
+      ATLASSERT(stepIdx == 0 || IsEqual(pSteps[stepIdx-1].ToVersion,step.FromVersion)); // steps must form a chain
+      if ( IsZero(sourceVersion) || IsEqual(sourceVersion,step.FromVersion) || sourceVersion < step.FromVersion )
+      {
+         vSteps.push_back(&step);
+      }
+   }
+
+   if ( vSteps.empty() )
+   {
+      strError.Format(_T("The %s document was created with a newer version of this program"),lpszDocumentType);
+      return nullptr;
+   }
+
+   // Xerces and Xalan are initialized by the XML runtime
+   CXMLRuntime& runtime(CXMLRuntime::GetInstance());
+
+   XalanTransformer theTransformer;
+   const XalanParsedSource* theParsedSource = 0;
+   if ( theTransformer.parseSource(lpszFilePath, theParsedSource) != 0 )
+   {
+      strError.Format(_T("Error parsing source document: %s"),A2T(theTransformer.getLastError()));
+      return nullptr;
+   }
+
+   // An XSL Transform needs its entire source document so each step parses its input into a source tree. The output
+   // of a step is streamed, as it is generated, into the input of the next step. Intermediate results are streamed
+   // as text and the source tree of a step is released before the source tree of the next step is built. The last step
+   // streams its output directly into the DOM that is bound to the object model. No more than one source tree, plus
+   // the tree that is being built, is held at any time.
+   DOMDocument* theDocument = nullptr;
+   std::vector<const MIGRATIONSTEP*>::const_iterator iter(vSteps.begin());
+   std::vector<const MIGRATIONSTEP*>::const_iterator end(vSteps.end());
+   for ( ; iter != end; iter++ )
+   {
+      const MIGRATIONSTEP* pStep(*iter);
+      bool bLastStep = (iter + 1 == end);
+
+#if defined _DEBUG
+      std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::now());
+#endif
+
+      // The stylesheet is compiled once and shared by all loads
+      const XalanCompiledStylesheet* theCompiledStylesheet = runtime.GetStylesheet(pStep->XSLTID);
+      if ( theCompiledStylesheet == nullptr )
+      {
+         strError = _T("Error loading XSL Transform resource");
+         break;
+      }
+
+      int theResult;
+      if ( bLastStep )
+      {
+         theDocument = DOMImplementation::getImplementation()->createDocument();
+         ATLASSERT(theDocument != nullptr);
+
+         // FormatterToXercesDOM is a FormatterListener that builds the DOM from the output events of the transform
+         FormatterToXercesDOM theFormatter(theDocument, 0);
+         theResult = theTransformer.transform(*theParsedSource, theCompiledStylesheet, theFormatter);
+      }
+      else
+      {
+         std::ostringstream upgradedStream;
+         XSLTResultTarget theResultTarget(upgradedStream);
+         theResult = theTransformer.transform(*theParsedSource, theCompiledStylesheet, theResultTarget);
+         if ( theResult == 0 )
+         {
+            theTransformer.destroyParsedSource(theParsedSource);
+            theParsedSource = 0;
+
+            std::istringstream upgradedSource(upgradedStream.str());
+            upgradedStream.str(std::string()); // release the text before the next source tree is built
+            XSLTInputSource theInputSource(upgradedSource);
+            theResult = theTransformer.parseSource(theInputSource, theParsedSource);
+         }
+      }
+
+      if ( theResult != 0 )
+      {
+         strError.Format(_T("Error upgrading %s document from version %g to version %g: %s"),lpszDocumentType,pStep->FromVersion,pStep->ToVersion,A2T(theTransformer.getLastError()));
+         break;
+      }
+
+#if defined _DEBUG
+      Float64 stepTime = std::chrono::duration<Float64,std::milli>(std::chrono::steady_clock::now() - startTime).count();
+      WATCH(lpszDocumentType << _T(" version ") << pStep->FromVersion << _T(" -> version ") << pStep->ToVersion << _T(" in ") << stepTime << _T(" ms"));
+#endif
+   }
+
+   if ( theParsedSource != 0 )
+   {
+      theTransformer.destroyParsedSource(theParsedSource);
+   }
+
+   if ( !strError.IsEmpty() )
+   {
+      delete theDocument;
+      return nullptr;
+   }
+
+   return theDocument;
+}
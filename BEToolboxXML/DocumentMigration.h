@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <xalanc/Include/PlatformDefinitions.hpp>
+#include <xercesc/dom/DOMDocument.hpp>
+
+// Document migration pipeline
+//
+// A document in an older format is brought up to the current format by applying a chain of XSL Transforms.
+// Each tool defines its migration as a table of steps, in order. A step upgrades a document from one version
+// to the next (Version 1.0 -> Version 2.0, Version 2.0 -> Version 2.1, etc). When the schema is versioned, add
+// a step to the end of the table.
+
+// One step in a document migration
+struct MIGRATIONSTEP
+{
+   Float64 FromVersion; // version of the document before the transform
+   Float64 ToVersion;   // version of the document after the transform
+   int XSLTID;          // resource ID of the XSL Transform
+};
+
+// Returns the version of a document, read from the root element, without parsing the rest of the document.
+// Returns 0 if the version can't be determined, such as for version 1 documents where the tool element
+// is wrapped in a BEToolbox element.
+Float64 GetDocumentVersion(LPCTSTR lpszFilePath,LPCSTR lpszRootElement);
+
+// Migrates a document from sourceVersion to the current version. Only the steps at, or after, sourceVersion
+// are applied. If sourceVersion is 0, all steps are applied (the transforms copy documents they don't
+// apply to). Returns the migrated document, ready to be bound to the object model. The caller owns the document.
+// Returns nullptr, and a description of the error in strError, if the document can't be migrated.
+XERCES_CPP_NAMESPACE::DOMDocument* MigrateDocument(LPCTSTR lpszDocumentType,LPCTSTR lpszFilePath,Float64 sourceVersion,const MIGRATIONSTEP* pSteps,IndexType nSteps,CString& strError);
@@ -23,10 +23,13 @@
 #include "stdafx.h"
 #include "resource.h"
 #include "GenComp.h"
-#include "Helpers.h"
+#include "DocumentMigration.h"
+#include "XMLRuntime.h"
+#include "UnitNormalizer.h"
 #include <WBFLUnitServer\OpenBridgeML.h>
 
 #include <fstream>
+#include <chrono>
 
 #include <xalanc/Include/PlatformDefinitions.hpp>
 #include <xercesc/dom/DOMDocument.hpp>
@@ -51,13 +54,9 @@ static char THIS_FILE[] = __FILE__;
 #endif
 
 
-XALAN_USING_XALAN(XalanCompiledStylesheet)
-XALAN_USING_XALAN(XalanParsedSource)
-XALAN_USING_XALAN(XalanTransformer)
-
 std::unique_ptr<GenComp> CreateGenCompModel()
 {
-   std::unique_ptr<GenComp> genCompXML(std::make_unique<GenComp>(UnitMode::US,1.0,ShapeType(),ShapeType()));
+   std::unique_ptr<GenComp> genCompXML(std::make_unique<GenComp>(UnitMode::US,ShapeType()));
    return genCompXML;
 }
 
@@ -72,17 +71,12 @@ BOOL ConvertToBaseUnits(GenComp* pGenComp,IUnitServer* pDocUnitServer)
    // 2) Walk document and convert all units to Consistent Base Units
    // 3) Do all work in consistent base units
    // 4) Save document with consistent base units
-   CComPtr<IUnitServer> xmlDocUnitServer;
-   HRESULT hr = xmlDocUnitServer.CoCreateInstance(CLSID_UnitServer);
-   ATLASSERT(SUCCEEDED(hr));
-
+   // The conversion factors are computed once for each unit of measure in the document
+   CUnitNormalizer normalizer(pDocUnitServer);
    GenComp::UnitsDeclaration_optional& unitsDeclaration(pGenComp->UnitsDeclaration());
-   if ( unitsDeclaration.present())
+   if ( !normalizer.Init(unitsDeclaration.present() ? &unitsDeclaration.get() : nullptr) )
    {
-      if ( !InitializeWBFLUnitServer(&unitsDeclaration.get(),xmlDocUnitServer) )
-      {
-         return FALSE;
-      }
+      return FALSE;
    }
 
    // Primary Shape
@@ -92,127 +86,65 @@ BOOL ConvertToBaseUnits(GenComp* pGenComp,IUnitServer* pDocUnitServer)
    for ( ; iter != end; iter++ )
    {
       PointType& point(*iter);
-      ConvertBetweenBaseUnits(point.X(), xmlDocUnitServer, pDocUnitServer);
-      ConvertBetweenBaseUnits(point.Y(), xmlDocUnitServer, pDocUnitServer);
+      normalizer.Convert(point.X());
+      normalizer.Convert(point.Y());
    }
 
-   // Secondary Shape
-   ShapeType& secondaryShape(pGenComp->SecondaryShape());
-   iter = secondaryShape.Point().begin();
-   end  = secondaryShape.Point().end();
-   for ( ; iter != end; iter++ )
+   // Secondary Pieces
+   for ( auto& piece : pGenComp->SecondaryPiece() )
    {
-      PointType& point(*iter);
-      ConvertBetweenBaseUnits(point.X(), xmlDocUnitServer, pDocUnitServer);
-      ConvertBetweenBaseUnits(point.Y(), xmlDocUnitServer, pDocUnitServer);
+      ShapeType& secondaryShape(piece.Shape());
+      iter = secondaryShape.Point().begin();
+      end  = secondaryShape.Point().end();
+      for ( ; iter != end; iter++ )
+      {
+         PointType& point(*iter);
+         normalizer.Convert(point.X());
+         normalizer.Convert(point.Y());
+      }
    }
 
    return TRUE;
 }
 
-std::unique_ptr<GenComp> CreateGenCompModel(LPCTSTR lpszFilePath,IUnitServer* pDocUnitServer)
+// Steps that migrate older GenComp documents to the current version. When the
+// GenComp schema is versioned, add a step for the new XSL Transform to the end of the table.
+static const MIGRATIONSTEP gs_GenCompMigration[] =
 {
-   ATLASSERT(lpszFilePath != nullptr);
-   ATLASSERT(pDocUnitServer != nullptr);
+   { 1.0, 2.0, IDR_GENCOMP_10_TO_20_XSLT },
+   { 2.0, 3.0, IDR_GENCOMP_20_TO_30_XSLT },
+};
+
+#define GENCOMP_VERSION 3.0 // version of the current GenComp format
 
+// Upgrades a document in an older format to the current format with the migration
+// pipeline and binds the upgraded document to the object model
+static std::unique_ptr<GenComp> UpgradeGenCompModel(LPCTSTR lpszFilePath,Float64 version)
+{
    // Creating is a two phase process.
-   // Step 1 is to run the document through the Xalan XSLT engine,
+   // Step 1 is to run the document through the migration pipeline,
    // applying XSL Transforms to bring the document model up to
    // the most current version.
    // Step 2 is to run the document through the C++\Tree binding
    // to populate the object model.
-   //
-   // Most of this code is taken from the TransformToXercesDOM example
-   // from the Xalan distribution.
    std::unique_ptr<GenComp> genCompXML;
    try
    {
-      XALAN_USING_XERCES(XMLPlatformUtils)
-      XMLPlatformUtils::Initialize();
-      XalanTransformer::initialize();
+      XALAN_USING_XERCES(DOMDocument)
+      XALAN_USING_XALAN(XalanAutoPtr)
 
+      CString strError;
+      const XalanAutoPtr<DOMDocument> theDocument(MigrateDocument(_T("GenComp"),lpszFilePath,version,gs_GenCompMigration,_countof(gs_GenCompMigration),strError));
+      if ( theDocument.get() == nullptr )
       {
-      XalanTransformer  theTransformer;
-      const XalanParsedSource* theParsedSource = 0;
-
-      int theResult = theTransformer.parseSource(lpszFilePath, theParsedSource);
-
-      if (theResult != 0)
-      {
-         CString strMsg;
-         strMsg.Format(_T("Error parsing source document: %s"),theTransformer.getLastError());
-         AfxMessageBox(strMsg);
+         AfxMessageBox(strError);
+         return std::unique_ptr<GenComp>();
       }
-      else
-      {
-           assert(theParsedSource != 0);
-
-           const XalanCompiledStylesheet*  theCompiledStylesheet = 0;
-
-           const char* lpstrXSLT = nullptr;
-           DWORD size = 0;
-#pragma Reminder("UPDATE: add error handling")
-           if ( !LoadXMLResource(IDR_GENCOMP_10_TO_20_XSLT,XSLTFILE,size,lpstrXSLT) )
-           {
-           }
-           std::string strXSLT(lpstrXSLT,size);
-           std::istringstream xsltStream(strXSLT);
-
-           theResult = theTransformer.compileStylesheet(xsltStream, theCompiledStylesheet);
-           // Note: create multiple XalanTransformer objects, one for each transformation
-           // Version 1.0 -> Version 2.0
-           // Version 2.0 -> Version 2.1
-           // etc
 
-           if (theResult != 0)
-           {
-              CString strMsg;
-              strMsg.Format(_T("Error compiling stylesheet: %s"),theTransformer.getLastError());
-              AfxMessageBox(strMsg);
-           }
-           else
-           {
-                XALAN_USING_XERCES(DOMDocument)
-                XALAN_USING_XERCES(DOMImplementation)
-                XALAN_USING_XALAN(FormatterToXercesDOM)
-                XALAN_USING_XALAN(XalanAutoPtr)
-
-                // This is the document which we'll build...
-                const XalanAutoPtr<DOMDocument>     theDocument(DOMImplementation::getImplementation()->createDocument());
-                assert(theDocument.get() != nullptr);
-
-                // This is a class derived from FormatterListener, which
-                // we'll hook up to Xalan's output stage...
-                FormatterToXercesDOM    theFormatter(theDocument.get(), 0);
-
-                // Do the transformation...
-                int     theResult =
-                    theTransformer.transform(
-                        *theParsedSource,
-                        theCompiledStylesheet,
-                        theFormatter);
-                // NOTE: do the transformation for each transformer
-
-                if (theResult != 0)
-                {
-                    CString strMsg;
-                    strMsg.Format(_T("Error transforming: %s"),theTransformer.getLastError());
-                    AfxMessageBox(strMsg);
-                }
-                else
-                {
-                   // Now that theDocument has been converted to the latest format
-                   // create the C++ binding
-               #pragma Reminder("UPDATE: try to make the schema be a resource that is compiled into this dll")
-                     xml_schema::properties props;
-                     props.no_namespace_schema_location(_T("GenComp_Version_2.0.xsd"));
-                     genCompXML = GenComp_(*theDocument.get()/*lpszPathName*/,0,props);
-                }
-           }
-      }
-      }
-      XalanTransformer::terminate();
-      XMLPlatformUtils::Terminate();
+      // Now that theDocument has been converted to the latest format
+      // create the C++ binding
+      // The transforms produce documents in the current format so the migrated document isn't validated again
+      genCompXML = GenComp_(*theDocument.get(),xml_schema::flags::dont_initialize);
    }
    catch(const xml_schema::exception& /*e*/)
    {
@@ -227,6 +159,65 @@ std::unique_ptr<GenComp> CreateGenCompModel(LPCTSTR lpszFilePath,IUnitServer* pD
       return std::unique_ptr<GenComp>();
    }
 
+   return genCompXML;
+}
+
+std::unique_ptr<GenComp> CreateGenCompModel(LPCTSTR lpszFilePath,IUnitServer* pDocUnitServer)
+{
+   ATLASSERT(lpszFilePath != nullptr);
+   ATLASSERT(pDocUnitServer != nullptr);
+
+#if defined _DEBUG
+   std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::now());
+#endif
+
+   // Documents in the current format don't need to be upgraded. The version of the document
+   // is read from the root element and current documents are bound directly from the file.
+   // Only older documents go through the migration pipeline.
+   std::unique_ptr<GenComp> genCompXML;
+   Float64 version = GetDocumentVersion(lpszFilePath,"GenComp");
+   bool bCurrentFormat = IsEqual(version,GENCOMP_VERSION);
+   if ( bCurrentFormat )
+   {
+      try
+      {
+         // Current documents are validated against the schema that is compiled into this module.
+         // The grammar is parsed once and cached by the XML runtime.
+         XALAN_USING_XERCES(DOMDocument)
+         XALAN_USING_XALAN(XalanAutoPtr)
+
+         CString strError;
+         const XalanAutoPtr<DOMDocument> theDocument(CXMLRuntime::GetInstance().ParseDocument(lpszFilePath,IDR_GENCOMP_30_XSD,strError));
+         if ( theDocument.get() == nullptr )
+         {
+            AfxMessageBox(strError);
+            return std::unique_ptr<GenComp>();
+         }
+
+         genCompXML = GenComp_(*theDocument.get(),xml_schema::flags::dont_initialize);
+      }
+      catch(...)
+      {
+#pragma Reminder("UPDATE: provide better error handling")
+         AfxMessageBox(_T("An error occured while loading the file"));
+         genCompXML.reset();
+      }
+   }
+   else
+   {
+      genCompXML = UpgradeGenCompModel(lpszFilePath,version);
+   }
+
+   if ( genCompXML.get() == nullptr )
+   {
+      return std::unique_ptr<GenComp>();
+   }
+
+#if defined _DEBUG
+   Float64 loadTime = std::chrono::duration<Float64,std::milli>(std::chrono::steady_clock::now() - startTime).count();
+   WATCH(lpszFilePath << _T(" loaded in ") << loadTime << (bCurrentFormat ? _T(" ms (current format)") : _T(" ms (upgraded)")));
+#endif
+
    if ( !ConvertToBaseUnits(genCompXML.get(),pDocUnitServer) )
    {
       // something went wrong in the unit conversion
@@ -23,7 +23,7 @@
 #pragma once
 
 #include <BEToolboxXML.h>
-#include <GenComp_Version_2.0.hxx>
+#include <GenComp_Version_3.0.hxx>
 #include <WBFLUnitServer.h>
 
 // Creates a GenComp data model. If lpszFileName is nullptr, a default
@@ -23,6 +23,8 @@
 #include "stdafx.h"
 #include "Helpers.h"
 
+#include <fstream>
+
 #ifdef _DEBUG
 #define new DEBUG_NEW
 #undef THIS_FILE
@@ -40,4 +42,208 @@ BOOL LoadXMLResource(int name,int type,DWORD& size,const char*& data)
    size = ::SizeofResource(handle,rc);
    data = static_cast<const char*>(::LockResource(rcData));
    return TRUE;
-}
\ No newline at end of file
+}
+
+// Result of scanning the prolog and root element start tag of an XML document
+enum ScanResult { scanComplete, scanNeedMore, scanError };
+
+// Scans the document held in strBuffer for the start tag of the root element. The XML declaration, processing
+// instructions, comments, and document type declaration before the root element are skipped.
+static ScanResult ScanRootElement(const std::string& strBuffer,std::string& strRootElement,Float64& version)
+{
+   const std::string::size_type npos = std::string::npos;
+   const std::string::size_type length = strBuffer.size();
+
+   auto isSpace = [](char c) {return c == ' ' || c == '\t' || c == '\r' || c == '\n';};
+
+   std::string::size_type pos = 0;
+   if ( 3 <= length && strBuffer.compare(0,3,"\xEF\xBB\xBF") == 0 )
+   {
+      pos = 3; // skip the UTF-8 byte order mark
+   }
+
+   while ( true )
+   {
+      while ( pos < length && isSpace(strBuffer[pos]) )
+      {
+         pos++;
+      }
+
+      if ( length < pos + 2 )
+      {
+         return scanNeedMore;
+      }
+
+      if ( strBuffer[pos] != '<' )
+      {
+         return scanError;
+      }
+
+      std::string::size_type end;
+      if ( strBuffer[pos+1] == '?' )
+      {
+         // XML declaration or processing instruction
+         end = strBuffer.find("?>",pos);
+         if ( end == npos )
+         {
+            return scanNeedMore;
+         }
+         pos = end + 2;
+      }
+      else if ( strBuffer[pos+1] == '!' )
+      {
+         if ( length < pos + 4 )
+         {
+            return scanNeedMore;
+         }
+
+         if ( strBuffer.compare(pos,4,"<!--") == 0 )
+         {
+            end = strBuffer.find("-->",pos+4);
+            if ( end == npos )
+            {
+               return scanNeedMore;
+            }
+            pos = end + 3;
+         }
+         else
+         {
+            // document type declaration, which may have an internal subset
+            end = strBuffer.find_first_of("[>",pos);
+            if ( end != npos && strBuffer[end] == '[' )
+            {
+               end = strBuffer.find("]",end);
+               end = (end == npos ? npos : strBuffer.find(">",end));
+            }
+
+            if ( end == npos )
+            {
+               return scanNeedMore;
+            }
+            pos = end + 1;
+         }
+      }
+      else
+      {
+         break; // this is the root element
+      }
+   }
+
+   // read the name of the root element
+   std::string::size_type start = ++pos;
+   while ( pos < length && !isSpace(strBuffer[pos]) && strBuffer[pos] != '>' && strBuffer[pos] != '/' )
+   {
+      pos++;
+   }
+
+   if ( pos == length )
+   {
+      return scanNeedMore;
+   }
+
+   strRootElement = strBuffer.substr(start,pos-start);
+   version = 0;
+
+   // read the attributes until the end of the start tag
+   while ( true )
+   {
+      while ( pos < length && isSpace(strBuffer[pos]) )
+      {
+         pos++;
+      }
+
+      if ( pos == length )
+      {
+         return scanNeedMore;
+      }
+
+      if ( strBuffer[pos] == '>' || strBuffer[pos] == '/' )
+      {
+         return scanComplete;
+      }
+
+      std::string::size_type equals = strBuffer.find('=',pos);
+      if ( equals == npos )
+      {
+         return scanNeedMore;
+      }
+
+      std::string::size_type nameEnd = equals;
+      while ( pos < nameEnd && isSpace(strBuffer[nameEnd-1]) )
+      {
+         nameEnd--;
+      }
+      std::string strName(strBuffer.substr(pos,nameEnd-pos));
+
+      pos = equals + 1;
+      while ( pos < length && isSpace(strBuffer[pos]) )
+      {
+         pos++;
+      }
+
+      if ( pos == length )
+      {
+         return scanNeedMore;
+      }
+
+      char quote = strBuffer[pos];
+      if ( quote != '\"' && quote != '\'' )
+      {
+         return scanError;
+      }
+
+      std::string::size_type end = strBuffer.find(quote,pos+1);
+      if ( end == npos )
+      {
+         return scanNeedMore;
+      }
+
+      if ( strName == "version" )
+      {
+         version = atof(strBuffer.substr(pos+1,end-pos-1).c_str());
+      }
+
+      pos = end + 1;
+   }
+}
+
+BOOL ReadRootElementVersion(LPCTSTR lpszFilePath,std::string& strRootElement,Float64& version)
+{
+   // The file is read in small blocks until the start tag of the root element has been read
+   // so the cost doesn't depend on the size of the document. Documents with a long prolog
+   // are not probed.
+   const std::streamsize blockSize = 512;
+   const std::string::size_type maxPrologSize = 64*1024;
+
+   std::ifstream file(lpszFilePath,std::ios::in | std::ios::binary);
+   if ( !file )
+   {
+      return FALSE;
+   }
+
+   std::string strBuffer;
+   char block[blockSize];
+   while ( strBuffer.size() < maxPrologSize )
+   {
+      file.read(block,blockSize);
+      std::streamsize nRead = file.gcount();
+      if ( nRead == 0 )
+      {
+         return FALSE;
+      }
+
+      strBuffer.append(block,(std::string::size_type)nRead);
+
+      ScanResult result = ScanRootElement(strBuffer,strRootElement,version);
+      if ( result == scanComplete )
+      {
+         return TRUE;
+      }
+      else if ( result == scanError )
+      {
+         return FALSE;
+      }
+   }
+
+   return FALSE;
+}
@@ -22,4 +22,9 @@
 
 #pragma once
 
-BOOL LoadXMLResource(int name,int type,DWORD& size,const char*& data);
\ No newline at end of file
+BOOL LoadXMLResource(int name,int type,DWORD& size,const char*& data);
+
+// Reads the name and version attribute of the root element of an XML document without parsing
+// the rest of the document. version is 0 if the root element does not have a version attribute.
+// Returns FALSE if the start tag of the root element could not be read.
+BOOL ReadRootElementVersion(LPCTSTR lpszFilePath,std::string& strRootElement,Float64& version);
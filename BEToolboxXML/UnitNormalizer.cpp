@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#include "stdafx.h"
+#include "UnitNormalizer.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+const std::_tstring CUnitNormalizer::m_strConsistentUnit;
+
+CUnitNormalizer::CUnitNormalizer(IUnitServer* pDocUnitServer)
+{
+   m_DocUnitServer = pDocUnitServer;
+}
+
+BOOL CUnitNormalizer::Init(OpenBridgeML::Units::UnitsDeclarationType* pUnitsDeclaration)
+{
+   m_Factors.clear();
+
+   m_XMLDocUnitServer.Release();
+   HRESULT hr = m_XMLDocUnitServer.CoCreateInstance(CLSID_UnitServer);
+   ATLASSERT(SUCCEEDED(hr));
+   if ( FAILED(hr) )
+   {
+      return FALSE;
+   }
+
+   if ( pUnitsDeclaration != nullptr )
+   {
+      if ( !InitializeWBFLUnitServer(pUnitsDeclaration,m_XMLDocUnitServer) )
+      {
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+}
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <WBFLUnitServer.h>
+#include <WBFLUnitServer\OpenBridgeML.h>
+
+#include <map>
+#include <typeindex>
+
+// Converts the values in a BEToolbox XML document to the base units of the application.
+//
+// A value is in the unit of measure given by its unit attribute, or in the consistent units declared
+// by the document if it doesn't have a unit attribute. The conversion factor for each type of value and unit of
+// measure is computed with the WBFL unit servers the first time it is needed. After that, a value is converted
+// with a multiplication rather than a call through the unit servers. Only units that are proportional to the base
+// units (length, force, etc) can be converted this way. Temperatures can't.
+class CUnitNormalizer
+{
+public:
+   CUnitNormalizer(IUnitServer* pDocUnitServer);
+
+   // Initializes the conversion for the units declared by a document. pUnitsDeclaration is nullptr if the
+   // document doesn't have a units declaration. Returns FALSE if the units declaration is not valid.
+   BOOL Init(OpenBridgeML::Units::UnitsDeclarationType* pUnitsDeclaration);
+
+   // Converts a value to the base units of the application
+   template <class T>
+   void Convert(T& value)
+   {
+      const std::_tstring& strUnit(value.unit().present() ? std::_tstring(value.unit().get()) : m_strConsistentUnit);
+      FACTORKEY key(std::type_index(typeid(T)),strUnit);
+      auto found = m_Factors.find(key);
+      if ( found == m_Factors.end() )
+      {
+         found = m_Factors.insert(std::make_pair(key,ComputeFactor(value))).first;
+      }
+
+      const UNITFACTOR& factor(found->second);
+
+#if defined _DEBUG
+      // the factor table must give the same value as the unit servers
+      T check(value);
+      ConvertBetweenBaseUnits(check,m_XMLDocUnitServer,m_DocUnitServer);
+#endif
+
+      static_cast<Float64&>(value) *= factor.Factor;
+      if ( factor.bHasUnit )
+      {
+         value.unit().set(factor.strUnit);
+      }
+      else
+      {
+         value.unit().reset();
+      }
+
+#if defined _DEBUG
+      ATLASSERT(IsEqual((Float64)value,(Float64)check));
+      ATLASSERT(value.unit() == check.unit());
+#endif
+   }
+
+private:
+   struct UNITFACTOR
+   {
+      Float64 Factor;
+      bool bHasUnit; // unit attribute of a converted value
+      std::_tstring strUnit;
+   };
+
+   // key is the type of value and its unit of measure
+   typedef std::pair<std::type_index,std::_tstring> FACTORKEY;
+   std::map<FACTORKEY,UNITFACTOR> m_Factors;
+
+   static const std::_tstring m_strConsistentUnit; // key for values in the consistent units of the document
+
+   CComPtr<IUnitServer> m_XMLDocUnitServer;
+   CComPtr<IUnitServer> m_DocUnitServer;
+
+   // Computes the conversion factor by converting a unit value with the unit servers
+   template <class T>
+   UNITFACTOR ComputeFactor(const T& value)
+   {
+      T unitValue(value);
+      static_cast<Float64&>(unitValue) = 1.0;
+      ConvertBetweenBaseUnits(unitValue,m_XMLDocUnitServer,m_DocUnitServer);
+
+      UNITFACTOR factor;
+      factor.Factor = unitValue;
+      factor.bHasUnit = unitValue.unit().present();
+      if ( factor.bHasUnit )
+      {
+         factor.strUnit = unitValue.unit().get();
+      }
+      return factor;
+   }
+};
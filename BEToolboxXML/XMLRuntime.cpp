@@ -0,0 +1,361 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "resource.h"
+#include "XMLRuntime.h"
+#include "Helpers.h"
+
+#include <sstream>
+
+#include <xercesc/util/PlatformUtils.hpp>
+#include <xercesc/util/XMLString.hpp>
+#include <xercesc/framework/MemBufInputSource.hpp>
+#include <xercesc/framework/XMLGrammarPoolImpl.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/util/XMLEntityResolver.hpp>
+#include <xercesc/util/XMLResourceIdentifier.hpp>
+#include <xercesc/util/XMLUni.hpp>
+#include <xercesc/dom/DOMConfiguration.hpp>
+#include <xercesc/dom/DOMError.hpp>
+#include <xercesc/dom/DOMErrorHandler.hpp>
+#include <xercesc/dom/DOMImplementationLS.hpp>
+#include <xercesc/dom/DOMImplementationRegistry.hpp>
+#include <xercesc/dom/DOMLocator.hpp>
+#include <xercesc/dom/DOMLSParser.hpp>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+XALAN_USING_XALAN(XalanCompiledStylesheet)
+XALAN_USING_XALAN(XalanTransformer)
+
+XALAN_USING_XERCES(XMLPlatformUtils)
+XALAN_USING_XERCES(XMLGrammarPool)
+XALAN_USING_XERCES(XMLUni)
+XALAN_USING_XERCES(DOMDocument)
+
+namespace
+{
+   // Schemas compiled into this module. The units schema is imported by the other schemas
+   // so it is loaded into every grammar pool, ahead of the schema for the pool.
+   struct SCHEMARESOURCE
+   {
+      int ID;
+      const char* lpszFileName;
+   };
+
+   const SCHEMARESOURCE gs_Schemas[] =
+   {
+      { IDR_WBFLUNITSERVER_XSD, "WBFLUnitServer.xsd" },
+      { IDR_CURVEL_20_XSD,      "Curvel_Version_2.0.xsd" },
+      { IDR_CURVEL_30_XSD,      "Curvel_Version_3.0.xsd" },
+      { IDR_GENCOMP_30_XSD,     "GenComp_Version_3.0.xsd" },
+   };
+
+   // Resolves schema imports to the schemas compiled into this module so
+   // loading the grammars never looks for a schema on disk
+   class CSchemaResolver : public XERCES_CPP_NAMESPACE::XMLEntityResolver
+   {
+   public:
+      virtual XERCES_CPP_NAMESPACE::InputSource* resolveEntity(XERCES_CPP_NAMESPACE::XMLResourceIdentifier* resourceIdentifier) override
+      {
+         XALAN_USING_XERCES(XMLString)
+         XALAN_USING_XERCES(MemBufInputSource)
+
+         const XMLCh* systemID = resourceIdentifier->getSystemId();
+         if ( systemID == nullptr )
+         {
+            return nullptr;
+         }
+
+         char* lpszSystemID = XMLString::transcode(systemID);
+         std::string strSystemID(lpszSystemID);
+         XMLString::release(&lpszSystemID);
+
+         for ( const auto& schema : gs_Schemas )
+         {
+            std::string strFileName(schema.lpszFileName);
+            if ( strFileName.size() <= strSystemID.size() && strSystemID.compare(strSystemID.size() - strFileName.size(),strFileName.size(),strFileName) == 0 )
+            {
+               const char* lpstrXSD = nullptr;
+               DWORD size = 0;
+               if ( LoadXMLResource(schema.ID,XSDFILE,size,lpstrXSD) )
+               {
+                  // Xerces objects have their own operator new so DEBUG_NEW can't be used here
+#pragma push_macro("new")
+#undef new
+                  return new MemBufInputSource((const XMLByte*)lpstrXSD,size,schema.lpszFileName);
+#pragma pop_macro("new")
+               }
+            }
+         }
+
+         return nullptr;
+      }
+   };
+
+   // Records the first error reported while a document is parsed and stops the parse
+   class CParseErrorHandler : public XERCES_CPP_NAMESPACE::DOMErrorHandler
+   {
+   public:
+      virtual bool handleError(const XERCES_CPP_NAMESPACE::DOMError& domError) override
+      {
+         XALAN_USING_XERCES(DOMError)
+         XALAN_USING_XERCES(DOMLocator)
+
+         if ( domError.getSeverity() == DOMError::DOM_SEVERITY_WARNING )
+         {
+            return true;
+         }
+
+         if ( m_strError.IsEmpty() )
+         {
+            CString strMessage(domError.getMessage());
+            const DOMLocator* pLocation = domError.getLocation();
+            m_strError.Format(_T("%s (line %d, column %d)"),strMessage,(int)pLocation->getLineNumber(),(int)pLocation->getColumnNumber());
+         }
+
+         return false;
+      }
+
+      CString m_strError;
+   };
+}
+
+std::mutex CXMLRuntime::ms_InstanceMutex;
+CXMLRuntime* CXMLRuntime::ms_pInstance = nullptr;
+
+CXMLRuntime& CXMLRuntime::GetInstance()
+{
+   // the runtime is created the first time it is needed
+   std::lock_guard<std::mutex> lock(ms_InstanceMutex);
+   if ( ms_pInstance == nullptr )
+   {
+      ms_pInstance = new CXMLRuntime;
+   }
+   return *ms_pInstance;
+}
+
+void CXMLRuntime::Terminate()
+{
+   std::lock_guard<std::mutex> lock(ms_InstanceMutex);
+   delete ms_pInstance;
+   ms_pInstance = nullptr;
+}
+
+CXMLRuntime::CXMLRuntime()
+{
+   XMLPlatformUtils::Initialize();
+   XalanTransformer::initialize();
+
+   m_pTransformer = std::make_unique<XalanTransformer>();
+}
+
+CXMLRuntime::~CXMLRuntime()
+{
+   // the transformer destroys the compiled stylesheets
+   m_Stylesheets.clear();
+   m_pTransformer.reset();
+   m_GrammarPools.clear();
+
+   XalanTransformer::terminate();
+   XMLPlatformUtils::Terminate();
+}
+
+const XalanCompiledStylesheet* CXMLRuntime::GetStylesheet(int xsltID)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   auto found = m_Stylesheets.find(xsltID);
+   if ( found != m_Stylesheets.end() )
+   {
+      return found->second;
+   }
+
+   const char* lpstrXSLT = nullptr;
+   DWORD size = 0;
+   if ( !LoadXMLResource(xsltID,XSLTFILE,size,lpstrXSLT) )
+   {
+      return nullptr;
+   }
+
+   std::string strXSLT(lpstrXSLT,size);
+   std::istringstream xsltStream(strXSLT);
+
+   const XalanCompiledStylesheet* theCompiledStylesheet = 0;
+   if ( m_pTransformer->compileStylesheet(xsltStream,theCompiledStylesheet) != 0 )
+   {
+      return nullptr;
+   }
+
+   m_Stylesheets.insert(std::make_pair(xsltID,theCompiledStylesheet));
+   return theCompiledStylesheet;
+}
+
+XMLGrammarPool* CXMLRuntime::GetGrammarPool(int xsdID)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   auto found = m_GrammarPools.find(xsdID);
+   if ( found != m_GrammarPools.end() )
+   {
+      return found->second.get();
+   }
+
+   // a pool that failed to load isn't cached so the next request tries again
+   std::unique_ptr<XMLGrammarPool> pGrammarPool(LoadGrammars(xsdID));
+   if ( pGrammarPool == nullptr )
+   {
+      return nullptr;
+   }
+
+   XMLGrammarPool* pPool = pGrammarPool.get();
+   m_GrammarPools.insert(std::make_pair(xsdID,std::move(pGrammarPool)));
+   return pPool;
+}
+
+DOMDocument* CXMLRuntime::ParseDocument(LPCTSTR lpszFilePath,int xsdID,CString& strError)
+{
+   XALAN_USING_XERCES(DOMImplementationRegistry)
+   XALAN_USING_XERCES(DOMImplementationLS)
+   XALAN_USING_XERCES(DOMLSParser)
+   XALAN_USING_XERCES(DOMConfiguration)
+
+   strError.Empty();
+
+   XMLGrammarPool* pGrammarPool = GetGrammarPool(xsdID);
+   if ( pGrammarPool == nullptr )
+   {
+      strError = _T("Error loading XML Schema resource");
+      return nullptr;
+   }
+
+   static const XMLCh ls[] = { XERCES_CPP_NAMESPACE::chLatin_L, XERCES_CPP_NAMESPACE::chLatin_S, XERCES_CPP_NAMESPACE::chNull };
+   DOMImplementationLS* pImpl = static_cast<DOMImplementationLS*>(DOMImplementationRegistry::getDOMImplementation(ls));
+
+   // The parser is cheap to create. The expensive part, parsing the schema, was done once when the grammar pool was loaded.
+   CParseErrorHandler errorHandler;
+   DOMLSParser* pParser = pImpl->createLSParser(DOMImplementationLS::MODE_SYNCHRONOUS,0,XMLPlatformUtils::fgMemoryManager,pGrammarPool);
+
+   DOMConfiguration* pConfig = pParser->getDomConfig();
+   pConfig->setParameter(XMLUni::fgDOMComments,false);
+   pConfig->setParameter(XMLUni::fgDOMDatatypeNormalization,true);
+   pConfig->setParameter(XMLUni::fgDOMEntities,false);
+   pConfig->setParameter(XMLUni::fgDOMNamespaces,true);
+   pConfig->setParameter(XMLUni::fgDOMElementContentWhitespace,false);
+   pConfig->setParameter(XMLUni::fgDOMValidate,true);
+   pConfig->setParameter(XMLUni::fgXercesSchema,true);
+   pConfig->setParameter(XMLUni::fgXercesSchemaFullChecking,false);
+   pConfig->setParameter(XMLUni::fgXercesUseCachedGrammarInParse,true);
+   pConfig->setParameter(XMLUni::fgXercesLoadSchema,false); // only the cached grammar is used, schema locations in the document are ignored
+   pConfig->setParameter(XMLUni::fgXercesUserAdoptsDOMDocument,true);
+   pConfig->setParameter(XMLUni::fgDOMErrorHandler,&errorHandler);
+
+   DOMDocument* pDocument = nullptr;
+   try
+   {
+      pDocument = pParser->parseURI(lpszFilePath);
+   }
+   catch(...)
+   {
+      pDocument = nullptr;
+   }
+
+   pParser->release();
+
+   if ( pDocument == nullptr || !errorHandler.m_strError.IsEmpty() )
+   {
+      strError = errorHandler.m_strError;
+      if ( strError.IsEmpty() )
+      {
+         strError = _T("Error parsing source document");
+      }
+
+      if ( pDocument != nullptr )
+      {
+         pDocument->release();
+      }
+      return nullptr;
+   }
+
+   return pDocument;
+}
+
+std::unique_ptr<XMLGrammarPool> CXMLRuntime::LoadGrammars(int xsdID)
+{
+   XALAN_USING_XERCES(XMLGrammarPoolImpl)
+   XALAN_USING_XERCES(SAX2XMLReader)
+   XALAN_USING_XERCES(XMLReaderFactory)
+   XALAN_USING_XERCES(MemBufInputSource)
+   XALAN_USING_XERCES(Grammar)
+
+   std::unique_ptr<XMLGrammarPool> pGrammarPool(std::make_unique<XMLGrammarPoolImpl>(XMLPlatformUtils::fgMemoryManager));
+
+   try
+   {
+      CSchemaResolver resolver;
+      std::unique_ptr<SAX2XMLReader> parser(XMLReaderFactory::createXMLReader(XMLPlatformUtils::fgMemoryManager,pGrammarPool.get()));
+      parser->setFeature(XMLUni::fgSAX2CoreNameSpaces,true);
+      parser->setFeature(XMLUni::fgXercesSchema,true);
+      parser->setFeature(XMLUni::fgXercesSchemaFullChecking,true);
+      parser->setXMLEntityResolver(&resolver);
+
+      for ( const auto& schema : gs_Schemas )
+      {
+         if ( schema.ID != IDR_WBFLUNITSERVER_XSD && schema.ID != xsdID )
+         {
+            // the pool only has the units schema and the requested schema
+            continue;
+         }
+
+         const char* lpstrXSD = nullptr;
+         DWORD size = 0;
+         if ( !LoadXMLResource(schema.ID,XSDFILE,size,lpstrXSD) )
+         {
+            ATLASSERT(false); // schema resource is missing
+            return nullptr;
+         }
+
+         MemBufInputSource source((const XMLByte*)lpstrXSD,size,schema.lpszFileName);
+         Grammar* pGrammar = parser->loadGrammar(source,Grammar::SchemaGrammarType,true);
+         if ( pGrammar == nullptr )
+         {
+            ATLASSERT(false); // schema could not be parsed
+            return nullptr;
+         }
+      }
+   }
+   catch(...)
+   {
+      ATLASSERT(false);
+      return nullptr;
+   }
+
+   // the pool can't be modified after it is locked so it is safe to share between threads
+   pGrammarPool->lockPool();
+   return pGrammarPool;
+}
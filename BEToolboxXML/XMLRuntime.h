@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <xalanc/Include/PlatformDefinitions.hpp>
+#include <xalanc/XalanTransformer/XalanTransformer.hpp>
+#include <xercesc/framework/XMLGrammarPool.hpp>
+#include <xercesc/dom/DOMDocument.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+// Process wide XML runtime for BEToolboxXML.
+//
+// Xerces and Xalan are initialized when the runtime is first used and terminated by Terminate, rather than
+// for every document that is loaded. Terminate must be called during application shutdown. It can't be left to the
+// static destructors because Xerces and Xalan must not be terminated while the module is being unloaded. The runtime keeps the compiled XSL Transforms and grammar pools
+// with the BEToolbox schemas so they are loaded and compiled once. The runtime may be used from any thread. A compiled
+// stylesheet is read-only so it can be used by several XalanTransformer objects, on different threads, at the same time.
+class CXMLRuntime
+{
+public:
+   static CXMLRuntime& GetInstance();
+
+   // Destroys the runtime and terminates Xerces and Xalan. Does nothing if the runtime was never used.
+   // The runtime must not be in use on another thread.
+   static void Terminate();
+
+   // Returns the compiled XSL Transform for a resource. The transform is compiled the first time
+   // it is requested. Returns nullptr if the transform could not be loaded or compiled.
+   const XALAN_CPP_NAMESPACE::XalanCompiledStylesheet* GetStylesheet(int xsltID);
+
+   // Returns the grammar pool for a schema resource. The pool has the grammar for the schema and the
+   // schemas it imports. The schemas are parsed from the resources compiled into this module the first time
+   // the pool is requested. The BEToolbox schemas don't have a target namespace so each one has its own pool.
+   // The pool is locked so it can be shared by parsers on any thread. Returns nullptr if the schema could not be loaded.
+   XERCES_CPP_NAMESPACE::XMLGrammarPool* GetGrammarPool(int xsdID);
+
+   // Parses a document and validates it against the cached grammar for a schema resource. Schemas are never read
+   // from disk. Returns the document, which is owned by the caller, or nullptr, and a description of the
+   // error in strError, if the document could not be parsed or is not valid.
+   XERCES_CPP_NAMESPACE::DOMDocument* ParseDocument(LPCTSTR lpszFilePath,int xsdID,CString& strError);
+
+private:
+   CXMLRuntime();
+   ~CXMLRuntime();
+   CXMLRuntime(const CXMLRuntime&) = delete;
+   CXMLRuntime& operator=(const CXMLRuntime&) = delete;
+
+   std::unique_ptr<XERCES_CPP_NAMESPACE::XMLGrammarPool> LoadGrammars(int xsdID);
+
+   static std::mutex ms_InstanceMutex; // protects ms_pInstance
+   static CXMLRuntime* ms_pInstance;
+
+   std::mutex m_Mutex; // protects m_Stylesheets and m_GrammarPools
+   std::unique_ptr<XALAN_CPP_NAMESPACE::XalanTransformer> m_pTransformer; // compiles, and owns, the stylesheets
+   std::map<int,const XALAN_CPP_NAMESPACE::XalanCompiledStylesheet*> m_Stylesheets; // key is the resource ID
+   std::map<int,std::unique_ptr<XERCES_CPP_NAMESPACE::XMLGrammarPool>> m_GrammarPools; // key is the resource ID of the schema
+};
@@ -6,12 +6,18 @@
 
 #define IDR_CURVEL_10_TO_20_XSLT  101
 #define IDR_GENCOMP_10_TO_20_XSLT 102
+#define IDR_GENCOMP_20_TO_30_XSLT 103
+#define IDR_CURVEL_30_XSD         104
+#define IDR_GENCOMP_30_XSD        105
+#define IDR_WBFLUNITSERVER_XSD    106
+#define IDR_CURVEL_20_TO_30_XSLT  107
+#define IDR_CURVEL_20_XSD         108
 
 // Next default values for new objects
 // 
 #ifdef APSTUDIO_INVOKED
 #ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NEXT_RESOURCE_VALUE        103
+#define _APS_NEXT_RESOURCE_VALUE        109
 #define _APS_NEXT_COMMAND_VALUE         40001
 #define _APS_NEXT_CONTROL_VALUE         1001
 #define _APS_NEXT_SYMED_VALUE           101
@@ -180,8 +180,19 @@ rptChapter* CBoxGdrChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
       St = IsZero(Yt) ? 0 : Ix/Yt;
       Sb = IsZero(Yb) ? 0 : Ix/Yb;
 
+#if defined _DEBUG
+      // the native section model used for the design space sweep must match the WBFL shapes
+      BOXGDRPROPERTIES props;
+      if ( CBoxGdrSweep::ComputeSectionProperties(problem,&props) )
+      {
+         ATLASSERT(IsEqual(props.Area,Area));
+         ATLASSERT(IsEqual(props.Ix,Ix));
+         ATLASSERT(IsEqual(props.Yt,Yt));
+      }
+#endif
+
       Float64 Weight;
-      Weight = Area*::ConvertToSysUnits(160.0,unitMeasure::PCF);
+      Weight = Area*CBoxGdrDoc::GetUnitWeight();
 
       (*pTable)(row,col++) << momentOfInertia.SetValue(Ix);
       (*pTable)(row,col++) << longLength.SetValue(Yt);
@@ -192,9 +203,110 @@ rptChapter* CBoxGdrChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
       (*pTable)(row,col++) << sectionModulus.SetValue(Sb);
    }
 
+   if ( m_pDoc->IsSweepEnabled() )
+   {
+      BuildSweep(pChapter);
+   }
+
    return pChapter;
 }
 
+void CBoxGdrChapterBuilder::BuildSweep(rptChapter* pChapter) const
+{
+   const BOXGDRSWEEPRESULTS& results = m_pDoc->GetSweepResults();
+
+   rptParagraph* pPara = new rptParagraph(rptStyleManager::GetHeadingStyle());
+   (*pChapter) << pPara;
+   *pPara << _T("Design Space Sweep") << rptNewLine;
+
+   pPara = new rptParagraph;
+   (*pChapter) << pPara;
+   if ( !results.bCompleted )
+   {
+      if ( CBoxGdrSweep::MaxCombinations < results.nCombinations )
+      {
+         *pPara << _T("The design space has more than ") << CBoxGdrSweep::MaxCombinations << _T(" combinations of dimensions and was not evaluated. Reduce the number of values in the sweep.") << rptNewLine;
+      }
+      else
+      {
+         *pPara << _T("The design space sweep was cancelled. Press [Sweep...] and then [OK] to evaluate it again.") << rptNewLine;
+      }
+      return;
+   }
+
+   *pPara << results.nCombinations << _T(" combinations of dimensions were evaluated. ");
+   *pPara << results.nRejected << _T(" combinations were rejected because they do not define a valid section.") << rptNewLine;
+   *pPara << _T("The efficient frontier consists of the sections for which there is no lighter section with a greater or equal section property.") << rptNewLine;
+
+   *pPara << rptNewLine << CreateSweepTable(_T("Efficient Frontier - Weight vs. I"),results.IxFrontier) << rptNewLine;
+   *pPara << rptNewLine << CreateSweepTable(_T("Efficient Frontier - Weight vs. ZB"),results.SbFrontier) << rptNewLine;
+}
+
+rptRcTable* CBoxGdrChapterBuilder::CreateSweepTable(LPCTSTR lpszTitle,const std::vector<BOXGDRSWEEPPOINT>& frontier) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   INIT_UV_PROTOTYPE( rptLengthUnitValue,  longLength,  pDispUnits->SpanLength, false);
+   INIT_UV_PROTOTYPE( rptLengthUnitValue,  shortLength, pDispUnits->ComponentDim, false);
+   INIT_UV_PROTOTYPE( rptLength2UnitValue,  area, m_Area, false);
+   INIT_UV_PROTOTYPE( rptLength4UnitValue,  momentOfInertia, m_MomentOfInertia, false);
+   INIT_UV_PROTOTYPE( rptLength3UnitValue,  sectionModulus, m_SectionModulus, false);
+   INIT_UV_PROTOTYPE( rptForcePerLengthUnitValue, weight, pDispUnits->ForcePerLength, false );
+
+   rptRcTable* pTable = rptStyleManager::CreateDefaultTable(19,lpszTitle);
+
+   ColumnIndexType col = 0;
+   (*pTable)(0,col++) << COLHDR(_T("WEIGHT"), rptForcePerLengthUnitTag, pDispUnits->ForcePerLength);
+   (*pTable)(0,col++) << COLHDR(_T("I"), rptLength4UnitTag, m_MomentOfInertia);
+   (*pTable)(0,col++) << COLHDR(_T("ZB"), rptLength3UnitTag, m_SectionModulus);
+   (*pTable)(0,col++) << COLHDR(_T("AREA"), rptLength2UnitTag, m_Area);
+   (*pTable)(0,col++) << COLHDR(_T("D"), rptLengthUnitTag, pDispUnits->SpanLength);
+   (*pTable)(0,col++) << COLHDR(_T("T"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << _T("No.");
+   (*pTable)(0,col++) << COLHDR(_T("W"),  rptLengthUnitTag, pDispUnits->SpanLength);
+   (*pTable)(0,col++) << COLHDR(_T("ST"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << COLHDR(_T("SB"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << COLHDR(_T("FT"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << COLHDR(_T("FB"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << COLHDR(_T("EL"), rptLengthUnitTag, pDispUnits->SpanLength);
+   (*pTable)(0,col++) << COLHDR(_T("CL"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << COLHDR(_T("BL"), rptLengthUnitTag, pDispUnits->SpanLength);
+   (*pTable)(0,col++) << COLHDR(_T("ER"), rptLengthUnitTag, pDispUnits->SpanLength);
+   (*pTable)(0,col++) << COLHDR(_T("CR"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << COLHDR(_T("BR"), rptLengthUnitTag, pDispUnits->SpanLength);
+   (*pTable)(0,col++) << COLHDR(_T("ZT"), rptLength3UnitTag, m_SectionModulus);
+
+   RowIndexType row = pTable->GetNumberOfHeaderRows();
+   for ( const auto& point : frontier )
+   {
+      col = 0;
+      const BOXGDRDIMENSIONS& dimensions = point.Dimensions;
+      (*pTable)(row,col++) << weight.SetValue(point.Weight);
+      (*pTable)(row,col++) << momentOfInertia.SetValue(point.Properties.Ix);
+      (*pTable)(row,col++) << sectionModulus.SetValue(point.Properties.Sb);
+      (*pTable)(row,col++) << area.SetValue(point.Properties.Area);
+      (*pTable)(row,col++) << longLength.SetValue(dimensions.D);
+      (*pTable)(row,col++) << shortLength.SetValue(dimensions.T);
+      (*pTable)(row,col++) << dimensions.N;
+      (*pTable)(row,col++) << longLength.SetValue(dimensions.W);
+      (*pTable)(row,col++) << shortLength.SetValue(dimensions.ST);
+      (*pTable)(row,col++) << shortLength.SetValue(dimensions.SB);
+      (*pTable)(row,col++) << shortLength.SetValue(dimensions.FT);
+      (*pTable)(row,col++) << shortLength.SetValue(dimensions.FB);
+      (*pTable)(row,col++) << longLength.SetValue(dimensions.EL);
+      (*pTable)(row,col++) << shortLength.SetValue(dimensions.CL);
+      (*pTable)(row,col++) << longLength.SetValue(dimensions.BL);
+      (*pTable)(row,col++) << longLength.SetValue(dimensions.ER);
+      (*pTable)(row,col++) << shortLength.SetValue(dimensions.CR);
+      (*pTable)(row,col++) << longLength.SetValue(dimensions.BR);
+      (*pTable)(row,col++) << sectionModulus.SetValue(point.Properties.St);
+      row++;
+   }
+
+   return pTable;
+}
+
 CChapterBuilder* CBoxGdrChapterBuilder::Clone() const
 {
    return new CBoxGdrChapterBuilder(m_pDoc);
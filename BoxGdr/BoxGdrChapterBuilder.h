@@ -40,6 +40,9 @@ public:
 private:
    CBoxGdrDoc* m_pDoc;
 
+   void BuildSweep(rptChapter* pChapter) const;
+   rptRcTable* CreateSweepTable(LPCTSTR lpszTitle,const std::vector<BOXGDRSWEEPPOINT>& frontier) const;
+
    mutable unitmgtIndirectMeasureDataT<unitLength2> m_Area;
    mutable unitmgtIndirectMeasureDataT<unitLength3> m_SectionModulus;
    mutable unitmgtIndirectMeasureDataT<unitLength4> m_MomentOfInertia;
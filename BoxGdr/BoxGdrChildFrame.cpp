@@ -24,6 +24,7 @@
 #include "..\resource.h"
 #include "BoxGdrChildFrame.h"
 #include "BoxGdrDoc.h"
+#include "BoxGdrSweepDlg.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -50,6 +51,7 @@ BEGIN_MESSAGE_MAP(CBoxGdrChildFrame, CEAFChildFrame)
    ON_BN_CLICKED(IDC_ADD,OnAdd)
    ON_BN_CLICKED(IDC_REMOVE,OnRemove)
    ON_UPDATE_COMMAND_UI(IDC_REMOVE,OnUpdateRemove)
+   ON_BN_CLICKED(IDC_SWEEP,OnSweep)
 	ON_MESSAGE(WM_HELP, OnCommandHelp)
 END_MESSAGE_MAP()
 
@@ -134,6 +136,25 @@ void CBoxGdrChildFrame::OnUpdateRemove(CCmdUI* pCmdUI)
    pCmdUI->Enable(m_DlgBar.AreProblemsSelected() ? TRUE : FALSE);
 }
 
+void CBoxGdrChildFrame::OnSweep()
+{
+   CBoxGdrDoc* pDoc = (CBoxGdrDoc*)GetActiveDocument();
+   if ( pDoc == nullptr )
+      return;
+
+   AFX_MANAGE_STATE(AfxGetStaticModuleState());
+   CBoxGdrSweepDlg dlg;
+   dlg.m_bEnable = pDoc->IsSweepEnabled() ? TRUE : FALSE;
+   dlg.m_Sweep = pDoc->GetSweep();
+   if ( dlg.DoModal() == IDOK )
+   {
+      pDoc->EnableSweep(dlg.m_bEnable ? true : false);
+      pDoc->SetSweep(dlg.m_Sweep);
+      pDoc->SetModifiedFlag();
+      pDoc->UpdateAllViews(nullptr);
+   }
+}
+
 void CBoxGdrChildFrame::SetUnitsMode(eafTypes::UnitMode um)
 {
    CEAFApp* pApp = EAFGetApp();
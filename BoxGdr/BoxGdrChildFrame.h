@@ -47,6 +47,7 @@ protected:
    afx_msg void OnAdd();
    afx_msg void OnRemove();
    afx_msg void OnUpdateRemove(CCmdUI* pCmdUI);
+   afx_msg void OnSweep();
    afx_msg LRESULT OnCommandHelp(WPARAM, LPARAM lParam);
 
    DECLARE_MESSAGE_MAP()
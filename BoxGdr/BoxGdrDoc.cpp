@@ -30,6 +30,8 @@
 #include "BoxGdrChapterBuilder.h"
 #include "BoxGdrChildFrame.h"
 #include "..\BEToolboxStatusBar.h"
+#include "..\BEToolboxRecordBlock.h"
+#include "..\BEToolboxProgressDlg.h"
 
 #include <EAF\EAFUtilities.h>
 #include <EAF\EAFApp.h>
@@ -58,6 +60,9 @@ CBoxGdrDoc::CBoxGdrDoc()
    m_RptMgr.AddReportBuilder(pRptBuilder);
 
    EnableUIHints(FALSE); // not using UIHints feature
+
+   m_bSweep = false;
+   m_bSweepResultsValid = false;
 }
 
 CBoxGdrDoc::~CBoxGdrDoc()
@@ -115,6 +120,17 @@ BOOL CBoxGdrDoc::Init()
 
    m_Problems.push_back(problem);
 
+   // initialize the design space with the dimensions of the default problem
+   Float64 values[BOXGDRSWEEP::nParameters] = {problem.D,problem.T,(Float64)problem.N,problem.W,problem.ST,problem.SB,problem.FT,problem.FB,problem.EL,problem.CL,problem.BL,problem.ER,problem.CR,problem.BR};
+   BOXGDRSWEEP sweep;
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      sweep.Range[i].Start = values[i];
+      sweep.Range[i].End = values[i];
+      sweep.Range[i].nValues = 1;
+   }
+   SetSweep(sweep);
+
    return TRUE;
 }
 
@@ -127,7 +143,7 @@ void CBoxGdrDoc::OnCloseDocument()
 
 HRESULT CBoxGdrDoc::WriteTheDocument(IStructuredSave* pStrSave)
 {
-   HRESULT hr = pStrSave->BeginUnit(_T("BoxGdr"),1.0);
+   HRESULT hr = pStrSave->BeginUnit(_T("BoxGdr"),2.0);
    if ( FAILED(hr) )
       return hr;
 
@@ -141,85 +157,24 @@ HRESULT CBoxGdrDoc::WriteTheDocument(IStructuredSave* pStrSave)
    if ( FAILED(hr) )
       return hr;
 
-   hr = pStrSave->BeginUnit(_T("Problems"),1.0);
+   // Version 2 - the problems are saved as a block of packed records instead of a Dimensions unit for each problem
+   hr = pStrSave->BeginUnit(_T("Problems"),2.0);
    if ( FAILED(hr) )
       return hr;
 
-   std::vector<BOXGDRDIMENSIONS>::iterator iter(m_Problems.begin());
-   std::vector<BOXGDRDIMENSIONS>::iterator end(m_Problems.end());
-   for ( ; iter != end; iter++ )
-   {
-      BOXGDRDIMENSIONS& dimensions = *iter;
-
-      hr = pStrSave->BeginUnit(_T("Dimensions"),1.0);
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("D"),CComVariant(dimensions.D));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("T"),CComVariant(dimensions.T));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("N"),CComVariant(dimensions.N));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("W"),CComVariant(dimensions.W));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("ST"),CComVariant(dimensions.ST));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("SB"),CComVariant(dimensions.SB));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("FT"),CComVariant(dimensions.FT));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("FB"),CComVariant(dimensions.FB));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("EL"),CComVariant(dimensions.EL));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("CL"),CComVariant(dimensions.CL));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("BL"),CComVariant(dimensions.BL));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("ER"),CComVariant(dimensions.ER));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("CR"),CComVariant(dimensions.CR));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("BR"),CComVariant(dimensions.BR));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->EndUnit(); // Dimensions
-      if ( FAILED(hr) )
-         return hr;
-   }
+   hr = WriteProblemRecords(pStrSave);
+   if ( FAILED(hr) )
+      return hr;
 
    hr = pStrSave->EndUnit(); // Problems
    if ( FAILED(hr) )
       return hr;
 
+   // added in version 2.0
+   hr = WriteSweep(pStrSave);
+   if ( FAILED(hr) )
+      return hr;
+
    hr = pStrSave->EndUnit(); // BoxGdr
    if ( FAILED(hr) )
       return hr;
@@ -257,6 +212,124 @@ HRESULT CBoxGdrDoc::LoadTheDocument(IStructuredLoad* pStrLoad)
    if ( FAILED(hr) )
       return hr;
 
+   Float64 problems_version;
+   pStrLoad->get_Version(&problems_version);
+   if ( problems_version < 2 )
+   {
+      hr = LoadProblems(pStrLoad,nProblems);
+   }
+   else
+   {
+      hr = LoadProblemRecords(pStrLoad,nProblems);
+   }
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrLoad->EndUnit(); // Problems
+   if ( FAILED(hr) )
+      return hr;
+
+   Float64 version;
+   pStrLoad->get_Version(&version);
+   if ( 1 < version )
+   {
+      hr = LoadSweep(pStrLoad);
+      if ( FAILED(hr) )
+         return hr;
+   }
+
+   hr = pStrLoad->EndUnit(); // BoxGdr
+   if ( FAILED(hr) )
+      return hr;
+
+   return S_OK;
+}
+
+// Fields of a problem record
+static const LPCTSTR gs_RecordFields[] = { _T("D"), _T("T"), _T("N"), _T("W"), _T("ST"), _T("SB"), _T("FT"), _T("FB"), _T("EL"), _T("CL"), _T("BL"), _T("ER"), _T("CR"), _T("BR") };
+
+static const std::vector<std::_tstring>& GetRecordFields()
+{
+   static std::vector<std::_tstring> vFields(std::begin(gs_RecordFields),std::end(gs_RecordFields));
+   return vFields;
+}
+
+HRESULT CBoxGdrDoc::WriteProblemRecords(IStructuredSave* pStrSave)
+{
+   const std::vector<std::_tstring>& vFields(GetRecordFields());
+   IndexType nFields = vFields.size();
+   IndexType nProblems = m_Problems.size();
+
+   std::vector<Float64> vRecords(nProblems*nFields);
+   Float64* pRecord = vRecords.data();
+   for ( const auto& dimensions : m_Problems )
+   {
+      // same order as gs_RecordFields
+      pRecord[0]  = dimensions.D;
+      pRecord[1]  = dimensions.T;
+      pRecord[2]  = (Float64)dimensions.N;
+      pRecord[3]  = dimensions.W;
+      pRecord[4]  = dimensions.ST;
+      pRecord[5]  = dimensions.SB;
+      pRecord[6]  = dimensions.FT;
+      pRecord[7]  = dimensions.FB;
+      pRecord[8]  = dimensions.EL;
+      pRecord[9]  = dimensions.CL;
+      pRecord[10] = dimensions.BL;
+      pRecord[11] = dimensions.ER;
+      pRecord[12] = dimensions.CR;
+      pRecord[13] = dimensions.BR;
+      pRecord += nFields;
+   }
+
+   return WriteRecordBlock(pStrSave,_T("Records"),vFields,vRecords.data(),nProblems);
+}
+
+HRESULT CBoxGdrDoc::LoadProblemRecords(IStructuredLoad* pStrLoad,IndexType nProblems)
+{
+   const std::vector<std::_tstring>& vFields(GetRecordFields());
+   IndexType nFields = vFields.size();
+   std::vector<Float64> vRecords;
+   IndexType nRecords;
+   HRESULT hr = ReadRecordBlock(pStrLoad,_T("Records"),vFields,&vRecords,&nRecords);
+   if ( FAILED(hr) )
+      return hr;
+
+   if ( nRecords != nProblems )
+      return E_FAIL;
+
+   m_Problems.resize(nProblems);
+   const Float64* pRecord = vRecords.data();
+   for ( auto& dimensions : m_Problems )
+   {
+      dimensions.D  = pRecord[0];
+      dimensions.T  = pRecord[1];
+      dimensions.N  = (IndexType)pRecord[2];
+      dimensions.W  = pRecord[3];
+      dimensions.ST = pRecord[4];
+      dimensions.SB = pRecord[5];
+      dimensions.FT = pRecord[6];
+      dimensions.FB = pRecord[7];
+      dimensions.EL = pRecord[8];
+      dimensions.CL = pRecord[9];
+      dimensions.BL = pRecord[10];
+      dimensions.ER = pRecord[11];
+      dimensions.CR = pRecord[12];
+      dimensions.BR = pRecord[13];
+      pRecord += nFields;
+   }
+
+   return S_OK;
+}
+
+HRESULT CBoxGdrDoc::LoadProblems(IStructuredLoad* pStrLoad,IndexType nProblems)
+{
+   // Problems version 1 - each problem is a Dimensions unit
+   CComVariant var;
+   HRESULT hr;
+
+   m_Problems.reserve(nProblems);
+
    for ( IndexType idx = 0; idx < nProblems; idx++ )
    {
       BOXGDRDIMENSIONS dimensions;
@@ -360,14 +433,6 @@ HRESULT CBoxGdrDoc::LoadTheDocument(IStructuredLoad* pStrLoad)
          return hr;
    }
 
-   hr = pStrLoad->EndUnit(); // Problems
-   if ( FAILED(hr) )
-      return hr;
-
-   hr = pStrLoad->EndUnit(); // BoxGdr
-   if ( FAILED(hr) )
-      return hr;
-
    return S_OK;
 }
 
@@ -495,3 +560,154 @@ void CBoxGdrDoc::ComputeShapeProperties(IndexType idx,IShapeProperties** ppShape
    CComQIPtr<IShape> shape(compositeShape);
    shape->get_ShapeProperties(ppShapeProperties);
 }
+
+bool CBoxGdrDoc::IsSweepEnabled() const
+{
+   return m_bSweep;
+}
+
+void CBoxGdrDoc::EnableSweep(bool bEnable)
+{
+   m_bSweep = bEnable;
+}
+
+const BOXGDRSWEEP& CBoxGdrDoc::GetSweep() const
+{
+   return m_Sweep;
+}
+
+void CBoxGdrDoc::SetSweep(const BOXGDRSWEEP& sweep)
+{
+   m_Sweep = sweep;
+   m_bSweepResultsValid = false;
+}
+
+const BOXGDRSWEEPRESULTS& CBoxGdrDoc::GetSweepResults()
+{
+   if ( !m_bSweepResultsValid )
+   {
+      Float64 unitWeight = GetUnitWeight();
+      if ( CBoxGdrSweep::MaxCombinations < CBoxGdrSweep::GetCombinationCount(m_Sweep) )
+      {
+         // too large to evaluate... Sweep returns right away with bCompleted set to false
+         CBoxGdrSweep::Sweep(m_Sweep,unitWeight,&m_SweepResults);
+      }
+      else
+      {
+         // The sweep runs on worker threads while a progress dialog keeps the application responsive.
+         // If the sweep is cancelled, the incomplete results are kept until the sweep is changed.
+         AFX_MANAGE_STATE(AfxGetStaticModuleState());
+         CBEToolboxProgressDlg progressDlg(_T("Evaluating the design space..."),EAFGetMainFrame());
+         bool bCancelled;
+         progressDlg.Run([this,unitWeight](const CBEToolboxProgressDlg::ProgressCallback& progress)
+         {
+            return CBoxGdrSweep::Sweep(m_Sweep,unitWeight,&m_SweepResults,[&progress](IndexType nEvaluated,IndexType nCombinations) {return progress((Float64)nEvaluated/nCombinations);});
+         },&bCancelled);
+      }
+      m_bSweepResultsValid = true;
+   }
+
+   return m_SweepResults;
+}
+
+Float64 CBoxGdrDoc::GetUnitWeight()
+{
+   return ::ConvertToSysUnits(160.0,unitMeasure::PCF);
+}
+
+static LPCTSTR gs_strSweepParameters[BOXGDRSWEEP::nParameters] = {_T("D"),_T("T"),_T("N"),_T("W"),_T("ST"),_T("SB"),_T("FT"),_T("FB"),_T("EL"),_T("CL"),_T("BL"),_T("ER"),_T("CR"),_T("BR")};
+
+HRESULT CBoxGdrDoc::WriteSweep(IStructuredSave* pStrSave)
+{
+   HRESULT hr = pStrSave->BeginUnit(_T("Sweep"),1.0);
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("Enabled"),CComVariant(m_bSweep));
+   if ( FAILED(hr) )
+      return hr;
+
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      hr = pStrSave->BeginUnit(gs_strSweepParameters[i],1.0);
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("Start"),CComVariant(m_Sweep.Range[i].Start));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("End"),CComVariant(m_Sweep.Range[i].End));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("Values"),CComVariant(m_Sweep.Range[i].nValues));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->EndUnit();
+      if ( FAILED(hr) )
+         return hr;
+   }
+
+   hr = pStrSave->EndUnit(); // Sweep
+   if ( FAILED(hr) )
+      return hr;
+
+   return S_OK;
+}
+
+HRESULT CBoxGdrDoc::LoadSweep(IStructuredLoad* pStrLoad)
+{
+   HRESULT hr = pStrLoad->BeginUnit(_T("Sweep"));
+   if ( FAILED(hr) )
+      return hr;
+
+   CComVariant var;
+   var.vt = VT_BOOL;
+   hr = pStrLoad->get_Property(_T("Enabled"),&var);
+   if ( FAILED(hr) )
+      return hr;
+
+   m_bSweep = (var.boolVal == VARIANT_TRUE);
+
+   BOXGDRSWEEP sweep;
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      hr = pStrLoad->BeginUnit(gs_strSweepParameters[i]);
+      if ( FAILED(hr) )
+         return hr;
+
+      var.vt = VT_R8;
+      hr = pStrLoad->get_Property(_T("Start"),&var);
+      if ( FAILED(hr) )
+         return hr;
+
+      sweep.Range[i].Start = var.dblVal;
+
+      hr = pStrLoad->get_Property(_T("End"),&var);
+      if ( FAILED(hr) )
+         return hr;
+
+      sweep.Range[i].End = var.dblVal;
+
+      var.vt = VT_INDEX;
+      hr = pStrLoad->get_Property(_T("Values"),&var);
+      if ( FAILED(hr) )
+         return hr;
+
+      sweep.Range[i].nValues = VARIANT2INDEX(var);
+
+      hr = pStrLoad->EndUnit();
+      if ( FAILED(hr) )
+         return hr;
+   }
+
+   SetSweep(sweep);
+
+   hr = pStrLoad->EndUnit(); // Sweep
+   if ( FAILED(hr) )
+      return hr;
+
+   return S_OK;
+}
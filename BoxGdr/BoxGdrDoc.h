@@ -28,24 +28,7 @@
 #include <WBFLGeometry.h>
 #include <WBFLUnitServer.h>
 #include <ReportManager\ReportManager.h>
-
-struct BOXGDRDIMENSIONS
-{
-   Float64 D;
-   Float64 T;
-   IndexType N;
-   Float64 W;
-   Float64 ST;
-   Float64 SB;
-   Float64 FT;
-   Float64 FB;
-   Float64 EL;
-   Float64 CL;
-   Float64 BL;
-   Float64 ER;
-   Float64 CR;
-   Float64 BR;
-};
+#include "BoxGdrSweep.h"
 
 class CBoxGdrDoc : public CBEToolboxDoc
 {
@@ -66,6 +49,19 @@ public:
 
    void ComputeShapeProperties(IndexType idx,IShapeProperties** ppShapeProperties);
 
+   // Design space sweep
+   bool IsSweepEnabled() const;
+   void EnableSweep(bool bEnable);
+   const BOXGDRSWEEP& GetSweep() const;
+   void SetSweep(const BOXGDRSWEEP& sweep);
+
+   // Returns the efficient frontier of the design space. The sweep is evaluated the
+   // first time the results are requested after the sweep definition changes.
+   const BOXGDRSWEEPRESULTS& GetSweepResults();
+
+   // Unit weight used to compute girder weight
+   static Float64 GetUnitWeight();
+
 #ifdef _DEBUG
 	virtual void AssertValid() const override;
 #ifndef _WIN32_WCE
@@ -90,6 +86,18 @@ protected:
 
    std::vector<BOXGDRDIMENSIONS> m_Problems;
 
+   HRESULT WriteProblemRecords(IStructuredSave* pStrSave);
+   HRESULT LoadProblemRecords(IStructuredLoad* pStrLoad,IndexType nProblems);
+   HRESULT LoadProblems(IStructuredLoad* pStrLoad,IndexType nProblems); // Problems version 1
+
+   bool m_bSweep;
+   BOXGDRSWEEP m_Sweep;
+   bool m_bSweepResultsValid;
+   BOXGDRSWEEPRESULTS m_SweepResults;
+
+   HRESULT WriteSweep(IStructuredSave* pStrSave);
+   HRESULT LoadSweep(IStructuredLoad* pStrLoad);
+
    afx_msg void OnHelpFinder();
 	DECLARE_MESSAGE_MAP()
 public:
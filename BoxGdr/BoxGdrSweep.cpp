@@ -0,0 +1,423 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "BoxGdrSweep.h"
+#include "..\BEToolboxUtilities.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+namespace
+{
+   // Accumulates the area, first moment and second moment about the X axis of a closed polygon
+   // using Green's theorem. The points must be listed in counter-clockwise order.
+   struct POLYGONSUMS
+   {
+      Float64 A2;   // twice the area
+      Float64 Qx6;  // six times the first moment about the X axis
+      Float64 Ix12; // twelve times the moment of inertia about the X axis
+      Float64 Ymin;
+      Float64 Ymax;
+   };
+
+   void PolygonSums(const Float64* x,const Float64* y,IndexType nPoints,POLYGONSUMS* pSums)
+   {
+      pSums->A2 = 0;
+      pSums->Qx6 = 0;
+      pSums->Ix12 = 0;
+      pSums->Ymin = y[0];
+      pSums->Ymax = y[0];
+      for ( IndexType i = 0; i < nPoints; i++ )
+      {
+         IndexType j = (i == nPoints-1 ? 0 : i+1);
+         Float64 a = x[i]*y[j] - x[j]*y[i];
+         pSums->A2 += a;
+         pSums->Qx6 += (y[i] + y[j])*a;
+         pSums->Ix12 += (y[i]*y[i] + y[i]*y[j] + y[j]*y[j])*a;
+         pSums->Ymin = Min(pSums->Ymin,y[i]);
+         pSums->Ymax = Max(pSums->Ymax,y[i]);
+      }
+   }
+
+   // A candidate point on the efficient frontier
+   struct CANDIDATE
+   {
+      IndexType Idx; // combination index
+      Float64 Weight;
+      Float64 Value; // Ix or Sb
+   };
+
+   // Reduces the candidates to the Pareto optimal set (minimum weight, maximum value),
+   // sorted by increasing weight
+   void Prune(std::vector<CANDIDATE>& candidates)
+   {
+      std::sort(candidates.begin(),candidates.end(),[](const auto& a,const auto& b) {return a.Weight < b.Weight || (a.Weight == b.Weight && b.Value < a.Value);});
+
+      auto end = candidates.begin();
+      Float64 maxValue = -Float64_Max;
+      for ( auto iter = candidates.begin(); iter != candidates.end(); iter++ )
+      {
+         if ( maxValue < iter->Value )
+         {
+            maxValue = iter->Value;
+            *end++ = *iter;
+         }
+      }
+      candidates.erase(end,candidates.end());
+   }
+
+   // Collects frontier candidates for one worker thread. The candidate list is pruned whenever
+   // it doubles in size so memory use doesn't depend on the size of the design space
+   class CFrontierBuilder
+   {
+   public:
+      CFrontierBuilder() : m_PruneSize(1024) {}
+
+      void Add(IndexType idx,Float64 weight,Float64 value)
+      {
+         m_Candidates.push_back({idx,weight,value});
+         if ( m_PruneSize < m_Candidates.size() )
+         {
+            Prune(m_Candidates);
+            m_PruneSize = Max((IndexType)1024,2*m_Candidates.size());
+         }
+      }
+
+      std::vector<CANDIDATE>& GetCandidates() { return m_Candidates; }
+
+   private:
+      std::vector<CANDIDATE> m_Candidates;
+      IndexType m_PruneSize;
+   };
+}
+
+bool CBoxGdrSweep::IsValid(const BOXGDRDIMENSIONS& dimensions)
+{
+   if ( dimensions.N < 2 )
+      return false;
+
+   Float64 H = dimensions.D - dimensions.ST - dimensions.SB; // void height
+   Float64 V = (dimensions.W - dimensions.N*dimensions.T)/(dimensions.N-1); // void width
+   if ( H <= 0 || V <= 0 )
+      return false;
+
+   if ( dimensions.FT < 0 || dimensions.FB < 0 || V/2 < dimensions.FT || V/2 < dimensions.FB || H < dimensions.FT + dimensions.FB )
+      return false;
+
+   return true;
+}
+
+bool CBoxGdrSweep::ComputeSectionProperties(const BOXGDRDIMENSIONS& dimensions,BOXGDRPROPERTIES* pProperties)
+{
+   if ( !IsValid(dimensions) )
+      return false;
+
+   // main shape (same points as CBoxGdrDoc::ComputeShapeProperties)
+   Float64 xm[9],ym[9];
+   xm[0] = 0;                                  ym[0] = 0;
+   xm[1] = dimensions.W/2;                     ym[1] = 0;
+   xm[2] = dimensions.W/2;                     ym[2] = dimensions.D-dimensions.BR;
+   xm[3] = dimensions.W/2+dimensions.ER;       ym[3] = dimensions.D-dimensions.CR;
+   xm[4] = dimensions.W/2+dimensions.ER;       ym[4] = dimensions.D;
+   xm[5] = -(dimensions.W/2+dimensions.EL);    ym[5] = dimensions.D;
+   xm[6] = -(dimensions.W/2+dimensions.EL);    ym[6] = dimensions.D-dimensions.CL;
+   xm[7] = -dimensions.W/2;                    ym[7] = dimensions.D-dimensions.BL;
+   xm[8] = -dimensions.W/2;                    ym[8] = 0;
+
+   POLYGONSUMS main;
+   PolygonSums(xm,ym,9,&main);
+
+   // voids... all voids are the same shape and at the same elevation so their properties about
+   // the X axis are the same
+   Float64 H = dimensions.D - dimensions.ST - dimensions.SB; // void height
+   IndexType nVoids = dimensions.N-1;
+   Float64 V = (dimensions.W - dimensions.N*dimensions.T)/(dimensions.N-1); // void width
+   Float64 yOffset = dimensions.SB;
+
+   Float64 xv[8],yv[8];
+   xv[0] = V/2 - dimensions.FB;    yv[0] = yOffset;
+   xv[1] = V/2;                    yv[1] = yOffset + dimensions.FB;
+   xv[2] = V/2;                    yv[2] = yOffset + H - dimensions.FT;
+   xv[3] = V/2 - dimensions.FT;    yv[3] = yOffset + H;
+   xv[4] = -xv[3];                 yv[4] = yv[3];
+   xv[5] = -xv[2];                 yv[5] = yv[2];
+   xv[6] = -xv[1];                 yv[6] = yv[1];
+   xv[7] = -xv[0];                 yv[7] = yv[0];
+
+   POLYGONSUMS voids;
+   PolygonSums(xv,yv,8,&voids);
+
+   Float64 A  = (main.A2   - nVoids*voids.A2)/2;
+   Float64 Qx = (main.Qx6  - nVoids*voids.Qx6)/6;
+   Float64 Ix = (main.Ix12 - nVoids*voids.Ix12)/12;
+   if ( A <= 0 )
+      return false;
+
+   Float64 Ybar = Qx/A;
+   pProperties->Area = A;
+   pProperties->Ix = Ix - A*Ybar*Ybar;
+   pProperties->Yt = main.Ymax - Ybar;
+   pProperties->Yb = Ybar - main.Ymin;
+   pProperties->St = IsZero(pProperties->Yt) ? 0 : pProperties->Ix/pProperties->Yt;
+   pProperties->Sb = IsZero(pProperties->Yb) ? 0 : pProperties->Ix/pProperties->Yb;
+
+   return true;
+}
+
+static Float64 RoundToWholeNumber(Float64 value)
+{
+   return Max(0.0,floor(value + 0.5));
+}
+
+// Returns the number of values taken by a parameter of the design space
+static IndexType GetValueCount(const BOXGDRSWEEP& sweep,int parameter)
+{
+   const BOXGDRSWEEPRANGE& range = sweep.Range[parameter];
+   IndexType nValues = Max(range.nValues,(IndexType)1);
+   if ( parameter == BOXGDRSWEEP::N )
+   {
+      // the number of webs is a whole number. more values than there are whole numbers
+      // in the range would repeat values and evaluate the same sections more than once
+      Float64 nWholeNumbers = fabs(RoundToWholeNumber(range.End) - RoundToWholeNumber(range.Start)) + 1;
+      if ( nWholeNumbers < nValues )
+      {
+         nValues = (IndexType)nWholeNumbers;
+      }
+   }
+   return nValues;
+}
+
+static Float64 GetSweepValue(const BOXGDRSWEEP& sweep,int parameter,IndexType valueIdx)
+{
+   const BOXGDRSWEEPRANGE& range = sweep.Range[parameter];
+   IndexType nValues = GetValueCount(sweep,parameter);
+   if ( parameter == BOXGDRSWEEP::N )
+   {
+      // the values are at least one apart so rounding can't produce the same number of webs twice
+      Float64 start = RoundToWholeNumber(range.Start);
+      Float64 end = RoundToWholeNumber(range.End);
+      return nValues < 2 ? start : floor(start + (end - start)*valueIdx/(nValues-1) + 0.5);
+   }
+
+   if ( nValues < 2 )
+      return range.Start;
+
+   return range.Start + (range.End - range.Start)*valueIdx/(nValues-1);
+}
+
+IndexType CBoxGdrSweep::GetCombinationCount(const BOXGDRSWEEP& sweep)
+{
+   // saturate instead of wrapping around if the design space is enormous
+   const IndexType maxCount = std::numeric_limits<IndexType>::max();
+   IndexType nCombinations = 1;
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      IndexType nValues = GetValueCount(sweep,i);
+      if ( maxCount/nValues < nCombinations )
+         return maxCount;
+
+      nCombinations *= nValues;
+   }
+   return nCombinations;
+}
+
+static void SetSweepValues(const Float64* values,BOXGDRDIMENSIONS* pDimensions)
+{
+   pDimensions->D  = values[BOXGDRSWEEP::D];
+   pDimensions->T  = values[BOXGDRSWEEP::T];
+   pDimensions->N  = (IndexType)(values[BOXGDRSWEEP::N] + 0.5);
+   pDimensions->W  = values[BOXGDRSWEEP::W];
+   pDimensions->ST = values[BOXGDRSWEEP::ST];
+   pDimensions->SB = values[BOXGDRSWEEP::SB];
+   pDimensions->FT = values[BOXGDRSWEEP::FT];
+   pDimensions->FB = values[BOXGDRSWEEP::FB];
+   pDimensions->EL = values[BOXGDRSWEEP::EL];
+   pDimensions->CL = values[BOXGDRSWEEP::CL];
+   pDimensions->BL = values[BOXGDRSWEEP::BL];
+   pDimensions->ER = values[BOXGDRSWEEP::ER];
+   pDimensions->CR = values[BOXGDRSWEEP::CR];
+   pDimensions->BR = values[BOXGDRSWEEP::BR];
+}
+
+void CBoxGdrSweep::GetDimensions(const BOXGDRSWEEP& sweep,IndexType combinationIdx,BOXGDRDIMENSIONS* pDimensions)
+{
+   // the first parameter is the least significant digit
+   Float64 values[BOXGDRSWEEP::nParameters];
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      IndexType nValues = GetValueCount(sweep,i);
+      values[i] = GetSweepValue(sweep,i,combinationIdx % nValues);
+      combinationIdx /= nValues;
+   }
+
+   SetSweepValues(values,pDimensions);
+}
+
+bool CBoxGdrSweep::Sweep(const BOXGDRSWEEP& sweep,Float64 unitWeight,BOXGDRSWEEPRESULTS* pResults,const ProgressCallback& progress)
+{
+   IndexType nCombinations = GetCombinationCount(sweep);
+   pResults->bCompleted = false;
+   pResults->nCombinations = nCombinations;
+   pResults->nRejected = 0;
+   pResults->IxFrontier.clear();
+   pResults->SbFrontier.clear();
+   if ( MaxCombinations < nCombinations )
+      return false;
+
+   // tabulate the values of each parameter so the workers only have to do table lookups
+   std::vector<Float64> vValues[BOXGDRSWEEP::nParameters];
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      IndexType nValues = GetValueCount(sweep,i);
+      vValues[i].reserve(nValues);
+      for ( IndexType valueIdx = 0; valueIdx < nValues; valueIdx++ )
+      {
+         vValues[i].push_back(GetSweepValue(sweep,i,valueIdx));
+      }
+   }
+
+   IndexType nThreads = GetWorkerThreadCount(nCombinations);
+   std::vector<CFrontierBuilder> ixFrontiers(nThreads);
+   std::vector<CFrontierBuilder> sbFrontiers(nThreads);
+   std::vector<IndexType> nRejected(nThreads,0);
+
+   // progress is reported, and cancellation checked, after every block of combinations
+   const IndexType blockSize = 65536;
+   std::atomic<IndexType> nEvaluated(0);
+   std::atomic<bool> bCancelled(false);
+   std::mutex progressMutex;
+
+   ParallelFor(nCombinations,[&](IndexType threadIdx,IndexType begin,IndexType end)
+   {
+      if ( begin == end )
+         return;
+
+      // decode the first combination then step through the rest like an odometer
+      IndexType digits[BOXGDRSWEEP::nParameters];
+      Float64 values[BOXGDRSWEEP::nParameters];
+      IndexType idx = begin;
+      for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+      {
+         IndexType nValues = vValues[i].size();
+         digits[i] = idx % nValues;
+         values[i] = vValues[i][digits[i]];
+         idx /= nValues;
+      }
+
+      CFrontierBuilder& ixFrontier = ixFrontiers[threadIdx];
+      CFrontierBuilder& sbFrontier = sbFrontiers[threadIdx];
+      IndexType& nInvalid = nRejected[threadIdx];
+
+      BOXGDRDIMENSIONS dimensions;
+      BOXGDRPROPERTIES props;
+      IndexType nInBlock = 0;
+      for ( IndexType combinationIdx = begin; combinationIdx < end; combinationIdx++ )
+      {
+         if ( nInBlock == blockSize )
+         {
+            nEvaluated += nInBlock;
+            nInBlock = 0;
+            if ( progress )
+            {
+               // don't wait if another thread is reporting progress
+               std::unique_lock<std::mutex> lock(progressMutex,std::try_to_lock);
+               if ( lock.owns_lock() && !progress(nEvaluated,nCombinations) )
+               {
+                  bCancelled = true;
+               }
+            }
+
+            if ( bCancelled )
+               return;
+         }
+         nInBlock++;
+
+         SetSweepValues(values,&dimensions);
+         if ( ComputeSectionProperties(dimensions,&props) )
+         {
+            Float64 weight = props.Area*unitWeight;
+            ixFrontier.Add(combinationIdx,weight,props.Ix);
+            sbFrontier.Add(combinationIdx,weight,props.Sb);
+         }
+         else
+         {
+            nInvalid++;
+         }
+
+         for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+         {
+            if ( ++digits[i] < vValues[i].size() )
+            {
+               values[i] = vValues[i][digits[i]];
+               break;
+            }
+            digits[i] = 0;
+            values[i] = vValues[i][0];
+         }
+      }
+   });
+
+   if ( bCancelled )
+      return false;
+
+   for ( auto n : nRejected )
+   {
+      pResults->nRejected += n;
+   }
+
+   // merge the frontiers from the worker threads
+   auto merge = [&sweep,unitWeight](std::vector<CFrontierBuilder>& frontiers,std::vector<BOXGDRSWEEPPOINT>& points)
+   {
+      std::vector<CANDIDATE> candidates;
+      for ( auto& frontier : frontiers )
+      {
+         Prune(frontier.GetCandidates());
+         candidates.insert(candidates.end(),frontier.GetCandidates().begin(),frontier.GetCandidates().end());
+      }
+      Prune(candidates);
+
+      points.clear();
+      points.reserve(candidates.size());
+      for ( const auto& candidate : candidates )
+      {
+         BOXGDRSWEEPPOINT point;
+         GetDimensions(sweep,candidate.Idx,&point.Dimensions);
+         VERIFY(ComputeSectionProperties(point.Dimensions,&point.Properties));
+         point.Weight = point.Properties.Area*unitWeight;
+         points.push_back(point);
+      }
+   };
+
+   merge(ixFrontiers,pResults->IxFrontier);
+   merge(sbFrontiers,pResults->SbFrontier);
+
+   pResults->bCompleted = true;
+   return true;
+}
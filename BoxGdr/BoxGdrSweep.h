@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <functional>
+
+struct BOXGDRDIMENSIONS
+{
+   Float64 D;
+   Float64 T;
+   IndexType N;
+   Float64 W;
+   Float64 ST;
+   Float64 SB;
+   Float64 FT;
+   Float64 FB;
+   Float64 EL;
+   Float64 CL;
+   Float64 BL;
+   Float64 ER;
+   Float64 CR;
+   Float64 BR;
+};
+
+// Section properties of a box girder computed with the native (non-COM) section model
+struct BOXGDRPROPERTIES
+{
+   Float64 Area;
+   Float64 Ix;   // moment of inertia about the horizontal centroidal axis
+   Float64 Yt;   // centroid to top of section
+   Float64 Yb;   // centroid to bottom of section
+   Float64 St;   // top section modulus
+   Float64 Sb;   // bottom section modulus
+};
+
+// Range of values for one dimension of the design space. nValues evenly spaced values
+// are generated from Start to End, inclusive. If nValues is 1, only Start is used.
+// The number of webs is a whole number. Start and End are rounded and there are never
+// more values than there are whole numbers from Start to End.
+struct BOXGDRSWEEPRANGE
+{
+   Float64 Start;
+   Float64 End;
+   IndexType nValues;
+};
+
+// Definition of a design space sweep. The design space is the Cartesian product of
+// the ranges of all the box girder dimensions
+struct BOXGDRSWEEP
+{
+   enum Parameter { D, T, N, W, ST, SB, FT, FB, EL, CL, BL, ER, CR, BR, nParameters };
+   BOXGDRSWEEPRANGE Range[nParameters];
+};
+
+// A point on the efficient frontier of the design space
+struct BOXGDRSWEEPPOINT
+{
+   BOXGDRDIMENSIONS Dimensions;
+   BOXGDRPROPERTIES Properties;
+   Float64 Weight;
+};
+
+struct BOXGDRSWEEPRESULTS
+{
+   bool bCompleted; // false if the sweep was cancelled or the design space is too large to evaluate
+   IndexType nCombinations; // number of combinations in the design space
+   IndexType nRejected; // number of combinations rejected because of invalid geometry
+
+   // Pareto optimal sections. A section is on the frontier if no other section is lighter
+   // with a greater (or equal) Ix (or Sb). Sorted by increasing weight.
+   std::vector<BOXGDRSWEEPPOINT> IxFrontier;
+   std::vector<BOXGDRSWEEPPOINT> SbFrontier;
+};
+
+// Native box girder section model and design space explorer.
+//
+// Section properties are computed in closed form from the same polygons that
+// CBoxGdrDoc::ComputeShapeProperties builds with the WBFL geometry objects. Because there are no
+// COM calls, the design space can be evaluated on worker threads.
+class CBoxGdrSweep
+{
+public:
+   // Design spaces with more combinations than this are not evaluated
+   static constexpr IndexType MaxCombinations = 1000000000;
+
+   // Called periodically during a sweep with the number of combinations evaluated so far.
+   // Return false to cancel the sweep. The callback is called from the worker threads, but
+   // never from more than one thread at a time.
+   typedef std::function<bool(IndexType nEvaluated,IndexType nCombinations)> ProgressCallback;
+
+   // Returns false, without computing properties, if the dimensions don't define a valid section
+   // (less than two webs, negative void width or height, or fillets that don't fit in the voids)
+   static bool IsValid(const BOXGDRDIMENSIONS& dimensions);
+
+   // Computes the section properties. Returns false if the dimensions are not valid.
+   static bool ComputeSectionProperties(const BOXGDRDIMENSIONS& dimensions,BOXGDRPROPERTIES* pProperties);
+
+   // Returns the number of combinations in the design space. If the number of combinations
+   // can't be represented by an IndexType, the maximum IndexType value is returned.
+   static IndexType GetCombinationCount(const BOXGDRSWEEP& sweep);
+
+   // Returns the dimensions for the specified combination. combinationIdx is a mixed radix number
+   // with one digit per dimension of the design space
+   static void GetDimensions(const BOXGDRSWEEP& sweep,IndexType combinationIdx,BOXGDRDIMENSIONS* pDimensions);
+
+   // Evaluates every combination in the design space, in parallel, and returns the
+   // efficient frontier of weight against Ix and Sb. Returns false, with empty frontiers, if
+   // the sweep is cancelled or there are more than MaxCombinations combinations.
+   static bool Sweep(const BOXGDRSWEEP& sweep,Float64 unitWeight,BOXGDRSWEEPRESULTS* pResults,const ProgressCallback& progress = nullptr);
+};
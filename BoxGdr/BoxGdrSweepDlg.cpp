@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+// BoxGdrSweepDlg.cpp : implementation file
+//
+
+#include "stdafx.h"
+#include "..\resource.h"
+#include "BoxGdrSweepDlg.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+
+// CBoxGdrSweepDlg dialog
+
+IMPLEMENT_DYNAMIC(CBoxGdrSweepDlg, CDialog)
+
+CBoxGdrSweepDlg::CBoxGdrSweepDlg(CWnd* pParent /*=nullptr*/)
+	: CDialog(CBoxGdrSweepDlg::IDD, pParent)
+{
+   m_bEnable = FALSE;
+}
+
+CBoxGdrSweepDlg::~CBoxGdrSweepDlg()
+{
+}
+
+void CBoxGdrSweepDlg::DoDataExchange(CDataExchange* pDX)
+{
+	CDialog::DoDataExchange(pDX);
+
+   DDX_Check(pDX,IDC_ENABLE_SWEEP,m_bEnable);
+
+   if ( pDX->m_bSaveAndValidate )
+   {
+      m_Grid.GetSweep(&m_Sweep);
+
+      if ( m_bEnable && CBoxGdrSweep::MaxCombinations < CBoxGdrSweep::GetCombinationCount(m_Sweep) )
+      {
+         pDX->PrepareCtrl(IDC_SWEEP_DIMENSIONS);
+         CString strMsg;
+         strMsg.Format(_T("The design space has more than %Iu combinations and can't be evaluated. Reduce the number of values."),CBoxGdrSweep::MaxCombinations);
+         AfxMessageBox(strMsg,MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+   }
+   else
+   {
+      m_Grid.FillGrid(m_Sweep);
+      UpdateCombinationCount();
+   }
+}
+
+
+BEGIN_MESSAGE_MAP(CBoxGdrSweepDlg, CDialog)
+   ON_BN_CLICKED(IDC_SWEEP_COUNT, &CBoxGdrSweepDlg::OnCount)
+END_MESSAGE_MAP()
+
+// CBoxGdrSweepDlg message handlers
+
+BOOL CBoxGdrSweepDlg::OnInitDialog()
+{
+   m_Grid.SubclassDlgItem(IDC_SWEEP_DIMENSIONS,this);
+   m_Grid.CustomInit();
+
+   CDialog::OnInitDialog();
+
+   return TRUE;  // return TRUE unless you set the focus to a control
+   // EXCEPTION: OCX Property Pages should return FALSE
+}
+
+void CBoxGdrSweepDlg::OnCount()
+{
+   m_Grid.GetSweep(&m_Sweep);
+   UpdateCombinationCount();
+}
+
+void CBoxGdrSweepDlg::UpdateCombinationCount()
+{
+   CString strCount;
+   IndexType nCombinations = CBoxGdrSweep::GetCombinationCount(m_Sweep);
+   if ( CBoxGdrSweep::MaxCombinations < nCombinations )
+      strCount.Format(_T("More than %Iu combinations"),CBoxGdrSweep::MaxCombinations);
+   else
+      strCount.Format(_T("%Iu combinations"),nCombinations);
+   GetDlgItem(IDC_SWEEP_COUNT_LABEL)->SetWindowText(strCount);
+}
@@ -0,0 +1,273 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+// BoxGdrSweepGrid.cpp : implementation file
+//
+
+#include "stdafx.h"
+#include "BoxGdrSweepGrid.h"
+#include <EAF\EAFUtilities.h>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+static LPCTSTR gs_strParameters[BOXGDRSWEEP::nParameters] = {_T("D"),_T("T"),_T("No. Webs"),_T("W"),_T("ST"),_T("SB"),_T("FT"),_T("FB"),_T("EL"),_T("CL"),_T("BL"),_T("ER"),_T("CR"),_T("BR")};
+
+/////////////////////////////////////////////////////////////////////////////
+// CBoxGdrSweepGrid
+
+CBoxGdrSweepGrid::CBoxGdrSweepGrid()
+{
+}
+
+CBoxGdrSweepGrid::~CBoxGdrSweepGrid()
+{
+}
+
+BEGIN_MESSAGE_MAP(CBoxGdrSweepGrid, CGXGridWnd)
+END_MESSAGE_MAP()
+
+void CBoxGdrSweepGrid::CustomInit()
+{
+   // Initialize the grid. For CWnd based grids this call is //
+   // essential. For view based grids this initialization is done
+   // in OnInitialUpdate.
+	Initialize( );
+
+	GetParam( )->EnableUndo(FALSE);
+
+   const ROWCOL num_rows = BOXGDRSWEEP::nParameters;
+   const ROWCOL num_cols = 3;
+
+	SetRowCount(num_rows);
+	SetColCount(num_cols);
+
+		// Turn off selecting whole columns when clicking on a column header
+	GetParam()->EnableSelection((WORD) (GX_SELFULL & ~GX_SELCOL & ~GX_SELTABLE));
+
+   // disable left side
+	SetStyleRange(CGXRange(0,0,num_rows,0), CGXStyle()
+			.SetControl(GX_IDS_CTRL_HEADER)
+			.SetEnabled(FALSE)          // disables usage as current cell
+		);
+
+	SetStyleRange(CGXRange(1,1,num_rows,num_cols), CGXStyle()
+      .SetHorizontalAlignment(DT_RIGHT)
+		);
+
+   UpdateColumnHeaders();
+
+   // make it so that text fits correctly in header row
+	ResizeRowHeightsToFit(CGXRange(0,0,0,num_cols));
+	ResizeColWidthsToFit(CGXRange(0,0,num_rows,0));
+
+   // don't allow users to resize grids
+   GetParam( )->EnableTrackColWidth(0);
+   GetParam( )->EnableTrackRowHeight(0);
+
+	SetFocus();
+
+	GetParam( )->EnableUndo(TRUE);
+}
+
+void CBoxGdrSweepGrid::UpdateColumnHeaders()
+{
+   ROWCOL col = 0;
+	SetStyleRange(CGXRange(0,col++), CGXStyle()
+         .SetWrapText(TRUE)
+         .SetHorizontalAlignment(DT_CENTER)
+         .SetVerticalAlignment(DT_VCENTER)
+			.SetEnabled(FALSE)          // disables usage as current cell
+			.SetValue(_T("Dimension"))
+		);
+
+	SetStyleRange(CGXRange(0,col++), CGXStyle()
+         .SetWrapText(TRUE)
+         .SetHorizontalAlignment(DT_CENTER)
+         .SetVerticalAlignment(DT_VCENTER)
+			.SetEnabled(FALSE)          // disables usage as current cell
+			.SetValue(_T("Start"))
+		);
+
+	SetStyleRange(CGXRange(0,col++), CGXStyle()
+         .SetWrapText(TRUE)
+         .SetHorizontalAlignment(DT_CENTER)
+         .SetVerticalAlignment(DT_VCENTER)
+			.SetEnabled(FALSE)          // disables usage as current cell
+			.SetValue(_T("End"))
+		);
+
+	SetStyleRange(CGXRange(0,col++), CGXStyle()
+         .SetWrapText(TRUE)
+         .SetHorizontalAlignment(DT_CENTER)
+         .SetVerticalAlignment(DT_VCENTER)
+			.SetEnabled(FALSE)          // disables usage as current cell
+			.SetValue(_T("No. Values"))
+		);
+
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      CString strLabel;
+      if ( i == BOXGDRSWEEP::N )
+      {
+         strLabel = gs_strParameters[i];
+      }
+      else
+      {
+         strLabel.Format(_T("%s (%s)"),gs_strParameters[i],GetLengthUnit((BOXGDRSWEEP::Parameter)i).UnitOfMeasure.UnitTag().c_str());
+      }
+
+      SetStyleRange(CGXRange(i+1,0), CGXStyle()
+         .SetHorizontalAlignment(DT_LEFT)
+			.SetValue(strLabel)
+		);
+   }
+}
+
+const unitmgtLengthData& CBoxGdrSweepGrid::GetLengthUnit(BOXGDRSWEEP::Parameter parameter)
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   switch(parameter)
+   {
+   case BOXGDRSWEEP::D:
+   case BOXGDRSWEEP::W:
+   case BOXGDRSWEEP::EL:
+   case BOXGDRSWEEP::BL:
+   case BOXGDRSWEEP::ER:
+   case BOXGDRSWEEP::BR:
+      return pDispUnits->SpanLength;
+
+   default:
+      return pDispUnits->ComponentDim;
+   }
+}
+
+void CBoxGdrSweepGrid::FillGrid(const BOXGDRSWEEP& sweep)
+{
+   GetParam()->EnableUndo(FALSE);
+
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      ROWCOL row = i+1;
+      const BOXGDRSWEEPRANGE& range = sweep.Range[i];
+      if ( i == BOXGDRSWEEP::N )
+      {
+         SetValueRange(CGXRange(row,1),(UINT)range.Start);
+         SetValueRange(CGXRange(row,2),(UINT)range.End);
+      }
+      else
+      {
+         const unitmgtLengthData& unit = GetLengthUnit((BOXGDRSWEEP::Parameter)i);
+         SetValueRange(CGXRange(row,1),::ConvertFromSysUnits(range.Start,unit.UnitOfMeasure));
+         SetValueRange(CGXRange(row,2),::ConvertFromSysUnits(range.End,unit.UnitOfMeasure));
+      }
+      SetValueRange(CGXRange(row,3),(UINT)range.nValues);
+   }
+
+   GetParam()->EnableUndo(TRUE);
+}
+
+void CBoxGdrSweepGrid::GetSweep(BOXGDRSWEEP* pSweep)
+{
+   for ( int i = 0; i < BOXGDRSWEEP::nParameters; i++ )
+   {
+      ROWCOL row = i+1;
+      BOXGDRSWEEPRANGE& range = pSweep->Range[i];
+
+      Float64 start, end;
+      sysTokenizer::ParseDouble(GetCellValue(row,1),&start);
+      sysTokenizer::ParseDouble(GetCellValue(row,2),&end);
+      if ( i != BOXGDRSWEEP::N )
+      {
+         const unitmgtLengthData& unit = GetLengthUnit((BOXGDRSWEEP::Parameter)i);
+         start = ::ConvertToSysUnits(start,unit.UnitOfMeasure);
+         end   = ::ConvertToSysUnits(end,  unit.UnitOfMeasure);
+      }
+      range.Start = start;
+      range.End = end;
+
+      long nValues;
+      sysTokenizer::ParseLong(GetCellValue(row,3),&nValues);
+      range.nValues = (IndexType)Max(nValues,1L);
+   }
+}
+
+CString CBoxGdrSweepGrid::GetCellValue(ROWCOL nRow, ROWCOL nCol)
+{
+    if (IsCurrentCell(nRow, nCol) && IsActiveCurrentCell())
+    {
+        CString s;
+        CGXControl* pControl = GetControl(nRow, nCol);
+        pControl->GetValue(s);
+        return s;
+  }
+    else
+        return GetValueRowCol(nRow, nCol);
+}
+
+// validate input
+BOOL CBoxGdrSweepGrid::OnValidateCell(ROWCOL nRow, ROWCOL nCol)
+{
+	CString s;
+	CGXControl* pControl = GetControl(nRow, nCol);
+	pControl->GetCurrentText(s);
+
+   if ( s.IsEmpty() )
+   {
+      SetWarningText(_T("Value must be a number"));
+      return FALSE;
+   }
+
+   if ( nCol == 3 || nRow == BOXGDRSWEEP::N+1 )
+   {
+      long l;
+      if ( !sysTokenizer::ParseLong(s,&l) || l < 1 )
+      {
+         SetWarningText(_T("Value must be a positive integer"));
+         return FALSE;
+      }
+   }
+   else
+   {
+      Float64 d;
+      if ( !sysTokenizer::ParseDouble(s,&d) )
+      {
+         SetWarningText(_T("Value must be a number"));
+         return FALSE;
+      }
+   }
+
+	return CGXGridWnd::OnValidateCell(nRow, nCol);
+}
+
+#if defined _DEBUG
+void CBoxGdrSweepGrid::AssertValid() const
+{
+   AFX_MANAGE_STATE(AfxGetStaticModuleState());
+   CGXGridWnd::AssertValid();
+}
+#endif
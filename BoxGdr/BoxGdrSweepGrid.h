@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// BoxGdrSweepGrid.h : header file
+//
+#include "BoxGdrSweep.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// CBoxGdrSweepGrid window
+//
+// One row per box girder dimension with the start value, end value, and number of values
+// of the dimension in the design space
+
+class CBoxGdrSweepGrid : public CGXGridWnd
+{
+// Construction
+public:
+	CBoxGdrSweepGrid();
+
+// Implementation
+public:
+	virtual ~CBoxGdrSweepGrid();
+
+protected:
+	DECLARE_MESSAGE_MAP()
+
+   // virtual overrides for grid
+   virtual BOOL OnValidateCell(ROWCOL nRow, ROWCOL nCol) override;
+
+   void UpdateColumnHeaders();
+
+   // get a cell value whether is is selected or not
+   CString GetCellValue(ROWCOL nRow, ROWCOL nCol);
+
+   const unitmgtLengthData& GetLengthUnit(BOXGDRSWEEP::Parameter parameter);
+
+public:
+   // custom stuff for grid
+   void CustomInit();
+
+   void FillGrid(const BOXGDRSWEEP& sweep);
+   void GetSweep(BOXGDRSWEEP* pSweep);
+
+#if defined _DEBUG
+   void AssertValid() const;
+#endif
+};
@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "CurvelAlignment.h"
+#include "..\BEToolboxUtilities.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+namespace
+{
+   // Returns an angle in the range [0,2PI)
+   Float64 NormalizeBearing(Float64 bearing)
+   {
+      bearing = fmod(bearing,2*M_PI);
+      return (bearing < 0 ? bearing + 2*M_PI : bearing);
+   }
+
+   // Returns an angle in the range (-PI,PI]
+   Float64 NormalizeDeflection(Float64 angle)
+   {
+      angle = NormalizeBearing(angle);
+      return (M_PI < angle ? angle - 2*M_PI : angle);
+   }
+}
+
+CCurvelAlignment::CCurvelAlignment()
+{
+   Init(0.0,std::vector<HorizontalCurve>());
+}
+
+void CCurvelAlignment::Init(Float64 direction,const std::vector<HorizontalCurve>& curves)
+{
+   m_StartStation.clear();
+   m_StartX.clear();
+   m_StartY.clear();
+   m_StartBearing.clear();
+   m_Curvature.clear();
+   m_Curves.clear();
+
+   Float64 bearing = NormalizeBearing(direction);
+   if ( curves.empty() )
+   {
+      AddSegment(0.0,0.0,0.0,bearing,0.0);
+      return;
+   }
+
+   // Walk the curves from PI to PI. station, x, y is the current location on the back tangent of the next curve
+   Float64 station = curves.front().PIStation;
+   Float64 x = 0;
+   Float64 y = 0;
+   for ( const auto& curve : curves )
+   {
+      Float64 dist = curve.PIStation - station;
+      Float64 piX = x + dist*cos(bearing);
+      Float64 piY = y + dist*sin(bearing);
+
+      Float64 delta = NormalizeDeflection(curve.FwdTangent - bearing);
+      Float64 radius = fabs(curve.Radius);
+      bool bAnglePoint = (IsZero(radius) || IsZero(delta));
+      Float64 T = (bAnglePoint ? 0.0 : radius*tan(fabs(delta)/2));
+
+      Float64 tsStation = curve.PIStation - T;
+      Float64 tsX = piX - T*cos(bearing);
+      Float64 tsY = piY - T*sin(bearing);
+
+      if ( m_StartStation.empty() )
+      {
+         // the first tangent extends back from the first curve
+         AddSegment(tsStation,tsX,tsY,bearing,0.0);
+      }
+      else
+      {
+         ATLASSERT(station < tsStation || IsEqual(station,tsStation)); // curves can't overlap
+         if ( station < tsStation && !IsEqual(station,tsStation) )
+         {
+            AddSegment(station,x,y,bearing,0.0);
+         }
+      }
+
+      Float64 fwdTangent = NormalizeBearing(bearing + delta);
+
+      CURVE c;
+      c.TSStation = tsStation;
+      c.PIX = piX;
+      c.PIY = piY;
+      c.BkTangent = bearing;
+      c.FwdTangent = fwdTangent;
+      if ( bAnglePoint )
+      {
+         c.STStation = curve.PIStation;
+         c.Radius = 0;
+
+         station = curve.PIStation;
+         x = piX;
+         y = piY;
+      }
+      else
+      {
+         // counter-clockwise curves (positive delta) are to the left
+         c.STStation = tsStation + radius*fabs(delta);
+         c.Radius = (0 < delta ? -radius : radius);
+         AddSegment(tsStation,tsX,tsY,bearing,(0 < delta ? 1.0 : -1.0)/radius);
+
+         station = c.STStation;
+         x = piX + T*cos(fwdTangent);
+         y = piY + T*sin(fwdTangent);
+      }
+      m_Curves.push_back(c);
+
+      bearing = fwdTangent;
+   }
+
+   // the last tangent extends forward from the last curve
+   AddSegment(station,x,y,bearing,0.0);
+}
+
+IndexType CCurvelAlignment::GetCurveCount() const
+{
+   return m_Curves.size();
+}
+
+void CCurvelAlignment::GetCurvePoints(IndexType curveIdx,Float64* pTSStation,Float64* pSTStation,Float64* pPIX,Float64* pPIY) const
+{
+   const CURVE& curve = m_Curves[curveIdx];
+   *pTSStation = curve.TSStation;
+   *pSTStation = curve.STStation;
+   *pPIX = curve.PIX;
+   *pPIY = curve.PIY;
+}
+
+void CCurvelAlignment::GetCurveTangents(IndexType curveIdx,Float64* pBkTangent,Float64* pFwdTangent) const
+{
+   const CURVE& curve = m_Curves[curveIdx];
+   *pBkTangent = curve.BkTangent;
+   *pFwdTangent = curve.FwdTangent;
+}
+
+Float64 CCurvelAlignment::GetCurveRadius(IndexType curveIdx) const
+{
+   return m_Curves[curveIdx].Radius;
+}
+
+void CCurvelAlignment::GetPoint(Float64 station,Float64* pX,Float64* pY) const
+{
+   Evaluate(1,&station,pX,pY,nullptr,nullptr);
+}
+
+Float64 CCurvelAlignment::GetBearing(Float64 station) const
+{
+   Float64 bearing;
+   Evaluate(1,&station,nullptr,nullptr,&bearing,nullptr);
+   return bearing;
+}
+
+Float64 CCurvelAlignment::GetRadius(Float64 station) const
+{
+   Float64 radius;
+   Evaluate(1,&station,nullptr,nullptr,nullptr,&radius);
+   return radius;
+}
+
+void CCurvelAlignment::Evaluate(IndexType nStations,const Float64* pStation,Float64* pX,Float64* pY,Float64* pBearing,Float64* pRadius) const
+{
+   // d is the distance along the segment from its start. On a curve, the bearing changes by
+   // curvature*d and the point is found by integrating the bearing in closed form.
+   IndexType segmentIdx = 0;
+   for ( IndexType i = 0; i < nStations; i++ )
+   {
+      segmentIdx = FindSegment(m_StartStation,pStation[i],segmentIdx);
+      Float64 d = pStation[i] - m_StartStation[segmentIdx];
+      Float64 k = m_Curvature[segmentIdx];
+      Float64 bearing0 = m_StartBearing[segmentIdx];
+      Float64 bearing = bearing0 + k*d;
+
+      if ( pX || pY )
+      {
+         Float64 dx, dy;
+         if ( IsZero(k) )
+         {
+            dx = d*cos(bearing0);
+            dy = d*sin(bearing0);
+         }
+         else
+         {
+            dx =  (sin(bearing) - sin(bearing0))/k;
+            dy = -(cos(bearing) - cos(bearing0))/k;
+         }
+
+         if ( pX )
+         {
+            pX[i] = m_StartX[segmentIdx] + dx;
+         }
+
+         if ( pY )
+         {
+            pY[i] = m_StartY[segmentIdx] + dy;
+         }
+      }
+
+      if ( pBearing )
+      {
+         pBearing[i] = NormalizeBearing(bearing);
+      }
+
+      if ( pRadius )
+      {
+         pRadius[i] = (IsZero(k) ? 0.0 : -1.0/k);
+      }
+   }
+}
+
+void CCurvelAlignment::ProjectPoint(Float64 x,Float64 y,Float64* pStation,Float64* pOffset) const
+{
+   // The point is projected onto each segment in closed form and the nearest projection is used.
+   // The first and last segments extend indefinitely so their projections are not limited.
+   const IndexType nSegments = m_StartStation.size();
+   Float64 minDistance = Float64_Max;
+   for ( IndexType segmentIdx = 0; segmentIdx < nSegments; segmentIdx++ )
+   {
+      Float64 x0 = m_StartX[segmentIdx];
+      Float64 y0 = m_StartY[segmentIdx];
+      Float64 bearing0 = m_StartBearing[segmentIdx];
+      Float64 k = m_Curvature[segmentIdx];
+      Float64 length = (segmentIdx == nSegments-1 ? Float64_Max : m_StartStation[segmentIdx+1] - m_StartStation[segmentIdx]);
+      Float64 dMin = (segmentIdx == 0 ? -Float64_Max : 0.0);
+
+      Float64 d, offset;
+      if ( IsZero(k) )
+      {
+         Float64 ux = cos(bearing0);
+         Float64 uy = sin(bearing0);
+         d = (x - x0)*ux + (y - y0)*uy;
+         offset = (x - x0)*uy - (y - y0)*ux;
+      }
+      else
+      {
+         // angle swept from the start of the arc to the point, measured in the direction of travel
+         // and centered on the middle of the arc
+         Float64 radius = 1/fabs(k);
+         Float64 cx = x0 - sin(bearing0)/k;
+         Float64 cy = y0 + cos(bearing0)/k;
+         Float64 sweep = fabs(k)*length;
+         Float64 angle = (0 < k ? 1 : -1)*(atan2(y - cy,x - cx) - atan2(y0 - cy,x0 - cx));
+         angle = fmod(angle - sweep/2 + M_PI,2*M_PI);
+         angle = (angle < 0 ? angle + 2*M_PI : angle) - M_PI + sweep/2;
+         d = angle*radius;
+         offset = (0 < k ? 1 : -1)*(sqrt((x - cx)*(x - cx) + (y - cy)*(y - cy)) - radius);
+      }
+
+      Float64 distance = fabs(offset);
+      if ( d < dMin || length < d )
+      {
+         // the point projects beyond the segment, use the nearest end
+         d = (d < dMin ? dMin : length);
+         Float64 station = m_StartStation[segmentIdx] + d;
+         Float64 xEnd, yEnd;
+         Evaluate(1,&station,&xEnd,&yEnd,nullptr,nullptr);
+         distance = sqrt((x - xEnd)*(x - xEnd) + (y - yEnd)*(y - yEnd));
+         offset = (offset < 0 ? -distance : distance);
+      }
+
+      if ( distance < minDistance )
+      {
+         minDistance = distance;
+         *pStation = m_StartStation[segmentIdx] + d;
+         *pOffset = offset;
+      }
+   }
+}
+
+void CCurvelAlignment::AddSegment(Float64 station,Float64 x,Float64 y,Float64 bearing,Float64 curvature)
+{
+   ATLASSERT(m_StartStation.empty() || m_StartStation.back() <= station);
+   m_StartStation.push_back(station);
+   m_StartX.push_back(x);
+   m_StartY.push_back(y);
+   m_StartBearing.push_back(bearing);
+   m_Curvature.push_back(curvature);
+}
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Native model of the Curvel horizontal alignment.
+//
+// The alignment is a sequence of tangents and circular curves defined by the bearing of the back tangent
+// of the first curve and the PI station, forward tangent bearing, and radius of each curve. Bearings are
+// in radians measured counter-clockwise from east. Coordinates are relative to the PI of the first curve.
+//
+// The alignment is indexed by the start station of each tangent and curve so a station is evaluated with
+// a binary search of the segment index and closed form math. When the stations in a batch are sorted, the
+// search starts with the segment of the previous station so the segments are walked in order.
+class CCurvelAlignment
+{
+public:
+   CCurvelAlignment();
+
+   void Init(Float64 direction,const std::vector<HorizontalCurve>& curves);
+
+   IndexType GetCurveCount() const;
+
+   // Key points of a curve. The TS and ST of an angle point are at the PI.
+   void GetCurvePoints(IndexType curveIdx,Float64* pTSStation,Float64* pSTStation,Float64* pPIX,Float64* pPIY) const;
+   void GetCurveTangents(IndexType curveIdx,Float64* pBkTangent,Float64* pFwdTangent) const;
+
+   // Radius of a curve using the Curvel sign convention, positive for curves to the right and negative
+   // for curves to the left. The radius of an angle point is zero.
+   Float64 GetCurveRadius(IndexType curveIdx) const;
+
+   // Evaluates the alignment at a single station. The radius is zero on tangents.
+   void GetPoint(Float64 station,Float64* pX,Float64* pY) const;
+   Float64 GetBearing(Float64 station) const;
+   Float64 GetRadius(Float64 station) const;
+
+   // Evaluates the alignment at nStations stations. Any of the output arrays may be nullptr.
+   void Evaluate(IndexType nStations,const Float64* pStation,Float64* pX,Float64* pY,Float64* pBearing,Float64* pRadius) const;
+
+   // Projects a point onto the alignment. The offset is positive to the right of the alignment.
+   void ProjectPoint(Float64 x,Float64 y,Float64* pStation,Float64* pOffset) const;
+
+private:
+   // Tangents and curves, sorted by start station. The start stations are the segment index.
+   std::vector<Float64> m_StartStation;
+   std::vector<Float64> m_StartX;
+   std::vector<Float64> m_StartY;
+   std::vector<Float64> m_StartBearing;
+   std::vector<Float64> m_Curvature; // positive for curves to the left, zero for tangents
+
+   struct CURVE
+   {
+      Float64 TSStation, STStation;
+      Float64 PIX, PIY;
+      Float64 BkTangent, FwdTangent;
+      Float64 Radius; // Curvel sign convention
+   };
+   std::vector<CURVE> m_Curves;
+
+   void AddSegment(Float64 station,Float64 x,Float64 y,Float64 bearing,Float64 curvature);
+};
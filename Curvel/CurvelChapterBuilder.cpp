@@ -24,7 +24,6 @@
 #include "CurvelChapterBuilder.h"
 #include "CurvelReportSpecification.h"
 #include "..\BEToolboxUtilities.h"
-#include <Math\QuadraticSolver.h>
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -37,6 +36,8 @@ static char THIS_FILE[] = __FILE__;
 CCurvelChapterBuilder::CCurvelChapterBuilder(CCurvelDoc* pDoc)
 {
    m_pDoc = pDoc;
+   m_ModelRevision = 0;
+   m_bHorzAlignment = false;
 
    m_SkewAngle.CoCreateInstance(CLSID_Angle);
 
@@ -94,15 +95,94 @@ rptChapter* CCurvelChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
 
    bool bCorrectForSuperelevation = pTheRptSpec->CorrectForSuperelevation();
 
-   *pPara << _T("PVI Station = ") << rptRcStation(pviStation,&pDispUnits->StationFormat);
-   *pPara << _T(" ");
-   *pPara << _T("PVI Elevation = ") << alignment.SetValue(pviElevation) << rptNewLine;
+   IndexType nVerticalCurves = m_Evaluator.GetVerticalCurveCount();
+   if ( nVerticalCurves == 1 )
+   {
+      *pPara << _T("PVI Station = ") << rptRcStation(pviStation,&pDispUnits->StationFormat);
+      *pPara << _T(" ");
+      *pPara << _T("PVI Elevation = ") << alignment.SetValue(pviElevation) << rptNewLine;
+
+      *pPara << _T("Length = ") << alignment.SetValue(length);
+      *pPara << _T(" ");
+      *pPara << _T("g1 = ") << scalar.SetValue(g1*100) << _T("%");
+      *pPara << _T(" ");
+      *pPara << _T("g2 = ") << scalar.SetValue(g2*100) << _T("%") << rptNewLine;
+   }
+   else
+   {
+      rptRcTable* pTable = rptStyleManager::CreateDefaultTable(6);
+      *pPara << pTable << rptNewLine;
+
+      ColumnIndexType col = 0;
+      (*pTable)(0,col++) << _T("Curve");
+      (*pTable)(0,col++) << _T("PVI Station");
+      (*pTable)(0,col++) << COLHDR(_T("PVI Elevation"),rptLengthUnitTag,pDispUnits->AlignmentLength);
+      (*pTable)(0,col++) << COLHDR(_T("Length"),rptLengthUnitTag,pDispUnits->AlignmentLength);
+      (*pTable)(0,col++) << _T("g1") << rptNewLine << _T("(%)");
+      (*pTable)(0,col++) << _T("g2") << rptNewLine << _T("(%)");
+
+      alignment.ShowUnitTag(false);
+      RowIndexType row = pTable->GetNumberOfHeaderRows();
+      for ( IndexType curveIdx = 0; curveIdx < nVerticalCurves; curveIdx++, row++ )
+      {
+         Float64 vcg1,vcg2,vcPVIStation,vcPVIElevation,vcLength;
+         m_Evaluator.GetVerticalCurve(curveIdx,&vcg1,&vcg2,&vcPVIStation,&vcPVIElevation,&vcLength);
+
+         col = 0;
+         (*pTable)(row,col++) << (Uint32)(curveIdx+1);
+         (*pTable)(row,col++) << rptRcStation(vcPVIStation,&pDispUnits->StationFormat);
+         (*pTable)(row,col++) << alignment.SetValue(vcPVIElevation);
+         (*pTable)(row,col++) << alignment.SetValue(vcLength);
+         (*pTable)(row,col++) << scalar.SetValue(vcg1*100);
+         (*pTable)(row,col++) << scalar.SetValue(vcg2*100);
+      }
+      alignment.ShowUnitTag(true);
+   }
 
-   *pPara << _T("Length = ") << alignment.SetValue(length);
-   *pPara << _T(" ");
-   *pPara << _T("g1 = ") << scalar.SetValue(g1*100) << _T("%");
-   *pPara << _T(" ");
-   *pPara << _T("g2 = ") << scalar.SetValue(g2*100) << _T("%") << rptNewLine;
+   if ( m_bHorzAlignment && 0 < m_HorzAlignment.GetCurveCount() )
+   {
+      pPara = new rptParagraph(rptStyleManager::GetHeadingStyle());
+      (*pChapter) << pPara;
+      *pPara << _T("Horizontal Alignment");
+
+      pPara = new rptParagraph;
+      (*pChapter) << pPara;
+
+      rptRcTable* pTable = rptStyleManager::CreateDefaultTable(5);
+      *pPara << pTable << rptNewLine;
+
+      ColumnIndexType col = 0;
+      (*pTable)(0,col++) << _T("Curve");
+      (*pTable)(0,col++) << _T("PI Station");
+      (*pTable)(0,col++) << COLHDR(_T("Radius"),rptLengthUnitTag,pDispUnits->AlignmentLength);
+      (*pTable)(0,col++) << _T("TS Station");
+      (*pTable)(0,col++) << _T("ST Station");
+
+      const std::vector<HorizontalCurve>& horzCurves(pTheRptSpec->GetHorizontalCurves());
+      alignment.ShowUnitTag(false);
+      RowIndexType row = pTable->GetNumberOfHeaderRows();
+      for ( IndexType curveIdx = 0; curveIdx < m_HorzAlignment.GetCurveCount(); curveIdx++, row++ )
+      {
+         Float64 tsStation, stStation, piX, piY;
+         m_HorzAlignment.GetCurvePoints(curveIdx,&tsStation,&stStation,&piX,&piY);
+         Float64 radius = m_HorzAlignment.GetCurveRadius(curveIdx);
+
+         col = 0;
+         (*pTable)(row,col++) << (Uint32)(curveIdx+1);
+         (*pTable)(row,col++) << rptRcStation(horzCurves[curveIdx].PIStation,&pDispUnits->StationFormat);
+         if ( IsZero(radius) )
+         {
+            (*pTable)(row,col++) << _T("Angle Point");
+         }
+         else
+         {
+            (*pTable)(row,col++) << alignment.SetValue(fabs(radius)) << (radius < 0 ? _T(" L") : _T(" R"));
+         }
+         (*pTable)(row,col++) << rptRcStation(tsStation,&pDispUnits->StationFormat);
+         (*pTable)(row,col++) << rptRcStation(stStation,&pDispUnits->StationFormat);
+      }
+      alignment.ShowUnitTag(true);
+   }
 
    if ( pTheRptSpec->CorrectForSuperelevation() )
    {
@@ -161,168 +241,61 @@ rptChapter* CCurvelChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
 
    RowIndexType row = pTable->GetNumberOfHeaderRows();
 
-   // Report BVC
-   CComPtr<IProfileElement> profileElement;
-   m_Profile->get_Item(0,&profileElement);
-   CComPtr<IUnknown> pUnk;
-   profileElement->get_Value(&pUnk);
-   CComQIPtr<IVertCurve> vc(pUnk);
-   CComPtr<IProfilePoint> bvc;
-   vc->get_BVC(&bvc);
-   CComPtr<IStation> bvcStation;
-   bvc->get_Station(&bvcStation);
-   Float64 bvcStationValue;
-   bvcStation->get_Value(&bvcStationValue);
-   Float64 bvcElevation;
-   bvc->get_Elevation(&bvcElevation);
-
-   col = 0;
-   (*pTable)(row,col++) << _T("BVC");
-   (*pTable)(row,col++) << rptRcStation(bvcStationValue,&pDispUnits->StationFormat);
-
-   (*pTable)(row,col++) << alignment.SetValue(bvcElevation);
-
-   Float64 grade;
-   m_Profile->Grade(CComVariant(bvcStation),&grade);
-   (*pTable)(row,col++) << scalar.SetValue(grade*100);
-
-   if ( bCorrectForSuperelevation )
+   // Report key points on the vertical curves
+   CURVELPROFILEPOINTS keyPoints;
+   keyPoints.Reserve(4*nVerticalCurves);
+   for ( IndexType curveIdx = 0; curveIdx < nVerticalCurves; curveIdx++ )
    {
-      Float64 offset = 0.0; // elevations computed at this offset from the alignment
-      (*pTable)(row,col++) << RPT_OFFSET(offset,alignment);
-
-      Float64 elevation;
-      m_Profile->Elevation(CComVariant(bvcStation),offset,&elevation);
-      (*pTable)(row,col++) << alignment.SetValue(elevation);
-
-      Float64 slope;
-      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(bvcStation),1,&slope);
-      (*pTable)(row,col++) << scalar.SetValue(-slope);
-
-      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(bvcStation),2,&slope);
-      (*pTable)(row,col++) << scalar.SetValue(slope);
+      Float64 keyStation, keyElevation;
+      m_Evaluator.GetBVC(curveIdx,&keyStation,&keyElevation);
+      keyPoints.Add(keyStation,0.0); // elevations computed at this offset from the alignment
+      m_Evaluator.GetEVC(curveIdx,&keyStation,&keyElevation);
+      keyPoints.Add(keyStation,0.0);
+      m_Evaluator.GetLowPoint(curveIdx,&keyStation,&keyElevation);
+      keyPoints.Add(keyStation,0.0);
+      m_Evaluator.GetHighPoint(curveIdx,&keyStation,&keyElevation);
+      keyPoints.Add(keyStation,0.0);
    }
+   m_Evaluator.Evaluate(&keyPoints);
 
-   row++;
-
-
-   // Report EVC
-   CComPtr<IProfilePoint> evc;
-   vc->get_EVC(&evc);
-   CComPtr<IStation> evcStation;
-   evc->get_Station(&evcStation);
-   Float64 evcStationValue;
-   evcStation->get_Value(&evcStationValue);
-   Float64 evcElevation;
-   evc->get_Elevation(&evcElevation);
-
-   col = 0;
-   (*pTable)(row,col++) << _T("EVC");
-   (*pTable)(row,col++) << rptRcStation(evcStationValue,&pDispUnits->StationFormat);
-
-   (*pTable)(row,col++) << alignment.SetValue(evcElevation);
-
-   m_Profile->Grade(CComVariant(evcStation),&grade);
-   (*pTable)(row,col++) << scalar.SetValue(grade*100);
-
-   if ( bCorrectForSuperelevation )
-   {
-      Float64 offset = 0.0; // elevations computed at this offset from the alignment
-      (*pTable)(row,col++) << RPT_OFFSET(offset,alignment);
-
-      Float64 elevation;
-      m_Profile->Elevation(CComVariant(evcStation),offset,&elevation);
-      (*pTable)(row,col++) << alignment.SetValue(elevation);
-
-      Float64 slope;
-      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(evcStation),1,&slope);
-      (*pTable)(row,col++) << scalar.SetValue(-slope);
-
-      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(evcStation),2,&slope);
-      (*pTable)(row,col++) << scalar.SetValue(slope);
-   }
-
-
-   row++;
-
-   // Report Low point
-   CComPtr<IProfilePoint> lowPt;
-   vc->get_LowPoint(&lowPt);
-   CComPtr<IStation> lpStation;
-   lowPt->get_Station(&lpStation);
-   Float64 lpStationValue;
-   lpStation->get_Value(&lpStationValue);
-   Float64 lpElevation;
-   lowPt->get_Elevation(&lpElevation);
-
-   col = 0;
-   (*pTable)(row,col++) << _T("Low");
-   (*pTable)(row,col++) << rptRcStation(lpStationValue,&pDispUnits->StationFormat);
-
-   (*pTable)(row,col++) << alignment.SetValue(lpElevation);
-
-   m_Profile->Grade(CComVariant(lpStation),&grade);
-   (*pTable)(row,col++) << scalar.SetValue(grade*100);
-
-   if ( bCorrectForSuperelevation )
-   {
-      Float64 offset = 0.0; // elevations computed at this offset from the alignment
-      (*pTable)(row,col++) << RPT_OFFSET(offset,alignment);
-
-      Float64 elevation;
-      m_Profile->Elevation(CComVariant(lpStation),offset,&elevation);
-      (*pTable)(row,col++) << alignment.SetValue(elevation);
-
-      Float64 slope;
-      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(lpStation),1,&slope);
-      (*pTable)(row,col++) << scalar.SetValue(-slope);
-
-      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(lpStation),2,&slope);
-      (*pTable)(row,col++) << scalar.SetValue(slope);
-   }
-
-   row++;
-
-   // Report Hight point
-   CComPtr<IProfilePoint> highPt;
-   vc->get_HighPoint(&highPt);
-   CComPtr<IStation> hpStation;
-   highPt->get_Station(&hpStation);
-   Float64 hpStationValue;
-   hpStation->get_Value(&hpStationValue);
-   Float64 hpElevation;
-   highPt->get_Elevation(&hpElevation);
-
-   col = 0;
-   (*pTable)(row,col++) << _T("High");
-   (*pTable)(row,col++) << rptRcStation(hpStationValue,&pDispUnits->StationFormat);
-
-   (*pTable)(row,col++) << alignment.SetValue(hpElevation);
-
-   m_Profile->Grade(CComVariant(hpStation),&grade);
-   (*pTable)(row,col++) << scalar.SetValue(grade*100);
+#if defined _DEBUG
+   AssertVerticalCurve();
+   AssertProfile(keyPoints);
+#endif
 
-   if ( bCorrectForSuperelevation )
+   LPCTSTR lpszKeyPoints[] = {_T("BVC"),_T("EVC"),_T("Low"),_T("High")};
+   for ( IndexType i = 0; i < keyPoints.GetCount(); i++, row++ )
    {
-      Float64 offset = 0.0; // elevations computed at this offset from the alignment
-      (*pTable)(row,col++) << RPT_OFFSET(offset,alignment);
-
-      Float64 elevation;
-      m_Profile->Elevation(CComVariant(hpStation),offset,&elevation);
-      (*pTable)(row,col++) << alignment.SetValue(elevation);
+      CString strKeyPoint(lpszKeyPoints[i%4]);
+      if ( 1 < nVerticalCurves )
+      {
+         strKeyPoint.AppendFormat(_T(" %d"),(int)(i/4+1));
+      }
 
-      Float64 slope;
-      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(hpStation),1,&slope);
-      (*pTable)(row,col++) << scalar.SetValue(-slope);
+      col = 0;
+      (*pTable)(row,col++) << strKeyPoint;
+      (*pTable)(row,col++) << rptRcStation(keyPoints.Station[i],&pDispUnits->StationFormat);
+      (*pTable)(row,col++) << alignment.SetValue(keyPoints.Elevation[i]);
+      (*pTable)(row,col++) << scalar.SetValue(keyPoints.Grade[i]*100);
 
-      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(hpStation),2,&slope);
-      (*pTable)(row,col++) << scalar.SetValue(slope);
+      if ( bCorrectForSuperelevation )
+      {
+         (*pTable)(row,col++) << RPT_OFFSET(keyPoints.Offset[i],alignment);
+         (*pTable)(row,col++) << alignment.SetValue(keyPoints.OffsetElevation[i]);
+         (*pTable)(row,col++) << scalar.SetValue(keyPoints.LeftSlope[i]);
+         (*pTable)(row,col++) << scalar.SetValue(keyPoints.RightSlope[i]);
+      }
    }
 
+   const std::vector<Uint32>& stationRevisions(pTheRptSpec->GetIndividualStationRevisions());
    const std::vector<IndividualStation>& stations(pTheRptSpec->GetIndividualStations());
+   const std::vector<Uint32>& rangeRevisions(pTheRptSpec->GetStationRangeRevisions());
    const std::vector<StationRange>& ranges(pTheRptSpec->GetStationRanges());
    if ( 0 < stations.size() + ranges.size() ) 
    {
+      UpdateIndividualStations(stations,stationRevisions);
+      UpdateStationRanges(ranges,rangeRevisions);
+
       // report input stations
       pPara = new rptParagraph(rptStyleManager::GetHeadingStyle());
       (*pChapter) << pPara;
@@ -349,79 +322,43 @@ rptChapter* CCurvelChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
 
       row = pTable->GetNumberOfHeaderRows();
 
-      std::vector<IndividualStation>::const_iterator iter(stations.begin());
-      std::vector<IndividualStation>::const_iterator end(stations.end());
-      for ( ; iter != end; iter++, row++ )
+      auto reportPoint = [&](RowIndexType r,const CURVELPROFILEPOINTS& points,IndexType idx)
       {
-         const IndividualStation& station(*iter);
-         col = 0;
-         (*pTable)(row,col++) << rptRcStation(station.Station,&pDispUnits->StationFormat);
-
-         Float64 elevation;
-         m_Profile->Elevation(CComVariant(station.Station),profileGradeOffset,&elevation);
-         (*pTable)(row,col++) << alignment.SetValue(elevation);
-
-         Float64 grade;
-         m_Profile->Grade(CComVariant(station.Station),&grade);
-         (*pTable)(row,col++) << scalar.SetValue(grade*100);
+         ColumnIndexType c = 0;
+         (*pTable)(r,c++) << rptRcStation(points.Station[idx],&pDispUnits->StationFormat);
+         (*pTable)(r,c++) << alignment.SetValue(points.Elevation[idx]);
+         (*pTable)(r,c++) << scalar.SetValue(points.Grade[idx]*100);
 
          if ( bCorrectForSuperelevation )
          {
-            (*pTable)(row,col++) << RPT_OFFSET(station.Offset,alignment);
-
-            m_Profile->Elevation(CComVariant(station.Station),station.Offset,&elevation);
-            (*pTable)(row,col++) << alignment.SetValue(elevation);
-
-            Float64 slope;
-            m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(station.Station),1,&slope);
-            (*pTable)(row,col++) << scalar.SetValue(-slope);
-
-            m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(station.Station),2,&slope);
-            (*pTable)(row,col++) << scalar.SetValue(slope);
+            (*pTable)(r,c++) << RPT_OFFSET(points.Offset[idx],alignment);
+            (*pTable)(r,c++) << alignment.SetValue(points.OffsetElevation[idx]);
+            (*pTable)(r,c++) << scalar.SetValue(points.LeftSlope[idx]);
+            (*pTable)(r,c++) << scalar.SetValue(points.RightSlope[idx]);
          }
+      };
+
+      for ( IndexType stationIdx = 0; stationIdx < stations.size(); stationIdx++, row++ )
+      {
+         reportPoint(row,m_IndividualStationPoints,stationIdx);
       }
 
-      std::vector<StationRange>::const_iterator srIter(ranges.begin());
-      std::vector<StationRange>::const_iterator srIterEnd(ranges.end());
-      for ( ; srIter != srIterEnd; srIter++, row++ )
+      for ( const auto& points : m_StationRangePoints )
       {
-         const StationRange& range(*srIter);
-         Float64 station = range.StartStation;
-         Float64 inc = (range.EndStation - range.StartStation)/range.nSpaces;
-         for ( IndexType i = 0; i <= range.nSpaces; i++, station += inc, row++ )
+         for ( IndexType pointIdx = 0; pointIdx < points.GetCount(); pointIdx++, row++ )
          {
-            col = 0;
-            (*pTable)(row,col++) << rptRcStation(station,&pDispUnits->StationFormat);
-
-            Float64 elevation;
-            m_Profile->Elevation(CComVariant(station),profileGradeOffset,&elevation);
-            (*pTable)(row,col++) << alignment.SetValue(elevation);
-
-            Float64 grade;
-            m_Profile->Grade(CComVariant(station),&grade);
-            (*pTable)(row,col++) << scalar.SetValue(grade*100);
-
-           if ( bCorrectForSuperelevation )
-            {
-               (*pTable)(row,col++) << RPT_OFFSET(range.Offset,alignment);
-
-               m_Profile->Elevation(CComVariant(station),range.Offset,&elevation);
-               (*pTable)(row,col++) << alignment.SetValue(elevation);
-
-               Float64 slope;
-               m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(station),1,&slope);
-               (*pTable)(row,col++) << scalar.SetValue(-slope);
-
-               m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(station),2,&slope);
-               (*pTable)(row,col++) << scalar.SetValue(slope);
-           }
+            reportPoint(row,points,pointIdx);
          }
+         row++;
       }
    }
 
+   const std::vector<Uint32>& skewLineRevisions(pTheRptSpec->GetSkewLineRevisions());
    const std::vector<SkewLine>& skewLines(pTheRptSpec->GetSkewLines());
    if ( 0 < skewLines.size() )
    {
+      UpdateSkewLines(skewLines,skewLineRevisions);
+
       pPara = new rptParagraph(rptStyleManager::GetHeadingStyle());
       (*pChapter) << pPara;
       *pPara << _T("Skew Line Elevations");
@@ -449,152 +386,368 @@ rptChapter* CCurvelChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
 
       row = pTable->GetNumberOfHeaderRows();
 
-      std::vector<SkewLine>::const_iterator skewIter(skewLines.begin());
-      std::vector<SkewLine>::const_iterator skewIterEnd(skewLines.end());
-      for ( ; skewIter != skewIterEnd; skewIter++, row++ )
+      for ( IndexType skewIdx = 0; skewIdx < skewLines.size(); skewIdx++, row++ )
       {
-         const SkewLine& skewLine(*skewIter);
-         UpdateAlignment(skewLine);
+         const SkewLine& skewLine(skewLines[skewIdx]);
+         const CURVELPROFILEPOINTS& points(m_SkewLineOffsetPoints);
          col = 0;
 
-         m_SkewAngle->FromString(CComBSTR(skewLine.strSkewAngle.c_str()));
-         Float64 skewAngleValue;
-         m_SkewAngle->get_Value(&skewAngleValue);
-
          CComBSTR bstrAngle;
-         m_AngleFormatter->Format(skewAngleValue,m_bstrAngleFormat,&bstrAngle);
+         m_AngleFormatter->Format(m_SkewLinePoints.SkewAngle[skewIdx],m_bstrAngleFormat,&bstrAngle);
          (*pTable)(row,col++) << bstrAngle;
 
-         (*pTable)(row,col++) << RPT_OFFSET(skewLine.Radius,alignment);
-
+         (*pTable)(row,col++) << RPT_OFFSET(m_SkewLinePoints.Radius[skewIdx],alignment);
          (*pTable)(row,col++) << RPT_OFFSET(skewLine.CrownOffset,alignment);
-
          (*pTable)(row,col++) << rptRcStation(skewLine.Station,&pDispUnits->StationFormat);
+         (*pTable)(row,col++) << RPT_OFFSET(m_SkewLinePoints.SkewDistance[skewIdx],alignment);
+         (*pTable)(row,col++) << rptRcStation(points.Station[skewIdx],&pDispUnits->StationFormat);
+         (*pTable)(row,col++) << alignment.SetValue(points.Elevation[skewIdx]);
+         (*pTable)(row,col++) << scalar.SetValue(points.Grade[skewIdx]*100);
+         (*pTable)(row,col++) << RPT_OFFSET(points.Offset[skewIdx],alignment);
+         (*pTable)(row,col++) << alignment.SetValue(points.OffsetElevation[skewIdx]);
+         (*pTable)(row,col++) << scalar.SetValue(points.LeftSlope[skewIdx]);
+         (*pTable)(row,col++) << scalar.SetValue(points.RightSlope[skewIdx]);
+      }
+   }
 
-         // Get the direction of the skew line
-         CComPtr<IDirection> direction;
-         m_Alignment->Normal(CComVariant(skewLine.Station),&direction);
-         direction->IncrementBy(CComVariant(m_SkewAngle));
+   return pChapter;
+}
 
-         Float64 skewDistance = skewLine.Offset;
+CChapterBuilder* CCurvelChapterBuilder::Clone() const
+{
+   return new CCurvelChapterBuilder(m_pDoc);
+}
 
-         if ( skewLine.OffsetType == SkewLine::RadialFromCrownLine )
-         {
-            if ( IsZero(skewLine.Radius) )
-            {
-               skewDistance = (skewLine.Offset - skewLine.CrownOffset)/cos(fabs(skewAngleValue));
-            }
-            else
-            {
-               // Using the law of cosines, compute the distance along the skew line
-               Float64 A,B,a;
-               A = skewLine.Radius - (skewLine.Offset - skewLine.CrownOffset);
-               B = skewLine.Radius;
-               a = M_PI - skewAngleValue;
-
-               Float64 k1 = 1.0;
-               Float64 k2 = -2*B*cos(a);
-               Float64 k3 = B*B - A*A;
-
-               mathQuadraticSolver qSolver(k1,k2,k3);
-               Float64 C1,C2;
-               int nRoots = qSolver.Solve(&C1,&C2);
-               ATLASSERT(nRoots == 2);
-               Float64 C = (skewLine.Radius < 0 ? C2 : C1);
-
-               skewDistance = -C;
-            }
-         }
+#if defined _DEBUG
+void CCurvelChapterBuilder::AssertVerticalCurve() const
+{
+   // the key points of the native vertical curves must match the COGO VertCurves
+   IndexType nCurves = m_Evaluator.GetVerticalCurveCount();
+   for ( IndexType curveIdx = 0; curveIdx < nCurves; curveIdx++ )
+   {
+      CComPtr<IProfileElement> profileElement;
+      m_Profile->get_Item((CollectionIndexType)curveIdx,&profileElement);
+      CComPtr<IUnknown> pUnk;
+      profileElement->get_Value(&pUnk);
+      CComQIPtr<IVertCurve> vc(pUnk);
+
+      CComPtr<IProfilePoint> keyPoints[4];
+      vc->get_BVC(&keyPoints[0]);
+      vc->get_EVC(&keyPoints[1]);
+      vc->get_LowPoint(&keyPoints[2]);
+      vc->get_HighPoint(&keyPoints[3]);
+
+      Float64 station[4], elevation[4];
+      m_Evaluator.GetBVC(curveIdx,&station[0],&elevation[0]);
+      m_Evaluator.GetEVC(curveIdx,&station[1],&elevation[1]);
+      m_Evaluator.GetLowPoint(curveIdx,&station[2],&elevation[2]);
+      m_Evaluator.GetHighPoint(curveIdx,&station[3],&elevation[3]);
+
+      for ( IndexType i = 0; i < 4; i++ )
+      {
+         CComPtr<IStation> objStation;
+         keyPoints[i]->get_Station(&objStation);
+         Float64 cogoStation;
+         objStation->get_Value(&cogoStation);
+         Float64 cogoElevation;
+         keyPoints[i]->get_Elevation(&cogoElevation);
+
+         // when the curve is flat, any point is the low/high point so only the elevations must match
+         ATLASSERT(IsEqual(elevation[i],cogoElevation));
+         ATLASSERT(1 < i || IsEqual(station[i],cogoStation));
+      }
+   }
+}
+
+void CCurvelChapterBuilder::AssertSkewLines(const std::vector<SkewLine>& skewLines,const std::vector<IndexType>& vSkewIdx,const CURVELSKEWLINES& skewLinePoints) const
+{
+   // the native offset points must match the offset points located on the COGO alignment.
+   // skewLinePoints are the points for the skew lines in vSkewIdx
+   IndexType nSkewLines = skewLinePoints.GetCount();
+   ATLASSERT(vSkewIdx.size() == nSkewLines);
+   for ( IndexType skewIdx = 0; skewIdx < nSkewLines; skewIdx++ )
+   {
+      const SkewLine& skewLine(skewLines[vSkewIdx[skewIdx]]);
+      if ( !m_bHorzAlignment )
+      {
+         UpdateAlignment(skewLine);
+      }
 
-         (*pTable)(row,col++) << RPT_OFFSET(skewDistance,alignment);
+      Float64 station = skewLinePoints.Station[skewIdx];
+      m_SkewAngle->FromString(CComBSTR(skewLine.strSkewAngle.c_str()));
 
-         // Locate the point at the end of the skewline
-         CComPtr<IPoint2d> offsetPoint;
-         m_Alignment->LocatePoint(CComVariant(skewLine.Station),omtAlongDirection,skewDistance,CComVariant(direction),&offsetPoint);
+      CComPtr<IDirection> direction;
+      m_Alignment->Normal(CComVariant(station),&direction);
+      direction->IncrementBy(CComVariant(m_SkewAngle));
 
-         // Get station and offset of offsetPoint
-         CComPtr<IStation> offsetStation;
-         Float64 offsetDistance;
-         m_Alignment->Offset(offsetPoint,&offsetStation,&offsetDistance);
+      CComPtr<IPoint2d> offsetPoint;
+      m_Alignment->LocatePoint(CComVariant(station),omtAlongDirection,skewLinePoints.SkewDistance[skewIdx],CComVariant(direction),&offsetPoint);
 
-         Float64 offsetStationValue;
-         offsetStation->get_Value(&offsetStationValue);
+      CComPtr<IStation> offsetStation;
+      Float64 offsetDistance;
+      m_Alignment->Offset(offsetPoint,&offsetStation,&offsetDistance);
 
-         (*pTable)(row,col++) << rptRcStation(offsetStationValue,&pDispUnits->StationFormat);
+      Float64 offsetStationValue;
+      offsetStation->get_Value(&offsetStationValue);
 
-         Float64 elevation;
-         m_Profile->Elevation(CComVariant(offsetStation),profileGradeOffset,&elevation);
-         (*pTable)(row,col++) << alignment.SetValue(elevation);
+      ATLASSERT(IsEqual(skewLinePoints.OffsetStation[skewIdx],offsetStationValue));
+      ATLASSERT(IsEqual(skewLinePoints.OffsetDistance[skewIdx],offsetDistance));
+   }
+}
 
-         Float64 grade;
-         m_Profile->Grade(CComVariant(offsetStation),&grade);
-         (*pTable)(row,col++) << scalar.SetValue(grade*100);
+void CCurvelChapterBuilder::AssertProfile(const CURVELPROFILEPOINTS& points) const
+{
+   // the native results must match the COGO Profile
+   IndexType nPoints = points.GetCount();
+   for ( IndexType i = 0; i < nPoints; i++ )
+   {
+      CComVariant varStation(points.Station[i]);
 
-         (*pTable)(row,col++) << RPT_OFFSET(offsetDistance+skewLine.CrownOffset,alignment);
+      Float64 elevation;
+      m_Profile->Elevation(varStation,points.Offset[i],&elevation);
+      ATLASSERT(IsEqual(points.OffsetElevation[i],elevation));
 
-         m_Profile->Elevation(CComVariant(offsetStation),offsetDistance+skewLine.CrownOffset,&elevation);
-         (*pTable)(row,col++) << alignment.SetValue(elevation);
+      Float64 grade;
+      m_Profile->Grade(varStation,&grade);
+      ATLASSERT(IsEqual(points.Grade[i],grade));
 
-         Float64 slope;
-         m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(offsetStation),1,&slope);
-         (*pTable)(row,col++) << scalar.SetValue(-slope);
+      Float64 slope;
+      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,varStation,1,&slope);
+      ATLASSERT(IsEqual(points.LeftSlope[i],-slope));
 
-         m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,CComVariant(offsetStation),2,&slope);
-         (*pTable)(row,col++) << scalar.SetValue(slope);
+      m_Profile->TemplateSegmentSlope(COGO_FINISHED_SURFACE_ID,varStation,2,&slope);
+      ATLASSERT(IsEqual(points.RightSlope[i],slope));
+   }
+}
+#endif
+
+void CCurvelChapterBuilder::Init(CCurvelReportSpecification* pRptSpec) const
+{
+   Uint32 modelRevision = pRptSpec->GetModelRevision();
+   if ( modelRevision != m_ModelRevision )
+   {
+      // The roadway has changed so all of the cached results are out of date
+      pRptSpec->InitProfileEvaluator(&m_Evaluator);
+      m_bHorzAlignment = pRptSpec->InitAlignment(&m_HorzAlignment);
+      m_ModelRevision = modelRevision;
+
+      m_IndividualStationRevisions.clear();
+      m_StationRangeRevisions.clear();
+      m_SkewLineRevisions.clear();
+   }
+
+#if defined _DEBUG
+   InitCOGOModel(pRptSpec);
+#endif
+}
+
+void CCurvelChapterBuilder::UpdateIndividualStations(const std::vector<IndividualStation>& stations,const std::vector<Uint32>& revisions) const
+{
+   ATLASSERT(stations.size() == revisions.size());
+   IndexType nStations = stations.size();
+   m_IndividualStationRevisions.resize(nStations,0);
+   m_IndividualStationPoints.Resize(nStations);
+
+   // evaluate the stations that have changed in one pass
+   std::vector<IndexType> vStationIdx;
+   CURVELPROFILEPOINTS points;
+   for ( IndexType stationIdx = 0; stationIdx < nStations; stationIdx++ )
+   {
+      if ( m_IndividualStationRevisions[stationIdx] != revisions[stationIdx] )
+      {
+         vStationIdx.push_back(stationIdx);
+         points.Add(stations[stationIdx].Station,stations[stationIdx].Offset);
       }
    }
 
-   return pChapter;
+   if ( vStationIdx.size() == 0 )
+   {
+      return;
+   }
+
+   m_Evaluator.Evaluate(&points);
+
+#if defined _DEBUG
+   AssertProfile(points);
+#endif
+
+   IndexType nPoints = points.GetCount();
+   for ( IndexType pointIdx = 0; pointIdx < nPoints; pointIdx++ )
+   {
+      IndexType stationIdx = vStationIdx[pointIdx];
+      m_IndividualStationPoints.CopyPoint(stationIdx,points,pointIdx);
+      m_IndividualStationRevisions[stationIdx] = revisions[stationIdx];
+   }
 }
 
-CChapterBuilder* CCurvelChapterBuilder::Clone() const
+void CCurvelChapterBuilder::UpdateStationRanges(const std::vector<StationRange>& ranges,const std::vector<Uint32>& revisions) const
 {
-   return new CCurvelChapterBuilder(m_pDoc);
+   ATLASSERT(ranges.size() == revisions.size());
+   IndexType nRanges = ranges.size();
+   m_StationRangeRevisions.resize(nRanges,0);
+   m_StationRangePoints.resize(nRanges);
+
+   for ( IndexType rangeIdx = 0; rangeIdx < nRanges; rangeIdx++ )
+   {
+      if ( m_StationRangeRevisions[rangeIdx] == revisions[rangeIdx] )
+      {
+         continue;
+      }
+
+      const StationRange& range(ranges[rangeIdx]);
+      CURVELPROFILEPOINTS& points(m_StationRangePoints[rangeIdx]);
+      points.Clear();
+      points.Reserve(range.nSpaces+1);
+
+      Float64 station = range.StartStation;
+      Float64 inc = (range.EndStation - range.StartStation)/range.nSpaces;
+      for ( IndexType i = 0; i <= range.nSpaces; i++, station += inc )
+      {
+         points.Add(station,range.Offset);
+      }
+
+      m_Evaluator.Evaluate(&points);
+
+#if defined _DEBUG
+      AssertProfile(points);
+#endif
+
+      m_StationRangeRevisions[rangeIdx] = revisions[rangeIdx];
+   }
 }
 
-void CCurvelChapterBuilder::Init(CCurvelReportSpecification* pRptSpec) const
+void CCurvelChapterBuilder::UpdateSkewLines(const std::vector<SkewLine>& skewLines,const std::vector<Uint32>& revisions) const
 {
+   ATLASSERT(skewLines.size() == revisions.size());
+   IndexType nSkewLines = skewLines.size();
+   m_SkewLineRevisions.resize(nSkewLines,0);
+   m_SkewLinePoints.Resize(nSkewLines);
+   m_SkewLineOffsetPoints.Resize(nSkewLines);
+
+   // Locate the offset point of each skew line that has changed on its alignment, then evaluate
+   // the roadway at all of the offset points in one pass. When there is a horizontal
+   // alignment, the skew lines are located on it and the radius of the alignment at
+   // the skew line station is used in place of the skew line radius.
+   std::vector<IndexType> vSkewIdx;
+   CURVELSKEWLINES skewLinePoints;
+   for ( IndexType skewIdx = 0; skewIdx < nSkewLines; skewIdx++ )
+   {
+      if ( m_SkewLineRevisions[skewIdx] != revisions[skewIdx] )
+      {
+         const SkewLine& skewLine(skewLines[skewIdx]);
+         m_SkewAngle->FromString(CComBSTR(skewLine.strSkewAngle.c_str()));
+         Float64 skewAngleValue;
+         m_SkewAngle->get_Value(&skewAngleValue);
+
+         vSkewIdx.push_back(skewIdx);
+         skewLinePoints.Add(skewLine,skewAngleValue);
+      }
+   }
+
+   if ( vSkewIdx.size() == 0 )
+   {
+      return;
+   }
+
+   m_SkewLineLocator.SetAlignment(m_bHorzAlignment ? &m_HorzAlignment : nullptr);
+   m_SkewLineLocator.Locate(&skewLinePoints);
+
+#if defined _DEBUG
+   AssertSkewLines(skewLines,vSkewIdx,skewLinePoints);
+#endif
+
+   IndexType nPoints = skewLinePoints.GetCount();
+   CURVELPROFILEPOINTS points;
+   points.Reserve(nPoints);
+   for ( IndexType pointIdx = 0; pointIdx < nPoints; pointIdx++ )
+   {
+      points.Add(skewLinePoints.OffsetStation[pointIdx],skewLinePoints.OffsetDistance[pointIdx] + skewLinePoints.CrownOffset[pointIdx]);
+   }
+
+   m_Evaluator.Evaluate(&points);
+
+#if defined _DEBUG
+   AssertProfile(points);
+#endif
+
+   for ( IndexType pointIdx = 0; pointIdx < nPoints; pointIdx++ )
+   {
+      IndexType skewIdx = vSkewIdx[pointIdx];
+      m_SkewLinePoints.CopySkewLine(skewIdx,skewLinePoints,pointIdx);
+      m_SkewLineOffsetPoints.CopyPoint(skewIdx,points,pointIdx);
+      m_SkewLineRevisions[skewIdx] = revisions[skewIdx];
+   }
+}
+
+#if defined _DEBUG
+void CCurvelChapterBuilder::InitCOGOModel(CCurvelReportSpecification* pRptSpec) const
+{
+   // The COGO model is built for every report because the extents of the roadway surface
+   // depend on all of the rows
    m_Alignment.Release();
    m_Profile.Release();
 
    m_Alignment.CoCreateInstance(CLSID_Alignment);
    m_Alignment->get_Profile(&m_Profile);
 
-   // Build the profile
-   CComPtr<IVertCurve> vertCurve;
-   vertCurve.CoCreateInstance(CLSID_VertCurve);
-
-   Float64 g1,g2,pviStation,pviElevation,length;
-   pRptSpec->GetVerticalCurveParameters(&g1,&g2,&pviStation,&pviElevation,&length);
-
-   Float64 pbgStation   = pviStation   - Max(100.0,length);
-   Float64 pbgElevation = pviElevation - g1*Max(100.0,length);
+   // Build the profile. The grade points of each vertical curve are the PVIs of the adjacent curves.
+   IndexType nVerticalCurves = m_Evaluator.GetVerticalCurveCount();
+   std::vector<Float64> g1(nVerticalCurves), g2(nVerticalCurves), pviStation(nVerticalCurves), pviElevation(nVerticalCurves), length(nVerticalCurves);
+   for ( IndexType curveIdx = 0; curveIdx < nVerticalCurves; curveIdx++ )
+   {
+      m_Evaluator.GetVerticalCurve(curveIdx,&g1[curveIdx],&g2[curveIdx],&pviStation[curveIdx],&pviElevation[curveIdx],&length[curveIdx]);
+   }
 
-   Float64 pfgStation   = pviStation   + Max(100.0,length);
-   Float64 pfgElevation = pviElevation + g2*Max(100.0,length);
+   Float64 pbgStation = pviStation.front() - Max(100.0,length.front());
+   Float64 pfgStation = pviStation.back()  + Max(100.0,length.back());
+   for ( IndexType curveIdx = 0; curveIdx < nVerticalCurves; curveIdx++ )
+   {
+      CComPtr<IProfilePoint> PBG;
+      PBG.CoCreateInstance(CLSID_ProfilePoint);
+      if ( curveIdx == 0 )
+      {
+         PBG->put_Station(CComVariant(pbgStation));
+         PBG->put_Elevation(pviElevation[curveIdx] - g1[curveIdx]*(pviStation[curveIdx] - pbgStation));
+      }
+      else
+      {
+         PBG->put_Station(CComVariant(pviStation[curveIdx-1]));
+         PBG->put_Elevation(pviElevation[curveIdx-1]);
+      }
 
-   CComPtr<IProfilePoint> PBG;
-   PBG.CoCreateInstance(CLSID_ProfilePoint);
-   PBG->put_Station(CComVariant(pbgStation));
-   PBG->put_Elevation(pbgElevation);
+      CComPtr<IProfilePoint> PFG;
+      PFG.CoCreateInstance(CLSID_ProfilePoint);
+      if ( curveIdx == nVerticalCurves-1 )
+      {
+         PFG->put_Station(CComVariant(pfgStation));
+         PFG->put_Elevation(pviElevation[curveIdx] + g2[curveIdx]*(pfgStation - pviStation[curveIdx]));
+      }
+      else
+      {
+         PFG->put_Station(CComVariant(pviStation[curveIdx+1]));
+         PFG->put_Elevation(pviElevation[curveIdx+1]);
+      }
 
-   CComPtr<IProfilePoint> PFG;
-   PFG.CoCreateInstance(CLSID_ProfilePoint);
-   PFG->put_Station(CComVariant(pfgStation));
-   PFG->put_Elevation(pfgElevation);
+      CComPtr<IProfilePoint> PVI;
+      PVI.CoCreateInstance(CLSID_ProfilePoint);
+      PVI->put_Station(CComVariant(pviStation[curveIdx]));
+      PVI->put_Elevation(pviElevation[curveIdx]);
 
-   CComPtr<IProfilePoint> PVI;
-   PVI.CoCreateInstance(CLSID_ProfilePoint);
-   PVI->put_Station(CComVariant(pviStation));
-   PVI->put_Elevation(pviElevation);
+      CComPtr<IVertCurve> vertCurve;
+      vertCurve.CoCreateInstance(CLSID_VertCurve);
+      vertCurve->putref_PBG(PBG);
+      vertCurve->putref_PVI(PVI);
+      vertCurve->putref_PFG(PFG);
+      vertCurve->put_L1(length[curveIdx]/2);
+      vertCurve->put_L2(length[curveIdx]/2);
 
-   vertCurve->putref_PBG(PBG);
-   vertCurve->putref_PVI(PVI);
-   vertCurve->putref_PFG(PFG);
-   vertCurve->put_L1(length/2);
-   vertCurve->put_L2(length/2);
+      m_Profile->AddEx(vertCurve);
+   }
 
-   m_Profile->AddEx(vertCurve);
+   if ( m_bHorzAlignment )
+   {
+      BuildAlignment();
+   }
 
    Float64 profileGradeOffset = pRptSpec->GetProfileGradeOffset();
 
@@ -712,8 +865,67 @@ void CCurvelChapterBuilder::Init(CCurvelReportSpecification* pRptSpec) const
    }
 }
 
+void CCurvelChapterBuilder::BuildAlignment() const
+{
+   // The COGO alignment is built once from the horizontal alignment. The alignment starts at the
+   // TS of the first curve, or the PI of the first curve if it is an angle point.
+   m_Alignment->Clear();
+
+   IndexType nCurves = m_HorzAlignment.GetCurveCount();
+   if ( nCurves == 0 )
+   {
+      m_Alignment->put_RefStation(CComVariant(0.0));
+      return;
+   }
+
+   for ( IndexType curveIdx = 0; curveIdx < nCurves; curveIdx++ )
+   {
+      Float64 tsStation, stStation, piX, piY;
+      m_HorzAlignment.GetCurvePoints(curveIdx,&tsStation,&stStation,&piX,&piY);
+
+      Float64 radius = fabs(m_HorzAlignment.GetCurveRadius(curveIdx));
+      if ( IsZero(radius) )
+      {
+         CComPtr<IPoint2d> pnt;
+         pnt.CoCreateInstance(CLSID_Point2d);
+         pnt->Move(piX,piY);
+         m_Alignment->AddEx(pnt);
+      }
+      else
+      {
+         Float64 bkTangent, fwdTangent;
+         m_HorzAlignment.GetCurveTangents(curveIdx,&bkTangent,&fwdTangent);
+
+         CComPtr<IHorzCurve> hc;
+         hc.CoCreateInstance(CLSID_HorzCurve);
+
+         CComPtr<IPoint2d> PBT, PFT, PI;
+         hc->get_PBT(&PBT);
+         hc->get_PI(&PI);
+         hc->get_PFT(&PFT);
+
+         // the tangent points are beyond the TS and ST
+         Float64 tangent = radius + stStation - tsStation;
+         PBT->Move(piX - tangent*cos(bkTangent),piY - tangent*sin(bkTangent));
+         PI->Move(piX,piY);
+         PFT->Move(piX + tangent*cos(fwdTangent),piY + tangent*sin(fwdTangent));
+
+         hc->put_Radius(radius);
+
+         m_Alignment->AddEx(hc);
+      }
+
+      if ( curveIdx == 0 )
+      {
+         m_Alignment->put_RefStation(CComVariant(tsStation));
+      }
+   }
+}
+
 void CCurvelChapterBuilder::UpdateAlignment(const SkewLine& skewLine) const
 {
+   // COGO alignment for a skew line without a horizontal alignment. This is the
+   // same curve as CCurvelSkewLineLocator::GetCurve
    m_Alignment->Clear();
 
    if ( IsZero(skewLine.Radius) )
@@ -745,4 +957,5 @@ void CCurvelChapterBuilder::UpdateAlignment(const SkewLine& skewLine) const
    // Define station at the TS point such that the station under consideration
    // is at the mid point of the curve
    m_Alignment->put_RefStation(CComVariant(skewLine.Station - Length/2));
-}
\ No newline at end of file
+}
+#endif
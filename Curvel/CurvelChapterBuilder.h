@@ -24,6 +24,9 @@
 #include <ReportManager\ChapterBuilder.h>
 #include "CurvelDoc.h"
 #include <WBFLCogo.h>
+#include "CurvelProfileEvaluator.h"
+#include "CurvelAlignment.h"
+#include "CurvelSkewLineLocator.h"
 
 class CCurvelReportSpecification;
 
@@ -47,8 +50,37 @@ private:
    CComPtr<IAngleDisplayUnitFormatter> m_AngleFormatter;
    CComBSTR m_bstrAngleFormat;
 
+   // The roadway model is only rebuilt when the model revision changes
    void Init(CCurvelReportSpecification* pRptSpec) const;
-   void UpdateAlignment(const SkewLine& skewLine) const;
+   mutable Uint32 m_ModelRevision;
+   mutable CCurvelProfileEvaluator m_Evaluator;
+   mutable CCurvelAlignment m_HorzAlignment;
+   mutable bool m_bHorzAlignment; // true if the skew lines are located on the horizontal alignment
+   mutable CCurvelSkewLineLocator m_SkewLineLocator; // keeps the skew line curves between reports
+
+   // Results for each row from previous reports. A row is only evaluated when its revision
+   // is different than the revision of its cached results.
+   void UpdateIndividualStations(const std::vector<IndividualStation>& stations,const std::vector<Uint32>& revisions) const;
+   void UpdateStationRanges(const std::vector<StationRange>& ranges,const std::vector<Uint32>& revisions) const;
+   void UpdateSkewLines(const std::vector<SkewLine>& skewLines,const std::vector<Uint32>& revisions) const;
+   mutable std::vector<Uint32> m_IndividualStationRevisions;
+   mutable CURVELPROFILEPOINTS m_IndividualStationPoints;
+   mutable std::vector<Uint32> m_StationRangeRevisions;
+   mutable std::vector<CURVELPROFILEPOINTS> m_StationRangePoints;
+   mutable std::vector<Uint32> m_SkewLineRevisions;
+   mutable CURVELSKEWLINES m_SkewLinePoints;
+   mutable CURVELPROFILEPOINTS m_SkewLineOffsetPoints; // roadway at the offset point of each skew line
+
+#if defined _DEBUG
+   // The COGO model is used to verify the native results
+   void InitCOGOModel(CCurvelReportSpecification* pRptSpec) const;
+   void BuildAlignment() const;
    mutable CComPtr<IAlignment> m_Alignment;
    mutable CComPtr<IProfile> m_Profile;
+
+   void UpdateAlignment(const SkewLine& skewLine) const;
+   void AssertVerticalCurve() const;
+   void AssertSkewLines(const std::vector<SkewLine>& skewLines,const std::vector<IndexType>& vSkewIdx,const CURVELSKEWLINES& skewLinePoints) const;
+   void AssertProfile(const CURVELPROFILEPOINTS& points) const;
+#endif
 };
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "CurvelDeckGrid.h"
+#include "..\BEToolboxUtilities.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+namespace
+{
+   // Evaluates the stations [firstStationIdx,lastStationIdx) and appends their records to buffer
+   void FormatRecords(const CCurvelProfileEvaluator& evaluator,const CURVELDECKGRID& grid,CCurvelDeckGrid::Format format,Float64 lengthFactor,IndexType firstStationIdx,IndexType lastStationIdx,std::vector<char>& buffer)
+   {
+      IndexType nOffsets = grid.Offsets.size();
+      IndexType nStations = lastStationIdx - firstStationIdx;
+
+      // The first point at each station is at offset zero, on the crown line. The profile grade elevation,
+      // grade and crown slopes don't depend on offset so they are taken from this point.
+      CURVELPROFILEPOINTS points;
+      points.Reserve(nStations*(nOffsets+1));
+      for ( IndexType stationIdx = firstStationIdx; stationIdx < lastStationIdx; stationIdx++ )
+      {
+         Float64 station = CCurvelDeckGrid::GetStation(grid,stationIdx);
+         points.Add(station,0.0);
+         for ( auto offset : grid.Offsets )
+         {
+            points.Add(station,offset);
+         }
+      }
+
+      evaluator.Evaluate(&points);
+
+      buffer.clear();
+      if ( format == CCurvelDeckGrid::CSV )
+      {
+         buffer.reserve(nStations*(5 + nOffsets)*16);
+         char str[64];
+         IndexType pointIdx = 0;
+         for ( IndexType i = 0; i < nStations; i++ )
+         {
+            int n = sprintf_s(str,"%.4f,%.4f,%.6f,%.6f,%.6f",
+               points.Station[pointIdx]*lengthFactor,
+               points.Elevation[pointIdx]*lengthFactor,
+               points.Grade[pointIdx],
+               points.LeftSlope[pointIdx],
+               points.RightSlope[pointIdx]);
+            buffer.insert(buffer.end(),str,str+n);
+            pointIdx++;
+
+            for ( IndexType offsetIdx = 0; offsetIdx < nOffsets; offsetIdx++, pointIdx++ )
+            {
+               n = sprintf_s(str,",%.4f",points.OffsetElevation[pointIdx]*lengthFactor);
+               buffer.insert(buffer.end(),str,str+n);
+            }
+            buffer.push_back('\n');
+         }
+      }
+      else
+      {
+         buffer.resize(nStations*(5 + nOffsets)*sizeof(Float64));
+         Float64* pRecord = (Float64*)buffer.data();
+         IndexType pointIdx = 0;
+         for ( IndexType i = 0; i < nStations; i++ )
+         {
+            *pRecord++ = points.Station[pointIdx]*lengthFactor;
+            *pRecord++ = points.Elevation[pointIdx]*lengthFactor;
+            *pRecord++ = points.Grade[pointIdx];
+            *pRecord++ = points.LeftSlope[pointIdx];
+            *pRecord++ = points.RightSlope[pointIdx];
+            pointIdx++;
+
+            for ( IndexType offsetIdx = 0; offsetIdx < nOffsets; offsetIdx++, pointIdx++ )
+            {
+               *pRecord++ = points.OffsetElevation[pointIdx]*lengthFactor;
+            }
+         }
+      }
+   }
+
+   bool WriteHeader(const CURVELDECKGRID& grid,CCurvelDeckGrid::Format format,Float64 lengthFactor,FILE* pFile)
+   {
+      if ( format == CCurvelDeckGrid::CSV )
+      {
+         fputs("Station,Profile Grade Elevation,Grade,Left Slope,Right Slope",pFile);
+         for ( auto offset : grid.Offsets )
+         {
+            fprintf(pFile,",Elevation at %.4f",offset*lengthFactor);
+         }
+         fputs("\n",pFile);
+      }
+      else
+      {
+         const char signature[8] = {'C','U','R','V','G','R','I','D'};
+         Uint32 version = 1;
+         Uint32 nOffsets = (Uint32)grid.Offsets.size();
+         Uint64 nStations = (Uint64)CCurvelDeckGrid::GetStationCount(grid);
+         Float64 unitSize = 1.0/lengthFactor;
+         fwrite(signature,sizeof(char),8,pFile);
+         fwrite(&version,sizeof(Uint32),1,pFile);
+         fwrite(&nOffsets,sizeof(Uint32),1,pFile);
+         fwrite(&nStations,sizeof(Uint64),1,pFile);
+         fwrite(&unitSize,sizeof(Float64),1,pFile);
+         for ( auto offset : grid.Offsets )
+         {
+            Float64 value = offset*lengthFactor;
+            fwrite(&value,sizeof(Float64),1,pFile);
+         }
+      }
+
+      return ferror(pFile) == 0;
+   }
+}
+
+IndexType CCurvelDeckGrid::GetStationCount(const CURVELDECKGRID& grid)
+{
+   ATLASSERT(0 < grid.StationSpacing);
+   if ( grid.EndStation < grid.StartStation )
+   {
+      return 0;
+   }
+
+   // the last station is at the end of the grid, even if it is closer than the station spacing
+   Float64 nSpaces = (grid.EndStation - grid.StartStation)/grid.StationSpacing;
+   return (IndexType)ceil(nSpaces - 1.0e-6) + 1;
+}
+
+Float64 CCurvelDeckGrid::GetStation(const CURVELDECKGRID& grid,IndexType stationIdx)
+{
+   return Min(grid.StartStation + stationIdx*grid.StationSpacing,grid.EndStation);
+}
+
+bool CCurvelDeckGrid::Export(const CCurvelProfileEvaluator& evaluator,const CURVELDECKGRID& grid,Format format,Float64 lengthFactor,FILE* pFile,const ProgressCallback& progress)
+{
+   if ( !WriteHeader(grid,format,lengthFactor,pFile) )
+   {
+      return false;
+   }
+
+   IndexType nStations = GetStationCount(grid);
+
+   // one buffer per worker thread, reused for every tile
+   std::vector<std::vector<char>> buffers(GetWorkerThreadCount(TileSize));
+   for ( IndexType firstStationIdx = 0; firstStationIdx < nStations; firstStationIdx += TileSize )
+   {
+      IndexType nTileStations = Min(TileSize,nStations - firstStationIdx);
+      IndexType nThreads = ParallelFor(nTileStations,[&](IndexType threadIdx,IndexType begin,IndexType end)
+      {
+         FormatRecords(evaluator,grid,format,lengthFactor,firstStationIdx + begin,firstStationIdx + end,buffers[threadIdx]);
+      });
+
+      // the blocks are in station order
+      for ( IndexType threadIdx = 0; threadIdx < nThreads; threadIdx++ )
+      {
+         const std::vector<char>& buffer(buffers[threadIdx]);
+         if ( fwrite(buffer.data(),sizeof(char),buffer.size(),pFile) != buffer.size() )
+         {
+            return false;
+         }
+      }
+
+      if ( !progress(firstStationIdx + nTileStations,nStations) )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "CurvelProfileEvaluator.h"
+#include <functional>
+
+// A lattice of points on the roadway surface. Stations are spaced at StationSpacing from
+// StartStation, and the last station is always EndStation. The roadway is evaluated at every
+// offset at every station.
+struct CURVELDECKGRID
+{
+   Float64 StartStation;
+   Float64 EndStation;
+   Float64 StationSpacing;
+   std::vector<Float64> Offsets; // offsets from the crown line
+};
+
+// Evaluates deck elevation grids and streams the results to a file.
+//
+// A deck elevation grid can have millions of points so it is not reported. The grid is evaluated
+// in tiles of stations. The stations in a tile are evaluated and formatted in parallel, then the tile
+// is written to the file before the next tile is evaluated, so the memory used does not depend on the
+// size of the grid.
+//
+// Both file formats have one record per station. A record has the station, the profile grade elevation,
+// the grade, the left and right crown slopes, and the elevation at each offset.
+//
+// The CSV format has a header row listing the offsets.
+//
+// The binary format is little endian and has a header followed by the records.
+//    char[8] "CURVGRID"
+//    Uint32 version (1)
+//    Uint32 number of offsets
+//    Uint64 number of stations
+//    Float64 size of the length unit in meters (stations, offsets and elevations are in this unit)
+//    Float64 offsets[number of offsets]
+//    Float64 records[number of stations][5 + number of offsets]
+class CCurvelDeckGrid
+{
+public:
+   enum Format { CSV, Binary };
+
+   // Called after each tile is written. Return false to cancel.
+   typedef std::function<bool(IndexType nStationsWritten,IndexType nStations)> ProgressCallback;
+
+   // Returns the number of stations in the grid
+   static IndexType GetStationCount(const CURVELDECKGRID& grid);
+
+   // Returns the station at stationIdx
+   static Float64 GetStation(const CURVELDECKGRID& grid,IndexType stationIdx);
+
+   // Evaluates the grid and writes it to pFile. Lengths are written in system units multiplied by
+   // lengthFactor (use lengthFactor to write the results in display units). pFile must be opened in binary
+   // mode for both formats. Returns false if the export is cancelled or the file could not be written.
+   static bool Export(const CCurvelProfileEvaluator& evaluator,const CURVELDECKGRID& grid,Format format,Float64 lengthFactor,FILE* pFile,const ProgressCallback& progress);
+
+   // Number of stations in a tile
+   static const IndexType TileSize = 4096;
+};
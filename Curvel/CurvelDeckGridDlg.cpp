@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+// CurvelDeckGridDlg.cpp : implementation file
+//
+
+#include "stdafx.h"
+#include "..\resource.h"
+#include "CurvelDeckGridDlg.h"
+#include "..\BEToolboxUtilities.h"
+#include <EAF\EAFApp.h>
+#include <MFCTools\CustomDDX.h>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+
+// CCurvelDeckGridDlg dialog
+
+IMPLEMENT_DYNAMIC(CCurvelDeckGridDlg, CDialog)
+
+CCurvelDeckGridDlg::CCurvelDeckGridDlg(CWnd* pParent /*=nullptr*/)
+	: CDialog(CCurvelDeckGridDlg::IDD, pParent)
+{
+   m_Format = CCurvelDeckGrid::CSV;
+}
+
+CCurvelDeckGridDlg::~CCurvelDeckGridDlg()
+{
+}
+
+void CCurvelDeckGridDlg::DoDataExchange(CDataExchange* pDX)
+{
+	CDialog::DoDataExchange(pDX);
+
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDisplayUnits = pApp->GetDisplayUnits();
+
+   DDX_Station(pDX,IDC_GRID_START_STATION,m_Grid.StartStation,pDisplayUnits->StationFormat);
+   DDX_Station(pDX,IDC_GRID_END_STATION,m_Grid.EndStation,pDisplayUnits->StationFormat);
+   DDX_UnitValueAndTag(pDX,IDC_GRID_SPACING,IDC_GRID_SPACING_UNIT,m_Grid.StationSpacing,pDisplayUnits->AlignmentLength);
+   DDX_Offsets(pDX);
+
+   int format = (int)m_Format;
+   DDX_Radio(pDX,IDC_GRID_CSV,format);
+   m_Format = (CCurvelDeckGrid::Format)format;
+
+   if ( pDX->m_bSaveAndValidate )
+   {
+      if ( m_Grid.EndStation <= m_Grid.StartStation )
+      {
+         pDX->PrepareEditCtrl(IDC_GRID_END_STATION);
+         AfxMessageBox(_T("The end station must be greater than the start station."),MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+
+      DDV_UnitValueGreaterThanZero(pDX,IDC_GRID_SPACING,m_Grid.StationSpacing,pDisplayUnits->AlignmentLength);
+
+      if ( m_Grid.Offsets.empty() )
+      {
+         pDX->PrepareEditCtrl(IDC_GRID_OFFSETS);
+         AfxMessageBox(_T("Enter at least one offset."),MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+   }
+}
+
+void CCurvelDeckGridDlg::DDX_Offsets(CDataExchange* pDX)
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtLengthData& lengthUnit(pApp->GetDisplayUnits()->AlignmentLength);
+   SetDlgItemText(IDC_GRID_OFFSETS_UNIT,lengthUnit.UnitOfMeasure.UnitTag().c_str());
+
+   // offsets are separated by commas because an offset can have a space before the L or R
+   CString strOffsets;
+   if ( pDX->m_bSaveAndValidate )
+   {
+      DDX_Text(pDX,IDC_GRID_OFFSETS,strOffsets);
+
+      std::vector<Float64> offsets;
+      int pos = 0;
+      CString strOffset(strOffsets.Tokenize(_T(","),pos));
+      while ( !strOffset.IsEmpty() )
+      {
+         offsets.push_back(GetOffset(strOffset,lengthUnit));
+         strOffset = strOffsets.Tokenize(_T(","),pos);
+      }
+      m_Grid.Offsets.swap(offsets);
+   }
+   else
+   {
+      for ( auto offset : m_Grid.Offsets )
+      {
+         strOffsets += (strOffsets.IsEmpty() ? _T("") : _T(", ")) + GetOffset(offset,lengthUnit);
+      }
+      DDX_Text(pDX,IDC_GRID_OFFSETS,strOffsets);
+   }
+}
+
+
+BEGIN_MESSAGE_MAP(CCurvelDeckGridDlg, CDialog)
+END_MESSAGE_MAP()
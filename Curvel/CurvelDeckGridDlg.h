@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "CurvelDeckGrid.h"
+
+// CCurvelDeckGridDlg dialog
+
+class CCurvelDeckGridDlg : public CDialog
+{
+	DECLARE_DYNAMIC(CCurvelDeckGridDlg)
+
+public:
+	CCurvelDeckGridDlg(CWnd* pParent = nullptr);   // standard constructor
+	virtual ~CCurvelDeckGridDlg();
+
+   CURVELDECKGRID m_Grid;
+   CCurvelDeckGrid::Format m_Format;
+
+// Dialog Data
+	enum { IDD = IDD_CURVEL_DECK_GRID };
+
+protected:
+	virtual void DoDataExchange(CDataExchange* pDX) override;    // DDX/DDV support
+
+   void DDX_Offsets(CDataExchange* pDX);
+
+	DECLARE_MESSAGE_MAP()
+};
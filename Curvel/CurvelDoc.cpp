@@ -34,7 +34,9 @@
 #include "CurvelReportSpecification.h"
 #include "CurvelReportSpecificationBuilder.h"
 #include "CurvelRptView.h"
+#include "CurvelDeckGridDlg.h"
 #include "..\BEToolboxStatusBar.h"
+#include "..\BEToolboxProgressDlg.h"
 
 
 #ifdef _DEBUG
@@ -88,6 +90,18 @@ CCurvelDoc::CCurvelDoc()
    m_pDefaultRptSpec = pCurvelRptSpec;
 
    EnableUIHints(FALSE); // not using UIHints feature
+
+   m_DeckGrid.StartStation = 0;
+   m_DeckGrid.EndStation = ::ConvertToSysUnits(1000.0,unitMeasure::Feet);
+   m_DeckGrid.StationSpacing = ::ConvertToSysUnits(1.0,unitMeasure::Feet);
+   for ( int i = -2; i <= 2; i++ )
+   {
+      m_DeckGrid.Offsets.push_back(::ConvertToSysUnits(10.0*i,unitMeasure::Feet));
+   }
+   m_DeckGridFormat = CCurvelDeckGrid::CSV;
+
+   m_NextRevision = 1;
+   ResetRevisions();
 }
 
 CCurvelDoc::~CCurvelDoc()
@@ -97,6 +111,7 @@ CCurvelDoc::~CCurvelDoc()
 
 BEGIN_MESSAGE_MAP(CCurvelDoc, CBEToolboxDoc)
    ON_COMMAND(ID_HELP_FINDER, OnHelpFinder)
+   ON_COMMAND(ID_EXPORT_DECK_GRID, OnExportDeckGrid)
 END_MESSAGE_MAP()
 
 void CCurvelDoc::OnHelpFinder()
@@ -104,6 +119,38 @@ void CCurvelDoc::OnHelpFinder()
    EAFHelp(EAFGetDocument()->GetDocumentationSetName(),IDH_CURVEL);
 }
 
+void CCurvelDoc::OnExportDeckGrid()
+{
+   AFX_MANAGE_STATE(AfxGetStaticModuleState());
+
+   CCurvelDeckGridDlg dlg;
+   dlg.m_Grid = m_DeckGrid;
+   dlg.m_Format = m_DeckGridFormat;
+   if ( dlg.DoModal() != IDOK )
+   {
+      return;
+   }
+
+   m_DeckGrid = dlg.m_Grid;
+   m_DeckGridFormat = dlg.m_Format;
+
+   CFileDialog fileDlg(FALSE,
+                       m_DeckGridFormat == CCurvelDeckGrid::CSV ? _T("csv") : _T("grd"),
+                       nullptr,OFN_HIDEREADONLY | OFN_OVERWRITEPROMPT,
+                       m_DeckGridFormat == CCurvelDeckGrid::CSV ? _T("Comma Separated Value Files (*.csv)|*.csv|All Files (*.*)|*.*||") : _T("Curvel Grid Files (*.grd)|*.grd|All Files (*.*)|*.*||"));
+   if ( fileDlg.DoModal() != IDOK )
+   {
+      return;
+   }
+
+   bool bCancelled;
+   CString strError;
+   if ( !ExportDeckGrid(fileDlg.GetPathName(),&bCancelled,&strError) && !bCancelled )
+   {
+      AfxMessageBox(strError,MB_OK | MB_ICONEXCLAMATION);
+   }
+}
+
 
 // CCurvelDoc diagnostics
 
@@ -135,6 +182,8 @@ BOOL CCurvelDoc::OnNewDocument()
    if ( m_CurvelXML.get() == nullptr )
       return FALSE;
 
+   ResetRevisions();
+
    return TRUE;
 }
 
@@ -146,6 +195,8 @@ BOOL CCurvelDoc::OpenTheDocument(LPCTSTR lpszPathName)
    if ( m_CurvelXML.get() == nullptr )
       return FALSE;
 
+   ResetRevisions();
+
    return TRUE;
 }
 
@@ -197,3 +248,59 @@ Curvel* CCurvelDoc::GetCurvelXML()
 {
    return m_CurvelXML.get();
 }
+
+CURVELREVISIONS& CCurvelDoc::GetRevisions()
+{
+   return m_Revisions;
+}
+
+Uint32 CCurvelDoc::GetNextRevision()
+{
+   return m_NextRevision++;
+}
+
+void CCurvelDoc::ResetRevisions()
+{
+   // everything is new. the row revisions are assigned when the rows are first read
+   m_Revisions.Model = GetNextRevision();
+   m_Revisions.IndividualStations.clear();
+   m_Revisions.StationRanges.clear();
+   m_Revisions.SkewLines.clear();
+}
+
+BOOL CCurvelDoc::ExportDeckGrid(LPCTSTR lpszPathName,bool* pbCancelled,CString* pstrError)
+{
+   *pbCancelled = false;
+
+   FILE* pFile = nullptr;
+   if ( _tfopen_s(&pFile,lpszPathName,_T("wb")) != 0 || pFile == nullptr )
+   {
+      pstrError->Format(_T("Unable to create %s"),lpszPathName);
+      return FALSE;
+   }
+
+   CCurvelProfileEvaluator evaluator;
+   m_pDefaultRptSpec->InitProfileEvaluator(&evaluator);
+
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtLengthData& lengthUnit(pApp->GetDisplayUnits()->AlignmentLength);
+   Float64 lengthFactor = ::ConvertFromSysUnits(1.0,lengthUnit.UnitOfMeasure);
+
+   // The grid is written on a worker thread while a progress dialog, with a Cancel button, keeps the application responsive
+   CBEToolboxProgressDlg progressDlg(_T("Exporting deck elevation grid..."),EAFGetMainFrame());
+   bool bSucceeded = progressDlg.Run([&](const CBEToolboxProgressDlg::ProgressCallback& progress)
+   {
+      return CCurvelDeckGrid::Export(evaluator,m_DeckGrid,m_DeckGridFormat,lengthFactor,pFile,[&progress](IndexType nStationsWritten,IndexType nStations) {return progress((Float64)nStationsWritten/nStations);});
+   },pbCancelled);
+   bSucceeded = (fclose(pFile) == 0 && bSucceeded);
+
+   if ( !bSucceeded )
+   {
+      // don't leave a partial grid behind
+      ::DeleteFile(lpszPathName);
+      pstrError->Format(_T("An error occurred while writing %s"),lpszPathName);
+      return FALSE;
+   }
+
+   return TRUE;
+}
@@ -25,8 +25,20 @@
 // CCurvelDoc document
 #include "..\BEToolboxDoc.h"
 #include "CurvelReportSpecification.h"
+#include "CurvelDeckGrid.h"
 #include <Curvel.h>
 
+// Revision numbers of the Curvel input. A revision number changes whenever the data it covers changes
+// so the report can reuse results computed for data that has not changed. Revision numbers are never
+// reused by a document, so a revision number of 0 never matches any data.
+struct CURVELREVISIONS
+{
+   Uint32 Model; // vertical curves, horizontal alignment, and superelevation
+   std::vector<Uint32> IndividualStations; // one per row
+   std::vector<Uint32> StationRanges; // one per row
+   std::vector<Uint32> SkewLines; // one per row
+};
+
 class CCurvelDoc : public CBEToolboxDoc
 {
 	DECLARE_DYNCREATE(CCurvelDoc)
@@ -43,6 +55,17 @@ public:
 
    Curvel* GetCurvelXML();
 
+   // Revision numbers of the Curvel input. The revision numbers are kept up to date by CCurvelReportSpecification
+   CURVELREVISIONS& GetRevisions();
+   Uint32 GetNextRevision();
+
+   // Evaluates the deck elevation grid and writes it to a file. Returns FALSE if the
+   // grid could not be written. pbCancelled is set to true if the user cancelled the export.
+   BOOL ExportDeckGrid(LPCTSTR lpszPathName,bool* pbCancelled,CString* pstrError);
+
+   CURVELDECKGRID m_DeckGrid;
+   CCurvelDeckGrid::Format m_DeckGridFormat;
+
 #ifdef _DEBUG
 	virtual void AssertValid() const override;
 #ifndef _WIN32_WCE
@@ -67,12 +90,18 @@ protected:
    CComPtr<IUnitServer> m_DocUnitServer;
    CComPtr<IUnitConvert> m_DocConvert;
 
+   void ResetRevisions();
+
    afx_msg void OnHelpFinder();
+   afx_msg void OnExportDeckGrid();
    DECLARE_MESSAGE_MAP()
 
 private:
    CReportBuilderManager m_RptMgr;
 
+   CURVELREVISIONS m_Revisions;
+   Uint32 m_NextRevision;
+
    std::shared_ptr<CReportSpecificationBuilder> m_pRptSpecBuilder;
    std::shared_ptr<CCurvelReportSpecification> m_pDefaultRptSpec; // this is the default spec that is
    // used to get things started... after the report is displayed, the view holds the real repost spec
@@ -315,36 +315,21 @@ STDMETHODIMP CCurvelExporter::Export(IBroker* pBroker)
       }
       else
       {
-         int curveIdx = 0;
-
-         // Curvel supports a single vertical curve, select which vertical curve to export to Curvel
-         if ( 1 < profileData.VertCurves.size() )
+         // Curvel models symmetric vertical curves. The entry grade of each curve is the exit
+         // grade of the previous curve so only the first curve has an entry grade and PVI elevation
+         auto iter(profileData.VertCurves.cbegin());
+         auto end(profileData.VertCurves.cend());
+         for ( ; iter != end; iter++ )
          {
-            GET_IFACE2(pBroker,IEAFDisplayUnits,pDisplayUnits);
-            CString strList;
-            auto iter(profileData.VertCurves.cbegin());
-            auto end(profileData.VertCurves.cend());
-            int idx = 1;
-            for ( ; iter != end; iter++, idx++ )
+            const auto& vCurve(*iter);
+            if ( !IsEqual(vCurve.L1,vCurve.L2) && !IsZero(vCurve.L2) )
             {
-               const auto& vCurve(*iter);
-               CString str;
-               str.Format(_T("Curve %d: PVI Station %s"),idx,::FormatStation(pDisplayUnits->GetStationFormat(),vCurve.PVIStation));
-               strList += str + _T("\n");
-
+               AfxMessageBox(_T("Cannot export profile information. Curvel does not support unsymmetric vertical curves"),MB_OK | MB_ICONSTOP);
+               return FALSE;
             }
-            curveIdx = AfxChoose(_T("Multiple Vertical Curves"),_T("Curvel is limited to a single vertical curve. Select the vertical curve to export."),strList,0,TRUE);
-            if ( curveIdx == -1 )
-               return S_FALSE;
-         }
-         
-         const auto& vCurve(profileData.VertCurves[curveIdx]);
-         if ( !IsEqual(vCurve.L1,vCurve.L2) && !IsZero(vCurve.L2) )
-         {
-            AfxMessageBox(_T("Cannot export profile information. Curvel does not support unsymmetric vertical curves"),MB_OK | MB_ICONSTOP);
-            return FALSE;
          }
 
+         const auto& vCurve(profileData.VertCurves.front());
          vCurveXML.g1( profileData.Grade );
          vCurveXML.g2( vCurve.ExitGrade );
          vCurveXML.Length(vCurve.L1 + vCurve.L2);
@@ -362,6 +347,17 @@ STDMETHODIMP CCurvelExporter::Export(IBroker* pBroker)
             vCurveXML.PVIStation(vCurve.PVIStation);
             vCurveXML.PVIElevation(pviElevation);
          }
+
+         if ( 1 < profileData.VertCurves.size() )
+         {
+            VerticalCurvesType verticalCurvesXML;
+            for ( iter = profileData.VertCurves.cbegin()+1; iter != end; iter++ )
+            {
+               const auto& nextCurve(*iter);
+               verticalCurvesXML.VerticalCurve().push_back(ProfileCurveType(nextCurve.PVIStation,nextCurve.ExitGrade,nextCurve.L1 + nextCurve.L2));
+            }
+            curvelXML->VerticalCurves(verticalCurvesXML);
+         }
       }
 
       ///////////////////////////////////////////////////////////////
@@ -446,10 +442,11 @@ STDMETHODIMP CCurvelExporter::Export(IBroker* pBroker)
       // Export horizontal curves
       ///////////////////////////////////////////////////////////////
 
-      // Curvel does not model horizontal curves the same way PGSuper does
-      // Create a skew line reporting point for each horizontal curve
-      // This is the best way to export the horizontal curve information
+      // The horizontal alignment is exported with circular curves. A skew line reporting point
+      // is also created at the PI of each horizontal curve.
       const AlignmentData2& alignmentData = pRoadway->GetAlignmentData2();
+      HorizontalAlignmentType alignmentXML(alignmentData.Direction);
+      Float64 bkTangent = alignmentData.Direction;
       auto iter(alignmentData.HorzCurves.cbegin());
       auto end(alignmentData.HorzCurves.cend());
       bool bSpiral = false;
@@ -459,6 +456,12 @@ STDMETHODIMP CCurvelExporter::Export(IBroker* pBroker)
       {
          bCurves = true;
          const auto& hCurve(*iter);
+
+         // FwdTangent is the bearing of the forward tangent or the curve delta, measured counter-clockwise
+         Float64 fwdTangent = (hCurve.bFwdTangent ? hCurve.FwdTangent : bkTangent + hCurve.FwdTangent);
+         alignmentXML.HorizontalCurve().push_back(HorizontalCurveType(hCurve.PIStation,fwdTangent,hCurve.Radius));
+         bkTangent = fwdTangent;
+
          SkewLineType skewLine(hCurve.PIStation,OffsetType::RadialFromCrownLine,0.0,_T("0.0 L"),hCurve.Radius,0.0);
          if ( !IsZero(hCurve.EntrySpiral) || !IsZero(hCurve.ExitSpiral) )
          {
@@ -470,12 +473,16 @@ STDMETHODIMP CCurvelExporter::Export(IBroker* pBroker)
 
       if ( bCurves )
       {
+         // Skew lines take their radius from the alignment when one is present so the
+         // alignment is only written when it has curves.
+         curvelXML->HorizontalAlignment(alignmentXML);
+
          curvelXML->SkewLines().set(skewLines);
 
-         CString strMsg(_T("Horizontal curves have been modeled as Skew Line input in Curvel."));
+         CString strMsg(_T("A Skew Line has been created at the PI of each horizontal curve."));
          if ( bSpiral )
          {
-            strMsg += _T("\nEntry and Exit Spirals are not modeled in Curvel.");
+            strMsg += _T("\nEntry and Exit Spirals are not modeled in Curvel. Curves with spirals are modeled as circular curves.");
          }
 
          AfxMessageBox(strMsg,MB_OK | MB_ICONINFORMATION);
@@ -104,6 +104,19 @@ STDMETHODIMP CCurvelImporter::Import(IBroker* pBroker)
       vcd.L2 = 0;
       profileData.VertCurves.push_back(vcd);
 
+      Curvel::VerticalCurves_optional& verticalCurves = curvelXML->VerticalCurves();
+      if ( verticalCurves.present() )
+      {
+         for ( auto& verticalCurve : verticalCurves->VerticalCurve() )
+         {
+            vcd.PVIStation = verticalCurve.PVIStation();
+            vcd.ExitGrade = verticalCurve.g2();
+            vcd.L1 = verticalCurve.Length();
+            vcd.L2 = 0;
+            profileData.VertCurves.push_back(vcd);
+         }
+      }
+
       Curvel::SuperelevationData_optional& super = curvelXML->SuperelevationData();
       bool bCrossSectionData = super.present();
       RoadwaySectionData sectionData;
@@ -166,6 +179,29 @@ STDMETHODIMP CCurvelImporter::Import(IBroker* pBroker)
       GET_IFACE2(pBroker,IRoadwayData,pRoadway);
       pRoadway->SetProfileData2(profileData);
 
+      // The horizontal alignment replaces the curves of the current alignment. The alignment
+      // reference point is retained since Curvel alignments are not located in space.
+      Curvel::HorizontalAlignment_optional& alignment = curvelXML->HorizontalAlignment();
+      bool bAlignmentData = alignment.present();
+      if ( bAlignmentData )
+      {
+         AlignmentData2 alignmentData = pRoadway->GetAlignmentData2();
+         alignmentData.Direction = alignment->Direction();
+         alignmentData.HorzCurves.clear();
+         for ( auto& horizontalCurve : alignment->HorizontalCurve() )
+         {
+            HorzCurveData hcd;
+            hcd.PIStation = horizontalCurve.PIStation();
+            hcd.FwdTangent = horizontalCurve.FwdTangent();
+            hcd.bFwdTangent = true;
+            hcd.Radius = horizontalCurve.Radius();
+            hcd.EntrySpiral = 0;
+            hcd.ExitSpiral = 0;
+            alignmentData.HorzCurves.push_back(hcd);
+         }
+         pRoadway->SetAlignmentData2(alignmentData);
+      }
+
       if ( bCrossSectionData )
       {
          pRoadway->SetRoadwaySectionData(sectionData);
@@ -174,7 +210,14 @@ STDMETHODIMP CCurvelImporter::Import(IBroker* pBroker)
       pEvents->FirePendingEvents();
 
       CString strMsg;
-      strMsg.Format(_T("Profile and Cross Section data was successfully imported from %s\n\nCurvel data does not include horizontal alignment information. Verify your alignment data is correct."),fileDlg.GetPathName());
+      if ( bAlignmentData )
+      {
+         strMsg.Format(_T("Alignment, Profile, and Cross Section data was successfully imported from %s"),fileDlg.GetPathName());
+      }
+      else
+      {
+         strMsg.Format(_T("Profile and Cross Section data was successfully imported from %s\n\nCurvel data does not include horizontal alignment information. Verify your alignment data is correct."),fileDlg.GetPathName());
+      }
       AfxMessageBox(strMsg,MB_OK | MB_ICONINFORMATION);
    }
    return S_OK;
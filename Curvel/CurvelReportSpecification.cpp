@@ -30,6 +30,44 @@
 static char THIS_FILE[] = __FILE__;
 #endif
 
+namespace
+{
+   // Gives every row a new revision if the revisions are not in sync with the rows
+   void SyncRevisions(CCurvelDoc* pDoc,IndexType nRows,std::vector<Uint32>& revisions)
+   {
+      if ( revisions.size() != nRows )
+      {
+         revisions.resize(nRows);
+         for ( auto& revision : revisions )
+         {
+            revision = pDoc->GetNextRevision();
+         }
+      }
+   }
+
+   // Rows that have not changed keep their revision. Changed and new rows get a new revision.
+   // Values are compared exactly because any change to a row is an edit of that row.
+   template <class T,class Equal>
+   void UpdateRevisions(CCurvelDoc* pDoc,const std::vector<T>& oldRows,const std::vector<T>& newRows,std::vector<Uint32>& revisions,Equal isEqual)
+   {
+      ATLASSERT(revisions.size() == oldRows.size());
+      IndexType nRows = newRows.size();
+      revisions.resize(nRows);
+      for ( IndexType rowIdx = 0; rowIdx < nRows; rowIdx++ )
+      {
+         if ( oldRows.size() <= rowIdx || !isEqual(oldRows[rowIdx],newRows[rowIdx]) )
+         {
+            revisions[rowIdx] = pDoc->GetNextRevision();
+         }
+      }
+   }
+
+   void UpdateModelRevision(CCurvelDoc* pDoc)
+   {
+      pDoc->GetRevisions().Model = pDoc->GetNextRevision();
+   }
+}
+
 CCurvelReportSpecification::CCurvelReportSpecification(LPCTSTR strReportName) :
 CReportSpecification(strReportName)
 {
@@ -50,6 +88,11 @@ void CCurvelReportSpecification::SetVerticalCurveParameters(Float64 g1,Float64 g
    Curvel* pCurvel = pDoc->GetCurvelXML();
 
    VerticalCurveDataType& vc = pCurvel->VerticalCurveData();
+   if ( vc.g1() != g1 || vc.g2() != g2 || vc.PVIStation() != PVIStation || vc.PVIElevation() != PVIElevation || vc.Length() != length )
+   {
+      UpdateModelRevision(pDoc);
+   }
+
    vc.g1(g1);
    vc.g2(g2);
    vc.PVIStation(PVIStation);
@@ -70,6 +113,84 @@ void CCurvelReportSpecification::GetVerticalCurveParameters(Float64* g1,Float64*
    *length       = vc.Length();
 }
 
+const std::vector<ProfileCurve>& CCurvelReportSpecification::GetProfileCurves() const
+{
+   CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
+   Curvel* pCurvel = pDoc->GetCurvelXML();
+
+   m_ProfileCurves.clear();
+
+   Curvel::VerticalCurves_optional& verticalCurvesOptional(pCurvel->VerticalCurves());
+   if ( verticalCurvesOptional.present() )
+   {
+      VerticalCurvesType::VerticalCurve_sequence& verticalCurves(verticalCurvesOptional->VerticalCurve());
+      VerticalCurvesType::VerticalCurve_iterator iter(verticalCurves.begin());
+      VerticalCurvesType::VerticalCurve_iterator end(verticalCurves.end());
+      for ( ; iter != end; iter++ )
+      {
+         ProfileCurveType& verticalCurve(*iter);
+
+         ProfileCurve pc;
+         pc.PVIStation = verticalCurve.PVIStation();
+         pc.g2         = verticalCurve.g2();
+         pc.Length     = verticalCurve.Length();
+         m_ProfileCurves.push_back(pc);
+      }
+   }
+
+   return m_ProfileCurves;
+}
+
+bool CCurvelReportSpecification::HasHorizontalAlignment() const
+{
+   CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
+   Curvel* pCurvel = pDoc->GetCurvelXML();
+
+   // An alignment without curves is a straight line. It doesn't change the report so it is treated as if it isn't there.
+   Curvel::HorizontalAlignment_optional& alignmentOptional(pCurvel->HorizontalAlignment());
+   return alignmentOptional.present() && !alignmentOptional->HorizontalCurve().empty();
+}
+
+Float64 CCurvelReportSpecification::GetAlignmentDirection() const
+{
+   CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
+   Curvel* pCurvel = pDoc->GetCurvelXML();
+
+   Curvel::HorizontalAlignment_optional& alignmentOptional(pCurvel->HorizontalAlignment());
+   if ( alignmentOptional.present() )
+      return alignmentOptional->Direction();
+   else
+      return 0.0;
+}
+
+const std::vector<HorizontalCurve>& CCurvelReportSpecification::GetHorizontalCurves() const
+{
+   CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
+   Curvel* pCurvel = pDoc->GetCurvelXML();
+
+   m_HorizontalCurves.clear();
+
+   Curvel::HorizontalAlignment_optional& alignmentOptional(pCurvel->HorizontalAlignment());
+   if ( alignmentOptional.present() )
+   {
+      HorizontalAlignmentType::HorizontalCurve_sequence& horizontalCurves(alignmentOptional->HorizontalCurve());
+      HorizontalAlignmentType::HorizontalCurve_iterator iter(horizontalCurves.begin());
+      HorizontalAlignmentType::HorizontalCurve_iterator end(horizontalCurves.end());
+      for ( ; iter != end; iter++ )
+      {
+         HorizontalCurveType& horizontalCurve(*iter);
+
+         HorizontalCurve hc;
+         hc.PIStation  = horizontalCurve.PIStation();
+         hc.FwdTangent = horizontalCurve.FwdTangent();
+         hc.Radius     = horizontalCurve.Radius();
+         m_HorizontalCurves.push_back(hc);
+      }
+   }
+
+   return m_HorizontalCurves;
+}
+
 bool CCurvelReportSpecification::CorrectForSuperelevation()
 {
    CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
@@ -87,11 +208,13 @@ void CCurvelReportSpecification::CorrectForSuperelevation(bool bCorrect)
    {
       // we have superelevatoin data and no longer want it
       pCurvel->SuperelevationData().reset();
+      UpdateModelRevision(pDoc);
    }
    else if ( !pCurvel->SuperelevationData().present() && bCorrect )
    {
       // we don't have superelevation data but need it
       pCurvel->SuperelevationData(Curvel::SuperelevationData_type(0.0,CrownSlopeType()));
+      UpdateModelRevision(pDoc);
    }
 }
 
@@ -102,6 +225,10 @@ void CCurvelReportSpecification::SetProfileGradeOffset(Float64 offset)
 
    Curvel::SuperelevationData_optional& super = pCurvel->SuperelevationData();
    ATLASSERT(super.present());
+   if ( super->ProfileGradeOffset() != offset )
+   {
+      UpdateModelRevision(pDoc);
+   }
    super->ProfileGradeOffset(offset);
 }
 
@@ -160,6 +287,11 @@ void CCurvelReportSpecification::SetSuperelevationPoint(IndexType idx,Supereleva
 
    ATLASSERT(superPP.size() == 3);
    ATLASSERT(0 <= idx && idx <= 2);
+   if ( superPP[idx].Station() != point.Station || superPP[idx].LeftSlope() != point.LeftSlope || superPP[idx].RightSlope() != point.RightSlope )
+   {
+      UpdateModelRevision(pDoc);
+   }
+
    superPP[idx].Station(    point.Station    );
    superPP[idx].LeftSlope(  point.LeftSlope  );
    superPP[idx].RightSlope( point.RightSlope );
@@ -197,6 +329,11 @@ void CCurvelReportSpecification::SetIndividualStations(const std::vector<Individ
    CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
    Curvel* pCurvel = pDoc->GetCurvelXML();
 
+   std::vector<IndividualStation> oldStations(GetIndividualStations());
+   GetIndividualStationRevisions(); // makes sure the revisions are in sync with the old rows
+   UpdateRevisions(pDoc,oldStations,stations,pDoc->GetRevisions().IndividualStations,
+                   [](const IndividualStation& a,const IndividualStation& b) {return a.Station == b.Station && a.Offset == b.Offset;});
+
    Curvel::IndividualStations_optional& individualStationsOptional(pCurvel->IndividualStations());
    if ( stations.size() == 0 )
    {
@@ -256,6 +393,11 @@ void CCurvelReportSpecification::SetStationRanges(const std::vector<StationRange
    CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
    Curvel* pCurvel = pDoc->GetCurvelXML();
 
+   std::vector<StationRange> oldRanges(GetStationRanges());
+   GetStationRangeRevisions(); // makes sure the revisions are in sync with the old rows
+   UpdateRevisions(pDoc,oldRanges,stations,pDoc->GetRevisions().StationRanges,
+                   [](const StationRange& a,const StationRange& b) {return a.StartStation == b.StartStation && a.EndStation == b.EndStation && a.nSpaces == b.nSpaces && a.Offset == b.Offset;});
+
    Curvel::StationRanges_optional& stationRangesOptional(pCurvel->StationRanges());
    if ( stations.size() == 0 )
    {
@@ -317,6 +459,11 @@ void CCurvelReportSpecification::SetSkewLines(const std::vector<SkewLine>& skewL
    CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
    Curvel* pCurvel = pDoc->GetCurvelXML();
 
+   std::vector<SkewLine> oldSkewLines(GetSkewLines());
+   GetSkewLineRevisions(); // makes sure the revisions are in sync with the old rows
+   UpdateRevisions(pDoc,oldSkewLines,skewLines,pDoc->GetRevisions().SkewLines,
+                   [](const SkewLine& a,const SkewLine& b) {return a.Station == b.Station && a.OffsetType == b.OffsetType && a.Offset == b.Offset && a.strSkewAngle == b.strSkewAngle && a.Radius == b.Radius && a.CrownOffset == b.CrownOffset;});
+
    Curvel::SkewLines_optional& skewLinesOptional(pCurvel->SkewLines());
    if ( skewLines.size() == 0 )
    {
@@ -341,3 +488,58 @@ void CCurvelReportSpecification::SetSkewLines(const std::vector<SkewLine>& skewL
       }
    }
 }
+
+Uint32 CCurvelReportSpecification::GetModelRevision() const
+{
+   CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
+   return pDoc->GetRevisions().Model;
+}
+
+const std::vector<Uint32>& CCurvelReportSpecification::GetIndividualStationRevisions() const
+{
+   CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
+   CURVELREVISIONS& revisions(pDoc->GetRevisions());
+   SyncRevisions(pDoc,GetIndividualStations().size(),revisions.IndividualStations);
+   return revisions.IndividualStations;
+}
+
+const std::vector<Uint32>& CCurvelReportSpecification::GetStationRangeRevisions() const
+{
+   CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
+   CURVELREVISIONS& revisions(pDoc->GetRevisions());
+   SyncRevisions(pDoc,GetStationRanges().size(),revisions.StationRanges);
+   return revisions.StationRanges;
+}
+
+const std::vector<Uint32>& CCurvelReportSpecification::GetSkewLineRevisions() const
+{
+   CCurvelDoc* pDoc = (CCurvelDoc*)EAFGetDocument();
+   CURVELREVISIONS& revisions(pDoc->GetRevisions());
+   SyncRevisions(pDoc,GetSkewLines().size(),revisions.SkewLines);
+   return revisions.SkewLines;
+}
+
+void CCurvelReportSpecification::InitProfileEvaluator(CCurvelProfileEvaluator* pEvaluator)
+{
+   Float64 g1,g2,pviStation,pviElevation,length;
+   GetVerticalCurveParameters(&g1,&g2,&pviStation,&pviElevation,&length);
+   pEvaluator->SetVerticalCurve(g1,g2,pviStation,pviElevation,length);
+
+   for ( const auto& profileCurve : GetProfileCurves() )
+   {
+      pEvaluator->AddVerticalCurve(profileCurve.PVIStation,profileCurve.g2,profileCurve.Length);
+   }
+
+   SuperelevationProfilePoint superelevationPoints[3];
+   for ( IndexType i = 0; i < 3; i++ )
+   {
+      superelevationPoints[i] = GetSuperelevationPoint(i);
+   }
+   pEvaluator->SetSuperelevation(GetProfileGradeOffset(),superelevationPoints);
+}
+
+bool CCurvelReportSpecification::InitAlignment(CCurvelAlignment* pAlignment)
+{
+   pAlignment->Init(GetAlignmentDirection(),GetHorizontalCurves());
+   return HasHorizontalAlignment();
+}
@@ -22,6 +22,8 @@
 
 #pragma once
 #include <ReportManager\ReportSpecification.h>
+#include "CurvelProfileEvaluator.h"
+#include "CurvelAlignment.h"
 
 class CCurvelReportSpecification :
    public CReportSpecification
@@ -33,6 +35,13 @@ public:
    void SetVerticalCurveParameters(Float64 g1,Float64 g2,Float64 PVIStation,Float64 PVIElevation,Float64 length);
    void GetVerticalCurveParameters(Float64* g1,Float64* g2,Float64* PVIStation,Float64* PVIElevation,Float64* length) const;
 
+   // Vertical curves that follow the first vertical curve
+   const std::vector<ProfileCurve>& GetProfileCurves() const;
+
+   bool HasHorizontalAlignment() const;
+   Float64 GetAlignmentDirection() const;
+   const std::vector<HorizontalCurve>& GetHorizontalCurves() const;
+
    bool CorrectForSuperelevation();
    void CorrectForSuperelevation(bool bCorrect);
 
@@ -51,10 +60,27 @@ public:
    const std::vector<SkewLine>& GetSkewLines() const;
    void SetSkewLines(const std::vector<SkewLine>& skewLines);
 
+   // Revision numbers of the input data (see CURVELREVISIONS). The model revision changes when the vertical curves,
+   // horizontal alignment, or superelevation change. The row revisions are in the same order as the rows and
+   // a row gets a new revision when any of its values change.
+   Uint32 GetModelRevision() const;
+   const std::vector<Uint32>& GetIndividualStationRevisions() const;
+   const std::vector<Uint32>& GetStationRangeRevisions() const;
+   const std::vector<Uint32>& GetSkewLineRevisions() const;
+
+   // Initializes a native evaluator with the vertical curve and superelevation data
+   void InitProfileEvaluator(CCurvelProfileEvaluator* pEvaluator);
+
+   // Initializes a native alignment with the horizontal alignment data. Returns false, and
+   // initializes a straight alignment, if there isn't a horizontal alignment
+   bool InitAlignment(CCurvelAlignment* pAlignment);
+
    virtual HRESULT Validate() const override;
 
 protected:
 
+   mutable std::vector<ProfileCurve> m_ProfileCurves;
+   mutable std::vector<HorizontalCurve> m_HorizontalCurves;
    mutable std::vector<IndividualStation> m_IndividualStations;
    mutable std::vector<StationRange> m_StationRanges;
    mutable std::vector<SkewLine> m_SkewLines;
@@ -146,6 +146,7 @@ BOOL CCurvelReportWizardStep3::OnInitDialog()
 
    m_SkewLineGrid.SubclassDlgItem(IDC_SKEW_LINE,this);
    m_SkewLineGrid.CustomInit();
+   m_SkewLineGrid.UseAlignmentRadius(pParent->m_pRptSpec && pParent->m_pRptSpec->HasHorizontalAlignment());
 
    // Put our logo on the dialog
    HICON hIcon = (HICON)LoadImage(AfxGetResourceHandle(),MAKEINTRESOURCE(IDR_CURVEL),IMAGE_ICON,0,0,LR_DEFAULTSIZE);
@@ -40,7 +40,8 @@ static char THIS_FILE[] = __FILE__;
 /////////////////////////////////////////////////////////////////////////////
 // CCurvelSkewLineGrid
 
-CCurvelSkewLineGrid::CCurvelSkewLineGrid()
+CCurvelSkewLineGrid::CCurvelSkewLineGrid() :
+m_bUseAlignmentRadius(false)
 {
 //   RegisterClass();
    m_objStation.CoCreateInstance(CLSID_Station);
@@ -87,6 +88,35 @@ void CCurvelSkewLineGrid::CorrectForSuperelevation(bool bCorrect)
    // No corrections
 }
 
+void CCurvelSkewLineGrid::UseAlignmentRadius(bool bUseAlignment)
+{
+   m_bUseAlignmentRadius = bUseAlignment;
+
+   GetParam()->EnableUndo(FALSE);
+   ROWCOL nRows = GetRowCount();
+   for ( ROWCOL row = 1; row <= nRows; row++ )
+   {
+      UpdateRadiusStyle(row);
+   }
+   GetParam()->EnableUndo(TRUE);
+}
+
+void CCurvelSkewLineGrid::UpdateRadiusStyle(ROWCOL nRow)
+{
+   const ROWCOL radiusCol = 5;
+   CGXStyle style;
+   if ( m_bUseAlignmentRadius )
+   {
+      style.SetReadOnly(TRUE).SetEnabled(FALSE).SetInterior(::GetSysColor(COLOR_BTNFACE)).SetTextColor(::GetSysColor(COLOR_GRAYTEXT));
+   }
+   else
+   {
+      style.SetReadOnly(FALSE).SetEnabled(TRUE).SetInterior(::GetSysColor(COLOR_WINDOW)).SetTextColor(::GetSysColor(COLOR_WINDOWTEXT));
+   }
+
+   SetStyleRange(CGXRange(nRow,radiusCol),style);
+}
+
 void CCurvelSkewLineGrid::CustomInit()
 {
    // Initialize the grid. For CWnd based grids this call is // 
@@ -215,6 +245,8 @@ void CCurvelSkewLineGrid::InsertSkewLine(const SkewLine& skewLine)
       .SetValue(GetOffset(skewLine.CrownOffset,pDispUnits->AlignmentLength))
          );
 
+   UpdateRadiusStyle(nRow);
+
    ResizeColWidthsToFit(CGXRange().SetCols(0,GetColCount()));
 
    SetCurrentCell(nRow, GetLeftCol(), GX_SCROLLINVIEW|GX_DISPLAYEDITWND);
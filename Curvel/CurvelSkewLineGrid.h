@@ -66,9 +66,11 @@ protected:
    virtual BOOL OnEndEditing(ROWCOL nRow,ROWCOL nCol) override;
 
    void UpdateColumnHeaders();
+   void UpdateRadiusStyle(ROWCOL nRow);
 
    CComPtr<IStation> m_objStation;
    CComPtr<IAngle> m_objAngle;
+   bool m_bUseAlignmentRadius;
 
 public:
    // custom stuff for grid
@@ -76,6 +78,10 @@ public:
 
    void CorrectForSuperelevation(bool bCorrect);
 
+   // When the document has a horizontal alignment, the radius of the L-Line comes from the alignment
+   // and the radius column is read only
+   void UseAlignmentRadius(bool bUseAlignment);
+
    void SetSkewLines(const std::vector<SkewLine>& skewLine);
    std::vector<SkewLine> GetSkewLines();
 
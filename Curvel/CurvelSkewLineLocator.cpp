@@ -0,0 +1,233 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "CurvelSkewLineLocator.h"
+#include "..\BEToolboxUtilities.h"
+#include <Math\QuadraticSolver.h>
+#include <set>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+// Skew lines are located in parallel when there are at least this many of them
+static const IndexType gs_ParallelThreshold = 256;
+
+void CURVELSKEWLINES::Clear()
+{
+   Station.clear();
+   OffsetType.clear();
+   Offset.clear();
+   SkewAngle.clear();
+   Radius.clear();
+   CrownOffset.clear();
+   SkewDistance.clear();
+   OffsetStation.clear();
+   OffsetDistance.clear();
+}
+
+void CURVELSKEWLINES::Reserve(IndexType nSkewLines)
+{
+   Station.reserve(nSkewLines);
+   OffsetType.reserve(nSkewLines);
+   Offset.reserve(nSkewLines);
+   SkewAngle.reserve(nSkewLines);
+   Radius.reserve(nSkewLines);
+   CrownOffset.reserve(nSkewLines);
+}
+
+IndexType CURVELSKEWLINES::Add(const SkewLine& skewLine,Float64 skewAngle)
+{
+   Station.push_back(skewLine.Station);
+   OffsetType.push_back(skewLine.OffsetType);
+   Offset.push_back(skewLine.Offset);
+   SkewAngle.push_back(skewAngle);
+   Radius.push_back(skewLine.Radius);
+   CrownOffset.push_back(skewLine.CrownOffset);
+   return Station.size()-1;
+}
+
+void CURVELSKEWLINES::Resize(IndexType nSkewLines)
+{
+   Station.resize(nSkewLines);
+   OffsetType.resize(nSkewLines);
+   Offset.resize(nSkewLines);
+   SkewAngle.resize(nSkewLines);
+   Radius.resize(nSkewLines);
+   CrownOffset.resize(nSkewLines);
+   SkewDistance.resize(nSkewLines);
+   OffsetStation.resize(nSkewLines);
+   OffsetDistance.resize(nSkewLines);
+}
+
+void CURVELSKEWLINES::CopySkewLine(IndexType idx,const CURVELSKEWLINES& skewLines,IndexType skewIdx)
+{
+   Station[idx]        = skewLines.Station[skewIdx];
+   OffsetType[idx]     = skewLines.OffsetType[skewIdx];
+   Offset[idx]         = skewLines.Offset[skewIdx];
+   SkewAngle[idx]      = skewLines.SkewAngle[skewIdx];
+   Radius[idx]         = skewLines.Radius[skewIdx];
+   CrownOffset[idx]    = skewLines.CrownOffset[skewIdx];
+   SkewDistance[idx]   = skewLines.SkewDistance[skewIdx];
+   OffsetStation[idx]  = skewLines.OffsetStation[skewIdx];
+   OffsetDistance[idx] = skewLines.OffsetDistance[skewIdx];
+}
+
+CCurvelSkewLineLocator::CCurvelSkewLineLocator()
+{
+   m_pAlignment = nullptr;
+}
+
+void CCurvelSkewLineLocator::SetAlignment(const CCurvelAlignment* pAlignment)
+{
+   m_pAlignment = pAlignment;
+}
+
+const CCurvelAlignment& CCurvelSkewLineLocator::GetCurve(Float64 radius)
+{
+   auto found = m_Curves.find(radius);
+   if ( found != m_Curves.end() )
+   {
+      return found->second;
+   }
+
+   // A 15 degree curve that turns right for positive radius. The PI station puts the
+   // middle of the curve at station 0.
+   std::vector<HorizontalCurve> curves;
+   if ( !IsZero(radius) )
+   {
+      Float64 delta = ::ToRadians(15.0);
+      Float64 R = fabs(radius);
+
+      HorizontalCurve curve;
+      curve.PIStation = R*tan(delta/2) - R*delta/2;
+      curve.FwdTangent = (0 < radius ? -delta : delta);
+      curve.Radius = R;
+      curves.push_back(curve);
+   }
+
+   CCurvelAlignment& alignment = m_Curves[radius];
+   alignment.Init(0.0,curves);
+   return alignment;
+}
+
+void CCurvelSkewLineLocator::Locate(CURVELSKEWLINES* pSkewLines)
+{
+   IndexType nSkewLines = pSkewLines->GetCount();
+   pSkewLines->SkewDistance.resize(nSkewLines);
+   pSkewLines->OffsetStation.resize(nSkewLines);
+   pSkewLines->OffsetDistance.resize(nSkewLines);
+
+   if ( m_pAlignment )
+   {
+      m_pAlignment->Evaluate(nSkewLines,pSkewLines->Station.data(),nullptr,nullptr,nullptr,pSkewLines->Radius.data());
+   }
+   else
+   {
+      // curves for radii that are no longer used are dropped so the cache doesn't grow as the skew lines are edited
+      std::set<Float64> radii(pSkewLines->Radius.begin(),pSkewLines->Radius.end());
+      for ( auto iter = m_Curves.begin(); iter != m_Curves.end(); )
+      {
+         iter = (radii.find(iter->first) == radii.end() ? m_Curves.erase(iter) : std::next(iter));
+      }
+
+      // build the curves before going parallel so the workers only read the curve cache
+      for ( Float64 radius : radii )
+      {
+         GetCurve(radius);
+      }
+   }
+
+   if ( nSkewLines < gs_ParallelThreshold )
+   {
+      Locate(pSkewLines,0,nSkewLines);
+   }
+   else
+   {
+      ParallelFor(nSkewLines,[this,pSkewLines](IndexType /*threadIdx*/,IndexType beginIdx,IndexType endIdx) {Locate(pSkewLines,beginIdx,endIdx);});
+   }
+}
+
+void CCurvelSkewLineLocator::Locate(CURVELSKEWLINES* pSkewLines,IndexType beginIdx,IndexType endIdx) const
+{
+   for ( IndexType i = beginIdx; i < endIdx; i++ )
+   {
+      Float64 station     = pSkewLines->Station[i];
+      Float64 offset      = pSkewLines->Offset[i];
+      Float64 skewAngle   = pSkewLines->SkewAngle[i];
+      Float64 radius      = pSkewLines->Radius[i];
+      Float64 crownOffset = pSkewLines->CrownOffset[i];
+
+      // The circular curves are centered on station 0 so the skew line station is shifted
+      // onto the curve and the offset point station is shifted back
+      const CCurvelAlignment& alignment = (m_pAlignment ? *m_pAlignment : m_Curves.find(radius)->second);
+      Float64 stationShift = (m_pAlignment ? 0.0 : station);
+
+      Float64 skewDistance = offset;
+      if ( pSkewLines->OffsetType[i] == SkewLine::RadialFromCrownLine )
+      {
+         if ( IsZero(radius) )
+         {
+            skewDistance = (offset - crownOffset)/cos(fabs(skewAngle));
+         }
+         else
+         {
+            // Using the law of cosines, compute the distance along the skew line
+            Float64 A,B,a;
+            A = radius - (offset - crownOffset);
+            B = radius;
+            a = M_PI - skewAngle;
+
+            Float64 k1 = 1.0;
+            Float64 k2 = -2*B*cos(a);
+            Float64 k3 = B*B - A*A;
+
+            mathQuadraticSolver qSolver(k1,k2,k3);
+            Float64 C1,C2;
+            int nRoots = qSolver.Solve(&C1,&C2);
+            ATLASSERT(nRoots == 2);
+            Float64 C = (radius < 0 ? C2 : C1);
+
+            skewDistance = -C;
+         }
+      }
+
+      // Move along the skew line from the L Line. The skew angle is measured from the normal,
+      // which points to the right of the L Line
+      Float64 x, y, bearing;
+      Float64 localStation = station - stationShift;
+      alignment.Evaluate(1,&localStation,&x,&y,&bearing,nullptr);
+      Float64 direction = bearing - M_PI/2 + skewAngle;
+      x += skewDistance*cos(direction);
+      y += skewDistance*sin(direction);
+
+      Float64 offsetStation, offsetDistance;
+      alignment.ProjectPoint(x,y,&offsetStation,&offsetDistance);
+
+      pSkewLines->SkewDistance[i]   = skewDistance;
+      pSkewLines->OffsetStation[i]  = offsetStation + stationShift;
+      pSkewLines->OffsetDistance[i] = offsetDistance;
+   }
+}
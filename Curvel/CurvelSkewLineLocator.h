@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CurvelAlignment.h"
+#include <map>
+
+// Skew lines to be located and the location of the point at the end of each skew line. The values
+// are stored in contiguous arrays so all of the skew lines are located in a single pass.
+struct CURVELSKEWLINES
+{
+   std::vector<Float64> Station; // input - station where the skew line crosses the L Line
+   std::vector<SkewLine::Type> OffsetType; // input
+   std::vector<Float64> Offset; // input
+   std::vector<Float64> SkewAngle; // input - skew angle in radians, measured counter-clockwise from the normal to the L Line
+   std::vector<Float64> Radius; // input - radius of the L Line. When skew lines are located on an alignment, this is the radius of the alignment
+   std::vector<Float64> CrownOffset; // input
+   std::vector<Float64> SkewDistance; // distance along the skew line from the L Line to the offset point
+   std::vector<Float64> OffsetStation; // station and offset of the offset point
+   std::vector<Float64> OffsetDistance;
+
+   void Clear();
+   void Reserve(IndexType nSkewLines);
+   IndexType Add(const SkewLine& skewLine,Float64 skewAngle); // returns the index of the skew line
+   IndexType GetCount() const { return Station.size(); }
+   void Resize(IndexType nSkewLines); // resizes the inputs and results
+   void CopySkewLine(IndexType idx,const CURVELSKEWLINES& skewLines,IndexType skewIdx); // copies a skew line and its results from skewLines to idx
+};
+
+// Native locator for the offset points of Curvel skew lines.
+//
+// The offset point of a skew line is found by moving along the skew line from the L Line and projecting
+// the point back onto the L Line. Without a horizontal alignment, each skew line is on a circular curve
+// with the skew line radius that is centered on the skew line station. These curves only depend on the radius
+// so they are built once for each radius and kept for later reports. Only the curves for the radii of the skew
+// lines that were last located are kept. The point location and projection are closed form on the tangents and
+// arcs of the alignment.
+class CCurvelSkewLineLocator
+{
+public:
+   CCurvelSkewLineLocator();
+
+   // Skew lines are located on pAlignment. If pAlignment is nullptr, each skew line is located
+   // on a circular curve with its radius
+   void SetAlignment(const CCurvelAlignment* pAlignment);
+
+   // Locates the offset points of all of the skew lines. Large sets of skew lines are located in parallel.
+   void Locate(CURVELSKEWLINES* pSkewLines);
+
+   // Returns the circular curve alignment for a radius. The middle of the curve is at station 0.
+   const CCurvelAlignment& GetCurve(Float64 radius);
+
+private:
+   const CCurvelAlignment* m_pAlignment;
+   std::map<Float64,CCurvelAlignment> m_Curves; // circular curves, by radius
+
+   void Locate(CURVELSKEWLINES* pSkewLines,IndexType beginIdx,IndexType endIdx) const;
+};
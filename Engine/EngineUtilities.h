@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+// Portable numerical engine. The headers in this directory are standard C++17 and don't include
+// any Windows, MFC, ATL, COM, or WBFL headers so the engines can be compiled on any platform
+// (see CMakeLists.txt). The BEToolbox documents are thin adapters over these engines.
+//
+// Everything is in the BEToolboxEngine namespace so the engine types and functions don't collide
+// with the WBFL types and functions of the same name when they are used together.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace BEToolboxEngine
+{
+   using Float64 = double;
+   using IndexType = std::size_t;
+   using Uint32 = std::uint32_t;
+
+   constexpr Float64 Pi = 3.1415926535897932384626433832795;
+   constexpr Float64 MaxFloat64 = (std::numeric_limits<Float64>::max)();
+
+   // Same tolerance as the WBFL IsZero and IsEqual
+   inline bool IsZero(Float64 value,Float64 tolerance = 1.0e-6)
+   {
+      return -tolerance < value && value < tolerance;
+   }
+
+   inline bool IsEqual(Float64 a,Float64 b,Float64 tolerance = 1.0e-6)
+   {
+      return IsZero(b - a,tolerance);
+   }
+
+   // Returns the number of worker threads to use for parallel evaluation of nItems independent items
+   inline IndexType GetWorkerThreadCount(IndexType nItems)
+   {
+      IndexType nThreads = (std::max)((IndexType)std::thread::hardware_concurrency(),(IndexType)1);
+      return (std::max)((std::min)(nThreads,nItems),(IndexType)1);
+   }
+
+   // Partitions the range [0,nItems) into contiguous blocks, one per worker thread, and
+   // calls fn(threadIdx,beginIdx,endIdx) for each block. The calling thread evaluates the last block.
+   // fn must not make COM calls or touch MFC/EAF objects since it runs outside of the UI thread.
+   template <class F>
+   IndexType ParallelFor(IndexType nItems,F fn)
+   {
+      IndexType nThreads = GetWorkerThreadCount(nItems);
+      IndexType nPerThread = nItems/nThreads;
+      IndexType nExtra = nItems%nThreads;
+
+      std::vector<std::thread> threads;
+      threads.reserve(nThreads-1);
+      IndexType begin = 0;
+      for ( IndexType threadIdx = 0; threadIdx < nThreads; threadIdx++ )
+      {
+         IndexType end = begin + nPerThread + (threadIdx < nExtra ? 1 : 0);
+         if ( threadIdx == nThreads-1 )
+         {
+            fn(threadIdx,begin,end);
+         }
+         else
+         {
+            threads.emplace_back(fn,threadIdx,begin,end);
+         }
+         begin = end;
+      }
+
+      for ( auto& thread : threads )
+      {
+         thread.join();
+      }
+
+      return nThreads;
+   }
+
+   // Returns the index of the segment containing station. vStart is the sorted start location of each segment.
+   // The first segment extends back and the last segment extends forward indefinitely. Sorted locations advance
+   // through the segments so the segment of the previous location, hint, and the segment that follows it are
+   // tried before searching the segment index.
+   inline IndexType FindSegment(const std::vector<Float64>& vStart,Float64 station,IndexType hint)
+   {
+      const IndexType nSegments = vStart.size();
+      assert(hint < nSegments);
+      if ( hint == 0 || vStart[hint] <= station )
+      {
+         if ( hint+1 == nSegments || station < vStart[hint+1] )
+         {
+            return hint;
+         }
+
+         if ( hint+2 == nSegments || station < vStart[hint+2] )
+         {
+            return hint+1;
+         }
+      }
+
+      auto begin = vStart.cbegin();
+      auto found = std::upper_bound(begin+1,vStart.cend(),station);
+      return (IndexType)(found - begin) - 1;
+   }
+}
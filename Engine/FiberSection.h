@@ -0,0 +1,866 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+// Native fiber section model for UltCol. Used in place of the WBFL RoundColumn object
+// so the interaction diagram can be computed with many points, and for sections the
+// RoundColumn can't model.
+
+#include "SectionProperties.h"
+#include <functional>
+#include <memory>
+
+#if defined _M_X64 || (defined _M_IX86_FP && 2 <= _M_IX86_FP) || defined __SSE2__
+#define BETOOLBOX_FIBER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace BEToolboxEngine
+{
+   // A point on the interaction diagram. Compression is negative (same as the WBFL RoundColumn)
+   struct INTERACTIONPOINT
+   {
+      Float64 c;   // depth of the neutral axis measured from the extreme compression fiber
+      Float64 et;  // strain in the extreme tension reinforcement (tension is positive)
+      Float64 phi; // resistance factor
+      Float64 Pn;  // nominal axial capacity
+      Float64 Mn;  // nominal moment capacity about the neutral axis
+      Float64 Pr;  // factored axial capacity (phi*Pn)
+      Float64 Mr;  // factored moment capacity (phi*Mn)
+      Float64 Mnx; // components of the nominal moment capacity about the x and y axes. Mnx is positive when
+      Float64 Mny; // the compression is on the +y side of the section and Mny is positive when it is on the +x side
+   };
+
+   // Fibers in the coordinate system of a neutral axis, for analyses that use the stress-strain relationships of the materials
+   struct FIBERS
+   {
+      std::vector<Float64> ConcreteY;   // elevation of the fiber, normal to the neutral axis and positive towards the compression face
+      std::vector<Float64> ConfinedA;   // area of the fiber inside the confined core
+      std::vector<Float64> UnconfinedA; // area of the fiber outside of the confined core
+      std::vector<Float64> SteelY;
+      std::vector<Float64> SteelA;      // area of reinforcement
+      Float64 Ytop;   // elevation of the extreme compression fiber
+      Float64 Height; // overall height of the section normal to the neutral axis
+   };
+
+   // Stress block factor, beta1, for concrete with a compressive strength of fc_ksi (LRFD 5.6.2.2)
+   inline Float64 ComputeBeta1(Float64 fc_ksi)
+   {
+      return (std::max)(0.65,(std::min)(0.85 - 0.05*(fc_ksi - 4.0),0.85));
+   }
+
+   // Copies of a section share its fiber mesh. The materials and the area of reinforcement belong to each copy
+   // so they can be changed without discretizing the section again. Initializing a section creates a new mesh.
+   class CFiberSection
+   {
+   public:
+      CFiberSection();
+
+      // Discretizes a round column. The concrete is divided into horizontal strips and the
+      // reinforcement is modeled as a thin ring of steel at the center of the bars (the same
+      // reinforcement model as the WBFL RoundColumn). The section is axisymmetric so capacities
+      // for any neutral axis angle are computed from the strips and rotated. The concrete inside
+      // the center of the bars is the confined core.
+      void InitRoundSection(Float64 diameter,Float64 cover,Float64 As,IndexType nConcreteFibers = 200,IndexType nSteelFibers = 90);
+
+      // Discretizes an arbitrary section. The concrete is defined by polygons stored end to end, as for
+      // ComputeTransformedProperties. Solid polygons have pN[i] = 1 and voids have pN[i] = -1. The concrete is
+      // meshed into square fibers, nCells along the longer side of the section, by clipping the polygons to
+      // each cell. The reinforcement is discrete bars. The concrete inside the rectangle pCore = {xMin,yMin,xMax,yMax}
+      // is the confined core. None of the concrete is confined if pCore is nullptr. Coordinates are shifted so that
+      // the origin is at the centroid of the concrete.
+      void InitSection(const Float64* pX,const Float64* pY,const IndexType* pOffsets,const Float64* pN,IndexType nPolygons,
+                       const Float64* pBarX,const Float64* pBarY,const Float64* pBarArea,IndexType nBars,const Float64* pCore = nullptr,IndexType nCells = 40);
+
+      // beta1 is the stress block factor for the concrete (see ComputeBeta1). It is an argument
+      // so the section doesn't depend on a system of units.
+      void SetMaterials(Float64 fc,Float64 fy,Float64 Es,Float64 beta1);
+
+      // Changes the total area of reinforcement. The bars keep their share of the total area.
+      void SetReinforcementArea(Float64 As);
+      Float64 GetReinforcementArea() const;
+
+      // Computes the nominal capacity for a neutral axis depth, c, measured from the extreme compression fiber.
+      // The neutral axis is at angle, measured counter-clockwise from the x-axis, and the compression is on
+      // the left side of the neutral axis (angle = 0 puts the top of the section in compression).
+      // The concrete is modeled with the equivalent rectangular stress block and the compression fiber strain is 0.003
+      void ComputeCapacity(Float64 angle,Float64 c,Float64 ecl,Float64 etl,INTERACTIONPOINT* pPoint) const;
+
+      // Computes the interaction diagram from pure compression to pure tension. Neutral axis depths are
+      // placed adaptively until the chord error of the nominal and factored curves is less than
+      // tolerance (a fraction of the range of axial and moment capacity), or nMaxPoints are computed.
+      // The points where phi begins and ends its transition (et = ecl and et = etl) are always included.
+      // The initial samples (about 20 points) are always computed, even if nMaxPoints is smaller.
+      void ComputeInteraction(Float64 angle,Float64 ecl,Float64 etl,Float64 tolerance,IndexType nMaxPoints,std::vector<INTERACTIONPOINT>& points) const;
+
+      // Computes nDepths points from pure compression to pure tension. The neutral axis depths have the
+      // same distribution for every angle, including the ends of the phi transition, so the curves for
+      // different angles can be joined into a surface. pPoints must have room for nDepths points.
+      void ComputeMeridian(Float64 angle,Float64 ecl,Float64 etl,IndexType nDepths,INTERACTIONPOINT* pPoints) const;
+
+      // Gets the fibers for a neutral axis at angle (as for ComputeCapacity)
+      void GetFibers(Float64 angle,FIBERS* pFibers) const;
+
+      // Returns true if capacities are the same for every neutral axis angle, apart from the direction of the moment
+      bool IsAxisymmetric() const;
+
+      Float64 GetHeight() const;
+      Float64 GetBeta1() const;
+
+   private:
+      // The fiber mesh is created once and shared by every neutral axis angle, and by copies of the section.
+      // Fibers are stored in contiguous arrays. Coordinates are measured from the centroid.
+      struct MESH
+      {
+         std::vector<Float64> ConcreteX; // location of the center of the fiber
+         std::vector<Float64> ConcreteY;
+         std::vector<Float64> ConcreteW; // width and height of the fiber
+         std::vector<Float64> ConcreteH;
+         std::vector<Float64> ConcreteA; // area of the fiber
+         std::vector<Float64> ConcreteCoreA; // area of the fiber inside the confined core
+         std::vector<Float64> SteelX;
+         std::vector<Float64> SteelY;
+         std::vector<Float64> SteelA;    // fraction of the total area of reinforcement
+         std::vector<Float64> BoundaryX; // vertices of the concrete outline
+         std::vector<Float64> BoundaryY;
+         bool bAxisymmetric;
+      };
+      std::shared_ptr<MESH> m_pMesh;
+
+      Float64 m_As;
+      Float64 m_fc;
+      Float64 m_fy;
+      Float64 m_Es;
+      Float64 m_Beta1;
+
+      // The mesh in the coordinate system of a neutral axis. y is normal to the neutral axis and positive
+      // towards the compression face and x is along the neutral axis. Each angle, and each thread, has its own frame.
+      struct FRAME
+      {
+         Float64 Angle;
+         std::vector<Float64> ConcreteX;
+         std::vector<Float64> ConcreteY;
+         std::vector<Float64> ConcreteH; // height of the fibers normal to the neutral axis
+         std::vector<Float64> SteelX;
+         std::vector<Float64> SteelY;
+         Float64 Ytop;   // elevation of the extreme compression fiber
+         Float64 Height; // overall height of the section
+         Float64 dt;     // depth of the extreme tension reinforcement
+      };
+
+      void InitFrame(Float64 angle,FRAME* pFrame) const;
+
+      // Evaluates the section for the inverse of the neutral axis depth. invC = 0 is pure compression
+      void Evaluate(const FRAME& frame,Float64 invC,Float64 ecl,Float64 etl,INTERACTIONPOINT* pPoint) const;
+      void EvaluateDepth(const FRAME& frame,Float64 c,Float64 ecl,Float64 etl,INTERACTIONPOINT* pPoint) const;
+      Float64 GetDepth(const FRAME& frame,Float64 et) const;
+      Float64 GetPureCompressionDepth(const FRAME& frame) const;
+      void Refine(const FRAME& frame,Float64 c1,const INTERACTIONPOINT& p1,Float64 c2,const INTERACTIONPOINT& p2,Float64 ecl,Float64 etl,Float64 tolerance,Float64 Pscale,Float64 Mscale,int level,IndexType nMaxPoints,std::vector<INTERACTIONPOINT>& points) const;
+   };
+
+   namespace Detail
+   {
+      const Float64 ecu = 0.003; // strain at the extreme compression fiber
+      const int MaxRefinementLevel = 12;
+
+      // Adds the force and moments of the concrete fibers. The concrete above yBlock is stressed to k = 0.85f'c.
+      // Fibers that are cut by the bottom of the stress block contribute in proportion to their height above it.
+      // M is the moment about the x-axis (the neutral axis) and Mt is the moment about the y-axis.
+      inline void AddConcreteFibers(const Float64* pX,const Float64* pY,const Float64* pH,const Float64* pA,IndexType nFibers,Float64 yBlock,Float64 k,Float64* pC,Float64* pM,Float64* pMt)
+      {
+         IndexType i = 0;
+         Float64 C = 0;
+         Float64 M = 0;
+         Float64 Mt = 0;
+
+   #if defined BETOOLBOX_FIBER_SSE2
+         const __m128d vBlock = _mm_set1_pd(yBlock);
+         const __m128d vk = _mm_set1_pd(k);
+         const __m128d zero = _mm_setzero_pd();
+         const __m128d one = _mm_set1_pd(1.0);
+         const __m128d half = _mm_set1_pd(0.5);
+         __m128d vC = _mm_setzero_pd();
+         __m128d vM = _mm_setzero_pd();
+         __m128d vMt = _mm_setzero_pd();
+         for ( ; i + 2 <= nFibers; i += 2 )
+         {
+            __m128d y = _mm_loadu_pd(pY + i);
+            __m128d h = _mm_loadu_pd(pH + i);
+            __m128d top = _mm_add_pd(y,_mm_mul_pd(half,h));
+            __m128d frac = _mm_min_pd(one,_mm_max_pd(zero,_mm_div_pd(_mm_sub_pd(top,vBlock),h)));
+            __m128d F = _mm_mul_pd(_mm_mul_pd(vk,_mm_loadu_pd(pA + i)),frac);
+            vC = _mm_add_pd(vC,F);
+            vM = _mm_add_pd(vM,_mm_mul_pd(F,y));
+            vMt = _mm_add_pd(vMt,_mm_mul_pd(F,_mm_loadu_pd(pX + i)));
+         }
+
+         Float64 lane[2];
+         _mm_storeu_pd(lane,vC);  C  = lane[0] + lane[1];
+         _mm_storeu_pd(lane,vM);  M  = lane[0] + lane[1];
+         _mm_storeu_pd(lane,vMt); Mt = lane[0] + lane[1];
+   #endif // BETOOLBOX_FIBER_SSE2
+
+         for ( ; i < nFibers; i++ )
+         {
+            Float64 frac = (std::max)(0.0,(std::min)((pY[i] + pH[i]/2 - yBlock)/pH[i],1.0));
+            Float64 F = k*pA[i]*frac;
+            C  += F;
+            M  += F*pY[i];
+            Mt += F*pX[i];
+         }
+
+         *pC  += C;
+         *pM  += M;
+         *pMt += Mt;
+      }
+
+      // Adds the force and moments of the reinforcement fibers. The steel is elastic-perfectly plastic. The strain
+      // is ecu at the extreme compression fiber (yTop) and zero at the neutral axis. Concrete displaced by
+      // reinforcement in the stress block (depth a) is removed.
+      inline void AddSteelFibers(const Float64* pX,const Float64* pY,const Float64* pA,IndexType nFibers,Float64 yTop,Float64 invC,Float64 a,Float64 Es,Float64 fy,Float64 k,Float64* pC,Float64* pM,Float64* pMt)
+      {
+         IndexType i = 0;
+         Float64 C = 0;
+         Float64 M = 0;
+         Float64 Mt = 0;
+
+   #if defined BETOOLBOX_FIBER_SSE2
+         const __m128d vTop = _mm_set1_pd(yTop);
+         const __m128d vInvC = _mm_set1_pd(invC);
+         const __m128d va = _mm_set1_pd(a);
+         const __m128d vEs = _mm_set1_pd(Es*ecu);
+         const __m128d vfy = _mm_set1_pd(fy);
+         const __m128d vfyNeg = _mm_set1_pd(-fy);
+         const __m128d vk = _mm_set1_pd(k);
+         const __m128d one = _mm_set1_pd(1.0);
+         __m128d vC = _mm_setzero_pd();
+         __m128d vM = _mm_setzero_pd();
+         __m128d vMt = _mm_setzero_pd();
+         for ( ; i + 2 <= nFibers; i += 2 )
+         {
+            __m128d y = _mm_loadu_pd(pY + i);
+            __m128d d = _mm_sub_pd(vTop,y);
+            __m128d stress = _mm_mul_pd(vEs,_mm_sub_pd(one,_mm_mul_pd(d,vInvC)));
+            stress = _mm_min_pd(vfy,_mm_max_pd(vfyNeg,stress));
+            stress = _mm_sub_pd(stress,_mm_and_pd(_mm_cmple_pd(d,va),vk));
+            __m128d F = _mm_mul_pd(stress,_mm_loadu_pd(pA + i));
+            vC = _mm_add_pd(vC,F);
+            vM = _mm_add_pd(vM,_mm_mul_pd(F,y));
+            vMt = _mm_add_pd(vMt,_mm_mul_pd(F,_mm_loadu_pd(pX + i)));
+         }
+
+         Float64 lane[2];
+         _mm_storeu_pd(lane,vC);  C  = lane[0] + lane[1];
+         _mm_storeu_pd(lane,vM);  M  = lane[0] + lane[1];
+         _mm_storeu_pd(lane,vMt); Mt = lane[0] + lane[1];
+   #endif // BETOOLBOX_FIBER_SSE2
+
+         for ( ; i < nFibers; i++ )
+         {
+            Float64 d = yTop - pY[i];
+            Float64 stress = (std::max)(-fy,(std::min)(Es*ecu*(1 - d*invC),fy));
+            if ( d <= a )
+            {
+               stress -= k;
+            }
+            Float64 F = stress*pA[i];
+            C  += F;
+            M  += F*pY[i];
+            Mt += F*pX[i];
+         }
+
+         *pC  += C;
+         *pM  += M;
+         *pMt += Mt;
+      }
+
+      // Clips a polygon to a rectangle. The clipped polygon is returned in x2/y2. The buffers are resized as needed.
+      inline IndexType ClipToRectangle(const Float64* pX,const Float64* pY,IndexType nPoints,Float64 xMin,Float64 yMin,Float64 xMax,Float64 yMax,
+                                std::vector<Float64>& x1,std::vector<Float64>& y1,std::vector<Float64>& x2,std::vector<Float64>& y2)
+      {
+         // each clip can double the number of points
+         IndexType nMax = 16*nPoints;
+         if ( x1.size() < nMax )
+         {
+            x1.resize(nMax);
+            y1.resize(nMax);
+            x2.resize(nMax);
+            y2.resize(nMax);
+         }
+
+         // vertical lines are clipped by swapping x and y
+         IndexType n = ClipPolygon(pY,pX,nPoints,xMin,true,y1.data(),x1.data());
+         n = ClipPolygon(y1.data(),x1.data(),n,xMax,false,y2.data(),x2.data());
+         n = ClipPolygon(x2.data(),y2.data(),n,yMin,true,x1.data(),y1.data());
+         return ClipPolygon(x1.data(),y1.data(),n,yMax,false,x2.data(),y2.data());
+      }
+
+      // Distance from point p to the chord (p1,p2) in a normalized space
+      inline Float64 ChordError(Float64 M,Float64 P,Float64 M1,Float64 P1,Float64 M2,Float64 P2,Float64 Mscale,Float64 Pscale)
+      {
+         Float64 x  = M/Mscale,  y  = P/Pscale;
+         Float64 x1 = M1/Mscale, y1 = P1/Pscale;
+         Float64 x2 = M2/Mscale, y2 = P2/Pscale;
+         Float64 dx = x2 - x1;
+         Float64 dy = y2 - y1;
+         Float64 L = sqrt(dx*dx + dy*dy);
+         if ( IsZero(L) )
+         {
+            return sqrt((x - x1)*(x - x1) + (y - y1)*(y - y1));
+         }
+         return fabs(dy*(x - x1) - dx*(y - y1))/L;
+      }
+   }
+
+
+   inline CFiberSection::CFiberSection()
+   {
+      m_pMesh = std::make_shared<MESH>();
+      m_pMesh->bAxisymmetric = false;
+      m_As = 0;
+      m_fc = 0;
+      m_fy = 0;
+      m_Es = 0;
+      m_Beta1 = 0.85;
+   }
+
+   inline void CFiberSection::InitRoundSection(Float64 diameter,Float64 cover,Float64 As,IndexType nConcreteFibers,IndexType nSteelFibers)
+   {
+      assert(0 < nConcreteFibers && 0 < nSteelFibers);
+
+      // create a new mesh. copies of this section keep using the old mesh
+      std::shared_ptr<MESH> pMesh(std::make_shared<MESH>());
+
+      Float64 r = diameter/2;
+      pMesh->bAxisymmetric = true;
+
+      // Only the top and bottom of the outline are needed since the section is only evaluated with the neutral axis horizontal
+      pMesh->BoundaryX.assign({0.0,0.0});
+      pMesh->BoundaryY.assign({r,-r});
+
+      // Concrete strips of equal height. The area of each strip is the exact area of the
+      // circle between the top and bottom of the strip.
+      pMesh->ConcreteX.assign(nConcreteFibers,0.0);
+      pMesh->ConcreteY.resize(nConcreteFibers);
+      pMesh->ConcreteW.resize(nConcreteFibers);
+      pMesh->ConcreteH.resize(nConcreteFibers);
+      pMesh->ConcreteA.resize(nConcreteFibers);
+      pMesh->ConcreteCoreA.resize(nConcreteFibers);
+      Float64 h = diameter/nConcreteFibers;
+      auto areaBelow = [](Float64 r,Float64 y)
+      {
+         // area of a circle of radius r below elevation y
+         Float64 t = (std::max)(-1.0,(std::min)(y/r,1.0));
+         return r*r*(asin(t) + t*sqrt(1 - t*t) + Pi/2);
+      };
+      Float64 rc = r - cover; // radius of the confined core
+      for ( IndexType i = 0; i < nConcreteFibers; i++ )
+      {
+         Float64 yBottom = -r + i*h;
+         pMesh->ConcreteY[i] = yBottom + h/2;
+         pMesh->ConcreteH[i] = h;
+         pMesh->ConcreteA[i] = areaBelow(r,yBottom + h) - areaBelow(r,yBottom);
+         pMesh->ConcreteCoreA[i] = (0 < rc ? areaBelow(rc,yBottom + h) - areaBelow(rc,yBottom) : 0.0);
+         pMesh->ConcreteW[i] = pMesh->ConcreteA[i]/h;
+      }
+
+      // Steel ring at the center of the bars. The fiber areas are fractions of the total area of reinforcement.
+      Float64 rs = r - cover;
+      pMesh->SteelX.resize(nSteelFibers);
+      pMesh->SteelY.resize(nSteelFibers);
+      pMesh->SteelA.resize(nSteelFibers);
+      for ( IndexType i = 0; i < nSteelFibers; i++ )
+      {
+         Float64 angle = 2*Pi*(i + 0.5)/nSteelFibers;
+         pMesh->SteelX[i] = rs*cos(angle);
+         pMesh->SteelY[i] = rs*sin(angle);
+         pMesh->SteelA[i] = 1.0/nSteelFibers;
+      }
+
+      m_pMesh = pMesh;
+      m_As = As;
+   }
+
+   inline void CFiberSection::InitSection(const Float64* pX,const Float64* pY,const IndexType* pOffsets,const Float64* pN,IndexType nPolygons,
+                                         const Float64* pBarX,const Float64* pBarY,const Float64* pBarArea,IndexType nBars,const Float64* pCore,IndexType nCells)
+   {
+      assert(0 < nPolygons && 0 < nCells);
+
+      std::shared_ptr<MESH> pMesh(std::make_shared<MESH>());
+      pMesh->bAxisymmetric = false;
+
+      // extents of the solid polygons
+      Float64 xMin = MaxFloat64, xMax = -MaxFloat64, yMin = MaxFloat64, yMax = -MaxFloat64;
+      IndexType nMaxPoints = 0;
+      for ( IndexType p = 0; p < nPolygons; p++ )
+      {
+         nMaxPoints = (std::max)(nMaxPoints,pOffsets[p+1] - pOffsets[p]);
+         if ( pN[p] <= 0 )
+         {
+            continue;
+         }
+
+         for ( IndexType i = pOffsets[p]; i < pOffsets[p+1]; i++ )
+         {
+            xMin = (std::min)(xMin,pX[i]);
+            xMax = (std::max)(xMax,pX[i]);
+            yMin = (std::min)(yMin,pY[i]);
+            yMax = (std::max)(yMax,pY[i]);
+            pMesh->BoundaryX.push_back(pX[i]);
+            pMesh->BoundaryY.push_back(pY[i]);
+         }
+      }
+      assert(xMin < xMax && yMin < yMax);
+
+      // square cells, adjusted to fit the extents exactly
+      Float64 size = (std::max)(xMax - xMin,yMax - yMin)/nCells;
+      IndexType nx = (std::max)((IndexType)1,(IndexType)ceil((xMax - xMin)/size - 0.001));
+      IndexType ny = (std::max)((IndexType)1,(IndexType)ceil((yMax - yMin)/size - 0.001));
+      Float64 dx = (xMax - xMin)/nx;
+      Float64 dy = (yMax - yMin)/ny;
+
+      // Each clip adds at most one point per edge. Polygons are clipped to a column of cells (two clips)
+      // and then to a cell (two more clips)
+      std::vector<Float64> columnX(nPolygons*4*nMaxPoints), columnY(nPolygons*4*nMaxPoints);
+      std::vector<IndexType> nColumnPoints(nPolygons);
+      std::vector<Float64> x1(16*nMaxPoints), y1(16*nMaxPoints), x2(16*nMaxPoints), y2(16*nMaxPoints);
+      std::vector<Float64> xCore1, yCore1, xCore2, yCore2;
+
+      Float64 minArea = 1.0e-6*dx*dy;
+      for ( IndexType i = 0; i < nx; i++ )
+      {
+         Float64 xLeft  = xMin + i*dx;
+         Float64 xRight = xLeft + dx;
+         for ( IndexType p = 0; p < nPolygons; p++ )
+         {
+            // clip to the column by swapping x and y so the clipping line is vertical
+            IndexType first = pOffsets[p];
+            IndexType n = ClipPolygon(pY + first,pX + first,pOffsets[p+1] - first,xLeft,true,y1.data(),x1.data());
+            nColumnPoints[p] = ClipPolygon(y1.data(),x1.data(),n,xRight,false,&columnY[p*4*nMaxPoints],&columnX[p*4*nMaxPoints]);
+         }
+
+         for ( IndexType j = 0; j < ny; j++ )
+         {
+            Float64 yBottom = yMin + j*dy;
+
+            // part of the cell inside the confined core
+            Float64 cxLeft   = (pCore ? (std::max)(xLeft,pCore[0]) : 0.0);
+            Float64 cyBottom = (pCore ? (std::max)(yBottom,pCore[1]) : 0.0);
+            Float64 cxRight  = (pCore ? (std::min)(xRight,pCore[2]) : 0.0);
+            Float64 cyTop    = (pCore ? (std::min)(yBottom + dy,pCore[3]) : 0.0);
+            bool bCore = (cxLeft < cxRight && cyBottom < cyTop);
+            bool bCellInCore = (bCore && IsEqual(cxRight - cxLeft,dx) && IsEqual(cyTop - cyBottom,dy));
+
+            Float64 A = 0, Qx = 0, Qy = 0, Acore = 0;
+            for ( IndexType p = 0; p < nPolygons; p++ )
+            {
+               if ( nColumnPoints[p] < 3 )
+               {
+                  continue;
+               }
+
+               IndexType n = ClipPolygon(&columnX[p*4*nMaxPoints],&columnY[p*4*nMaxPoints],nColumnPoints[p],yBottom,true,x1.data(),y1.data());
+               n = ClipPolygon(x1.data(),y1.data(),n,yBottom + dy,false,x2.data(),y2.data());
+               if ( n < 3 )
+               {
+                  continue;
+               }
+
+               POLYGONPROPERTIES props;
+               ComputePolygonProperties(x2.data(),y2.data(),n,&props);
+               A  += pN[p]*props.Area;
+               Qx += pN[p]*props.Area*props.Ybar;
+               Qy += pN[p]*props.Area*props.Xbar;
+
+               if ( bCore && !bCellInCore )
+               {
+                  // clip the part of the polygon in the cell to the core
+                  IndexType nCore = Detail::ClipToRectangle(x2.data(),y2.data(),n,cxLeft,cyBottom,cxRight,cyTop,xCore1,yCore1,xCore2,yCore2);
+                  if ( 3 <= nCore )
+                  {
+                     ComputePolygonProperties(xCore2.data(),yCore2.data(),nCore,&props);
+                     Acore += pN[p]*props.Area;
+                  }
+               }
+            }
+
+            if ( bCellInCore )
+            {
+               Acore = A;
+            }
+
+            if ( minArea < A )
+            {
+               pMesh->ConcreteX.push_back(Qy/A);
+               pMesh->ConcreteY.push_back(Qx/A);
+               pMesh->ConcreteW.push_back(dx);
+               pMesh->ConcreteH.push_back(dy);
+               pMesh->ConcreteA.push_back(A);
+               pMesh->ConcreteCoreA.push_back((std::max)(0.0,(std::min)(Acore,A)));
+            }
+         }
+      }
+
+      pMesh->SteelX.assign(pBarX,pBarX + nBars);
+      pMesh->SteelY.assign(pBarY,pBarY + nBars);
+      pMesh->SteelA.assign(pBarArea,pBarArea + nBars);
+
+      // the bar areas are stored as fractions of the total area of reinforcement
+      m_As = 0;
+      for ( IndexType i = 0; i < nBars; i++ )
+      {
+         m_As += pBarArea[i];
+      }
+      if ( 0 < m_As )
+      {
+         for ( auto& area : pMesh->SteelA )
+         {
+            area /= m_As;
+         }
+      }
+
+      // measure everything from the centroid of the concrete
+      Float64 A = 0, Qx = 0, Qy = 0;
+      IndexType nFibers = pMesh->ConcreteA.size();
+      for ( IndexType i = 0; i < nFibers; i++ )
+      {
+         A  += pMesh->ConcreteA[i];
+         Qx += pMesh->ConcreteA[i]*pMesh->ConcreteY[i];
+         Qy += pMesh->ConcreteA[i]*pMesh->ConcreteX[i];
+      }
+      assert(0 < A);
+      Float64 xc = Qy/A;
+      Float64 yc = Qx/A;
+      auto shift = [](std::vector<Float64>& v,Float64 d) { for ( auto& value : v ) { value -= d; } };
+      shift(pMesh->ConcreteX,xc);
+      shift(pMesh->ConcreteY,yc);
+      shift(pMesh->SteelX,xc);
+      shift(pMesh->SteelY,yc);
+      shift(pMesh->BoundaryX,xc);
+      shift(pMesh->BoundaryY,yc);
+
+      m_pMesh = pMesh;
+   }
+
+   inline void CFiberSection::SetReinforcementArea(Float64 As)
+   {
+      m_As = As;
+   }
+
+   inline Float64 CFiberSection::GetReinforcementArea() const
+   {
+      return m_As;
+   }
+
+   inline void CFiberSection::SetMaterials(Float64 fc,Float64 fy,Float64 Es,Float64 beta1)
+   {
+      m_fc = fc;
+      m_fy = fy;
+      m_Es = Es;
+      m_Beta1 = beta1;
+   }
+
+   inline void CFiberSection::GetFibers(Float64 angle,FIBERS* pFibers) const
+   {
+      FRAME frame;
+      InitFrame(angle,&frame);
+
+      pFibers->ConcreteY = frame.ConcreteY;
+      pFibers->ConfinedA = m_pMesh->ConcreteCoreA;
+      IndexType nFibers = m_pMesh->ConcreteA.size();
+      pFibers->UnconfinedA.resize(nFibers);
+      for ( IndexType i = 0; i < nFibers; i++ )
+      {
+         pFibers->UnconfinedA[i] = m_pMesh->ConcreteA[i] - m_pMesh->ConcreteCoreA[i];
+      }
+
+      pFibers->SteelY = frame.SteelY;
+      pFibers->SteelA.resize(m_pMesh->SteelA.size());
+      std::transform(m_pMesh->SteelA.cbegin(),m_pMesh->SteelA.cend(),pFibers->SteelA.begin(),[this](Float64 fraction) {return fraction*m_As;});
+
+      pFibers->Ytop = frame.Ytop;
+      pFibers->Height = frame.Height;
+   }
+
+   inline bool CFiberSection::IsAxisymmetric() const
+   {
+      return m_pMesh->bAxisymmetric;
+   }
+
+   inline Float64 CFiberSection::GetHeight() const
+   {
+      if ( m_pMesh->BoundaryY.empty() )
+      {
+         return 0;
+      }
+
+      auto extents = std::minmax_element(m_pMesh->BoundaryY.cbegin(),m_pMesh->BoundaryY.cend());
+      return *extents.second - *extents.first;
+   }
+
+   inline Float64 CFiberSection::GetBeta1() const
+   {
+      return m_Beta1;
+   }
+
+   inline void CFiberSection::InitFrame(Float64 angle,FRAME* pFrame) const
+   {
+      pFrame->Angle = angle;
+
+      // axisymmetric sections are always evaluated with the neutral axis horizontal and the moments are rotated
+      Float64 sin_angle = (m_pMesh->bAxisymmetric ? 0.0 : sin(angle));
+      Float64 cos_angle = (m_pMesh->bAxisymmetric ? 1.0 : cos(angle));
+
+      // x' = r.t and y' = r.n where t = (cos,sin) is along the neutral axis and n = (-sin,cos) points to the compression face
+      auto rotate = [sin_angle,cos_angle](const std::vector<Float64>& x,const std::vector<Float64>& y,std::vector<Float64>& xr,std::vector<Float64>& yr)
+      {
+         IndexType n = x.size();
+         xr.resize(n);
+         yr.resize(n);
+         for ( IndexType i = 0; i < n; i++ )
+         {
+            xr[i] =  x[i]*cos_angle + y[i]*sin_angle;
+            yr[i] = -x[i]*sin_angle + y[i]*cos_angle;
+         }
+      };
+
+      rotate(m_pMesh->ConcreteX,m_pMesh->ConcreteY,pFrame->ConcreteX,pFrame->ConcreteY);
+      rotate(m_pMesh->SteelX,m_pMesh->SteelY,pFrame->SteelX,pFrame->SteelY);
+
+      // height of the fibers normal to the neutral axis
+      IndexType nFibers = m_pMesh->ConcreteH.size();
+      pFrame->ConcreteH.resize(nFibers);
+      Float64 abs_sin = fabs(sin_angle);
+      Float64 abs_cos = fabs(cos_angle);
+      for ( IndexType i = 0; i < nFibers; i++ )
+      {
+         pFrame->ConcreteH[i] = m_pMesh->ConcreteW[i]*abs_sin + m_pMesh->ConcreteH[i]*abs_cos;
+      }
+
+      Float64 yTop = -MaxFloat64, yBottom = MaxFloat64;
+      IndexType nVertices = m_pMesh->BoundaryX.size();
+      for ( IndexType i = 0; i < nVertices; i++ )
+      {
+         Float64 y = -m_pMesh->BoundaryX[i]*sin_angle + m_pMesh->BoundaryY[i]*cos_angle;
+         yTop = (std::max)(yTop,y);
+         yBottom = (std::min)(yBottom,y);
+      }
+
+      pFrame->Ytop = yTop;
+      pFrame->Height = yTop - yBottom;
+
+      if ( pFrame->SteelY.empty() )
+      {
+         pFrame->dt = pFrame->Height;
+      }
+      else
+      {
+         pFrame->dt = yTop - *std::min_element(pFrame->SteelY.cbegin(),pFrame->SteelY.cend());
+      }
+   }
+
+   inline void CFiberSection::ComputeCapacity(Float64 angle,Float64 c,Float64 ecl,Float64 etl,INTERACTIONPOINT* pPoint) const
+   {
+      assert(0 < c);
+      FRAME frame;
+      InitFrame(angle,&frame);
+      Evaluate(frame,1/c,ecl,etl,pPoint);
+   }
+
+   inline void CFiberSection::Evaluate(const FRAME& frame,Float64 invC,Float64 ecl,Float64 etl,INTERACTIONPOINT* pPoint) const
+   {
+      // depth of the stress block, limited to the height of the section
+      Float64 a = (invC*frame.Height <= m_Beta1 ? frame.Height : m_Beta1/invC);
+      Float64 k = 0.85*m_fc;
+
+      // C is compression force (compression is positive). M is the moment about the neutral axis
+      // direction and Mt is the moment about the normal to the neutral axis, both about the centroid
+      Float64 C = 0;
+      Float64 M = 0;
+      Float64 Mt = 0;
+      Detail::AddConcreteFibers(frame.ConcreteX.data(),frame.ConcreteY.data(),frame.ConcreteH.data(),m_pMesh->ConcreteA.data(),m_pMesh->ConcreteA.size(),frame.Ytop - a,k,&C,&M,&Mt);
+
+      // the steel fiber areas are fractions of As so the steel forces are scaled by As
+      Float64 Cs = 0;
+      Float64 Ms = 0;
+      Float64 Mts = 0;
+      Detail::AddSteelFibers(frame.SteelX.data(),frame.SteelY.data(),m_pMesh->SteelA.data(),m_pMesh->SteelA.size(),frame.Ytop,invC,a,m_Es,m_fy,k,&Cs,&Ms,&Mts);
+      C  += m_As*Cs;
+      M  += m_As*Ms;
+      Mt += m_As*Mts;
+
+      Float64 et = Detail::ecu*(frame.dt*invC - 1);
+      Float64 phi = (std::max)(0.75,(std::min)(0.75 + 0.15*(et - ecl)/(etl - ecl),0.9));
+
+      Float64 sin_angle = sin(frame.Angle);
+      Float64 cos_angle = cos(frame.Angle);
+
+      pPoint->c   = (invC == 0 ? MaxFloat64 : 1/invC);
+      pPoint->et  = et;
+      pPoint->phi = phi;
+      pPoint->Pn  = -C;
+      pPoint->Mn  = M;
+      pPoint->Pr  = phi*pPoint->Pn;
+      pPoint->Mr  = phi*pPoint->Mn;
+      pPoint->Mnx = M*cos_angle + Mt*sin_angle;
+      pPoint->Mny = Mt*cos_angle - M*sin_angle;
+   }
+
+   inline void CFiberSection::EvaluateDepth(const FRAME& frame,Float64 c,Float64 ecl,Float64 etl,INTERACTIONPOINT* pPoint) const
+   {
+      // pure tension (c = 0) is evaluated with a vanishingly small compression zone
+      Float64 invC = (c <= 0 ? 1.0e6/frame.Height : 1/c);
+      Evaluate(frame,invC,ecl,etl,pPoint);
+   }
+
+   inline Float64 CFiberSection::GetDepth(const FRAME& frame,Float64 et) const
+   {
+      // the neutral axis depth where the strain in the extreme tension reinforcement is et
+      return Detail::ecu*frame.dt/(Detail::ecu + et);
+   }
+
+   inline Float64 CFiberSection::GetPureCompressionDepth(const FRAME& frame) const
+   {
+      // The capacity is constant once the stress block covers the section and all of the
+      // reinforcement has yielded in compression. Neutral axis depths beyond this point are wasted.
+      Float64 c = frame.Height/m_Beta1;
+      Float64 ey = m_fy/m_Es;
+      if ( ey < Detail::ecu )
+      {
+         c = (std::max)(c,Detail::ecu*frame.dt/(Detail::ecu - ey));
+      }
+      else
+      {
+         // the reinforcement doesn't yield in compression... approach pure compression asymptotically
+         c = (std::max)(c,100*frame.Height);
+      }
+      return c;
+   }
+
+   inline void CFiberSection::ComputeInteraction(Float64 angle,Float64 ecl,Float64 etl,Float64 tolerance,IndexType nMaxPoints,std::vector<INTERACTIONPOINT>& points) const
+   {
+      points.clear();
+
+      FRAME frame;
+      InitFrame(angle,&frame);
+
+      // Initial samples, from pure compression to pure tension, including the ends of the phi transition.
+      // The samples are concentrated toward pure tension where the capacity changes quickly with depth.
+      // If they were evenly spaced, the chord to pure tension could pass the curve with a small error at its midpoint.
+      const int nInitial = 16;
+      Float64 cMax = GetPureCompressionDepth(frame);
+      std::vector<Float64> c;
+      c.reserve(nInitial + 3);
+      for ( int i = 0; i <= nInitial; i++ )
+      {
+         Float64 s = 1.0 - (Float64)i/nInitial;
+         c.push_back(cMax*s*s);
+      }
+      c.push_back(GetDepth(frame,ecl));
+      c.push_back(GetDepth(frame,etl));
+      std::sort(c.begin(),c.end(),std::greater<Float64>());
+      c.erase(std::unique(c.begin(),c.end(),[](Float64 a,Float64 b) {return IsEqual(a,b);}),c.end());
+
+      std::vector<INTERACTIONPOINT> samples(c.size());
+      Float64 Pmin = MaxFloat64, Pmax = -MaxFloat64, Mmax = 0;
+      for ( IndexType i = 0; i < c.size(); i++ )
+      {
+         EvaluateDepth(frame,c[i],ecl,etl,&samples[i]);
+         Pmin = (std::min)(Pmin,samples[i].Pn);
+         Pmax = (std::max)(Pmax,samples[i].Pn);
+         Mmax = (std::max)(Mmax,fabs(samples[i].Mn));
+      }
+
+      Float64 Pscale = (IsZero(Pmax - Pmin) ? 1.0 : Pmax - Pmin);
+      Float64 Mscale = (IsZero(Mmax) ? 1.0 : Mmax);
+
+      points.reserve((std::max)(nMaxPoints,(IndexType)c.size()));
+      for ( IndexType i = 0; i < c.size()-1; i++ )
+      {
+         points.push_back(samples[i]);
+
+         // leave room for the samples that haven't been added yet
+         IndexType nRemaining = c.size() - 1 - i;
+         IndexType nLimit = (nRemaining < nMaxPoints ? nMaxPoints - nRemaining : 0);
+         Refine(frame,c[i],samples[i],c[i+1],samples[i+1],ecl,etl,tolerance,Pscale,Mscale,0,nLimit,points);
+      }
+      points.push_back(samples.back());
+   }
+
+   inline void CFiberSection::ComputeMeridian(Float64 angle,Float64 ecl,Float64 etl,IndexType nDepths,INTERACTIONPOINT* pPoints) const
+   {
+      assert(4 <= nDepths);
+
+      FRAME frame;
+      InitFrame(angle,&frame);
+
+      // Depths are concentrated toward pure tension, where the capacity changes quickly with depth.
+      // Two of the samples are replaced with the ends of the phi transition.
+      Float64 cMax = GetPureCompressionDepth(frame);
+      std::vector<Float64> c(nDepths);
+      IndexType nGrid = nDepths - 2;
+      for ( IndexType i = 0; i < nGrid; i++ )
+      {
+         Float64 s = 1.0 - (Float64)i/(nGrid - 1);
+         c[i] = cMax*s*s;
+      }
+      c[nGrid]   = (std::min)(GetDepth(frame,ecl),cMax);
+      c[nGrid+1] = (std::min)(GetDepth(frame,etl),cMax);
+      std::sort(c.begin(),c.end(),std::greater<Float64>());
+
+      for ( IndexType i = 0; i < nDepths; i++ )
+      {
+         EvaluateDepth(frame,c[i],ecl,etl,&pPoints[i]);
+      }
+   }
+
+   inline void CFiberSection::Refine(const FRAME& frame,Float64 c1,const INTERACTIONPOINT& p1,Float64 c2,const INTERACTIONPOINT& p2,Float64 ecl,Float64 etl,Float64 tolerance,Float64 Pscale,Float64 Mscale,int level,IndexType nMaxPoints,std::vector<INTERACTIONPOINT>& points) const
+   {
+      // nMaxPoints is the most points the list can hold when refinement is done
+      if ( Detail::MaxRefinementLevel <= level || nMaxPoints <= points.size() )
+      {
+         return;
+      }
+
+      Float64 c = (c1 + c2)/2;
+      INTERACTIONPOINT p;
+      EvaluateDepth(frame,c,ecl,etl,&p);
+
+      Float64 error = (std::max)(Detail::ChordError(p.Mn,p.Pn,p1.Mn,p1.Pn,p2.Mn,p2.Pn,Mscale,Pscale),
+                                 Detail::ChordError(p.Mr,p.Pr,p1.Mr,p1.Pr,p2.Mr,p2.Pr,Mscale,Pscale));
+      if ( error <= tolerance )
+      {
+         return;
+      }
+
+      Refine(frame,c1,p1,c,p,ecl,etl,tolerance,Pscale,Mscale,level+1,nMaxPoints,points);
+      if ( nMaxPoints <= points.size() )
+      {
+         return;
+      }
+
+      points.push_back(p);
+      Refine(frame,c,p,c2,p2,ecl,etl,tolerance,Pscale,Mscale,level+1,nMaxPoints,points);
+   }
+}
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+// USGS seismic hazard grid. The grid has the spectral accelerations for the 7% in 75 year
+// hazard at 0.05 degree intervals over the conterminous United States. Rows run from north to
+// south and columns run from west to east.
+
+#include "EngineUtilities.h"
+#include <istream>
+
+namespace BEToolboxEngine
+{
+   // Spectral accelerations at a grid point. This is also the record layout of the hazard grid
+   // file, which is written in little endian byte order.
+   struct SpectralValues
+   {
+      Float64 lng;
+      Float64 lat;
+      Float64 v1hz;
+      Float64 v5hz;
+      Float64 vpga;
+   };
+
+   constexpr Float64 HazardGridMinLatitude  = 24.6;
+   constexpr Float64 HazardGridMaxLatitude  = 50.0;
+   constexpr Float64 HazardGridMinLongitude = -125.0;
+   constexpr Float64 HazardGridMaxLongitude = -65.0;
+   constexpr Float64 HazardGridIncrement    = 0.05;
+   constexpr IndexType HazardGridRows       = 509;
+   constexpr IndexType HazardGridColumns    = 1201;
+   constexpr IndexType HazardGridPointCount = HazardGridRows*HazardGridColumns;
+
+   inline bool IsInHazardGrid(Float64 lat,Float64 lng)
+   {
+      return HazardGridMinLatitude <= lat && lat <= HazardGridMaxLatitude && HazardGridMinLongitude <= lng && lng <= HazardGridMaxLongitude;
+   }
+
+   // Gets the indices of the four grid points that surround lat,lng
+   //
+   //  1          2
+   //   +--------+
+   //   | *      |
+   //   |        |
+   //   +--------+
+   //  3          4
+   inline void GetHazardGridIndices(Float64 lat,Float64 lng,IndexType* i1,IndexType* i2,IndexType* i3,IndexType* i4)
+   {
+      IndexType k = (IndexType)floor((HazardGridMaxLatitude - lat)/HazardGridIncrement);
+      IndexType l = (IndexType)floor((lng - HazardGridMinLongitude)/HazardGridIncrement);
+
+      *i1 = k*HazardGridColumns + l;
+      *i2 = k*HazardGridColumns + l+1;
+      *i3 = (k+1)*HazardGridColumns + l;
+      *i4 = (k+1)*HazardGridColumns + l+1;
+   }
+
+   // Reads the hazard grid file. Returns false if the stream doesn't have a complete grid.
+   inline bool ReadHazardGrid(std::istream& is,std::vector<SpectralValues>& values)
+   {
+      values.resize(HazardGridPointCount);
+      std::streamsize nBytes = (std::streamsize)(HazardGridPointCount*sizeof(SpectralValues));
+      is.read(reinterpret_cast<char*>(values.data()),nBytes);
+      if ( is.gcount() != nBytes )
+      {
+         values.clear();
+         return false;
+      }
+      return true;
+   }
+
+   namespace Detail
+   {
+      // Elevation at x,y of the plane through three points
+      inline Float64 GetPlaneZ(const Float64* pA,const Float64* pB,const Float64* pC,Float64 x,Float64 y)
+      {
+         Float64 u[3] = {pB[0] - pA[0], pB[1] - pA[1], pB[2] - pA[2]};
+         Float64 v[3] = {pC[0] - pA[0], pC[1] - pA[1], pC[2] - pA[2]};
+         Float64 nx = u[1]*v[2] - u[2]*v[1];
+         Float64 ny = u[2]*v[0] - u[0]*v[2];
+         Float64 nz = u[0]*v[1] - u[1]*v[0];
+         assert(!IsZero(nz,1.0e-12)); // the grid points are never colinear
+         return pA[2] - (nx*(x - pA[0]) + ny*(y - pA[1]))/nz;
+      }
+   }
+
+   // Interpolates the spectral accelerations at lat,lng from a complete hazard grid. lat,lng must be in the grid.
+   //
+   // Don't assume that the four surrounding points are co-planar. The grid cell is split into two
+   // triangles and the values are interpolated on the plane of the triangle that contains the point.
+   //
+   //  1          2
+   //   +--------+
+   //   |       /|
+   //   |     /  |
+   //   |   /    |
+   //   | /      |
+   //   +--------+
+   //  3          4
+   inline void InterpolateSpectralValues(const SpectralValues* pValues,Float64 lat,Float64 lng,Float64* pS1,Float64* pSs,Float64* pPGA)
+   {
+      IndexType i1,i2,i3,i4;
+      GetHazardGridIndices(lat,lng,&i1,&i2,&i3,&i4);
+
+      assert(pValues[i3].lat <= lat && lat <= pValues[i1].lat);
+      assert(pValues[i4].lat <= lat && lat <= pValues[i2].lat);
+      assert(pValues[i1].lng <= lng && lng <= pValues[i2].lng);
+      assert(pValues[i3].lng <= lng && lng <= pValues[i4].lng);
+
+      // The point is in triangle 1-2-3 if it is on the same side of the diagonal 2-3 as point 1
+      const SpectralValues& p1 = pValues[i1];
+      const SpectralValues& p2 = pValues[i2];
+      const SpectralValues& p3 = pValues[i3];
+      const SpectralValues& p4 = pValues[i4];
+      auto side = [&p2,&p3](Float64 x,Float64 y) { return (p3.lng - p2.lng)*(y - p2.lat) - (p3.lat - p2.lat)*(x - p2.lng); };
+      Float64 s = side(lng,lat);
+      Float64 s1 = side(p1.lng,p1.lat);
+      bool bUpperTriangle = (s == 0 || (0 < s) == (0 < s1));
+
+      const SpectralValues& a = (bUpperTriangle ? p1 : p2);
+      const SpectralValues& b = (bUpperTriangle ? p2 : p3);
+      const SpectralValues& c = (bUpperTriangle ? p3 : p4);
+      auto interpolate = [&a,&b,&c,lat,lng](Float64 SpectralValues::*value)
+      {
+         Float64 A[3] = {a.lng, a.lat, a.*value};
+         Float64 B[3] = {b.lng, b.lat, b.*value};
+         Float64 C[3] = {c.lng, c.lat, c.*value};
+         return Detail::GetPlaneZ(A,B,C,lng,lat);
+      };
+
+      *pS1  = interpolate(&SpectralValues::v1hz);
+      *pSs  = interpolate(&SpectralValues::v5hz);
+      *pPGA = interpolate(&SpectralValues::vpga);
+   }
+}
@@ -0,0 +1,426 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "FiberSection.h"
+
+namespace BEToolboxEngine
+{
+   // The biaxial interaction surface (P-Mx-My) as a closed triangle mesh for checking load case demands.
+   // Axial force is compression positive in this class (the sense used in the report).
+   //
+   // The surface is swept from interaction curves (meridians) for evenly spaced neutral axis angles. Every
+   // meridian has the same number of points so the mesh is a grid of rings between the pure compression and
+   // pure tension poles. Vertices are stored as packed (Mx,My,P) triples and triangles as packed vertex index triples.
+   //
+   // The surface is star-shaped about the origin. A demand is checked by intersecting its ray with the mesh.
+   // Triangles are binned by the direction they cover (azimuth and elevation, in a space normalized by the range
+   // of the capacities) so a query only tests the few triangles in the bin of the ray.
+   class CInteractionSurface
+   {
+   public:
+      CInteractionSurface();
+
+      // Builds the surface from nAngles neutral axis angles with nDepths points per meridian. The angles are
+      // evaluated in parallel. The surface is made from the factored capacities if bFactored is true, otherwise
+      // from the nominal capacities.
+      void Init(const CFiberSection& section,Float64 ecl,Float64 etl,IndexType nAngles = 72,IndexType nDepths = 60,bool bFactored = true);
+
+      IndexType GetVertexCount() const;
+      IndexType GetTriangleCount() const;
+      void GetVertex(IndexType vertexIdx,Float64* pMx,Float64* pMy,Float64* pP) const;
+      void GetTriangle(IndexType triangleIdx,IndexType* pV1,IndexType* pV2,IndexType* pV3) const;
+
+      // Returns the capacity ratio of a demand. The capacity ratio is the distance from the origin to the
+      // demand divided by the distance from the origin to the surface along the same ray. The demand
+      // is inside the surface when the ratio is not more than 1.0. If pPr, pMrx, and pMry are not nullptr,
+      // they receive the capacity on the ray through the demand. If the ray doesn't hit the surface,
+      // the capacity ratio can't be evaluated and NaN is returned for the ratio and the capacities.
+      Float64 GetCapacityRatio(Float64 Pu,Float64 Mux,Float64 Muy,Float64* pPr = nullptr,Float64* pMrx = nullptr,Float64* pMry = nullptr) const;
+
+      // Returns false if the capacity ratio can't be evaluated
+      bool IsInside(Float64 Pu,Float64 Mux,Float64 Muy) const;
+
+   private:
+      std::vector<Float64> m_Vertices; // Mx, My, P
+      std::vector<Uint32> m_Triangles;
+
+      // triangles in bin i are m_BinTriangles[m_BinStart[i],m_BinStart[i+1])
+      std::vector<IndexType> m_BinStart;
+      std::vector<Uint32> m_BinTriangles;
+
+      Float64 m_Pscale;
+      Float64 m_Mscale;
+
+      void BuildBins();
+      IndexType GetBin(IndexType azimuthIdx,IndexType elevationIdx) const;
+      bool Intersect(IndexType triangleIdx,const Float64* pRay,Float64* pT) const;
+   };
+
+   namespace Detail
+   {
+      const IndexType nAzimuthBins = 64;
+      const IndexType nElevationBins = 32;
+      const Float64 BarycentricTolerance = 1.0e-9;
+
+      // Distance from the origin to the line segment (x1,y1)-(x2,y2)
+      inline Float64 DistanceToSegment(Float64 x1,Float64 y1,Float64 x2,Float64 y2)
+      {
+         Float64 dx = x2 - x1;
+         Float64 dy = y2 - y1;
+         Float64 L2 = dx*dx + dy*dy;
+         Float64 t = (IsZero(L2) ? 0.0 : (std::max)(0.0,(std::min)(-(x1*dx + y1*dy)/L2,1.0)));
+         Float64 x = x1 + t*dx;
+         Float64 y = y1 + t*dy;
+         return sqrt(x*x + y*y);
+      }
+
+      inline IndexType GetAzimuthIndex(Float64 azimuth)
+      {
+         // azimuth is in (-2PI,2PI) after unwrapping so it is brought into [0,2PI) before binning
+         Float64 a = fmod(azimuth + 2*Pi,2*Pi);
+         return (std::min)((IndexType)(a*nAzimuthBins/(2*Pi)),nAzimuthBins - 1);
+      }
+
+      inline IndexType GetElevationIndex(Float64 elevation)
+      {
+         Float64 e = (std::max)(0.0,(std::min)(elevation + Pi/2,Pi));
+         return (std::min)((IndexType)(e*nElevationBins/Pi),nElevationBins - 1);
+      }
+   }
+
+
+   inline CInteractionSurface::CInteractionSurface()
+   {
+      m_Pscale = 1.0;
+      m_Mscale = 1.0;
+   }
+
+   inline void CInteractionSurface::Init(const CFiberSection& section,Float64 ecl,Float64 etl,IndexType nAngles,IndexType nDepths,bool bFactored)
+   {
+      assert(3 <= nAngles && 4 <= nDepths);
+
+      // Sweep the neutral axis angles. The fiber mesh is shared by all the angles and each
+      // meridian is written to its own part of the array.
+      std::vector<INTERACTIONPOINT> meridians(nAngles*nDepths);
+      ParallelFor(nAngles,[&](IndexType /*threadIdx*/,IndexType begin,IndexType end)
+      {
+         for ( IndexType angleIdx = begin; angleIdx < end; angleIdx++ )
+         {
+            Float64 angle = 2*Pi*angleIdx/nAngles;
+            section.ComputeMeridian(angle,ecl,etl,nDepths,&meridians[angleIdx*nDepths]);
+         }
+      });
+
+      // Vertices are the two poles followed by rings of nAngles vertices. Pure compression and pure
+      // tension don't depend on the neutral axis angle so the ends of the meridians meet at the poles.
+      IndexType nRings = nDepths - 2;
+      m_Vertices.resize(3*(2 + nRings*nAngles));
+      auto setVertex = [this,bFactored](IndexType vertexIdx,const INTERACTIONPOINT& point)
+      {
+         Float64 phi = (bFactored ? point.phi : 1.0);
+         m_Vertices[3*vertexIdx]     = phi*point.Mnx;
+         m_Vertices[3*vertexIdx + 1] = phi*point.Mny;
+         m_Vertices[3*vertexIdx + 2] = -phi*point.Pn; // compression positive
+      };
+
+      setVertex(0,meridians.front());
+      setVertex(1,meridians.back());
+      for ( IndexType angleIdx = 0; angleIdx < nAngles; angleIdx++ )
+      {
+         for ( IndexType ringIdx = 0; ringIdx < nRings; ringIdx++ )
+         {
+            setVertex(2 + ringIdx*nAngles + angleIdx,meridians[angleIdx*nDepths + ringIdx + 1]);
+         }
+      }
+
+      // triangles... a fan at each pole and two triangles for each quad between rings
+      auto ringVertex = [nAngles](IndexType ringIdx,IndexType angleIdx) { return (Uint32)(2 + ringIdx*nAngles + angleIdx%nAngles); };
+      m_Triangles.clear();
+      m_Triangles.reserve(3*2*nAngles*(nRings));
+      for ( IndexType angleIdx = 0; angleIdx < nAngles; angleIdx++ )
+      {
+         m_Triangles.insert(m_Triangles.end(),{0,ringVertex(0,angleIdx),ringVertex(0,angleIdx+1)});
+
+         for ( IndexType ringIdx = 0; ringIdx < nRings-1; ringIdx++ )
+         {
+            Uint32 v1 = ringVertex(ringIdx,  angleIdx);
+            Uint32 v2 = ringVertex(ringIdx+1,angleIdx);
+            Uint32 v3 = ringVertex(ringIdx+1,angleIdx+1);
+            Uint32 v4 = ringVertex(ringIdx,  angleIdx+1);
+            m_Triangles.insert(m_Triangles.end(),{v1,v2,v3});
+            m_Triangles.insert(m_Triangles.end(),{v1,v3,v4});
+         }
+
+         m_Triangles.insert(m_Triangles.end(),{ringVertex(nRings-1,angleIdx),1,ringVertex(nRings-1,angleIdx+1)});
+      }
+
+      // normalize by the range of the capacities so the bins are evenly shaped
+      Float64 Pmin = 0, Pmax = 0, Mmax = 0;
+      IndexType nVertices = GetVertexCount();
+      for ( IndexType i = 0; i < nVertices; i++ )
+      {
+         Mmax = (std::max)(Mmax,sqrt(m_Vertices[3*i]*m_Vertices[3*i] + m_Vertices[3*i+1]*m_Vertices[3*i+1]));
+         Pmin = (std::min)(Pmin,m_Vertices[3*i+2]);
+         Pmax = (std::max)(Pmax,m_Vertices[3*i+2]);
+      }
+      m_Pscale = (IsZero(Pmax - Pmin) ? 1.0 : (Pmax - Pmin)/2);
+      m_Mscale = (IsZero(Mmax) ? 1.0 : Mmax);
+
+      BuildBins();
+   }
+
+   inline IndexType CInteractionSurface::GetVertexCount() const
+   {
+      return m_Vertices.size()/3;
+   }
+
+   inline IndexType CInteractionSurface::GetTriangleCount() const
+   {
+      return m_Triangles.size()/3;
+   }
+
+   inline void CInteractionSurface::GetVertex(IndexType vertexIdx,Float64* pMx,Float64* pMy,Float64* pP) const
+   {
+      *pMx = m_Vertices[3*vertexIdx];
+      *pMy = m_Vertices[3*vertexIdx + 1];
+      *pP  = m_Vertices[3*vertexIdx + 2];
+   }
+
+   inline void CInteractionSurface::GetTriangle(IndexType triangleIdx,IndexType* pV1,IndexType* pV2,IndexType* pV3) const
+   {
+      *pV1 = m_Triangles[3*triangleIdx];
+      *pV2 = m_Triangles[3*triangleIdx + 1];
+      *pV3 = m_Triangles[3*triangleIdx + 2];
+   }
+
+   inline IndexType CInteractionSurface::GetBin(IndexType azimuthIdx,IndexType elevationIdx) const
+   {
+      return elevationIdx*Detail::nAzimuthBins + azimuthIdx;
+   }
+
+   inline void CInteractionSurface::BuildBins()
+   {
+      // Find the range of bins covered by each triangle, then store the triangles by bin (counting
+      // pass followed by a filling pass). The ranges are conservative so every ray finds its triangle.
+      IndexType nTriangles = GetTriangleCount();
+      std::vector<IndexType> range(4*nTriangles); // first and last azimuth index, first and last elevation index
+      for ( IndexType triangleIdx = 0; triangleIdx < nTriangles; triangleIdx++ )
+      {
+         Float64 u[3], v[3], w[3], rho[3], azimuth[3];
+         for ( int i = 0; i < 3; i++ )
+         {
+            IndexType vertexIdx = m_Triangles[3*triangleIdx + i];
+            u[i] = m_Vertices[3*vertexIdx]/m_Mscale;
+            v[i] = m_Vertices[3*vertexIdx + 1]/m_Mscale;
+            w[i] = m_Vertices[3*vertexIdx + 2]/m_Pscale;
+            rho[i] = sqrt(u[i]*u[i] + v[i]*v[i]);
+            azimuth[i] = atan2(v[i],u[i]);
+         }
+
+         // distance from the P axis to the triangle, projected onto the moment plane
+         Float64 rhoMin = (std::min)((std::min)(Detail::DistanceToSegment(u[0],v[0],u[1],v[1]),Detail::DistanceToSegment(u[1],v[1],u[2],v[2])),Detail::DistanceToSegment(u[2],v[2],u[0],v[0]));
+         Float64 rhoMax = (std::max)((std::max)(rho[0],rho[1]),rho[2]);
+         Float64 c1 = u[0]*v[1] - u[1]*v[0];
+         Float64 c2 = u[1]*v[2] - u[2]*v[1];
+         Float64 c3 = u[2]*v[0] - u[0]*v[2];
+         bool bAroundAxis = (IsZero(rhoMin) || (0 <= c1 && 0 <= c2 && 0 <= c3) || (c1 <= 0 && c2 <= 0 && c3 <= 0));
+         if ( bAroundAxis )
+         {
+            // the triangle surrounds (or touches) the P axis so it covers every azimuth
+            rhoMin = 0;
+            range[4*triangleIdx]     = 0;
+            range[4*triangleIdx + 1] = Detail::nAzimuthBins - 1;
+         }
+         else
+         {
+            // The triangle subtends less than PI about the P axis. Unwrap the azimuths relative to the first vertex.
+            Float64 lo = 0, hi = 0;
+            for ( int i = 1; i < 3; i++ )
+            {
+               Float64 d = azimuth[i] - azimuth[0];
+               if ( Pi < d )  d -= 2*Pi;
+               if ( d < -Pi ) d += 2*Pi;
+               lo = (std::min)(lo,d);
+               hi = (std::max)(hi,d);
+            }
+            IndexType first = Detail::GetAzimuthIndex(azimuth[0] + lo);
+            IndexType last  = Detail::GetAzimuthIndex(azimuth[0] + hi);
+            range[4*triangleIdx]     = first;
+            range[4*triangleIdx + 1] = (last < first ? last + Detail::nAzimuthBins : last); // wraps past 2PI
+         }
+
+         // elevation increases with P and moves toward the poles as the distance to the P axis decreases
+         Float64 wMin = (std::min)((std::min)(w[0],w[1]),w[2]);
+         Float64 wMax = (std::max)((std::max)(w[0],w[1]),w[2]);
+         Float64 eMin = atan2(wMin,wMin < 0 ? rhoMin : rhoMax);
+         Float64 eMax = atan2(wMax,wMax < 0 ? rhoMax : rhoMin);
+         range[4*triangleIdx + 2] = Detail::GetElevationIndex(eMin);
+         range[4*triangleIdx + 3] = Detail::GetElevationIndex(eMax);
+      }
+
+      m_BinStart.assign(Detail::nAzimuthBins*Detail::nElevationBins + 1,0);
+      for ( int pass = 0; pass < 2; pass++ )
+      {
+         std::vector<IndexType> next;
+         if ( pass == 1 )
+         {
+            // convert the counts to starting positions
+            for ( IndexType binIdx = 0; binIdx < Detail::nAzimuthBins*Detail::nElevationBins; binIdx++ )
+            {
+               m_BinStart[binIdx+1] += m_BinStart[binIdx];
+            }
+            m_BinTriangles.resize(m_BinStart.back());
+            next.assign(m_BinStart.cbegin(),m_BinStart.cend()-1);
+         }
+
+         for ( IndexType triangleIdx = 0; triangleIdx < nTriangles; triangleIdx++ )
+         {
+            for ( IndexType e = range[4*triangleIdx + 2]; e <= range[4*triangleIdx + 3]; e++ )
+            {
+               for ( IndexType a = range[4*triangleIdx]; a <= range[4*triangleIdx + 1]; a++ )
+               {
+                  IndexType binIdx = GetBin(a%Detail::nAzimuthBins,e);
+                  if ( pass == 0 )
+                  {
+                     m_BinStart[binIdx+1]++;
+                  }
+                  else
+                  {
+                     m_BinTriangles[next[binIdx]++] = (Uint32)triangleIdx;
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   inline bool CInteractionSurface::Intersect(IndexType triangleIdx,const Float64* pRay,Float64* pT) const
+   {
+      // Moller-Trumbore ray-triangle intersection for a ray from the origin, in normalized coordinates
+      Float64 p[3][3];
+      for ( int i = 0; i < 3; i++ )
+      {
+         IndexType vertexIdx = m_Triangles[3*triangleIdx + i];
+         p[i][0] = m_Vertices[3*vertexIdx]/m_Mscale;
+         p[i][1] = m_Vertices[3*vertexIdx + 1]/m_Mscale;
+         p[i][2] = m_Vertices[3*vertexIdx + 2]/m_Pscale;
+      }
+
+      Float64 e1[3] = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+      Float64 e2[3] = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+      Float64 h[3] = {pRay[1]*e2[2] - pRay[2]*e2[1], pRay[2]*e2[0] - pRay[0]*e2[2], pRay[0]*e2[1] - pRay[1]*e2[0]};
+      Float64 det = e1[0]*h[0] + e1[1]*h[1] + e1[2]*h[2];
+      if ( fabs(det) < 1.0e-14 )
+      {
+         return false; // the ray is parallel to the triangle (or the triangle is degenerate)
+      }
+
+      Float64 s[3] = {-p[0][0], -p[0][1], -p[0][2]}; // origin - p0
+      Float64 a = (s[0]*h[0] + s[1]*h[1] + s[2]*h[2])/det;
+      if ( a < -Detail::BarycentricTolerance || 1 + Detail::BarycentricTolerance < a )
+      {
+         return false;
+      }
+
+      Float64 q[3] = {s[1]*e1[2] - s[2]*e1[1], s[2]*e1[0] - s[0]*e1[2], s[0]*e1[1] - s[1]*e1[0]};
+      Float64 b = (pRay[0]*q[0] + pRay[1]*q[1] + pRay[2]*q[2])/det;
+      if ( b < -Detail::BarycentricTolerance || 1 + Detail::BarycentricTolerance < a + b )
+      {
+         return false;
+      }
+
+      Float64 t = (e2[0]*q[0] + e2[1]*q[1] + e2[2]*q[2])/det;
+      if ( t <= 0 )
+      {
+         return false;
+      }
+
+      *pT = t;
+      return true;
+   }
+
+   inline Float64 CInteractionSurface::GetCapacityRatio(Float64 Pu,Float64 Mux,Float64 Muy,Float64* pPr,Float64* pMrx,Float64* pMry) const
+   {
+      assert(!m_Triangles.empty());
+
+      Float64 ray[3] = {Mux/m_Mscale, Muy/m_Mscale, Pu/m_Pscale};
+      Float64 rho = sqrt(ray[0]*ray[0] + ray[1]*ray[1]);
+      if ( IsZero(rho) && IsZero(ray[2]) )
+      {
+         // no demand
+         if ( pPr )  *pPr = 0;
+         if ( pMrx ) *pMrx = 0;
+         if ( pMry ) *pMry = 0;
+         return 0;
+      }
+
+      // The ray hits the surface at t*ray and the ratio is 1/t. Edges and vertices are shared by
+      // triangles so the nearest hit is used.
+      Float64 tMin = MaxFloat64;
+      IndexType binIdx = GetBin(Detail::GetAzimuthIndex(atan2(ray[1],ray[0])),Detail::GetElevationIndex(atan2(ray[2],rho)));
+      for ( IndexType i = m_BinStart[binIdx]; i < m_BinStart[binIdx+1]; i++ )
+      {
+         Float64 t;
+         if ( Intersect(m_BinTriangles[i],ray,&t) )
+         {
+            tMin = (std::min)(tMin,t);
+         }
+      }
+
+      if ( tMin == MaxFloat64 )
+      {
+         // the ray slipped between triangles because of round off... check all the triangles
+         IndexType nTriangles = GetTriangleCount();
+         for ( IndexType triangleIdx = 0; triangleIdx < nTriangles; triangleIdx++ )
+         {
+            Float64 t;
+            if ( Intersect(triangleIdx,ray,&t) )
+            {
+               tMin = (std::min)(tMin,t);
+            }
+         }
+      }
+      if ( tMin == MaxFloat64 )
+      {
+         // the ray missed the surface. the origin isn't inside the surface or the surface has a hole
+         const Float64 nan = std::numeric_limits<Float64>::quiet_NaN();
+         if ( pPr )  *pPr  = nan;
+         if ( pMrx ) *pMrx = nan;
+         if ( pMry ) *pMry = nan;
+         return nan;
+      }
+
+      if ( pPr )  *pPr  = tMin*Pu;
+      if ( pMrx ) *pMrx = tMin*Mux;
+      if ( pMry ) *pMry = tMin*Muy;
+
+      return 1/tMin;
+   }
+
+   inline bool CInteractionSurface::IsInside(Float64 Pu,Float64 Mux,Float64 Muy) const
+   {
+      return GetCapacityRatio(Pu,Mux,Muy) <= 1.0;
+   }
+}
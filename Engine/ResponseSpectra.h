@@ -0,0 +1,304 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+// Design response spectra and the site factor tables of the supported specifications
+
+#include "EngineUtilities.h"
+#include <utility>
+
+namespace BEToolboxEngine
+{
+   enum SpecificationType
+   {
+      WSDOT_BDM = 0, // WSDOT Bridge Design Manual
+      AASHTO_LRFD = 1, // AASHTO LRFD Bridge Design Specifications, 8th Edition
+      AASHTO_SEISMIC = 2, // AASHTO Guide Specifications for LRFD Seismic Bridge Design, 2nd Edition, 2011
+      nSpecTypes = 3  // this is always last
+   };
+
+   enum SiteClass
+   {
+      scA,
+      scB,
+      scC,
+      scD,
+      scE,
+      scF,
+      nSiteClasses
+   };
+
+   enum SiteFactorType
+   {
+      sfZeroPeriod,  // Fpga
+      sfShortPeriod, // Fa for 0.2 sec period spectral acceleration
+      sfLongPeriod,  // Fv for 1.0 sec period spectral acceleration
+      nSiteFactorTypes
+   };
+
+   // A site factor table for one site class. Site factors are interpolated between the
+   // tabulated accelerations and are constant beyond the first and last accelerations.
+   class CSiteFactorCurve
+   {
+   public:
+      CSiteFactorCurve(const Float64* pX,const Float64* pY,IndexType nPoints) : m_pX(pX), m_pY(pY), m_nPoints(nPoints)
+      {
+         assert(0 < nPoints);
+      }
+
+      Float64 Evaluate(Float64 x) const
+      {
+         if ( x <= m_pX[0] )
+         {
+            return m_pY[0];
+         }
+
+         for ( IndexType i = 1; i < m_nPoints; i++ )
+         {
+            if ( x <= m_pX[i] )
+            {
+               return m_pY[i-1] + (m_pY[i] - m_pY[i-1])*(x - m_pX[i-1])/(m_pX[i] - m_pX[i-1]);
+            }
+         }
+
+         return m_pY[m_nPoints-1];
+      }
+
+   private:
+      const Float64* m_pX;
+      const Float64* m_pY;
+      IndexType m_nPoints;
+   };
+
+   namespace Detail
+   {
+      // Site factors for site classes A through E at common accelerations. Site class F requires a site specific analysis.
+      struct SITEFACTORTABLE
+      {
+         IndexType nPoints;
+         Float64 X[6];
+         Float64 Y[5][6];
+      };
+
+      inline const SITEFACTORTABLE& GetSiteFactorTable(SpecificationType specType,SiteFactorType type)
+      {
+         static const SITEFACTORTABLE tables[nSpecTypes][nSiteFactorTypes] =
+         {
+            // WSDOT Bridge Design Manual
+            {
+               // Zero Period Site Factors (Fpga) - BDM Table 3.4.2.3-1A
+               {6,{0.1,0.2,0.3,0.4,0.5,0.6},{{0.8,0.8,0.8,0.8,0.8,0.8},
+                                             {0.9,0.9,0.9,0.9,0.9,0.9},
+                                             {1.3,1.2,1.2,1.2,1.2,1.2},
+                                             {1.6,1.4,1.3,1.2,1.1,1.1},
+                                             {2.4,1.9,1.6,1.4,1.2,1.1}}},
+               // Short Period Site Factors (Fa) - BDM Table 3.4.2.3-1B
+               {6,{0.25,0.50,0.75,1.00,1.25,1.50},{{0.8,0.8,0.8,0.8,0.8,0.8},
+                                                   {0.9,0.9,0.9,0.9,0.9,0.9},
+                                                   {1.3,1.3,1.2,1.2,1.2,1.2},
+                                                   {1.6,1.4,1.2,1.1,1.0,1.0},
+                                                   {2.4,1.7,1.3,1.0,0.9,0.9}}},
+               // Long Period Site Factors (Fv) - BDM Table 3.4.2.3.2
+               {6,{0.1,0.2,0.3,0.4,0.5,0.6},{{0.8,0.8,0.8,0.8,0.8,0.8},
+                                             {0.8,0.8,0.8,0.8,0.8,0.8},
+                                             {1.5,1.5,1.5,1.5,1.5,1.4},
+                                             {2.4,2.2,2.0,1.9,1.8,1.7},
+                                             {4.2,3.3,2.8,2.4,2.2,2.0}}},
+            },
+            // AASHTO LRFD Bridge Design Specifications
+            {
+               // Zero Period Site Factors (Fpga) - Table 3.4.2.3-1
+               {5,{0.1,0.2,0.3,0.4,0.5},{{0.8,0.8,0.8,0.8,0.8},
+                                         {1.0,1.0,1.0,1.0,1.0},
+                                         {1.2,1.2,1.1,1.0,1.0},
+                                         {1.6,1.4,1.2,1.1,1.0},
+                                         {2.5,1.7,1.2,0.9,0.9}}},
+               // Short Period Site Factors (Fa) - Table 3.4.2.3-1
+               {5,{0.25,0.50,0.75,1.00,1.25},{{0.8,0.8,0.8,0.8,0.8},
+                                              {1.0,1.0,1.0,1.0,1.0},
+                                              {1.2,1.2,1.1,1.0,1.0},
+                                              {1.6,1.4,1.2,1.1,1.0},
+                                              {2.5,1.7,1.2,0.9,0.9}}},
+               // Long Period Site Factors (Fv) - Table 3.10.3.2-3
+               {5,{0.1,0.2,0.3,0.4,0.5},{{0.8,0.8,0.8,0.8,0.8},
+                                         {1.0,1.0,1.0,1.0,1.0},
+                                         {1.7,1.6,1.5,1.4,1.3},
+                                         {2.4,2.0,1.8,1.6,1.5},
+                                         {3.5,3.2,2.8,2.4,2.4}}},
+            },
+            // AASHTO Guide Specifications for LRFD Seismic Bridge Design
+            {
+               // Zero Period Site Factors (Fpga) - Table 3.4.2.3-1
+               {5,{0.1,0.2,0.3,0.4,0.5},{{0.8,0.8,0.8,0.8,0.8},
+                                         {1.0,1.0,1.0,1.0,1.0},
+                                         {1.2,1.2,1.1,1.0,1.0},
+                                         {1.6,1.4,1.2,1.1,1.0},
+                                         {2.5,1.7,1.2,0.9,0.9}}},
+               // Short Period Site Factors (Fa) - Table 3.4.2.3-1
+               {5,{0.25,0.50,0.75,1.00,1.25},{{0.8,0.8,0.8,0.8,0.8},
+                                              {1.0,1.0,1.0,1.0,1.0},
+                                              {1.2,1.2,1.1,1.0,1.0},
+                                              {1.6,1.4,1.2,1.1,1.0},
+                                              {2.5,1.7,1.2,0.9,0.9}}},
+               // Long Period Site Factors (Fv) - Table 3.4.2.3-2
+               {5,{0.1,0.2,0.3,0.4,0.5},{{0.8,0.8,0.8,0.8,0.8},
+                                         {1.0,1.0,1.0,1.0,1.0},
+                                         {1.7,1.6,1.5,1.4,1.3},
+                                         {2.4,2.0,1.8,1.6,1.5},
+                                         {3.5,3.2,2.8,2.4,2.4}}},
+            },
+         };
+
+         return tables[specType][type];
+      }
+   }
+
+   // Returns the site factor table for a specification and site class. siteClass can't be scF.
+   inline CSiteFactorCurve GetSiteFactorCurve(SpecificationType specType,SiteFactorType type,SiteClass siteClass)
+   {
+      assert(siteClass < scF);
+      const Detail::SITEFACTORTABLE& table = Detail::GetSiteFactorTable(specType,type);
+      return CSiteFactorCurve(table.X,table.Y[siteClass],table.nPoints);
+   }
+
+   // Gets the site factors for the mapped accelerations. Returns false if a site specific analysis is required.
+   inline bool GetSiteFactors(SpecificationType specType,Float64 S1,Float64 Ss,Float64 PGA,SiteClass siteClass,Float64* pFa,Float64* pFv,Float64* pFpga)
+   {
+      if ( siteClass == scF )
+      {
+         return false;
+      }
+
+      *pFpga = GetSiteFactorCurve(specType,sfZeroPeriod,siteClass).Evaluate(PGA);
+      *pFa   = GetSiteFactorCurve(specType,sfShortPeriod,siteClass).Evaluate(Ss);
+      *pFv   = GetSiteFactorCurve(specType,sfLongPeriod,siteClass).Evaluate(S1);
+      return true;
+   }
+
+   // The design response spectrum
+   class CResponseSpectrum
+   {
+   public:
+      CResponseSpectrum() : m_PGA(0), m_Ss(0), m_S1(0), m_Fpga(0), m_Fa(0), m_Fv(0)
+      {
+      }
+
+      void Init(Float64 PGA,Float64 Ss,Float64 S1,Float64 Fpga,Float64 Fa,Float64 Fv)
+      {
+         m_PGA  = PGA;
+         m_Ss   = Ss;
+         m_S1   = S1;
+         m_Fpga = Fpga;
+         m_Fa   = Fa;
+         m_Fv   = Fv;
+      }
+
+      Float64 GetPGA() const { return m_PGA; }
+      Float64 GetSs() const { return m_Ss; }
+      Float64 GetS1() const { return m_S1; }
+      Float64 GetFpga() const { return m_Fpga; }
+      Float64 GetFa() const { return m_Fa; }
+      Float64 GetFv() const { return m_Fv; }
+      Float64 GetTo() const { return 0.2*GetTs(); }
+      Float64 GetTs() const { return GetSd1()/GetSds(); }
+      Float64 GetAs() const { return m_Fpga*m_PGA; }
+      Float64 GetSds() const { return m_Fa*m_Ss; }
+      Float64 GetSd1() const { return m_Fv*m_S1; }
+
+      // Returns the seismic zone (LRFD) or seismic design category (Guide Specification) as an index
+      // from 0 to 3 (zones 1 to 4 or SDC A to D)
+      IndexType GetSeismicDesignCategory() const
+      {
+         Float64 Sd1 = GetSd1();
+         return (Sd1 < 0.15 ? 0 : (Sd1 < 0.30 ? 1 : (Sd1 < 0.50 ? 2 : 3)));
+      }
+
+      Float64 GetSa(Float64 time) const
+      {
+         if ( time < 0 )
+         {
+            return 0;
+         }
+
+         Float64 As = GetAs();
+         Float64 Sds = GetSds();
+         Float64 Ts = GetTs();
+         Float64 To = GetTo();
+         if ( time <= 0.2*Ts )
+         {
+            return (IsZero(To) ? As : As + (Sds - As)*time/To);
+         }
+         else if ( time <= Ts )
+         {
+            return Sds;
+         }
+         else
+         {
+            return GetSd1()/time;
+         }
+      }
+
+      // Returns the spectrum from 0 to Tmax at tStep intervals, including the key periods To and Ts, sorted by period
+      std::vector<std::pair<Float64,Float64>> GetSpectraValues(Float64 Tmax,Float64 tStep) const
+      {
+         Float64 To = GetTo();
+         Float64 Ts = GetTs();
+
+         std::vector<std::pair<Float64,Float64>> values;
+
+         // store the key values
+         values.emplace_back(0.0,GetSa(0.0));
+         values.emplace_back(To,GetSa(To));
+         values.emplace_back(Ts,GetSa(Ts));
+
+         if ( Tmax - Ts < 0 )
+         {
+            return values;
+         }
+
+         // fill up vector with values
+         Float64 t = tStep;
+         while ( t < Tmax )
+         {
+            values.emplace_back(t,GetSa(t));
+            t += tStep;
+         }
+
+         // add the last value
+         values.emplace_back(Tmax,GetSa(Tmax));
+
+         // sort
+         std::sort(values.begin(), values.end(), [](const auto& v1, const auto& v2) {return v1.first < v2.first;});
+
+         // remove duplicates
+         values.erase(std::unique(values.begin(), values.end(), [](const auto& v1, const auto& v2) {return v1.first == v2.first;}), values.end());
+
+         return values;
+      }
+
+   protected:
+      Float64 m_PGA, m_Ss, m_S1;
+      Float64 m_Fpga, m_Fa, m_Fv;
+   };
+}
@@ -0,0 +1,656 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+// Native section property kernel for polygons. This is used in place of the WBFL PolyShape
+// and CompositeSection objects when a section is defined by a large number of points.
+
+#include "EngineUtilities.h"
+
+#if defined _M_X64 || (defined _M_IX86_FP && 2 <= _M_IX86_FP) || defined __SSE2__
+#define BETOOLBOX_POLYGON_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace BEToolboxEngine
+{
+   // Geometric properties of a polygon, or a transformed section made from polygons
+   struct POLYGONPROPERTIES
+   {
+      Float64 Area;
+      Float64 Xbar; // location of the centroid
+      Float64 Ybar;
+      Float64 Ixx; // moments of inertia about the centroid
+      Float64 Iyy;
+      Float64 Ixy;
+      Float64 Xmin; // extents of the section
+      Float64 Xmax;
+      Float64 Ymin;
+      Float64 Ymax;
+
+      // distances from the centroid to the extreme fibers (same as IShapeProperties)
+      Float64 GetXleft() const { return Xbar - Xmin; }
+      Float64 GetXright() const { return Xmax - Xbar; }
+      Float64 GetYtop() const { return Ymax - Ybar; }
+      Float64 GetYbottom() const { return Ybar - Ymin; }
+   };
+
+   // Initializes the properties of an empty section
+   inline void InitPolygonProperties(POLYGONPROPERTIES* pProps);
+
+   // Computes the properties of a polygon defined by contiguous arrays of x and y coordinates.
+   // The polygon is implicitly closed and may be defined clockwise or counter-clockwise.
+   inline void ComputePolygonProperties(const Float64* pX,const Float64* pY,IndexType nPoints,POLYGONPROPERTIES* pProps);
+
+   // Adds a piece to a transformed section. The piece is transformed by n (modular ratio).
+   // Pieces without area do not contribute to the section.
+   inline void AddPolygonProperties(POLYGONPROPERTIES* pSection,const POLYGONPROPERTIES& piece,Float64 n);
+
+   // Computes the properties of a transformed section made from polygons stored end to end in
+   // contiguous coordinate arrays. Polygon i is defined by the points [pOffsets[i],pOffsets[i+1]) and
+   // is transformed by pN[i]. If pPieces is not nullptr, it receives the properties of each polygon.
+   inline void ComputeTransformedProperties(const Float64* pX,const Float64* pY,const IndexType* pOffsets,const Float64* pN,IndexType nPolygons,POLYGONPROPERTIES* pSection,POLYGONPROPERTIES* pPieces = nullptr);
+
+   // Clips a polygon to the part above (bAbove = true) or below a horizontal line at y. The clipped
+   // polygon is written to pXclip/pYclip which must have room for 2*nPoints points. The orientation
+   // of the polygon is preserved. Returns the number of points in the clipped polygon.
+   inline IndexType ClipPolygon(const Float64* pX,const Float64* pY,IndexType nPoints,Float64 y,bool bAbove,Float64* pXclip,Float64* pYclip);
+
+   // Locates the horizontal axis that divides the transformed area of a section made from polygons, stored as for
+   // ComputeTransformedProperties, in half. Q is the first moment of the transformed area about this axis, in
+   // units of the reference material. This is not a plastic property unless every polygon is the same material,
+   // in which case the axis is the plastic neutral axis and Q is the plastic section modulus.
+   inline void ComputeEqualAreaProperties(const Float64* pX,const Float64* pY,const IndexType* pOffsets,const Float64* pN,IndexType nPolygons,Float64* pYea,Float64* pQ);
+
+   // Computes the properties of a cracked transformed section made from polygons stored as for
+   // ComputeTransformedProperties. Polygon i is transformed by pN[i] where it is in compression and by pNt[i]
+   // where it is in tension. Use pNt[i] = 0 for material that is ineffective in tension, such as concrete.
+   // The compression face is the top of the section if bTopInCompression is true, otherwise it is the bottom.
+   // pBase is the transformed properties of fully effective material that isn't defined by a polygon,
+   // such as a rolled shape that is defined only by its area and moment of inertia. pBase may be nullptr.
+   // The elevation of the cracked neutral axis is returned in pYna.
+   inline void ComputeCrackedProperties(const Float64* pX,const Float64* pY,const IndexType* pOffsets,const Float64* pN,const Float64* pNt,IndexType nPolygons,const POLYGONPROPERTIES* pBase,bool bTopInCompression,Float64* pYna,POLYGONPROPERTIES* pSection);
+
+   // The section properties are computed with Green's theorem. For each edge (i,j) of the polygon
+   // with cross product c = xi*yj - xj*yi
+   //
+   // 2A     = sum( c )
+   // 6Qy    = sum( (xi + xj)c )
+   // 6Qx    = sum( (yi + yj)c )
+   // 12Iyy  = sum( (xi^2 + xi*xj + xj^2)c )
+   // 12Ixx  = sum( (yi^2 + yi*yj + yj^2)c )
+   // 24Ixy  = sum( (xi*yj + 2xi*yi + 2xj*yj + xj*yi)c )
+   //
+   // Coordinates are taken relative to the first point so that surveyed or CAD coordinates, which are
+   // often far from the origin, don't lose precision in the products. The sums use Kahan compensated
+   // accumulation so that the result doesn't degrade as the number of points grows. The compensation
+   // is defeated by /fp:fast and -ffast-math, so code that includes this header must be compiled with
+   // /fp:precise (the project default) or without -ffast-math.
+
+   namespace Detail
+   {
+      enum Sum { A2, Qx6, Qy6, Ixx12, Iyy12, Ixy24, nSums };
+
+      class CKahanSum
+      {
+      public:
+         CKahanSum() : m_Sum(0), m_C(0) {}
+
+         void Add(Float64 value)
+         {
+            Float64 y = value - m_C;
+            Float64 t = m_Sum + y;
+            m_C = (t - m_Sum) - y;
+            m_Sum = t;
+         }
+
+         Float64 GetSum() const { return m_Sum; }
+
+      private:
+         Float64 m_Sum;
+         Float64 m_C;
+      };
+
+      inline void AddEdge(CKahanSum* pSums,Float64 xi,Float64 yi,Float64 xj,Float64 yj)
+      {
+         Float64 c = xi*yj - xj*yi;
+         pSums[A2].Add(c);
+         pSums[Qy6].Add((xi + xj)*c);
+         pSums[Qx6].Add((yi + yj)*c);
+         pSums[Iyy12].Add((xi*xi + xi*xj + xj*xj)*c);
+         pSums[Ixx12].Add((yi*yi + yi*yj + yj*yj)*c);
+         pSums[Ixy24].Add((xi*yj + 2*xi*yi + 2*xj*yj + xj*yi)*c);
+      }
+
+   #if defined BETOOLBOX_POLYGON_SSE2
+      inline void KahanAdd(__m128d& sum,__m128d& c,__m128d value)
+      {
+         __m128d y = _mm_sub_pd(value,c);
+         __m128d t = _mm_add_pd(sum,y);
+         c = _mm_sub_pd(_mm_sub_pd(t,sum),y);
+         sum = t;
+      }
+
+      // Evaluates two edges at a time. Returns the index of the first edge that was not evaluated.
+      inline IndexType AddEdges(CKahanSum* pSums,const Float64* pX,const Float64* pY,IndexType nPoints,Float64 x0,Float64 y0,Float64* pExtents)
+      {
+         if ( nPoints < 3 )
+         {
+            return 0;
+         }
+
+         __m128d sum[nSums], comp[nSums];
+         for ( int i = 0; i < nSums; i++ )
+         {
+            sum[i]  = _mm_setzero_pd();
+            comp[i] = _mm_setzero_pd();
+         }
+
+         const __m128d vx0 = _mm_set1_pd(x0);
+         const __m128d vy0 = _mm_set1_pd(y0);
+         const __m128d two = _mm_set1_pd(2.0);
+
+         __m128d xMin = _mm_set1_pd(pExtents[0]);
+         __m128d xMax = _mm_set1_pd(pExtents[1]);
+         __m128d yMin = _mm_set1_pd(pExtents[2]);
+         __m128d yMax = _mm_set1_pd(pExtents[3]);
+
+         IndexType i = 0;
+         for ( ; i + 2 < nPoints; i += 2 )
+         {
+            __m128d X  = _mm_loadu_pd(pX + i);
+            __m128d Y  = _mm_loadu_pd(pY + i);
+
+            xMin = _mm_min_pd(xMin,X);
+            xMax = _mm_max_pd(xMax,X);
+            yMin = _mm_min_pd(yMin,Y);
+            yMax = _mm_max_pd(yMax,Y);
+
+            __m128d xi = _mm_sub_pd(X,vx0);
+            __m128d yi = _mm_sub_pd(Y,vy0);
+            __m128d xj = _mm_sub_pd(_mm_loadu_pd(pX + i + 1),vx0);
+            __m128d yj = _mm_sub_pd(_mm_loadu_pd(pY + i + 1),vy0);
+
+            __m128d xiyj = _mm_mul_pd(xi,yj);
+            __m128d xjyi = _mm_mul_pd(xj,yi);
+            __m128d c = _mm_sub_pd(xiyj,xjyi);
+
+            KahanAdd(sum[A2],comp[A2],c);
+            KahanAdd(sum[Qy6],comp[Qy6],_mm_mul_pd(_mm_add_pd(xi,xj),c));
+            KahanAdd(sum[Qx6],comp[Qx6],_mm_mul_pd(_mm_add_pd(yi,yj),c));
+
+            __m128d x2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(xi,xi),_mm_mul_pd(xi,xj)),_mm_mul_pd(xj,xj));
+            KahanAdd(sum[Iyy12],comp[Iyy12],_mm_mul_pd(x2,c));
+
+            __m128d y2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(yi,yi),_mm_mul_pd(yi,yj)),_mm_mul_pd(yj,yj));
+            KahanAdd(sum[Ixx12],comp[Ixx12],_mm_mul_pd(y2,c));
+
+            __m128d xy = _mm_add_pd(_mm_add_pd(xiyj,xjyi),_mm_mul_pd(two,_mm_add_pd(_mm_mul_pd(xi,yi),_mm_mul_pd(xj,yj))));
+            KahanAdd(sum[Ixy24],comp[Ixy24],_mm_mul_pd(xy,c));
+         }
+
+         // reduce the lanes. the compensation is the rounding error carried by each lane's sum
+         // so it is subtracted to keep the accuracy of the compensated summation
+         for ( int s = 0; s < nSums; s++ )
+         {
+            Float64 lane[2];
+            _mm_storeu_pd(lane,sum[s]);
+            pSums[s].Add(lane[0]);
+            pSums[s].Add(lane[1]);
+
+            _mm_storeu_pd(lane,comp[s]);
+            pSums[s].Add(-lane[0]);
+            pSums[s].Add(-lane[1]);
+         }
+
+         Float64 lane[2];
+         _mm_storeu_pd(lane,xMin); pExtents[0] = (std::min)(lane[0],lane[1]);
+         _mm_storeu_pd(lane,xMax); pExtents[1] = (std::max)(lane[0],lane[1]);
+         _mm_storeu_pd(lane,yMin); pExtents[2] = (std::min)(lane[0],lane[1]);
+         _mm_storeu_pd(lane,yMax); pExtents[3] = (std::max)(lane[0],lane[1]);
+
+         return i;
+      }
+   #else
+      inline IndexType AddEdges(CKahanSum* /*pSums*/,const Float64* /*pX*/,const Float64* /*pY*/,IndexType /*nPoints*/,Float64 /*x0*/,Float64 /*y0*/,Float64* /*pExtents*/)
+      {
+         // no SIMD support, all edges are evaluated by the scalar loop
+         return 0;
+      }
+   #endif // BETOOLBOX_POLYGON_SSE2
+
+      // The neutral axis searches are bisections. The search ends when the bracket is a small
+      // fraction of the section depth, or after a fixed number of steps for sections that are
+      // far from the origin where the bracket can't be made that small.
+      const Float64 BisectionTolerance = 1.0e-12;
+      const int MaxBisectionSteps = 100;
+
+      // Scratch buffers for clipped polygons. The buffers are sized once for the largest
+      // polygon so the bisection steps don't allocate memory.
+      class CClipBuffer
+      {
+      public:
+         CClipBuffer(const IndexType* pOffsets,IndexType nPolygons)
+         {
+            IndexType nMaxPoints = 0;
+            for ( IndexType i = 0; i < nPolygons; i++ )
+            {
+               nMaxPoints = (std::max)(nMaxPoints,pOffsets[i+1] - pOffsets[i]);
+            }
+            m_X.resize(2*nMaxPoints);
+            m_Y.resize(2*nMaxPoints);
+         }
+
+         Float64* GetX() { return m_X.data(); }
+         Float64* GetY() { return m_Y.data(); }
+
+      private:
+         std::vector<Float64> m_X;
+         std::vector<Float64> m_Y;
+      };
+
+      // Computes the area and the first moment about the line at y of the part of a polygon
+      // that is above or below the line
+      inline void ComputeClippedMoments(const Float64* pX,const Float64* pY,IndexType nPoints,Float64 y,bool bAbove,CClipBuffer& buffer,Float64* pA,Float64* pQ)
+      {
+         *pA = 0;
+         *pQ = 0;
+
+         Float64* pXclip = buffer.GetX();
+         Float64* pYclip = buffer.GetY();
+         IndexType nClip = ClipPolygon(pX,pY,nPoints,y,bAbove,pXclip,pYclip);
+         if ( nClip < 3 )
+         {
+            return;
+         }
+
+         // coordinates are relative to the line so the first moment is about the line
+         Float64 x0 = pXclip[0];
+         Float64 A2 = 0;
+         Float64 Q6 = 0;
+         for ( IndexType i = 0; i < nClip; i++ )
+         {
+            IndexType j = (i == nClip-1 ? 0 : i+1);
+            Float64 xi = pXclip[i] - x0;
+            Float64 yi = pYclip[i] - y;
+            Float64 xj = pXclip[j] - x0;
+            Float64 yj = pYclip[j] - y;
+            Float64 c = xi*yj - xj*yi;
+            A2 += c;
+            Q6 += (yi + yj)*c;
+         }
+
+         Float64 sign = (A2 < 0 ? -1.0 : 1.0);
+         *pA = sign*A2/2;
+         *pQ = sign*Q6/6;
+      }
+
+      inline void GetVerticalExtents(const Float64* pY,IndexType nPoints,Float64* pYmin,Float64* pYmax)
+      {
+         for ( IndexType i = 0; i < nPoints; i++ )
+         {
+            *pYmin = (std::min)(*pYmin,pY[i]);
+            *pYmax = (std::max)(*pYmax,pY[i]);
+         }
+      }
+   }
+
+
+   inline void InitPolygonProperties(POLYGONPROPERTIES* pProps)
+   {
+      pProps->Area = 0;
+      pProps->Xbar = 0;
+      pProps->Ybar = 0;
+      pProps->Ixx  = 0;
+      pProps->Iyy  = 0;
+      pProps->Ixy  = 0;
+      pProps->Xmin = 0;
+      pProps->Xmax = 0;
+      pProps->Ymin = 0;
+      pProps->Ymax = 0;
+   }
+
+   inline void ComputePolygonProperties(const Float64* pX,const Float64* pY,IndexType nPoints,POLYGONPROPERTIES* pProps)
+   {
+      InitPolygonProperties(pProps);
+      if ( nPoints == 0 )
+      {
+         return;
+      }
+
+      Float64 x0 = pX[0];
+      Float64 y0 = pY[0];
+      Float64 extents[4] = {x0,x0,y0,y0}; // xmin, xmax, ymin, ymax
+
+      Detail::CKahanSum sums[Detail::nSums];
+      IndexType i = Detail::AddEdges(sums,pX,pY,nPoints,x0,y0,extents);
+
+      // remaining edges, including the closing edge
+      for ( ; i < nPoints; i++ )
+      {
+         IndexType j = (i == nPoints-1 ? 0 : i+1);
+         Detail::AddEdge(sums,pX[i]-x0,pY[i]-y0,pX[j]-x0,pY[j]-y0);
+
+         extents[0] = (std::min)(extents[0],pX[i]);
+         extents[1] = (std::max)(extents[1],pX[i]);
+         extents[2] = (std::min)(extents[2],pY[i]);
+         extents[3] = (std::max)(extents[3],pY[i]);
+      }
+
+      pProps->Xmin = extents[0];
+      pProps->Xmax = extents[1];
+      pProps->Ymin = extents[2];
+      pProps->Ymax = extents[3];
+
+      Float64 A = sums[Detail::A2].GetSum()/2;
+      if ( A == 0 )
+      {
+         // degenerate polygon
+         pProps->Xbar = x0;
+         pProps->Ybar = y0;
+         return;
+      }
+
+      // clockwise polygons have negative area... all of the sums change sign
+      Float64 sign = (A < 0 ? -1.0 : 1.0);
+      A *= sign;
+
+      Float64 xbar = sign*sums[Detail::Qy6].GetSum()/(6*A);
+      Float64 ybar = sign*sums[Detail::Qx6].GetSum()/(6*A);
+
+      pProps->Area = A;
+      pProps->Xbar = x0 + xbar;
+      pProps->Ybar = y0 + ybar;
+      pProps->Ixx = sign*sums[Detail::Ixx12].GetSum()/12 - A*ybar*ybar;
+      pProps->Iyy = sign*sums[Detail::Iyy12].GetSum()/12 - A*xbar*xbar;
+      pProps->Ixy = sign*sums[Detail::Ixy24].GetSum()/24 - A*xbar*ybar;
+   }
+
+   inline void AddPolygonProperties(POLYGONPROPERTIES* pSection,const POLYGONPROPERTIES& piece,Float64 n)
+   {
+      if ( piece.Area == 0 )
+      {
+         return;
+      }
+
+      Float64 nA = n*piece.Area;
+      if ( pSection->Area == 0 )
+      {
+         *pSection = piece;
+         pSection->Area = nA;
+         pSection->Ixx *= n;
+         pSection->Iyy *= n;
+         pSection->Ixy *= n;
+         return;
+      }
+
+      // combine about the new centroid using the parallel axis theorem
+      Float64 A = pSection->Area + nA;
+      Float64 xbar = (pSection->Area*pSection->Xbar + nA*piece.Xbar)/A;
+      Float64 ybar = (pSection->Area*pSection->Ybar + nA*piece.Ybar)/A;
+
+      Float64 dx1 = pSection->Xbar - xbar;
+      Float64 dy1 = pSection->Ybar - ybar;
+      Float64 dx2 = piece.Xbar - xbar;
+      Float64 dy2 = piece.Ybar - ybar;
+
+      pSection->Ixx = pSection->Ixx + pSection->Area*dy1*dy1 + n*piece.Ixx + nA*dy2*dy2;
+      pSection->Iyy = pSection->Iyy + pSection->Area*dx1*dx1 + n*piece.Iyy + nA*dx2*dx2;
+      pSection->Ixy = pSection->Ixy + pSection->Area*dx1*dy1 + n*piece.Ixy + nA*dx2*dy2;
+
+      pSection->Area = A;
+      pSection->Xbar = xbar;
+      pSection->Ybar = ybar;
+
+      pSection->Xmin = (std::min)(pSection->Xmin,piece.Xmin);
+      pSection->Xmax = (std::max)(pSection->Xmax,piece.Xmax);
+      pSection->Ymin = (std::min)(pSection->Ymin,piece.Ymin);
+      pSection->Ymax = (std::max)(pSection->Ymax,piece.Ymax);
+   }
+
+   inline void ComputeTransformedProperties(const Float64* pX,const Float64* pY,const IndexType* pOffsets,const Float64* pN,IndexType nPolygons,POLYGONPROPERTIES* pSection,POLYGONPROPERTIES* pPieces)
+   {
+      InitPolygonProperties(pSection);
+      for ( IndexType i = 0; i < nPolygons; i++ )
+      {
+         IndexType first = pOffsets[i];
+         IndexType nPoints = pOffsets[i+1] - first;
+
+         POLYGONPROPERTIES props;
+         ComputePolygonProperties(pX + first,pY + first,nPoints,&props);
+         AddPolygonProperties(pSection,props,pN[i]);
+
+         if ( pPieces )
+         {
+            pPieces[i] = props;
+         }
+      }
+   }
+
+   inline IndexType ClipPolygon(const Float64* pX,const Float64* pY,IndexType nPoints,Float64 y,bool bAbove,Float64* pXclip,Float64* pYclip)
+   {
+      // Sutherland-Hodgman clipping against a single horizontal edge. Each edge of the polygon
+      // contributes at most two points to the clipped polygon.
+      if ( nPoints == 0 )
+      {
+         return 0;
+      }
+
+      IndexType nClip = 0;
+      Float64 xi = pX[nPoints-1];
+      Float64 yi = pY[nPoints-1];
+      bool bInside_i = (bAbove ? y <= yi : yi <= y);
+      for ( IndexType j = 0; j < nPoints; j++ )
+      {
+         Float64 xj = pX[j];
+         Float64 yj = pY[j];
+         bool bInside_j = (bAbove ? y <= yj : yj <= y);
+
+         if ( bInside_i != bInside_j )
+         {
+            // the edge crosses the line
+            Float64 t = (y - yi)/(yj - yi);
+            pXclip[nClip] = xi + t*(xj - xi);
+            pYclip[nClip] = y;
+            nClip++;
+         }
+
+         if ( bInside_j )
+         {
+            pXclip[nClip] = xj;
+            pYclip[nClip] = yj;
+            nClip++;
+         }
+
+         xi = xj;
+         yi = yj;
+         bInside_i = bInside_j;
+      }
+
+      return nClip;
+   }
+
+   inline void ComputeEqualAreaProperties(const Float64* pX,const Float64* pY,const IndexType* pOffsets,const Float64* pN,IndexType nPolygons,Float64* pYea,Float64* pQ)
+   {
+      *pYea = 0;
+      *pQ = 0;
+
+      IndexType nPoints = (nPolygons == 0 ? 0 : pOffsets[nPolygons] - pOffsets[0]);
+      if ( nPoints == 0 )
+      {
+         return;
+      }
+
+      Float64 yMin = pY[pOffsets[0]];
+      Float64 yMax = yMin;
+      Detail::GetVerticalExtents(pY + pOffsets[0],nPoints,&yMin,&yMax);
+
+      Detail::CClipBuffer buffer(pOffsets,nPolygons);
+
+      // The transformed area above the axis decreases, and the transformed area below the axis
+      // increases, as the axis moves up. Bisect until they are equal.
+      Float64 yLower = yMin;
+      Float64 yUpper = yMax;
+      Float64 tolerance = Detail::BisectionTolerance*(yMax - yMin);
+      for ( int step = 0; step < Detail::MaxBisectionSteps && tolerance < yUpper - yLower; step++ )
+      {
+         Float64 y = (yLower + yUpper)/2;
+         Float64 Nabove = 0;
+         Float64 Nbelow = 0;
+         for ( IndexType i = 0; i < nPolygons; i++ )
+         {
+            Float64 A, Q;
+            Detail::ComputeClippedMoments(pX + pOffsets[i],pY + pOffsets[i],pOffsets[i+1] - pOffsets[i],y,true,buffer,&A,&Q);
+            Nabove += pN[i]*A;
+
+            Detail::ComputeClippedMoments(pX + pOffsets[i],pY + pOffsets[i],pOffsets[i+1] - pOffsets[i],y,false,buffer,&A,&Q);
+            Nbelow += pN[i]*A;
+         }
+
+         if ( Nabove < Nbelow )
+         {
+            yUpper = y;
+         }
+         else
+         {
+            yLower = y;
+         }
+      }
+
+      Float64 Yea = (yLower + yUpper)/2;
+
+      Float64 Q = 0;
+      for ( IndexType i = 0; i < nPolygons; i++ )
+      {
+         Float64 Aabove, Qabove;
+         Detail::ComputeClippedMoments(pX + pOffsets[i],pY + pOffsets[i],pOffsets[i+1] - pOffsets[i],Yea,true,buffer,&Aabove,&Qabove);
+
+         Float64 Abelow, Qbelow;
+         Detail::ComputeClippedMoments(pX + pOffsets[i],pY + pOffsets[i],pOffsets[i+1] - pOffsets[i],Yea,false,buffer,&Abelow,&Qbelow);
+
+         Q += pN[i]*(Qabove - Qbelow);
+      }
+
+      *pYea = Yea;
+      *pQ = Q;
+   }
+
+   inline void ComputeCrackedProperties(const Float64* pX,const Float64* pY,const IndexType* pOffsets,const Float64* pN,const Float64* pNt,IndexType nPolygons,const POLYGONPROPERTIES* pBase,bool bTopInCompression,Float64* pYna,POLYGONPROPERTIES* pSection)
+   {
+      InitPolygonProperties(pSection);
+      *pYna = 0;
+
+      bool bBase = (pBase != nullptr && pBase->Area != 0);
+      IndexType nPoints = (nPolygons == 0 ? 0 : pOffsets[nPolygons] - pOffsets[0]);
+      if ( nPoints == 0 && !bBase )
+      {
+         return;
+      }
+
+      Float64 yMin = (bBase ? pBase->Ymin : pY[pOffsets[0]]);
+      Float64 yMax = (bBase ? pBase->Ymax : yMin);
+      Detail::GetVerticalExtents(pY + (nPolygons == 0 ? 0 : pOffsets[0]),nPoints,&yMin,&yMax);
+
+      Detail::CClipBuffer buffer(pOffsets,nPolygons);
+
+      std::vector<POLYGONPROPERTIES> pieces(nPolygons);
+      for ( IndexType i = 0; i < nPolygons; i++ )
+      {
+         ComputePolygonProperties(pX + pOffsets[i],pY + pOffsets[i],pOffsets[i+1] - pOffsets[i],&pieces[i]);
+      }
+
+      // The first moment of the effective transformed area about the axis decreases as the
+      // axis moves up. Bisect until the first moment is zero. Polygons that are transformed
+      // the same in tension and compression don't need to be clipped.
+      Float64 yLower = yMin;
+      Float64 yUpper = yMax;
+      Float64 tolerance = Detail::BisectionTolerance*(yMax - yMin);
+      for ( int step = 0; step < Detail::MaxBisectionSteps && tolerance < yUpper - yLower; step++ )
+      {
+         Float64 y = (yLower + yUpper)/2;
+         Float64 Q = (bBase ? pBase->Area*(pBase->Ybar - y) : 0);
+         for ( IndexType i = 0; i < nPolygons; i++ )
+         {
+            if ( pN[i] == pNt[i] )
+            {
+               Q += pN[i]*pieces[i].Area*(pieces[i].Ybar - y);
+            }
+            else
+            {
+               Float64 nAbove = (bTopInCompression ? pN[i]  : pNt[i]);
+               Float64 nBelow = (bTopInCompression ? pNt[i] : pN[i]);
+
+               Float64 A, Qabove, Qbelow;
+               Detail::ComputeClippedMoments(pX + pOffsets[i],pY + pOffsets[i],pOffsets[i+1] - pOffsets[i],y,true, buffer,&A,&Qabove);
+               Detail::ComputeClippedMoments(pX + pOffsets[i],pY + pOffsets[i],pOffsets[i+1] - pOffsets[i],y,false,buffer,&A,&Qbelow);
+               Q += nAbove*Qabove + nBelow*Qbelow;
+            }
+         }
+
+         if ( 0 < Q )
+         {
+            yLower = y;
+         }
+         else
+         {
+            yUpper = y;
+         }
+      }
+
+      Float64 Yna = (yLower + yUpper)/2;
+
+      // properties of the effective section
+      for ( IndexType i = 0; i < nPolygons; i++ )
+      {
+         if ( pN[i] == pNt[i] )
+         {
+            AddPolygonProperties(pSection,pieces[i],pN[i]);
+            continue;
+         }
+
+         for ( int side = 0; side < 2; side++ )
+         {
+            bool bAbove = (side == 0);
+            Float64 n = (bAbove == bTopInCompression ? pN[i] : pNt[i]);
+            if ( n == 0 )
+            {
+               continue;
+            }
+
+            IndexType nClip = ClipPolygon(pX + pOffsets[i],pY + pOffsets[i],pOffsets[i+1] - pOffsets[i],Yna,bAbove,buffer.GetX(),buffer.GetY());
+
+            POLYGONPROPERTIES props;
+            ComputePolygonProperties(buffer.GetX(),buffer.GetY(),nClip,&props);
+            AddPolygonProperties(pSection,props,n);
+         }
+      }
+
+      if ( bBase )
+      {
+         AddPolygonProperties(pSection,*pBase,1.0);
+      }
+
+      *pYna = Yna;
+   }
+}
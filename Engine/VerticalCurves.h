@@ -0,0 +1,417 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "EngineUtilities.h"
+
+namespace BEToolboxEngine
+{
+   // A point on the superelevation profile. Slopes are positive upwards away from the crown line.
+   struct SuperelevationProfilePoint
+   {
+      Float64 Station;
+      Float64 LeftSlope;
+      Float64 RightSlope;
+   };
+
+   // Stations where the roadway is evaluated and the results of the evaluation. The values are stored
+   // in contiguous arrays so a span of stations is evaluated in a single pass.
+   struct PROFILEPOINTS
+   {
+      std::vector<Float64> Station; // input - station where the roadway is evaluated
+      std::vector<Float64> Offset; // input - offset from the crown line where OffsetElevation is evaluated
+      std::vector<Float64> Elevation; // profile grade elevation
+      std::vector<Float64> Grade; // profile grade
+      std::vector<Float64> OffsetElevation; // finished grade elevation at Offset
+      std::vector<Float64> LeftSlope; // crown slopes, positive upwards away from the crown line
+      std::vector<Float64> RightSlope;
+
+      void Clear();
+      void Reserve(IndexType nPoints);
+      IndexType Add(Float64 station,Float64 offset); // returns the index of the point
+      IndexType GetCount() const { return Station.size(); }
+      void Resize(IndexType nPoints); // resizes the inputs and results
+      void CopyPoint(IndexType idx,const PROFILEPOINTS& points,IndexType pointIdx); // copies a point and its results from points to idx
+   };
+
+   // Native evaluator for the Curvel roadway model.
+   //
+   // The Curvel roadway profile is a sequence of symmetric parabolic vertical curves and a crown slope
+   // transition defined by three superelevation profile points. The crown slopes are constant before the first
+   // and after the last profile point and vary linearly between them. The profile grade line is offset from the
+   // crown line so the elevation at an offset is the profile grade elevation adjusted for the crown slopes between
+   // the profile grade line and the offset.
+   //
+   // The profile is indexed by the BVC station of each vertical curve. The segment starting at a BVC covers
+   // the vertical curve and the tangent grade that follows it, up to the next BVC, so a station is evaluated with
+   // a binary search of the segment index and closed form math. When the stations in a batch are sorted, the
+   // search starts with the segment of the previous station so the segments are walked in order.
+   //
+   // This is equivalent to the COGO Profile with VertCurve elements and a finished surface with four template
+   // segments, but all of the results for a span of stations are computed without any COM calls.
+   class CProfileEvaluator
+   {
+   public:
+      CProfileEvaluator();
+
+      // Defines the first vertical curve. Any other vertical curves are removed.
+      void SetVerticalCurve(Float64 g1,Float64 g2,Float64 pviStation,Float64 pviElevation,Float64 length);
+
+      // Adds a vertical curve after the last vertical curve. The entry grade is the exit grade of the
+      // previous curve and the PVI is on the previous exit grade. The curves may not overlap.
+      void AddVerticalCurve(Float64 pviStation,Float64 g2,Float64 length);
+
+      void SetSuperelevation(Float64 profileGradeOffset,const SuperelevationProfilePoint* pPoints); // pPoints has 3 points
+
+      IndexType GetVerticalCurveCount() const;
+      void GetVerticalCurve(IndexType curveIdx,Float64* pg1,Float64* pg2,Float64* pPVIStation,Float64* pPVIElevation,Float64* pLength) const;
+
+      // Key points on a vertical curve. The low and high points are the locations of the minimum
+      // and maximum elevation between the BVC and the EVC.
+      void GetBVC(IndexType curveIdx,Float64* pStation,Float64* pElevation) const;
+      void GetEVC(IndexType curveIdx,Float64* pStation,Float64* pElevation) const;
+      void GetLowPoint(IndexType curveIdx,Float64* pStation,Float64* pElevation) const;
+      void GetHighPoint(IndexType curveIdx,Float64* pStation,Float64* pElevation) const;
+
+      // Evaluates the roadway at all of the stations in pPoints
+      void Evaluate(PROFILEPOINTS* pPoints) const;
+
+      // Evaluates the roadway at a single station
+      Float64 GetElevation(Float64 station) const;
+      Float64 GetGrade(Float64 station) const;
+      Float64 GetElevation(Float64 station,Float64 offset) const;
+      void GetCrownSlopes(Float64 station,Float64* pLeftSlope,Float64* pRightSlope) const;
+
+   private:
+      // Vertical curves, sorted by BVC station. The BVC stations are the segment index.
+      std::vector<Float64> m_BVCStation;
+      std::vector<Float64> m_BVCElevation;
+      std::vector<Float64> m_g1;
+      std::vector<Float64> m_g2;
+      std::vector<Float64> m_Length;
+      std::vector<Float64> m_r; // rate of change of grade
+
+      Float64 m_ProfileGradeOffset;
+      Float64 m_Station[3]; // superelevation profile points, sorted by station
+      Float64 m_LeftSlope[3];
+      Float64 m_RightSlope[3];
+      Float64 m_dLeftSlope[2]; // rate of change of slope between profile points
+      Float64 m_dRightSlope[2];
+
+      Float64 GetCurveElevation(IndexType curveIdx,Float64 station) const;
+      Float64 GetSlope(Float64 station,const Float64* pSlope,const Float64* pdSlope) const;
+   };
+
+   inline void PROFILEPOINTS::Clear()
+   {
+      Station.clear();
+      Offset.clear();
+      Elevation.clear();
+      Grade.clear();
+      OffsetElevation.clear();
+      LeftSlope.clear();
+      RightSlope.clear();
+   }
+
+   inline void PROFILEPOINTS::Reserve(IndexType nPoints)
+   {
+      Station.reserve(nPoints);
+      Offset.reserve(nPoints);
+   }
+
+   inline IndexType PROFILEPOINTS::Add(Float64 station,Float64 offset)
+   {
+      Station.push_back(station);
+      Offset.push_back(offset);
+      return Station.size()-1;
+   }
+
+   inline void PROFILEPOINTS::Resize(IndexType nPoints)
+   {
+      Station.resize(nPoints);
+      Offset.resize(nPoints);
+      Elevation.resize(nPoints);
+      Grade.resize(nPoints);
+      OffsetElevation.resize(nPoints);
+      LeftSlope.resize(nPoints);
+      RightSlope.resize(nPoints);
+   }
+
+   inline void PROFILEPOINTS::CopyPoint(IndexType idx,const PROFILEPOINTS& points,IndexType pointIdx)
+   {
+      Station[idx]         = points.Station[pointIdx];
+      Offset[idx]          = points.Offset[pointIdx];
+      Elevation[idx]       = points.Elevation[pointIdx];
+      Grade[idx]           = points.Grade[pointIdx];
+      OffsetElevation[idx] = points.OffsetElevation[pointIdx];
+      LeftSlope[idx]       = points.LeftSlope[pointIdx];
+      RightSlope[idx]      = points.RightSlope[pointIdx];
+   }
+
+   inline CProfileEvaluator::CProfileEvaluator()
+   {
+      SetVerticalCurve(0,0,0,0,0);
+
+      SuperelevationProfilePoint points[3];
+      for ( IndexType i = 0; i < 3; i++ )
+      {
+         points[i].Station = (Float64)i;
+         points[i].LeftSlope = 0;
+         points[i].RightSlope = 0;
+      }
+      SetSuperelevation(0,points);
+   }
+
+   inline void CProfileEvaluator::SetVerticalCurve(Float64 g1,Float64 g2,Float64 pviStation,Float64 pviElevation,Float64 length)
+   {
+      m_BVCStation.clear();
+      m_BVCElevation.clear();
+      m_g1.clear();
+      m_g2.clear();
+      m_Length.clear();
+      m_r.clear();
+
+      m_BVCStation.push_back(pviStation - length/2);
+      m_BVCElevation.push_back(pviElevation - g1*length/2);
+      m_g1.push_back(g1);
+      m_g2.push_back(g2);
+      m_Length.push_back(length);
+      m_r.push_back(IsZero(length) ? 0.0 : (g2 - g1)/length);
+   }
+
+   inline void CProfileEvaluator::AddVerticalCurve(Float64 pviStation,Float64 g2,Float64 length)
+   {
+      IndexType prevIdx = m_BVCStation.size()-1;
+      Float64 prevPVIStation = m_BVCStation[prevIdx] + m_Length[prevIdx]/2;
+      Float64 prevPVIElevation = m_BVCElevation[prevIdx] + m_g1[prevIdx]*m_Length[prevIdx]/2;
+
+      Float64 g1 = m_g2[prevIdx];
+      Float64 pviElevation = prevPVIElevation + g1*(pviStation - prevPVIStation);
+
+      Float64 bvcStation = pviStation - length/2;
+      Float64 prevEVCStation = m_BVCStation[prevIdx] + m_Length[prevIdx];
+      assert(prevEVCStation < bvcStation || IsEqual(prevEVCStation,bvcStation)); // curves can't overlap
+
+      m_BVCStation.push_back(bvcStation);
+      m_BVCElevation.push_back(pviElevation - g1*length/2);
+      m_g1.push_back(g1);
+      m_g2.push_back(g2);
+      m_Length.push_back(length);
+      m_r.push_back(IsZero(length) ? 0.0 : (g2 - g1)/length);
+   }
+
+   inline void CProfileEvaluator::SetSuperelevation(Float64 profileGradeOffset,const SuperelevationProfilePoint* pPoints)
+   {
+      m_ProfileGradeOffset = profileGradeOffset;
+
+      SuperelevationProfilePoint points[3] = {pPoints[0],pPoints[1],pPoints[2]};
+      std::stable_sort(std::begin(points),std::end(points),[](const auto& a,const auto& b) {return a.Station < b.Station;});
+
+      for ( IndexType i = 0; i < 3; i++ )
+      {
+         m_Station[i]    = points[i].Station;
+         m_LeftSlope[i]  = points[i].LeftSlope;
+         m_RightSlope[i] = points[i].RightSlope;
+      }
+
+      for ( IndexType i = 0; i < 2; i++ )
+      {
+         Float64 ds = m_Station[i+1] - m_Station[i];
+         m_dLeftSlope[i]  = IsZero(ds) ? 0.0 : (m_LeftSlope[i+1]  - m_LeftSlope[i])/ds;
+         m_dRightSlope[i] = IsZero(ds) ? 0.0 : (m_RightSlope[i+1] - m_RightSlope[i])/ds;
+      }
+   }
+
+   inline IndexType CProfileEvaluator::GetVerticalCurveCount() const
+   {
+      return m_BVCStation.size();
+   }
+
+   inline void CProfileEvaluator::GetVerticalCurve(IndexType curveIdx,Float64* pg1,Float64* pg2,Float64* pPVIStation,Float64* pPVIElevation,Float64* pLength) const
+   {
+      *pg1 = m_g1[curveIdx];
+      *pg2 = m_g2[curveIdx];
+      *pLength = m_Length[curveIdx];
+      *pPVIStation = m_BVCStation[curveIdx] + m_Length[curveIdx]/2;
+      *pPVIElevation = m_BVCElevation[curveIdx] + m_g1[curveIdx]*m_Length[curveIdx]/2;
+   }
+
+   inline void CProfileEvaluator::GetBVC(IndexType curveIdx,Float64* pStation,Float64* pElevation) const
+   {
+      *pStation = m_BVCStation[curveIdx];
+      *pElevation = m_BVCElevation[curveIdx];
+   }
+
+   inline void CProfileEvaluator::GetEVC(IndexType curveIdx,Float64* pStation,Float64* pElevation) const
+   {
+      *pStation = m_BVCStation[curveIdx] + m_Length[curveIdx];
+      *pElevation = GetCurveElevation(curveIdx,*pStation);
+   }
+
+   inline void CProfileEvaluator::GetLowPoint(IndexType curveIdx,Float64* pStation,Float64* pElevation) const
+   {
+      Float64 evcStation, evcElevation;
+      GetEVC(curveIdx,&evcStation,&evcElevation);
+
+      Float64 g1 = m_g1[curveIdx];
+      Float64 g2 = m_g2[curveIdx];
+      if ( g1 < 0 && 0 < g2 && !IsZero(m_Length[curveIdx]) )
+      {
+         // sag curve - the low point is where the grade is zero
+         *pStation = m_BVCStation[curveIdx] - g1/m_r[curveIdx];
+         *pElevation = GetCurveElevation(curveIdx,*pStation);
+      }
+      else if ( evcElevation < m_BVCElevation[curveIdx] )
+      {
+         *pStation = evcStation;
+         *pElevation = evcElevation;
+      }
+      else
+      {
+         GetBVC(curveIdx,pStation,pElevation);
+      }
+   }
+
+   inline void CProfileEvaluator::GetHighPoint(IndexType curveIdx,Float64* pStation,Float64* pElevation) const
+   {
+      Float64 evcStation, evcElevation;
+      GetEVC(curveIdx,&evcStation,&evcElevation);
+
+      Float64 g1 = m_g1[curveIdx];
+      Float64 g2 = m_g2[curveIdx];
+      if ( 0 < g1 && g2 < 0 && !IsZero(m_Length[curveIdx]) )
+      {
+         // crest curve - the high point is where the grade is zero
+         *pStation = m_BVCStation[curveIdx] - g1/m_r[curveIdx];
+         *pElevation = GetCurveElevation(curveIdx,*pStation);
+      }
+      else if ( m_BVCElevation[curveIdx] < evcElevation )
+      {
+         *pStation = evcStation;
+         *pElevation = evcElevation;
+      }
+      else
+      {
+         GetBVC(curveIdx,pStation,pElevation);
+      }
+   }
+
+   inline void CProfileEvaluator::Evaluate(PROFILEPOINTS* pPoints) const
+   {
+      IndexType nPoints = pPoints->GetCount();
+      assert(pPoints->Offset.size() == nPoints);
+      pPoints->Elevation.resize(nPoints);
+      pPoints->Grade.resize(nPoints);
+      pPoints->OffsetElevation.resize(nPoints);
+      pPoints->LeftSlope.resize(nPoints);
+      pPoints->RightSlope.resize(nPoints);
+
+      const Float64* pStation = pPoints->Station.data();
+      const Float64* pOffset = pPoints->Offset.data();
+      Float64* pElevation = pPoints->Elevation.data();
+      Float64* pGrade = pPoints->Grade.data();
+      Float64* pOffsetElevation = pPoints->OffsetElevation.data();
+      Float64* pLeftSlope = pPoints->LeftSlope.data();
+      Float64* pRightSlope = pPoints->RightSlope.data();
+
+      // Vertical curves - x is the distance from the BVC of the segment and xc is x clamped to the vertical curve.
+      // Beyond the vertical curve, the elevation is extended along the tangent grade.
+      IndexType segmentIdx = 0;
+      for ( IndexType i = 0; i < nPoints; i++ )
+      {
+         segmentIdx = FindSegment(m_BVCStation,pStation[i],segmentIdx);
+         const Float64 g1 = m_g1[segmentIdx];
+         const Float64 g2 = m_g2[segmentIdx];
+         const Float64 L = m_Length[segmentIdx];
+         const Float64 r = m_r[segmentIdx];
+         const Float64 bvcElevation = m_BVCElevation[segmentIdx];
+
+         Float64 x = pStation[i] - m_BVCStation[segmentIdx];
+         Float64 xc = (x < 0 ? 0 : (L < x ? L : x));
+         Float64 grade = (x < 0 ? g1 : (L < x ? g2 : g1 + r*xc));
+         pGrade[i] = grade;
+         pElevation[i] = bvcElevation + (g1 + 0.5*r*xc)*xc + grade*(x - xc);
+      }
+
+      // Crown slopes and the elevation at the offset. This loop is written without calls or early returns
+      // so the compiler can vectorize it. The elevation change from the crown line
+      // to an offset is slope*offset on the right side and -slope*offset on the left side.
+      const Float64 pgo = m_ProfileGradeOffset;
+      for ( IndexType i = 0; i < nPoints; i++ )
+      {
+         Float64 station = pStation[i];
+         Float64 leftSlope  = GetSlope(station,m_LeftSlope,m_dLeftSlope);
+         Float64 rightSlope = GetSlope(station,m_RightSlope,m_dRightSlope);
+         pLeftSlope[i]  = leftSlope;
+         pRightSlope[i] = rightSlope;
+
+         Float64 offset = pOffset[i];
+         Float64 dyOffset = (offset < 0 ? -leftSlope : rightSlope)*offset;
+         Float64 dyPGL    = (pgo < 0 ? -leftSlope : rightSlope)*pgo;
+         pOffsetElevation[i] = pElevation[i] + dyOffset - dyPGL;
+      }
+   }
+
+   inline Float64 CProfileEvaluator::GetElevation(Float64 station) const
+   {
+      return GetElevation(station,m_ProfileGradeOffset);
+   }
+
+   inline Float64 CProfileEvaluator::GetGrade(Float64 station) const
+   {
+      PROFILEPOINTS point;
+      point.Add(station,m_ProfileGradeOffset);
+      Evaluate(&point);
+      return point.Grade.front();
+   }
+
+   inline Float64 CProfileEvaluator::GetElevation(Float64 station,Float64 offset) const
+   {
+      PROFILEPOINTS point;
+      point.Add(station,offset);
+      Evaluate(&point);
+      return point.OffsetElevation.front();
+   }
+
+   inline void CProfileEvaluator::GetCrownSlopes(Float64 station,Float64* pLeftSlope,Float64* pRightSlope) const
+   {
+      *pLeftSlope  = GetSlope(station,m_LeftSlope,m_dLeftSlope);
+      *pRightSlope = GetSlope(station,m_RightSlope,m_dRightSlope);
+   }
+
+   inline Float64 CProfileEvaluator::GetCurveElevation(IndexType curveIdx,Float64 station) const
+   {
+      // elevation on a curve between its BVC and EVC
+      Float64 x = station - m_BVCStation[curveIdx];
+      return m_BVCElevation[curveIdx] + (m_g1[curveIdx] + 0.5*m_r[curveIdx]*x)*x;
+   }
+
+   inline Float64 CProfileEvaluator::GetSlope(Float64 station,const Float64* pSlope,const Float64* pdSlope) const
+   {
+      // slopes are constant before the first and after the last profile point
+      Float64 s0 = (station < m_Station[0] ? m_Station[0] : (m_Station[1] < station ? m_Station[1] : station));
+      Float64 s1 = (station < m_Station[1] ? m_Station[1] : (m_Station[2] < station ? m_Station[2] : station));
+      return (station < m_Station[1] ? pSlope[0] + pdSlope[0]*(s0 - m_Station[0]) : pSlope[1] + pdSlope[1]*(s1 - m_Station[1]));
+   }
+}
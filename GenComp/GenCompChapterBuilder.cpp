@@ -68,64 +68,58 @@ rptChapter* CGenCompChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16
    pPara = new rptParagraph;
    (*pChapter) << pPara;
 
-   rptRcTable* pLayoutTable = rptStyleManager::CreateLayoutTable(4);
+   // one column for each shape and one for the composite section
+   IndexType nPieces = m_pDoc->GetSecondaryPieceCount();
+   rptRcTable* pLayoutTable = rptStyleManager::CreateLayoutTable((ColumnIndexType)(nPieces+2));
 
    (*pPara) << pLayoutTable;
 
-   CEAFApp* pApp = EAFGetApp();
-   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
-
-   INIT_UV_PROTOTYPE( rptLengthUnitValue,  length, pDispUnits->ComponentDim, false);
-
-   rptRcTable* pPrimaryPointsTable = rptStyleManager::CreateDefaultTable(2,_T("Basic Section"));
-
-   (*pLayoutTable)(0,0) << pPrimaryPointsTable;
-   (*pPrimaryPointsTable)(0,0) << COLHDR(_T("X"),rptLengthUnitTag, pDispUnits->ComponentDim);
-   (*pPrimaryPointsTable)(0,1) << COLHDR(_T("Y"),rptLengthUnitTag, pDispUnits->ComponentDim);
-
-
-   rptRcTable* pSecondaryPointsTable = rptStyleManager::CreateDefaultTable(2,_T("Composite Piece"));
-
-   (*pLayoutTable)(0,1) << pSecondaryPointsTable;
-   (*pSecondaryPointsTable)(0,0) << COLHDR(_T("X"),rptLengthUnitTag, pDispUnits->ComponentDim);
-   (*pSecondaryPointsTable)(0,1) << COLHDR(_T("Y"),rptLengthUnitTag, pDispUnits->ComponentDim);
-
    //
-   // Echo Input
+   // Echo Input and the properties of each shape
    //
-   RowIndexType row = pPrimaryPointsTable->GetNumberOfHeaderRows();
-   const std::vector<std::pair<Float64,Float64>>& primaryPoints(m_pDoc->GetPrimaryPoints());
-   std::vector<std::pair<Float64,Float64>>::const_iterator iter(primaryPoints.begin());
-   std::vector<std::pair<Float64,Float64>>::const_iterator end(primaryPoints.end());
-   for ( ; iter != end; iter++, row++ )
+   const POLYGONPROPERTIES& primaryProps(m_pDoc->GetPrimaryProperties());
+   ColumnIndexType col = 0;
+   (*pLayoutTable)(0,col) << CreatePointsTable(_T("Basic Section"),m_pDoc->GetPrimaryPoints()) << rptNewLine;
+   (*pLayoutTable)(0,col) << Bold(_T("Basic Section Properties")) << rptNewLine;
+   WriteSectionProperties((*pLayoutTable)(0,col),primaryProps);
+   col++;
+
+   for ( IndexType pieceIdx = 0; pieceIdx < nPieces; pieceIdx++, col++ )
    {
-      Float64 x = iter->first;
-      Float64 y = iter->second;
-
-      (*pPrimaryPointsTable)(row,0) << length.SetValue(x);
-      (*pPrimaryPointsTable)(row,1) << length.SetValue(y);
+      CString strTitle;
+      strTitle.Format(_T("Composite Piece %d"),(int)(pieceIdx+1));
+      CString strProperties;
+      strProperties.Format(_T("Composite Piece %d Properties"),(int)(pieceIdx+1));
+      (*pLayoutTable)(0,col) << CreatePointsTable(strTitle,m_pDoc->GetSecondaryPoints(pieceIdx)) << rptNewLine;
+      (*pLayoutTable)(0,col) << Bold(strProperties) << rptNewLine;
+      (*pLayoutTable)(0,col) << _T("Modular Ratio, n = ") << m_pDoc->GetModularRatio(pieceIdx) << rptNewLine;
+      WriteSectionProperties((*pLayoutTable)(0,col),m_pDoc->GetSecondaryProperties(pieceIdx));
    }
 
-   row = pSecondaryPointsTable->GetNumberOfHeaderRows();
-   const std::vector<std::pair<Float64,Float64>>& secondaryPoints(m_pDoc->GetSecondaryPoints());
-   iter = secondaryPoints.begin();
-   end  = secondaryPoints.end();
-   for ( ; iter != end; iter++, row++ )
-   {
-      Float64 x = iter->first;
-      Float64 y = iter->second;
+   const POLYGONPROPERTIES& compositeProps(m_pDoc->GetCompositeProperties());
+   (*pLayoutTable)(0,col) << Bold(_T("Composite Section Properties")) << rptNewLine;
+   WriteSectionProperties((*pLayoutTable)(0,col),compositeProps);
 
-      (*pSecondaryPointsTable)(row,0) << length.SetValue(x);
-      (*pSecondaryPointsTable)(row,1) << length.SetValue(y);
-   }
+   //
+   // Equal transformed area axis and cracked section properties
+   //
+   pPara = new rptParagraph;
+   *pChapter << pPara;
+
+   pLayoutTable = rptStyleManager::CreateLayoutTable(3);
+   (*pPara) << pLayoutTable;
+
+   WriteEqualAreaProperties((*pLayoutTable)(0,0));
+   WriteCrackedProperties((*pLayoutTable)(0,1),true);
+   WriteCrackedProperties((*pLayoutTable)(0,2),false);
 
-   // Properties
+#if defined _DEBUG
+   // the native polygon kernel must match the WBFL shapes
    CComPtr<IPolyShape> primaryShape(m_pDoc->GetPrimaryShape());
    CComQIPtr<IShape> shape(primaryShape);
    CComPtr<IShapeProperties> shapeProps;
    shape->get_ShapeProperties(&shapeProps);
-   (*pLayoutTable)(0,2) << Bold(_T("Basic Section Properties")) << rptNewLine;
-   WriteSectionProperties((*pLayoutTable)(0,2),shapeProps);
+   AssertSectionProperties(primaryProps,shapeProps);
 
    CComPtr<ICompositeSection> compSection(m_pDoc->GetCompositeSection());
    CComQIPtr<ISection> section(compSection);
@@ -133,10 +127,8 @@ rptChapter* CGenCompChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16
    section->get_ElasticProperties(&elasticProperties);
    CComPtr<IShapeProperties> compositeProperties;
    elasticProperties->TransformProperties(1.0,&compositeProperties);
-
-   (*pLayoutTable)(0,3) << Bold(_T("Composite Section Properties")) << rptNewLine;
-   (*pLayoutTable)(0,3) << _T("Modular Ratio, n = ") << m_pDoc->GetModularRatio() << rptNewLine;
-   WriteSectionProperties((*pLayoutTable)(0,3),compositeProperties);
+   AssertSectionProperties(compositeProps,compositeProperties);
+#endif
 
    
    pPara = new rptParagraph;
@@ -148,7 +140,33 @@ rptChapter* CGenCompChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16
    return pChapter;
 }
 
-void CGenCompChapterBuilder::WriteSectionProperties(rptParagraph& para,IShapeProperties* pShapeProp) const
+rptRcTable* CGenCompChapterBuilder::CreatePointsTable(LPCTSTR lpszTitle,const std::vector<std::pair<Float64,Float64>>& points) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   INIT_UV_PROTOTYPE( rptLengthUnitValue,  length, pDispUnits->ComponentDim, false);
+
+   rptRcTable* pTable = rptStyleManager::CreateDefaultTable(2,lpszTitle);
+   (*pTable)(0,0) << COLHDR(_T("X"),rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,1) << COLHDR(_T("Y"),rptLengthUnitTag, pDispUnits->ComponentDim);
+
+   RowIndexType row = pTable->GetNumberOfHeaderRows();
+   std::vector<std::pair<Float64,Float64>>::const_iterator iter(points.begin());
+   std::vector<std::pair<Float64,Float64>>::const_iterator end(points.end());
+   for ( ; iter != end; iter++, row++ )
+   {
+      Float64 x = iter->first;
+      Float64 y = iter->second;
+
+      (*pTable)(row,0) << length.SetValue(x);
+      (*pTable)(row,1) << length.SetValue(y);
+   }
+
+   return pTable;
+}
+
+void CGenCompChapterBuilder::WriteSectionProperties(rptParagraph& para,const POLYGONPROPERTIES& props) const
 {
    CEAFApp* pApp = EAFGetApp();
    const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
@@ -157,6 +175,52 @@ void CGenCompChapterBuilder::WriteSectionProperties(rptParagraph& para,IShapePro
    INIT_UV_PROTOTYPE( rptLength2UnitValue,  area, pDispUnits->Area, true);
    INIT_UV_PROTOTYPE( rptLength4UnitValue,  momentOfInertia, pDispUnits->MomentOfInertia, true);
 
+   para << _T("Area = ") << area.SetValue(props.Area) << rptNewLine;
+   para << _T("Xl = ") << length.SetValue(props.GetXleft()) << rptNewLine;
+   para << _T("Xr = ") << length.SetValue(props.GetXright()) << rptNewLine;
+   para << _T("Yt = ") << length.SetValue(props.GetYtop()) << rptNewLine;
+   para << _T("Yb = ") << length.SetValue(props.GetYbottom()) << rptNewLine;
+   para << _T("Ixx = ") << momentOfInertia.SetValue(props.Ixx) << rptNewLine;
+   para << _T("Iyy = ") << momentOfInertia.SetValue(props.Iyy) << rptNewLine;
+   para << _T("Ixy = ") << momentOfInertia.SetValue(props.Ixy) << rptNewLine;
+}
+
+void CGenCompChapterBuilder::WriteEqualAreaProperties(rptParagraph& para) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   INIT_UV_PROTOTYPE( rptLengthUnitValue,  length, pDispUnits->ComponentDim, true);
+   INIT_UV_PROTOTYPE( rptLength3UnitValue,  sectionModulus, pDispUnits->SectModulus, true);
+
+   Float64 Yea, Q;
+   m_pDoc->GetEqualAreaProperties(&Yea,&Q);
+
+   para << Bold(_T("Equal Transformed Area Axis")) << rptNewLine;
+   para << _T("Yea = ") << length.SetValue(Yea) << rptNewLine;
+   para << _T("Yb = ") << length.SetValue(Yea - m_pDoc->GetCompositeProperties().Ymin) << rptNewLine;
+   para << _T("Qea = ") << sectionModulus.SetValue(Q) << rptNewLine;
+}
+
+void CGenCompChapterBuilder::WriteCrackedProperties(rptParagraph& para,bool bTopInCompression) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   INIT_UV_PROTOTYPE( rptLengthUnitValue,  length, pDispUnits->ComponentDim, true);
+
+   Float64 Yna;
+   POLYGONPROPERTIES props;
+   m_pDoc->GetCrackedProperties(bTopInCompression,&Yna,&props);
+
+   para << Bold(bTopInCompression ? _T("Cracked Section Properties, Top in Compression") : _T("Cracked Section Properties, Bottom in Compression")) << rptNewLine;
+   para << _T("Yna = ") << length.SetValue(Yna) << rptNewLine;
+   WriteSectionProperties(para,props);
+}
+
+#if defined _DEBUG
+void CGenCompChapterBuilder::AssertSectionProperties(const POLYGONPROPERTIES& props,IShapeProperties* pShapeProp) const
+{
    Float64 Area,Ixx,Iyy,Ixy,yt,yb,xl,xr;
    pShapeProp->get_Area(&Area);
    pShapeProp->get_Ixx(&Ixx);
@@ -167,15 +231,16 @@ void CGenCompChapterBuilder::WriteSectionProperties(rptParagraph& para,IShapePro
    pShapeProp->get_Xleft(&xl);
    pShapeProp->get_Xright(&xr);
 
-   para << _T("Area = ") << area.SetValue(Area) << rptNewLine;
-   para << _T("Xl = ") << length.SetValue(xl) << rptNewLine;
-   para << _T("Xr = ") << length.SetValue(xr) << rptNewLine;
-   para << _T("Yt = ") << length.SetValue(yt) << rptNewLine;
-   para << _T("Yb = ") << length.SetValue(yb) << rptNewLine;
-   para << _T("Ixx = ") << momentOfInertia.SetValue(Ixx) << rptNewLine;
-   para << _T("Iyy = ") << momentOfInertia.SetValue(Iyy) << rptNewLine;
-   para << _T("Ixy = ") << momentOfInertia.SetValue(Ixy) << rptNewLine;
+   ATLASSERT(IsEqual(props.Area,Area));
+   ATLASSERT(IsEqual(props.Ixx,Ixx));
+   ATLASSERT(IsEqual(props.Iyy,Iyy));
+   ATLASSERT(IsEqual(props.Ixy,Ixy));
+   ATLASSERT(IsEqual(props.GetYbottom(),yb));
+   ATLASSERT(IsEqual(props.GetYtop(),yt));
+   ATLASSERT(IsEqual(props.GetXleft(),xl));
+   ATLASSERT(IsEqual(props.GetXright(),xr));
 }
+#endif
 
 CChapterBuilder* CGenCompChapterBuilder::Clone() const
 {
@@ -231,37 +296,27 @@ rptRcImage* CGenCompChapterBuilder::CreateImage() const
    graph.SetYAxisNumberOfMinorTics(0);
    graph.SetYAxisNumberOfMajorTics(11);
 
-   IndexType primarySeries = graph.CreateDataSeries(_T(""),PS_SOLID,1,BLUE);
-   IndexType secondarySeries = graph.CreateDataSeries(_T(""),PS_SOLID,1,BLUE);
-
-   const std::vector<std::pair<Float64,Float64>>& primaryPoints(m_pDoc->GetPrimaryPoints());
-   std::vector<std::pair<Float64,Float64>>::const_iterator iter(primaryPoints.begin());
-   std::vector<std::pair<Float64,Float64>>::const_iterator end(primaryPoints.end());
-   for (; iter != end; iter++)
-   {
-      gpPoint2d point(::ConvertFromSysUnits(iter->first,pDispUnits->ComponentDim.UnitOfMeasure),::ConvertFromSysUnits(iter->second,pDispUnits->ComponentDim.UnitOfMeasure));
-      graph.AddPoint(primarySeries,point);
-   }
-
-   if ( 0 < primaryPoints.size() )
-   {
-      gpPoint2d point(::ConvertFromSysUnits(primaryPoints.front().first,pDispUnits->ComponentDim.UnitOfMeasure),::ConvertFromSysUnits(primaryPoints.front().second,pDispUnits->ComponentDim.UnitOfMeasure));
-      graph.AddPoint(primarySeries,point);
-   }
-
-   const std::vector<std::pair<Float64,Float64>>& secondaryPoints(m_pDoc->GetSecondaryPoints());
-   iter = secondaryPoints.begin();
-   end = secondaryPoints.end();
-   for (; iter != end; iter++)
-   {
-      gpPoint2d point(::ConvertFromSysUnits(iter->first,pDispUnits->ComponentDim.UnitOfMeasure),::ConvertFromSysUnits(iter->second,pDispUnits->ComponentDim.UnitOfMeasure));
-      graph.AddPoint(secondarySeries,point);
-   }
-
-   if ( 0 < secondaryPoints.size() )
+   IndexType nPieces = m_pDoc->GetSecondaryPieceCount();
+   for ( IndexType shapeIdx = 0; shapeIdx <= nPieces; shapeIdx++ )
    {
-      gpPoint2d point(::ConvertFromSysUnits(secondaryPoints.front().first,pDispUnits->ComponentDim.UnitOfMeasure),::ConvertFromSysUnits(secondaryPoints.front().second,pDispUnits->ComponentDim.UnitOfMeasure));
-      graph.AddPoint(secondarySeries,point);
+      const std::vector<std::pair<Float64,Float64>>& points(shapeIdx == 0 ? m_pDoc->GetPrimaryPoints() : m_pDoc->GetSecondaryPoints(shapeIdx-1));
+      if ( points.size() == 0 )
+      {
+         continue;
+      }
+
+      IndexType series = graph.CreateDataSeries(_T(""),PS_SOLID,1,BLUE);
+      std::vector<std::pair<Float64,Float64>>::const_iterator iter(points.begin());
+      std::vector<std::pair<Float64,Float64>>::const_iterator end(points.end());
+      for (; iter != end; iter++)
+      {
+         gpPoint2d point(::ConvertFromSysUnits(iter->first,pDispUnits->ComponentDim.UnitOfMeasure),::ConvertFromSysUnits(iter->second,pDispUnits->ComponentDim.UnitOfMeasure));
+         graph.AddPoint(series,point);
+      }
+
+      // close the shape
+      gpPoint2d point(::ConvertFromSysUnits(points.front().first,pDispUnits->ComponentDim.UnitOfMeasure),::ConvertFromSysUnits(points.front().second,pDispUnits->ComponentDim.UnitOfMeasure));
+      graph.AddPoint(series,point);
    }
 
    // Updates the graph metrics based on "nice" axis ranges
@@ -38,9 +38,16 @@ public:
    virtual CChapterBuilder* Clone() const override;
 
 private:
-   void WriteSectionProperties(rptParagraph& para,IShapeProperties* pShapeProp) const;
+   rptRcTable* CreatePointsTable(LPCTSTR lpszTitle,const std::vector<std::pair<Float64,Float64>>& points) const;
+   void WriteSectionProperties(rptParagraph& para,const POLYGONPROPERTIES& props) const;
+   void WriteEqualAreaProperties(rptParagraph& para) const;
+   void WriteCrackedProperties(rptParagraph& para,bool bTopInCompression) const;
    rptRcImage* CreateImage() const;
 
+#if defined _DEBUG
+   void AssertSectionProperties(const POLYGONPROPERTIES& props,IShapeProperties* pShapeProp) const;
+#endif
+
    // This is a list of temporary files that were created on the fly
    // Delete them in the destructor
    mutable std::vector<std::_tstring> m_TemporaryFiles;
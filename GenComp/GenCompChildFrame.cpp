@@ -54,6 +54,13 @@ BEGIN_MESSAGE_MAP(CGenCompChildFrame, CEAFChildFrame)
    ON_BN_CLICKED(IDC_ADD_SECONDARY,OnAddSecondary)
    ON_BN_CLICKED(IDC_REMOVE_SECONDARY,OnRemoveSecondary)
    ON_UPDATE_COMMAND_UI(IDC_REMOVE_SECONDARY,OnUpdateRemoveSecondary)
+   ON_CBN_SELCHANGE(IDC_PIECE,OnPieceChanged)
+   ON_BN_CLICKED(IDC_ADD_PIECE,OnAddPiece)
+   ON_BN_CLICKED(IDC_REMOVE_PIECE,OnRemovePiece)
+   ON_UPDATE_COMMAND_UI(IDC_REMOVE_PIECE,OnUpdateSecondaryPiece)
+   ON_UPDATE_COMMAND_UI(IDC_ADD_SECONDARY,OnUpdateSecondaryPiece)
+   ON_UPDATE_COMMAND_UI(IDC_N,OnUpdateSecondaryPiece)
+   ON_UPDATE_COMMAND_UI(IDC_SECONDARY_SHAPE_GRID,OnUpdateSecondaryPiece)
 	ON_MESSAGE(WM_HELP, OnCommandHelp)
 END_MESSAGE_MAP()
 
@@ -171,6 +178,32 @@ void CGenCompChildFrame::OnUpdateRemoveSecondary(CCmdUI* pCmdUI)
    pCmdUI->Enable(m_DlgBar.AreSecondaryPointsSelected() ? TRUE : FALSE);
 }
 
+void CGenCompChildFrame::OnPieceChanged()
+{
+   m_DlgBar.OnPieceChanged();
+}
+
+void CGenCompChildFrame::OnAddPiece()
+{
+   m_DlgBar.AddPiece();
+
+   CGenCompDoc* pDoc = (CGenCompDoc*)EAFGetDocument();
+   pDoc->SetModifiedFlag();
+}
+
+void CGenCompChildFrame::OnRemovePiece()
+{
+   m_DlgBar.RemovePiece();
+
+   CGenCompDoc* pDoc = (CGenCompDoc*)EAFGetDocument();
+   pDoc->SetModifiedFlag();
+}
+
+void CGenCompChildFrame::OnUpdateSecondaryPiece(CCmdUI* pCmdUI)
+{
+   pCmdUI->Enable(m_DlgBar.IsPieceSelected());
+}
+
 void CGenCompChildFrame::SetUnitsMode(eafTypes::UnitMode um)
 {
    CEAFApp* pApp = EAFGetApp();
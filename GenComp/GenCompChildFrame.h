@@ -51,6 +51,10 @@ protected:
    afx_msg void OnAddSecondary();
    afx_msg void OnRemoveSecondary();
    afx_msg void OnUpdateRemoveSecondary(CCmdUI* pCmdUI);
+   afx_msg void OnPieceChanged();
+   afx_msg void OnAddPiece();
+   afx_msg void OnRemovePiece();
+   afx_msg void OnUpdateSecondaryPiece(CCmdUI* pCmdUI);
    afx_msg LRESULT OnCommandHelp(WPARAM, LPARAM lParam);
 
    DECLARE_MESSAGE_MAP()
@@ -40,6 +40,8 @@ static char THIS_FILE[] = __FILE__;
 
 CGenCompDimensionGrid::CGenCompDimensionGrid()
 {
+   m_bPrimaryPoints = true;
+   m_PieceIdx = INVALID_INDEX;
 //   RegisterClass();
 }
 
@@ -72,10 +74,10 @@ void CGenCompDimensionGrid::DoDataExchange(CDataExchange* pDX)
          pDoc->ClearPrimaryPoints();
          pDoc->AddPrimaryPoints(points);
       }
-      else
+      else if ( m_PieceIdx != INVALID_INDEX )
       {
-         pDoc->ClearSecondaryPoints();
-         pDoc->AddSecondaryPoints(points);
+         pDoc->ClearSecondaryPoints(m_PieceIdx);
+         pDoc->AddSecondaryPoints(m_PieceIdx,points);
       }
    }
    else
@@ -83,7 +85,10 @@ void CGenCompDimensionGrid::DoDataExchange(CDataExchange* pDX)
       if ( 0 < GetRowCount() )
          RemoveRows(1,GetRowCount());
 
-      const std::vector<std::pair<Float64,Float64>>& points(m_bPrimaryPoints ? pDoc->GetPrimaryPoints() : pDoc->GetSecondaryPoints());
+      if ( !m_bPrimaryPoints && m_PieceIdx == INVALID_INDEX )
+         return;
+
+      const std::vector<std::pair<Float64,Float64>>& points(m_bPrimaryPoints ? pDoc->GetPrimaryPoints() : pDoc->GetSecondaryPoints(m_PieceIdx));
       std::vector<std::pair<Float64,Float64>>::const_iterator iter(points.begin());
       std::vector<std::pair<Float64,Float64>>::const_iterator end(points.end());
       for ( ; iter != end; iter++ )
@@ -138,6 +143,12 @@ void CGenCompDimensionGrid::CustomInit(bool bPrimaryPoints)
 //   EnableIntelliMouse();
 }
 
+void CGenCompDimensionGrid::SetPieceIndex(IndexType pieceIdx)
+{
+   ATLASSERT(!m_bPrimaryPoints);
+   m_PieceIdx = pieceIdx;
+}
+
 void CGenCompDimensionGrid::AddPoint()
 {
    InsertRow(0.0,0.0);
@@ -73,10 +73,12 @@ protected:
    void UpdateColumnHeaders();
 
    bool m_bPrimaryPoints;
+   IndexType m_PieceIdx; // secondary piece displayed in the grid
 
 public:
    // custom stuff for grid
    void CustomInit(bool bPrimaryPoints);
+   void SetPieceIndex(IndexType pieceIdx);
    
    void AddPoint();
    BOOL ArePointsSelected();
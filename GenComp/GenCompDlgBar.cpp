@@ -44,6 +44,7 @@ CGenCompDialogBar::CGenCompDialogBar()
 {
    m_pPrimaryGrid = nullptr;
    m_pSecondaryGrid = nullptr;
+   m_PieceIdx = INVALID_INDEX;
 }
 
 CGenCompDialogBar::~CGenCompDialogBar()
@@ -73,11 +74,18 @@ void CGenCompDialogBar::DoDataExchange(CDataExchange* pDX)
    DDX_Radio(pDX,IDC_US,i);
 
    CGenCompDoc* pDoc = (CGenCompDoc*)EAFGetDocument();
-   Float64 modularRatio = pDoc->GetModularRatio();
+   if ( m_PieceIdx != INVALID_INDEX )
+   {
+      Float64 modularRatio = pDoc->GetModularRatio(m_PieceIdx);
 
-   DDX_Text(pDX,IDC_N,modularRatio);
+      DDX_Text(pDX,IDC_N,modularRatio);
 
-   pDoc->SetModularRatio(modularRatio);
+      pDoc->SetModularRatio(m_PieceIdx,modularRatio);
+   }
+   else if ( !pDX->m_bSaveAndValidate )
+   {
+      GetDlgItem(IDC_N)->SetWindowText(_T(""));
+   }
 
    m_pPrimaryGrid->DoDataExchange(pDX);
    m_pSecondaryGrid->DoDataExchange(pDX);
@@ -101,6 +109,80 @@ void CGenCompDialogBar::InitGrids()
 
 	m_pSecondaryGrid->SubclassDlgItem(IDC_SECONDARY_SHAPE_GRID, this);
    m_pSecondaryGrid->CustomInit(false);
+
+   CGenCompDoc* pDoc = (CGenCompDoc*)EAFGetDocument();
+   m_PieceIdx = (0 < pDoc->GetSecondaryPieceCount() ? 0 : INVALID_INDEX);
+   m_pSecondaryGrid->SetPieceIndex(m_PieceIdx);
+   FillPieceList();
+}
+
+void CGenCompDialogBar::SelectPiece(IndexType pieceIdx)
+{
+   m_PieceIdx = pieceIdx;
+   m_pSecondaryGrid->SetPieceIndex(m_PieceIdx);
+   FillPieceList();
+   UpdateData(FALSE);
+}
+
+void CGenCompDialogBar::FillPieceList()
+{
+   CComboBox* pcbPieces = (CComboBox*)GetDlgItem(IDC_PIECE);
+   pcbPieces->ResetContent();
+
+   CGenCompDoc* pDoc = (CGenCompDoc*)EAFGetDocument();
+   IndexType nPieces = pDoc->GetSecondaryPieceCount();
+   for ( IndexType pieceIdx = 0; pieceIdx < nPieces; pieceIdx++ )
+   {
+      CString strPiece;
+      strPiece.Format(_T("%d"),(int)(pieceIdx+1));
+      pcbPieces->AddString(strPiece);
+   }
+
+   pcbPieces->SetCurSel(m_PieceIdx == INVALID_INDEX ? -1 : (int)m_PieceIdx);
+}
+
+void CGenCompDialogBar::AddPiece()
+{
+   UpdateData(TRUE); // save the piece that is being edited
+
+   CGenCompDoc* pDoc = (CGenCompDoc*)EAFGetDocument();
+   IndexType pieceIdx = pDoc->AddSecondaryPiece(1.0);
+   SelectPiece(pieceIdx);
+
+   pDoc->UpdateAllViews(nullptr,0,nullptr);
+}
+
+void CGenCompDialogBar::RemovePiece()
+{
+   if ( m_PieceIdx == INVALID_INDEX )
+   {
+      return;
+   }
+
+   UpdateData(TRUE); // save edits to the other shapes
+
+   CGenCompDoc* pDoc = (CGenCompDoc*)EAFGetDocument();
+   pDoc->RemoveSecondaryPiece(m_PieceIdx);
+
+   IndexType nPieces = pDoc->GetSecondaryPieceCount();
+   SelectPiece(nPieces == 0 ? INVALID_INDEX : Min(m_PieceIdx,nPieces-1));
+
+   pDoc->UpdateAllViews(nullptr,0,nullptr);
+}
+
+void CGenCompDialogBar::OnPieceChanged()
+{
+   // save the piece that was being edited before switching to the selected piece
+   UpdateData(TRUE);
+
+   CComboBox* pcbPieces = (CComboBox*)GetDlgItem(IDC_PIECE);
+   int curSel = pcbPieces->GetCurSel();
+   SelectPiece(curSel == CB_ERR ? INVALID_INDEX : (IndexType)curSel);
+}
+
+BOOL CGenCompDialogBar::IsPieceSelected()
+{
+   return m_PieceIdx == INVALID_INDEX ? FALSE : TRUE;
 }
 
 void CGenCompDialogBar::AddPrimaryPoint()
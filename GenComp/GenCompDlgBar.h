@@ -44,9 +44,12 @@ public:
    void RemoveSelectedSecondaryPoints();
    BOOL AreSecondaryPointsSelected();
 
-   void OnUnitsModeChanged();
+   void AddPiece();
+   void RemovePiece();
+   void OnPieceChanged();
+   BOOL IsPieceSelected();
 
-   Float64 m_ModularRatio;
+   void OnUnitsModeChanged();
 
 protected:
 	DECLARE_MESSAGE_MAP()
@@ -57,7 +60,11 @@ protected:
 
    virtual void DoDataExchange(CDataExchange* pDX) override;
    void InitGrids();
+   void SelectPiece(IndexType pieceIdx);
+   void FillPieceList();
 
    CGenCompDimensionGrid* m_pPrimaryGrid;
    CGenCompDimensionGrid* m_pSecondaryGrid;
+
+   IndexType m_PieceIdx; // secondary piece being edited
 };
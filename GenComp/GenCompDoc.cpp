@@ -61,6 +61,7 @@ CGenCompDoc::CGenCompDoc()
                             CComBSTR(unitSysUnitsMgr::GetAngleUnit().UnitTag().c_str()));  
    m_DocUnitServer->QueryInterface(&m_DocConvert);
 
+   m_bGeometryValid = false;
 
    std::unique_ptr<CReportBuilder> pRptBuilder(std::make_unique<CReportBuilder>(_T("GenComp")));
 
@@ -120,12 +121,18 @@ BOOL CGenCompDoc::OnNewDocument()
    if ( m_GenCompXML.get() == nullptr )
       return FALSE;
 
+   InvalidateGeometry();
+
+   // start with one composite piece
+   AddSecondaryPiece(1.0);
+
    return TRUE;
 }
 
 BOOL CGenCompDoc::OpenTheDocument(LPCTSTR lpszPathName)
 {
    m_GenCompXML = CreateGenCompModel(lpszPathName,m_DocUnitServer);
+   InvalidateGeometry();
    return m_GenCompXML.get() == nullptr ? FALSE : TRUE;
 }
 
@@ -172,27 +179,20 @@ void CGenCompDoc::OnOldFormat(LPCTSTR lpszPathName)
 void CGenCompDoc::Clear()
 {
    ClearPrimaryPoints();
-   ClearSecondaryPoints();
-}
-
-void CGenCompDoc::SetModularRatio(Float64 n)
-{
-   m_GenCompXML->ModularRatio(n);
-}
-
-Float64 CGenCompDoc::GetModularRatio() const
-{
-   return m_GenCompXML->ModularRatio();
+   m_GenCompXML->SecondaryPiece().clear();
+   InvalidateGeometry();
 }
 
 void CGenCompDoc::ClearPrimaryPoints()
 {
    m_GenCompXML->PrimaryShape().Point().clear();
+   InvalidateGeometry();
 }
 
 void CGenCompDoc::AddPrimaryPoint(Float64 x,Float64 y)
 {
    m_GenCompXML->PrimaryShape().Point().push_back(PointType(x,y));
+   InvalidateGeometry();
 }
 
 void CGenCompDoc::AddPrimaryPoints(const std::vector<std::pair<Float64,Float64>>& newPoints)
@@ -204,89 +204,203 @@ void CGenCompDoc::AddPrimaryPoints(const std::vector<std::pair<Float64,Float64>>
    {
       points.push_back(PointType(iter->first,iter->second));
    }
+   InvalidateGeometry();
 }
 
 const std::vector<std::pair<Float64,Float64>>& CGenCompDoc::GetPrimaryPoints()
 {
-   m_PrimaryPoints.clear();
-   ShapeType::Point_sequence& points(m_GenCompXML->PrimaryShape().Point());
-   for ( const auto& point : points)
-   {
-      m_PrimaryPoints.emplace_back(point.X(),point.Y());
-   }
-   return m_PrimaryPoints;
+   UpdateGeometry();
+   return m_Points.front();
+}
+
+IndexType CGenCompDoc::GetSecondaryPieceCount() const
+{
+   return m_GenCompXML->SecondaryPiece().size();
+}
+
+IndexType CGenCompDoc::AddSecondaryPiece(Float64 n)
+{
+   GenComp::SecondaryPiece_sequence& pieces(m_GenCompXML->SecondaryPiece());
+   pieces.push_back(PieceType(n,ShapeType()));
+   InvalidateGeometry();
+   return pieces.size()-1;
+}
+
+void CGenCompDoc::RemoveSecondaryPiece(IndexType pieceIdx)
+{
+   GenComp::SecondaryPiece_sequence& pieces(m_GenCompXML->SecondaryPiece());
+   ATLASSERT(pieceIdx < pieces.size());
+   pieces.erase(pieces.begin() + pieceIdx);
+   InvalidateGeometry();
+}
+
+void CGenCompDoc::SetModularRatio(IndexType pieceIdx,Float64 n)
+{
+   m_GenCompXML->SecondaryPiece().at(pieceIdx).ModularRatio(n);
+   InvalidateGeometry();
+}
+
+Float64 CGenCompDoc::GetModularRatio(IndexType pieceIdx) const
+{
+   return m_GenCompXML->SecondaryPiece().at(pieceIdx).ModularRatio();
 }
 
-void CGenCompDoc::ClearSecondaryPoints()
+void CGenCompDoc::ClearSecondaryPoints(IndexType pieceIdx)
 {
-   m_GenCompXML->SecondaryShape().Point().clear();
+   m_GenCompXML->SecondaryPiece().at(pieceIdx).Shape().Point().clear();
+   InvalidateGeometry();
 }
 
-void CGenCompDoc::AddSecondaryPoint(Float64 x,Float64 y)
+void CGenCompDoc::AddSecondaryPoint(IndexType pieceIdx,Float64 x,Float64 y)
 {
-   m_GenCompXML->SecondaryShape().Point().push_back(PointType(x,y));
+   m_GenCompXML->SecondaryPiece().at(pieceIdx).Shape().Point().push_back(PointType(x,y));
+   InvalidateGeometry();
 }
 
-void CGenCompDoc::AddSecondaryPoints(const std::vector<std::pair<Float64,Float64>>& newPoints)
+void CGenCompDoc::AddSecondaryPoints(IndexType pieceIdx,const std::vector<std::pair<Float64,Float64>>& newPoints)
 {
-   ShapeType::Point_sequence& points(m_GenCompXML->SecondaryShape().Point());
+   ShapeType::Point_sequence& points(m_GenCompXML->SecondaryPiece().at(pieceIdx).Shape().Point());
    std::vector<std::pair<Float64,Float64>>::const_iterator iter(newPoints.begin());
    std::vector<std::pair<Float64,Float64>>::const_iterator end(newPoints.end());
    for ( ; iter != end; iter++ )
    {
       points.push_back(PointType(iter->first,iter->second));
    }
+   InvalidateGeometry();
 }
 
-const std::vector<std::pair<Float64,Float64>>& CGenCompDoc::GetSecondaryPoints()
+const std::vector<std::pair<Float64,Float64>>& CGenCompDoc::GetSecondaryPoints(IndexType pieceIdx)
 {
-   m_SecondaryPoints.clear();
-   ShapeType::Point_sequence& points(m_GenCompXML->SecondaryShape().Point());
-   for ( const auto& point : points)
-   {
-      m_SecondaryPoints.emplace_back(point.X(),point.Y());
-   }
-   return m_SecondaryPoints;
+   UpdateGeometry();
+   return m_Points[pieceIdx+1];
+}
+
+const POLYGONPROPERTIES& CGenCompDoc::GetPrimaryProperties()
+{
+   UpdateGeometry();
+   return m_Properties.front();
+}
+
+const POLYGONPROPERTIES& CGenCompDoc::GetSecondaryProperties(IndexType pieceIdx)
+{
+   UpdateGeometry();
+   return m_Properties[pieceIdx+1];
+}
+
+const POLYGONPROPERTIES& CGenCompDoc::GetCompositeProperties()
+{
+   UpdateGeometry();
+   return m_CompositeProperties;
+}
+
+void CGenCompDoc::GetEqualAreaProperties(Float64* pYea,Float64* pQ)
+{
+   UpdateGeometry();
+   ComputeEqualAreaProperties(m_X.data(),m_Y.data(),m_Offsets.data(),m_N.data(),m_N.size(),pYea,pQ);
+}
+
+void CGenCompDoc::GetCrackedProperties(bool bTopInCompression,Float64* pYna,POLYGONPROPERTIES* pProps)
+{
+   UpdateGeometry();
+
+   std::vector<Float64> Nt(m_N);
+   Nt.front() = 0; // primary shape is ineffective in tension
+   ComputeCrackedProperties(m_X.data(),m_Y.data(),m_Offsets.data(),m_N.data(),Nt.data(),m_N.size(),nullptr,bTopInCompression,pYna,pProps);
 }
 
 CComPtr<IPolyShape> CGenCompDoc::GetPrimaryShape()
 {
-   CComPtr<IPolyShape> polyShape;
-   polyShape.CoCreateInstance(CLSID_PolyShape);
+   UpdateGeometry();
+   return CreatePolyShape(0);
+}
 
-   ShapeType::Point_sequence& points(m_GenCompXML->PrimaryShape().Point());
-   ShapeType::Point_sequence::iterator iter(points.begin());
-   ShapeType::Point_sequence::iterator end(points.end());
-   for ( ; iter != end; iter++ )
+CComPtr<ICompositeSection> CGenCompDoc::GetCompositeSection()
+{
+   UpdateGeometry();
+
+   CComPtr<ICompositeSection> section;
+   section.CoCreateInstance(CLSID_CompositeSection);
+
+   IndexType nShapes = m_N.size();
+   for ( IndexType shapeIdx = 0; shapeIdx < nShapes; shapeIdx++ )
    {
-      polyShape->AddPoint(iter->X(),iter->Y());
+      CComPtr<IPolyShape> polyShape(CreatePolyShape(shapeIdx));
+      CComQIPtr<IShape> shape(polyShape);
+      section->AddSection(shape,m_N[shapeIdx],1.0,VARIANT_FALSE,VARIANT_TRUE);
    }
 
-   return polyShape;
+   return section;
 }
 
-CComPtr<ICompositeSection> CGenCompDoc::GetCompositeSection()
+void CGenCompDoc::InvalidateGeometry()
 {
-   CComPtr<IPolyShape> primaryShape(GetPrimaryShape());
-   CComPtr<IPolyShape> secondaryShape;
-   secondaryShape.CoCreateInstance(CLSID_PolyShape);
+   m_bGeometryValid = false;
+}
 
-   ShapeType::Point_sequence& points(m_GenCompXML->SecondaryShape().Point());
-   ShapeType::Point_sequence::iterator iter(points.begin());
-   ShapeType::Point_sequence::iterator end(points.end());
-   for ( ; iter != end; iter++ )
+void CGenCompDoc::UpdateGeometry()
+{
+   if ( m_bGeometryValid )
    {
-      secondaryShape->AddPoint(iter->X(),iter->Y());
+      return;
    }
 
-   CComPtr<ICompositeSection> section;
-   section.CoCreateInstance(CLSID_CompositeSection);
+   m_Points.clear();
+   m_X.clear();
+   m_Y.clear();
+   m_Offsets.clear();
+   m_N.clear();
 
-   CComQIPtr<IShape> shape1(primaryShape);
-   section->AddSection(shape1,1.0,1.0,VARIANT_FALSE,VARIANT_TRUE);
+   IndexType nPoints = m_GenCompXML->PrimaryShape().Point().size();
+   for ( const auto& piece : m_GenCompXML->SecondaryPiece() )
+   {
+      nPoints += piece.Shape().Point().size();
+   }
+   m_X.reserve(nPoints);
+   m_Y.reserve(nPoints);
+
+   // the primary shape is the base material
+   AddShapeGeometry(m_GenCompXML->PrimaryShape(),1.0);
+   for ( const auto& piece : m_GenCompXML->SecondaryPiece() )
+   {
+      AddShapeGeometry(piece.Shape(),piece.ModularRatio());
+   }
+   m_Offsets.push_back(m_X.size());
 
-   CComQIPtr<IShape> shape2(secondaryShape);
-   section->AddSection(shape2,m_GenCompXML->ModularRatio(),1.0,VARIANT_FALSE,VARIANT_TRUE);
+   // transformed properties in a single pass over all of the points
+   IndexType nShapes = m_N.size();
+   m_Properties.resize(nShapes);
+   ComputeTransformedProperties(m_X.data(),m_Y.data(),m_Offsets.data(),m_N.data(),nShapes,&m_CompositeProperties,m_Properties.data());
 
-   return section;
+   m_bGeometryValid = true;
+}
+
+void CGenCompDoc::AddShapeGeometry(const ShapeType& shape,Float64 n)
+{
+   const ShapeType::Point_sequence& points(shape.Point());
+   m_Offsets.push_back(m_X.size());
+   m_N.push_back(n);
+
+   m_Points.emplace_back();
+   std::vector<std::pair<Float64,Float64>>& shapePoints(m_Points.back());
+   shapePoints.reserve(points.size());
+   for ( const auto& point : points )
+   {
+      shapePoints.emplace_back(point.X(),point.Y());
+      m_X.push_back(point.X());
+      m_Y.push_back(point.Y());
+   }
+}
+
+CComPtr<IPolyShape> CGenCompDoc::CreatePolyShape(IndexType shapeIdx)
+{
+   CComPtr<IPolyShape> polyShape;
+   polyShape.CoCreateInstance(CLSID_PolyShape);
+
+   IndexType end = m_Offsets[shapeIdx+1];
+   for ( IndexType i = m_Offsets[shapeIdx]; i < end; i++ )
+   {
+      polyShape->AddPoint(m_X[i],m_Y[i]);
+   }
+
+   return polyShape;
 }
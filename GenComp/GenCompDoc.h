@@ -26,6 +26,7 @@
 #include "..\BEToolboxDoc.h"
 #include <ReportManager\ReportManager.h>
 #include <GenComp.h>
+#include "..\BEToolboxPolygon.h"
 
 class CGenCompDoc : public CBEToolboxDoc
 {
@@ -39,18 +40,40 @@ public:
 
    void Clear();
 
-   void SetModularRatio(Float64 n);
-   Float64 GetModularRatio() const;
-
    void ClearPrimaryPoints();
    void AddPrimaryPoint(Float64 x,Float64 y);
    void AddPrimaryPoints(const std::vector<std::pair<Float64,Float64>>& points);
    const std::vector<std::pair<Float64,Float64>>& GetPrimaryPoints();
 
-   void ClearSecondaryPoints();
-   void AddSecondaryPoint(Float64 x,Float64 y);
-   void AddSecondaryPoints(const std::vector<std::pair<Float64,Float64>>& points);
-   const std::vector<std::pair<Float64,Float64>>& GetSecondaryPoints();
+   // Secondary pieces are transformed into the material of the primary shape
+   // by their modular ratio, n = Epiece/Eprimary
+   IndexType GetSecondaryPieceCount() const;
+   IndexType AddSecondaryPiece(Float64 n); // returns the index of the new piece
+   void RemoveSecondaryPiece(IndexType pieceIdx);
+
+   void SetModularRatio(IndexType pieceIdx,Float64 n);
+   Float64 GetModularRatio(IndexType pieceIdx) const;
+
+   void ClearSecondaryPoints(IndexType pieceIdx);
+   void AddSecondaryPoint(IndexType pieceIdx,Float64 x,Float64 y);
+   void AddSecondaryPoints(IndexType pieceIdx,const std::vector<std::pair<Float64,Float64>>& points);
+   const std::vector<std::pair<Float64,Float64>>& GetSecondaryPoints(IndexType pieceIdx);
+
+   // Section properties computed with the native polygon kernel
+   const POLYGONPROPERTIES& GetPrimaryProperties();
+   const POLYGONPROPERTIES& GetSecondaryProperties(IndexType pieceIdx);
+   const POLYGONPROPERTIES& GetCompositeProperties();
+
+   // Properties about the axis that divides the transformed area of the composite section in half.
+   // Yea is the elevation of the axis and Q is the first moment of the transformed area about it.
+   // The pieces don't have material strengths so these are not plastic properties, except for a
+   // section of one material
+   void GetEqualAreaProperties(Float64* pYea,Float64* pQ);
+
+   // Cracked properties of the composite section. The primary shape is ineffective in tension
+   // and the secondary pieces are fully effective (e.g. a concrete section with reinforcement
+   // modeled as secondary pieces). Yna is the elevation of the cracked neutral axis
+   void GetCrackedProperties(bool bTopInCompression,Float64* pYna,POLYGONPROPERTIES* pProps);
 
    CComPtr<IPolyShape> GetPrimaryShape();
    CComPtr<ICompositeSection> GetCompositeSection();
@@ -76,12 +99,26 @@ protected:
 
    virtual void OnOldFormat(LPCTSTR lpszPathName) override;
 
+   // Geometry is cached so the XML model is only read once after each edit.
+   // Mutators must call InvalidateGeometry.
+   void InvalidateGeometry();
+   void UpdateGeometry();
+   void AddShapeGeometry(const ShapeType& shape,Float64 n);
+   CComPtr<IPolyShape> CreatePolyShape(IndexType shapeIdx);
+
    std::unique_ptr<GenComp> m_GenCompXML;
    CComPtr<IUnitServer> m_DocUnitServer;
    CComPtr<IUnitConvert> m_DocConvert;
 
-   std::vector<std::pair<Float64,Float64>> m_PrimaryPoints;
-   std::vector<std::pair<Float64,Float64>> m_SecondaryPoints;
+   // Cached geometry. Shape 0 is the primary shape and shape i+1 is secondary piece i
+   bool m_bGeometryValid;
+   std::vector<std::vector<std::pair<Float64,Float64>>> m_Points; // points of each shape
+   std::vector<Float64> m_X; // points of all shapes, end to end, for the polygon kernel
+   std::vector<Float64> m_Y;
+   std::vector<IndexType> m_Offsets; // index of the first point of each shape in m_X/m_Y, followed by the total number of points
+   std::vector<Float64> m_N; // modular ratio of each shape
+   std::vector<POLYGONPROPERTIES> m_Properties; // untransformed properties of each shape
+   POLYGONPROPERTIES m_CompositeProperties;
 
    afx_msg void OnHelpFinder();
    DECLARE_MESSAGE_MAP()
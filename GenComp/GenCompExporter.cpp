@@ -45,6 +45,24 @@ static char THIS_FILE[] = __FILE__;
 #endif
 
 
+static void AddPoints(IPoint2dCollection* pPoints,ShapeType::Point_sequence& pointsXML)
+{
+   CollectionIndexType nPoints;
+   pPoints->get_Count(&nPoints);
+   for ( CollectionIndexType i = 0; i < nPoints; i++ )
+   {
+      CComPtr<IPoint2d> pnt;
+      pPoints->get_Item(i,&pnt);
+      Float64 x,y;
+      pnt->Location(&x,&y);
+
+      x = IsZero(x) ? 0 : x;
+      y = IsZero(y) ? 0 : y;
+
+      pointsXML.push_back(PointType(x,y));
+   }
+}
+
 HRESULT CGenCompExporter::FinalConstruct()
 {
    AFX_MANAGE_STATE(AfxGetStaticModuleState());
@@ -137,7 +155,7 @@ STDMETHODIMP CGenCompExporter::Export(IBroker* pBroker)
       pShapes->GetSegmentShape(intervalIdx, poi, false, pgsTypes::scGirder, &shape);
 
       CComPtr<IPoint2dCollection> primaryShapePoints;
-      CComPtr<IPoint2dCollection> secondaryShapePoints;
+      std::vector<CComPtr<IPoint2dCollection>> secondaryShapePoints; // deck and longitudinal joints, one piece each
       CComQIPtr<ICompositeShape> compShape(shape);
       if (compShape)
       {
@@ -156,7 +174,9 @@ STDMETHODIMP CGenCompExporter::Export(IBroker* pBroker)
             item.Release();
             compShape->get_Item(1, &item);
             item->get_Shape(&secondaryShape);
-            secondaryShape->get_PolyPoints(&secondaryShapePoints);
+            CComPtr<IPoint2dCollection> points;
+            secondaryShape->get_PolyPoints(&points);
+            secondaryShapePoints.push_back(points);
          }
       }
       else
@@ -168,42 +188,16 @@ STDMETHODIMP CGenCompExporter::Export(IBroker* pBroker)
       pShapes->GetJointShapes(intervalIdx, poi, false, pgsTypes::scGirder, &leftJointShape, &rightJointShape);
       if (leftJointShape)
       {
-         if (secondaryShapePoints == nullptr)
-         {
-            secondaryShapePoints.CoCreateInstance(CLSID_Point2dCollection);
-         }
-
          CComPtr<IPoint2dCollection> points;
          leftJointShape->get_PolyPoints(&points);
-
-         CComPtr<IEnumPoint2d> enumPoints;
-         points->get__Enum(&enumPoints);
-         CComPtr<IPoint2d> point;
-         while (enumPoints->Next(1, &point, nullptr) != S_FALSE)
-         {
-            secondaryShapePoints->Add(point);
-            point.Release();
-         }
+         secondaryShapePoints.push_back(points);
       }
 
       if (rightJointShape)
       {
-         if (secondaryShapePoints == nullptr)
-         {
-            secondaryShapePoints.CoCreateInstance(CLSID_Point2dCollection);
-         }
-
          CComPtr<IPoint2dCollection> points;
          rightJointShape->get_PolyPoints(&points);
-
-         CComPtr<IEnumPoint2d> enumPoints;
-         points->get__Enum(&enumPoints);
-         CComPtr<IPoint2d> point;
-         while (enumPoints->Next(1, &point, nullptr) != S_FALSE)
-         {
-            secondaryShapePoints->Add(point);
-            point.Release();
-         }
+         secondaryShapePoints.push_back(points);
       }
 
 
@@ -241,51 +235,23 @@ STDMETHODIMP CGenCompExporter::Export(IBroker* pBroker)
       }
 
       std::unique_ptr<GenComp> genCompXML( CreateGenCompModel() );
-      ShapeType& primaryShapeXML(genCompXML->PrimaryShape());
-      ShapeType::Point_sequence& primaryShapePointsXML(primaryShapeXML.Point());
-      ShapeType& secondaryShapeXML(genCompXML->SecondaryShape());
-      ShapeType::Point_sequence& secondaryShapePointsXML(secondaryShapeXML.Point());
 
       GET_IFACE2(pBroker,IEAFDisplayUnits,pDisplayUnits);
       genCompXML->Units(pDisplayUnits->GetUnitMode() == eafTypes::umSI ? UnitMode::SI : UnitMode::US);
 
       Float64 n = EcDeck/EcGdr;
       n = ::RoundOff(n,0.001);
-      genCompXML->ModularRatio(n);
 
-      CollectionIndexType nPoints;
       if ( primaryShapePoints )
       {
-         primaryShapePoints->get_Count(&nPoints);
-         for ( CollectionIndexType i = 0; i < nPoints; i++ )
-         {
-            CComPtr<IPoint2d> pnt;
-            primaryShapePoints->get_Item(i,&pnt);
-            Float64 x,y;
-            pnt->Location(&x,&y);
-
-            x = IsZero(x) ? 0 : x;
-            y = IsZero(y) ? 0 : y;
-
-            primaryShapePointsXML.push_back(PointType(x,y));
-         }
+         AddPoints(primaryShapePoints,genCompXML->PrimaryShape().Point());
       }
 
-      if ( secondaryShapePoints )
+      for ( const auto& points : secondaryShapePoints )
       {
-         secondaryShapePoints->get_Count(&nPoints);
-         for ( CollectionIndexType i = 0; i < nPoints; i++ )
-         {
-            CComPtr<IPoint2d> pnt;
-            secondaryShapePoints->get_Item(i,&pnt);
-            Float64 x,y;
-            pnt->Location(&x,&y);
-
-            x = IsZero(x) ? 0 : x;
-            y = IsZero(y) ? 0 : y;
-
-            secondaryShapePointsXML.push_back(PointType(x,y));
-         }
+         PieceType piece(n,ShapeType());
+         AddPoints(points,piece.Shape().Point());
+         genCompXML->SecondaryPiece().push_back(piece);
       }
 
       CString strPathName = fileDlg.GetPathName();
@@ -22,6 +22,7 @@
 
 #include "stdafx.h"
 #include "GirCompChapterBuilder.h"
+#include "..\BEToolboxPolygon.h"
 #include <Reporter\Reporter.h>
 
 #include <GraphicsLib\GraphicsLib.h>
@@ -32,6 +33,59 @@
 static char THIS_FILE[] = __FILE__;
 #endif
 
+static void AddRectangle(Float64 width,Float64 height,Float64 yBottom,Float64 n,Float64 nt,std::vector<Float64>& x,std::vector<Float64>& y,std::vector<IndexType>& offsets,std::vector<Float64>& N,std::vector<Float64>& Nt)
+{
+   if ( offsets.empty() )
+   {
+      offsets.push_back(0);
+   }
+
+   x.push_back(-width/2); y.push_back(yBottom);
+   x.push_back( width/2); y.push_back(yBottom);
+   x.push_back( width/2); y.push_back(yBottom + height);
+   x.push_back(-width/2); y.push_back(yBottom + height);
+
+   offsets.push_back(x.size());
+   N.push_back(n);
+   Nt.push_back(nt);
+}
+
+// Builds the geometry of a composite girder for the native polygon kernel. The bottom of the girder is at y = 0
+// and the section is transformed into slab material. The slab and haunch are ineffective in tension.
+// Built-up girders are modeled with plates. Rolled and general sections are known only by their properties
+// so they are returned in pGirder and the function returns false.
+static bool GetCompositeGeometry(const GIRCOMPDIMENSIONS& dimensions,Float64 N,std::vector<Float64>& x,std::vector<Float64>& y,std::vector<IndexType>& offsets,std::vector<Float64>& n,std::vector<Float64>& nt,POLYGONPROPERTIES* pGirder)
+{
+   InitPolygonProperties(pGirder);
+
+   Float64 Hg;
+   bool bPlates = (dimensions.Type == GIRCOMPDIMENSIONS::BuiltUp);
+   if ( bPlates )
+   {
+      AddRectangle(dimensions.wBotFlange,dimensions.tBotFlange,0.0,N,N,x,y,offsets,n,nt);
+      AddRectangle(dimensions.tWeb,dimensions.D,dimensions.tBotFlange,N,N,x,y,offsets,n,nt);
+      AddRectangle(dimensions.wTopFlange,dimensions.tTopFlange,dimensions.tBotFlange + dimensions.D,N,N,x,y,offsets,n,nt);
+      Hg = dimensions.tTopFlange + dimensions.D + dimensions.tBotFlange;
+   }
+   else
+   {
+      POLYGONPROPERTIES girder;
+      InitPolygonProperties(&girder);
+      girder.Area = dimensions.Area;
+      girder.Ixx  = dimensions.MomentOfInertia;
+      girder.Ybar = dimensions.D/2;
+      girder.Xmin = -dimensions.wTopFlange/2;
+      girder.Xmax =  dimensions.wTopFlange/2;
+      girder.Ymax = dimensions.D;
+      AddPolygonProperties(pGirder,girder,N);
+      Hg = dimensions.D;
+   }
+
+   AddRectangle(dimensions.wTopFlange,dimensions.G,Hg,1.0,0.0,x,y,offsets,n,nt);
+   AddRectangle(dimensions.wSlab,dimensions.tSlab,Hg + dimensions.G,1.0,0.0,x,y,offsets,n,nt);
+
+   return bPlates;
+}
 
 //////////////////////////////////
 CGirCompChapterBuilder::CGirCompChapterBuilder(CGirCompDoc* pDoc) :
@@ -282,6 +336,7 @@ void CGirCompChapterBuilder::ReportCompositeSectionProperties(rptChapter* pChapt
    if ( Hg < Yb )
    {
       *pPara << _T("Neutral Axis Lies in Slab") << rptNewLine;
+      ReportInelasticSectionProperties(pChapter,dimensions,N);
       return;
    }
 
@@ -318,4 +373,56 @@ void CGirCompChapterBuilder::ReportCompositeSectionProperties(rptChapter* pChapt
    {
       *pPara << _T("Q Slab & Top Flange") << _T(" = ") << sectionModulus.SetValue(Qt) << _T(" ");
    }
+
+   ReportInelasticSectionProperties(pChapter,dimensions,N);
+}
+
+void CGirCompChapterBuilder::ReportInelasticSectionProperties(rptChapter* pChapter,const GIRCOMPDIMENSIONS& dimensions,Float64 N) const
+{
+   rptParagraph* pPara = new rptParagraph;
+   *pChapter << pPara;
+
+   INIT_UV_PROTOTYPE( rptLengthUnitValue,  length,          m_Length,          true);
+   INIT_UV_PROTOTYPE( rptLength4UnitValue, momentOfInertia, m_MomentOfInertia, true);
+   INIT_UV_PROTOTYPE( rptLength3UnitValue, sectionModulus,  m_SectionModulus,  true);
+
+   std::vector<Float64> x, y, n, nt;
+   std::vector<IndexType> offsets;
+   POLYGONPROPERTIES girder;
+   bool bPlates = GetCompositeGeometry(dimensions,N,x,y,offsets,n,nt,&girder);
+   IndexType nPolygons = n.size();
+
+   // Cracked section with the slab in compression. The concrete below the neutral axis is ineffective.
+   Float64 Yna;
+   POLYGONPROPERTIES cracked;
+   ComputeCrackedProperties(x.data(),y.data(),offsets.data(),n.data(),nt.data(),nPolygons,&girder,true,&Yna,&cracked);
+
+#if defined _DEBUG
+   // when the neutral axis is below the haunch the cracked section is the elastic composite section
+   if ( Yna < y[offsets[nPolygons-2]] )
+   {
+      POLYGONPROPERTIES elastic = girder;
+      POLYGONPROPERTIES concrete;
+      ComputeTransformedProperties(x.data(),y.data(),offsets.data(),n.data(),nPolygons,&concrete);
+      AddPolygonProperties(&elastic,concrete,1.0);
+      ATLASSERT(IsEqual(elastic.Ybar,cracked.Ybar));
+      ATLASSERT(IsEqual(elastic.Ixx,cracked.Ixx));
+   }
+#endif
+
+   *pPara << _T("Cracked Composite Girder Properties N = ") << N << rptNewLine;
+   *pPara << Sub2(_T("I"),_T("cr")) << _T(" = ") << momentOfInertia.SetValue(cracked.Ixx) << _T(" ");
+   *pPara << Sub2(_T("Y"),_T("b")) << _T(" = ") << length.SetValue(cracked.GetYbottom()) << rptNewLine;
+
+   if ( bPlates )
+   {
+      // GirComp doesn't have material strengths so the plastic neutral axis can't be located.
+      // Report the axis that divides the transformed area in half instead.
+      Float64 Yea, Q;
+      ComputeEqualAreaProperties(x.data(),y.data(),offsets.data(),n.data(),nPolygons,&Yea,&Q);
+
+      *pPara << _T("Equal Transformed Area Axis N = ") << N << rptNewLine;
+      *pPara << Sub2(_T("Y"),_T("ea")) << _T(" = ") << length.SetValue(Yea) << _T(" ");
+      *pPara << Sub2(_T("Q"),_T("ea")) << _T(" = ") << sectionModulus.SetValue(Q) << rptNewLine;
+   }
 }
@@ -44,6 +44,7 @@ private:
    void ReportGeneralSectionProperties(rptChapter* pChapter,IndexType idx,const GIRCOMPDIMENSIONS& dimensions) const;
    void ReportBuiltUpSectionProperties(rptChapter* pChapter,IndexType idx,const GIRCOMPDIMENSIONS& dimensions) const;
    void ReportCompositeSectionProperties(rptChapter* pChapter,IndexType idx,const GIRCOMPDIMENSIONS& dimensions,int n) const;
+   void ReportInelasticSectionProperties(rptChapter* pChapter,const GIRCOMPDIMENSIONS& dimensions,Float64 N) const;
 
    mutable unitmgtIndirectMeasureDataT<unitLength>  m_Length;
    mutable unitmgtIndirectMeasureDataT<unitLength2> m_Area;
@@ -30,6 +30,8 @@
 #include "GirCompChapterBuilder.h"
 #include "GirCompChildFrame.h"
 #include "..\BEToolboxStatusBar.h"
+#include "..\BEToolboxBinaryDocument.h"
+#include "..\BEToolboxRecordBlock.h"
 
 #include <EAF\EAFUtilities.h>
 #include <EAF\EAFApp.h>
@@ -166,6 +168,45 @@ CString CGirCompDoc::GetDocumentationRootLocation()
    return pApp->GetDocumentationRootLocation();
 }
 
+// Dimensions that are saved as numbers. In the binary format, the problems are stored by column with one
+// array for each dimension. In the XML format, the problems are stored as packed records with a value for each dimension.
+static const struct
+{
+   LPCSTR lpszName;
+   Float64 GIRCOMPDIMENSIONS::*pDimension;
+} gs_Columns[] =
+{
+   { "Area",            &GIRCOMPDIMENSIONS::Area },
+   { "MomentOfInertia", &GIRCOMPDIMENSIONS::MomentOfInertia },
+   { "D",               &GIRCOMPDIMENSIONS::D },
+   { "tWeb",            &GIRCOMPDIMENSIONS::tWeb },
+   { "wTopFlange",      &GIRCOMPDIMENSIONS::wTopFlange },
+   { "tTopFlange",      &GIRCOMPDIMENSIONS::tTopFlange },
+   { "wBotFlange",      &GIRCOMPDIMENSIONS::wBotFlange },
+   { "tBotFlange",      &GIRCOMPDIMENSIONS::tBotFlange },
+   { "G",               &GIRCOMPDIMENSIONS::G },
+   { "tSlab",           &GIRCOMPDIMENSIONS::tSlab },
+   { "wSlab",           &GIRCOMPDIMENSIONS::wSlab },
+   { "N1",              &GIRCOMPDIMENSIONS::N1 },
+   { "N2",              &GIRCOMPDIMENSIONS::N2 },
+   { "N3",              &GIRCOMPDIMENSIONS::N3 },
+};
+
+// Fields of a problem record in the XML format
+static const std::vector<std::_tstring>& GetRecordFields()
+{
+   static std::vector<std::_tstring> vFields;
+   if ( vFields.empty() )
+   {
+      vFields.push_back(_T("ProblemType"));
+      for ( const auto& column : gs_Columns )
+      {
+         vFields.push_back(std::_tstring(CA2T(column.lpszName)));
+      }
+   }
+   return vFields;
+}
+
 HRESULT CGirCompDoc::WriteTheDocument(IStructuredSave* pStrSave)
 {
    HRESULT hr = pStrSave->BeginUnit(_T("GirComp"),1.0);
@@ -182,101 +223,14 @@ HRESULT CGirCompDoc::WriteTheDocument(IStructuredSave* pStrSave)
    if ( FAILED(hr) )
       return hr;
 
-   hr = pStrSave->BeginUnit(_T("Problems"),1.0);
+   // Version 2 - the problems are saved as a block of packed records instead of a Dimensions unit for each problem
+   hr = pStrSave->BeginUnit(_T("Problems"),2.0);
    if ( FAILED(hr) )
       return hr;
 
-   std::vector<GIRCOMPDIMENSIONS>::iterator iter(m_Problems.begin());
-   std::vector<GIRCOMPDIMENSIONS>::iterator end(m_Problems.end());
-   for ( ; iter != end; iter++ )
-   {
-      GIRCOMPDIMENSIONS& dimensions = *iter;
-
-      hr = pStrSave->BeginUnit(_T("Dimensions"),1.0);
-      if ( FAILED(hr) )
-         return hr;
-
-      switch(dimensions.Type)
-      {
-      case GIRCOMPDIMENSIONS::General:
-         hr = pStrSave->put_Property(_T("ProblemType"),CComVariant(_T("General")));
-         break;
-
-      case GIRCOMPDIMENSIONS::Rolled:
-         hr = pStrSave->put_Property(_T("ProblemType"),CComVariant(_T("Rolled")));
-         break;
-
-      case GIRCOMPDIMENSIONS::BuiltUp:
-         hr = pStrSave->put_Property(_T("ProblemType"),CComVariant(_T("BuiltUp")));
-         break;
-      }
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("RolledSectionName"),CComVariant(dimensions.RolledSectionName.c_str()));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("Area"),CComVariant(dimensions.Area));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("MomentOfInertia"),CComVariant(dimensions.MomentOfInertia));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("D"),CComVariant(dimensions.D));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("tWeb"),CComVariant(dimensions.tWeb));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("wTopFlange"),CComVariant(dimensions.wTopFlange));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("tTopFlange"),CComVariant(dimensions.tTopFlange));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("wBotFlange"),CComVariant(dimensions.wBotFlange));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("tBotFlange"),CComVariant(dimensions.tBotFlange));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("G"),CComVariant(dimensions.G));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("tSlab"),CComVariant(dimensions.tSlab));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("wSlab"),CComVariant(dimensions.wSlab));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("N1"),CComVariant(dimensions.N1));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("N2"),CComVariant(dimensions.N2));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->put_Property(_T("N3"),CComVariant(dimensions.N3));
-      if ( FAILED(hr) )
-         return hr;
-
-      hr = pStrSave->EndUnit(); // Dimensions
-      if ( FAILED(hr) )
-         return hr;
-   }
+   hr = WriteProblemRecords(pStrSave);
+   if ( FAILED(hr) )
+      return hr;
 
    hr = pStrSave->EndUnit(); // Problems
    if ( FAILED(hr) )
@@ -291,8 +245,6 @@ HRESULT CGirCompDoc::WriteTheDocument(IStructuredSave* pStrSave)
 
 HRESULT CGirCompDoc::LoadTheDocument(IStructuredLoad* pStrLoad)
 {
-   USES_CONVERSION;
-
    ClearProblems();
 
    HRESULT hr = pStrLoad->BeginUnit(_T("GirComp"));
@@ -321,6 +273,118 @@ HRESULT CGirCompDoc::LoadTheDocument(IStructuredLoad* pStrLoad)
    if ( FAILED(hr) )
       return hr;
 
+   Float64 version;
+   pStrLoad->get_Version(&version);
+   if ( version < 2 )
+   {
+      hr = LoadProblems(pStrLoad,nProblems);
+   }
+   else
+   {
+      hr = LoadProblemRecords(pStrLoad,nProblems);
+   }
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrLoad->EndUnit(); // Problems
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrLoad->EndUnit(); // GirComp
+   if ( FAILED(hr) )
+      return hr;
+
+   return S_OK;
+}
+
+HRESULT CGirCompDoc::WriteProblemRecords(IStructuredSave* pStrSave)
+{
+   const std::vector<std::_tstring>& vFields(GetRecordFields());
+   IndexType nFields = vFields.size();
+   IndexType nProblems = m_Problems.size();
+
+   std::vector<std::_tstring> vRolledSectionNames;
+   std::vector<Float64> vRecords(nProblems*nFields);
+   vRolledSectionNames.reserve(nProblems);
+   Float64* pRecord = vRecords.data();
+   for ( const auto& dimensions : m_Problems )
+   {
+      vRolledSectionNames.push_back(dimensions.RolledSectionName);
+
+      pRecord[0] = (Float64)dimensions.Type;
+      IndexType fieldIdx = 1;
+      for ( const auto& column : gs_Columns )
+      {
+         pRecord[fieldIdx++] = dimensions.*column.pDimension;
+      }
+      pRecord += nFields;
+   }
+
+   HRESULT hr = WriteStringBlock(pStrSave,_T("RolledSectionNames"),vRolledSectionNames);
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = WriteRecordBlock(pStrSave,_T("Records"),vFields,vRecords.data(),nProblems);
+   if ( FAILED(hr) )
+      return hr;
+
+   return S_OK;
+}
+
+HRESULT CGirCompDoc::LoadProblemRecords(IStructuredLoad* pStrLoad,IndexType nProblems)
+{
+   std::vector<std::_tstring> vRolledSectionNames;
+   HRESULT hr = ReadStringBlock(pStrLoad,_T("RolledSectionNames"),&vRolledSectionNames);
+   if ( FAILED(hr) )
+      return hr;
+
+   const std::vector<std::_tstring>& vFields(GetRecordFields());
+   IndexType nFields = vFields.size();
+   std::vector<Float64> vRecords;
+   IndexType nRecords;
+   hr = ReadRecordBlock(pStrLoad,_T("Records"),vFields,&vRecords,&nRecords);
+   if ( FAILED(hr) )
+      return hr;
+
+   if ( nRecords != nProblems || vRolledSectionNames.size() != nProblems )
+      return E_FAIL;
+
+   // the problems are validated before they are put in the document
+   std::vector<GIRCOMPDIMENSIONS> vProblems(nProblems);
+   const Float64* pRecord = vRecords.data();
+   for ( IndexType idx = 0; idx < nProblems; idx++ )
+   {
+      Float64 type = pRecord[0];
+      if ( type != GIRCOMPDIMENSIONS::Rolled && type != GIRCOMPDIMENSIONS::General && type != GIRCOMPDIMENSIONS::BuiltUp )
+         return E_FAIL;
+
+      GIRCOMPDIMENSIONS& dimensions(vProblems[idx]);
+      dimensions.Type = (GIRCOMPDIMENSIONS::BeamType)(Int32)type;
+      dimensions.RolledSectionName.swap(vRolledSectionNames[idx]);
+
+      IndexType fieldIdx = 1;
+      for ( const auto& column : gs_Columns )
+      {
+         dimensions.*column.pDimension = pRecord[fieldIdx++];
+      }
+      pRecord += nFields;
+   }
+
+   m_Problems.swap(vProblems);
+
+   return S_OK;
+}
+
+HRESULT CGirCompDoc::LoadProblems(IStructuredLoad* pStrLoad,IndexType nProblems)
+{
+   // Problems version 1 - each problem is a Dimensions unit
+   USES_CONVERSION;
+
+   CComVariant var;
+   HRESULT hr;
+
+   m_Problems.reserve(nProblems);
+
    for ( IndexType idx = 0; idx < nProblems; idx++ )
    {
       GIRCOMPDIMENSIONS dimensions;
@@ -428,14 +492,122 @@ HRESULT CGirCompDoc::LoadTheDocument(IStructuredLoad* pStrLoad)
          return hr;
    }
 
-   hr = pStrLoad->EndUnit(); // Problems
+   return S_OK;
+}
+
+BOOL CGirCompDoc::SupportsBinaryFormat() const
+{
+   return TRUE;
+}
+
+HRESULT CGirCompDoc::WriteBinaryDocument(CBinaryDocumentWriter& writer)
+{
+   // same content, and version, as the GirComp unit written by WriteTheDocument
+   Float64 version = 1.0;
+   HRESULT hr = writer.WriteFloat64Array("Version",&version,1);
    if ( FAILED(hr) )
       return hr;
 
-   hr = pStrLoad->EndUnit(); // GirComp
+   CEAFApp* pApp = EAFGetApp();
+   Int32 units = (Int32)pApp->GetUnitsMode();
+   hr = writer.WriteInt32Array("Units",&units,1);
    if ( FAILED(hr) )
       return hr;
 
+   IndexType nProblems = m_Problems.size();
+   std::vector<Int32> vTypes;
+   std::vector<std::_tstring> vRolledSectionNames;
+   vTypes.reserve(nProblems);
+   vRolledSectionNames.reserve(nProblems);
+   for ( const auto& dimensions : m_Problems )
+   {
+      vTypes.push_back((Int32)dimensions.Type);
+      vRolledSectionNames.push_back(dimensions.RolledSectionName);
+   }
+
+   hr = writer.WriteInt32Array("ProblemType",vTypes.data(),nProblems);
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = writer.WriteStringArray("RolledSectionName",vRolledSectionNames);
+   if ( FAILED(hr) )
+      return hr;
+
+   std::vector<Float64> vValues(nProblems);
+   for ( const auto& column : gs_Columns )
+   {
+      for ( IndexType idx = 0; idx < nProblems; idx++ )
+      {
+         vValues[idx] = m_Problems[idx].*column.pDimension;
+      }
+
+      hr = writer.WriteFloat64Array(column.lpszName,vValues.data(),nProblems);
+      if ( FAILED(hr) )
+         return hr;
+   }
+
+   return S_OK;
+}
+
+HRESULT CGirCompDoc::LoadBinaryDocument(CBinaryDocumentReader& reader)
+{
+   // Every chunk is read and validated before anything is applied to the document
+   // or the application so a bad file doesn't leave a partially loaded document behind.
+   if ( strcmp(reader.GetDocumentType(),"GirComp") != 0 )
+      return E_FAIL;
+
+   const Float64* pVersion;
+   IndexType nValues;
+   HRESULT hr = reader.GetFloat64Array("Version",&pVersion,&nValues);
+   if ( FAILED(hr) || nValues != 1 || 1.0 < *pVersion )
+      return E_FAIL;
+
+   const Int32* pUnits;
+   hr = reader.GetInt32Array("Units",&pUnits,&nValues);
+   if ( FAILED(hr) || nValues != 1 || (*pUnits != eafTypes::umSI && *pUnits != eafTypes::umUS) )
+      return E_FAIL;
+
+   const Int32* pTypes;
+   IndexType nProblems;
+   hr = reader.GetInt32Array("ProblemType",&pTypes,&nProblems);
+   if ( FAILED(hr) )
+      return E_FAIL;
+
+   std::vector<std::_tstring> vRolledSectionNames;
+   hr = reader.GetStringArray("RolledSectionName",&vRolledSectionNames);
+   if ( FAILED(hr) || vRolledSectionNames.size() != nProblems )
+      return E_FAIL;
+
+   std::vector<GIRCOMPDIMENSIONS> vProblems(nProblems);
+   for ( IndexType idx = 0; idx < nProblems; idx++ )
+   {
+      if ( pTypes[idx] != GIRCOMPDIMENSIONS::Rolled && pTypes[idx] != GIRCOMPDIMENSIONS::General && pTypes[idx] != GIRCOMPDIMENSIONS::BuiltUp )
+         return E_FAIL;
+
+      GIRCOMPDIMENSIONS& dimensions(vProblems[idx]);
+      dimensions.Type = (GIRCOMPDIMENSIONS::BeamType)pTypes[idx];
+      dimensions.RolledSectionName = vRolledSectionNames[idx];
+   }
+
+   // the dimension columns are copied from the mapped file into the problems
+   for ( const auto& column : gs_Columns )
+   {
+      const Float64* pValues;
+      hr = reader.GetFloat64Array(column.lpszName,&pValues,&nValues);
+      if ( FAILED(hr) || nValues != nProblems )
+         return E_FAIL;
+
+      for ( IndexType idx = 0; idx < nProblems; idx++ )
+      {
+         vProblems[idx].*column.pDimension = pValues[idx];
+      }
+   }
+
+   CEAFApp* pApp = EAFGetApp();
+   pApp->SetUnitsMode(eafTypes::UnitMode(*pUnits));
+
+   m_Problems.swap(vProblems);
+
    return S_OK;
 }
 
@@ -110,6 +110,11 @@ protected:
    virtual HRESULT WriteTheDocument(IStructuredSave* pStrSave) override;
    virtual HRESULT LoadTheDocument(IStructuredLoad* pStrLoad) override;
 
+   // Called by the framework when the document is to be loaded and saved in the compact binary format
+   virtual BOOL SupportsBinaryFormat() const override;
+   virtual HRESULT WriteBinaryDocument(CBinaryDocumentWriter& writer) override;
+   virtual HRESULT LoadBinaryDocument(CBinaryDocumentReader& reader) override;
+
    virtual void LoadDocumentSettings() override;
    virtual void SaveDocumentSettings() override;
 
@@ -119,6 +124,10 @@ protected:
 
    std::vector<GIRCOMPDIMENSIONS> m_Problems;
 
+   HRESULT WriteProblemRecords(IStructuredSave* pStrSave);
+   HRESULT LoadProblemRecords(IStructuredLoad* pStrLoad,IndexType nProblems);
+   HRESULT LoadProblems(IStructuredLoad* pStrLoad,IndexType nProblems); // Problems version 1
+
    void ComputeRollSectionProperties(const GIRCOMPDIMENSIONS& dimensions,IShapeProperties** ppShapeProperties);
    void ComputeGeneralSectionProperties(const GIRCOMPDIMENSIONS& dimensions,IShapeProperties** ppShapeProperties);
    void ComputeBuiltUpSectionProperties(const GIRCOMPDIMENSIONS& dimensions,IShapeProperties** ppShapeProperties);
@@ -24,6 +24,7 @@
 #include "..\resource.h"
 #include "PGStableDoc.h"
 #include "..\BEToolboxStatusBar.h"
+#include "PGStableLibraryCache.h"
 
 #include <EAF\EAFUtilities.h>
 #include <EAF\EAFApp.h>
@@ -131,97 +132,13 @@ BOOL CPGStableDoc::Init()
 
 void CPGStableDoc::LoadPGSLibrary()
 {
-   CAutoRegistry autoReg(_T("PGSuper"));
-
-   CEAFApp* pApp = EAFGetApp();
-
-   CString strMasterLibaryFile = pApp->GetProfileString(_T("Options"),_T("MasterLibraryCache2"));
-
-   if (strMasterLibaryFile.IsEmpty())
-   {
-      AfxMessageBox(_T("Cannot ready PGSuper Configuration.\r\nProceeding without configuration information.\r\nUse the BridgeLink Configuration Wizard to update the software configuration."),MB_OK | MB_ICONEXCLAMATION);
-      return; // there isn't a master library defined
-   }
-
-   CString strURL = pApp->GetProfileString(_T("Options"),_T("MasterLibraryURL2"));
-
-   if (strURL.IsEmpty())
-   {
-      strURL = strMasterLibaryFile;
-   }
-
-   CString strPublisher = pApp->GetProfileString(_T("Options"), _T("Publisher2"));
-   CString strServer = pApp->GetProfileString(_T("Options"), _T("CatalogServer2"));
-
-   m_LibMgr.SetName( _T("PGSLibrary") );
-   m_LibMgr.SetMasterLibraryInfo(strPublisher,strServer,strURL);
-
-   CComBSTR bpath(strMasterLibaryFile);
-
-   FileStream ifile;
-   if ( ifile.open(bpath) )
-   {
-      // try to load file
-      try
-      {
-         // clear out library
-         m_LibMgr.ClearAllEntries();
-
-         sysStructuredLoadXmlPrs load;
-         load.BeginLoad( &ifile );
-
-         // Problem : Library Editor application specific code is in the
-         // master library file. We have to read it or get an error.
-         load.BeginUnit(_T("PGSuperLibrary"));
-         load.BeginUnit(_T("LIBRARY_EDITOR"));
-         std::_tstring str;
-         load.Property(_T("EDIT_UNITS"), &str);
-
-         if ( !m_LibMgr.LoadMe( &load ) )
-         {
-            AfxMessageBox(_T("Failed to load the PGSuper Configuration information"),MB_OK | MB_ICONEXCLAMATION);
-            return;
-         }
-
-         load.EndUnit(); //"LIBRARY_EDITOR"
-         load.EndUnit(); //"PGSuperLibrary"
-         load.EndLoad();
-
-         // success!
-         WATCH(_T("Master Library loaded successfully"));
-      }
-      catch( sysXStructuredLoad& e )
-      {
-         CString strMsg;
-         if ( e.GetExplicitReason() == sysXStructuredLoad::CantInitializeTheParser )
-         {
-            strMsg = _T("Failed to initialize the xml parser. This is an installation issue.");
-         }
-         else
-         {
-            ASSERT(0);
-            strMsg = _T("An unknown error occurred while loading the master library.");
-         }
-
-         AfxMessageBox(strMsg,MB_OK | MB_ICONEXCLAMATION);
-         return;
-      }
-      catch(...)
-      {
-         AfxMessageBox(_T("An unknown error occurred while loading the master library."),MB_OK | MB_ICONEXCLAMATION);
-         return;
-      }
-   }
-   else
+   // the master library is shared by all PGStable documents. it is loaded once and cached
+   CString strError;
+   m_pLibrary = CPGStableLibraryCache::GetInstance().GetLibrary(strError);
+   if ( !strError.IsEmpty() )
    {
-      CString strMsg;
-      strMsg.Format(_T("Failed to open the master library file: %s"),strMasterLibaryFile);
-      AfxMessageBox(strMsg,MB_OK | MB_ICONEXCLAMATION);
-      return;
+      AfxMessageBox(strError,MB_OK | MB_ICONEXCLAMATION);
    }
-
-   // make all entries in master library read-only
-   m_LibMgr.EnableEditingForAllEntries(false);
 }
 
 HRESULT CPGStableDoc::WriteTheDocument(IStructuredSave* pStrSave)
@@ -382,12 +299,21 @@ const CString& CPGStableDoc::GetCriteria() const
 
 void CPGStableDoc::SetCriteria(LPCTSTR lpszCriteria)
 {
+   bool bChanged = (m_strProjectCriteria != lpszCriteria);
    m_strProjectCriteria = lpszCriteria;
 
-   if ( m_strProjectCriteria != gs_strCriteria )
+   // only the selected criteria entry is loaded from the library
+   const SpecLibraryEntry* pSpec = GetSpecLibraryEntry();
+   if ( pSpec == nullptr && m_strProjectCriteria != gs_strCriteria && bChanged )
+   {
+      // the names come from the library so the entry is there, but it couldn't be loaded
+      CString strMsg;
+      strMsg.Format(_T("The \"%s\" project criteria could not be loaded from the master library. The lifting and hauling parameters were not updated."),m_strProjectCriteria);
+      AfxMessageBox(strMsg,MB_OK | MB_ICONEXCLAMATION);
+   }
+   else if ( pSpec != nullptr )
    {
       // update input parameters to match library
-      const SpecLibraryEntry* pSpec = GetSpecLibraryEntry();
 
       stbLiftingStabilityProblem liftingProblem = GetLiftingStabilityProblem();
       liftingProblem.SetImpact(pSpec->GetLiftingUpwardImpactFactor(),pSpec->GetLiftingDownwardImpactFactor());
@@ -789,9 +715,9 @@ stbHaulingCheckArtifact CPGStableDoc::GetHaulingCheckArtifact() const
    return m_Model.GetHaulingCheckArtifact();
 }
 
-const SpecLibrary* CPGStableDoc::GetSpecLibrary() const
+const CPGStableLibrary* CPGStableDoc::GetLibrary() const
 {
-   return m_LibMgr.GetSpecLibrary();
+   return m_pLibrary.get();
 }
 
 const SpecLibraryEntry* CPGStableDoc::GetSpecLibraryEntry() const
@@ -802,16 +728,10 @@ const SpecLibraryEntry* CPGStableDoc::GetSpecLibraryEntry() const
    }
    else
    {
-      const SpecLibrary* pLib = GetSpecLibrary();
-      return (const SpecLibraryEntry*)(pLib->GetEntry(m_strProjectCriteria));
+      return m_pLibrary->GetCriteriaEntry(m_strProjectCriteria);
    }
 }
 
-const HaulTruckLibrary* CPGStableDoc::GetHaulTruckLibrary() const
-{
-   return m_LibMgr.GetHaulTruckLibrary();
-}
-
 const HaulTruckLibraryEntry* CPGStableDoc::GetHaulTruckLibraryEntry() const
 {
    if ( m_strHaulTruck == gs_strHaulTruck )
@@ -820,16 +740,10 @@ const HaulTruckLibraryEntry* CPGStableDoc::GetHaulTruckLibraryEntry() const
    }
    else
    {
-      const HaulTruckLibrary* pLib = GetHaulTruckLibrary();
-      return (const HaulTruckLibraryEntry*)(pLib->GetEntry(m_strHaulTruck));
+      return m_pLibrary->GetHaulTruckEntry(m_strHaulTruck);
    }
 }
 
-const GirderLibrary* CPGStableDoc::GetGirderLibrary() const
-{
-   return &(m_LibMgr.GetGirderLibrary());
-}
-
 const GirderLibraryEntry* CPGStableDoc::GetGirderLibraryEntry() const
 {
    if ( m_strGirder == gs_strGirder )
@@ -838,8 +752,7 @@ const GirderLibraryEntry* CPGStableDoc::GetGirderLibraryEntry() const
    }
    else
    {
-      const GirderLibrary* pLib = GetGirderLibrary();
-      return (const GirderLibraryEntry*)(pLib->GetEntry(m_strGirder));
+      return m_pLibrary->GetGirderEntry(m_strGirder);
    }
 }
 
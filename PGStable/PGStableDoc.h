@@ -29,7 +29,9 @@
 #include "PGStablePluginCATID.h"
 
 #include <ReportManager\ReportManager.h>
-#include <PsgLib\LibraryManager.h>
+#include "PGStableLibrary.h"
+
+#include <memory>
 
 
 static CString gs_strCriteria(_T("Define project criteria"));
@@ -119,13 +121,9 @@ public:
    stbLiftingCheckArtifact GetLiftingCheckArtifact() const;
    stbHaulingCheckArtifact GetHaulingCheckArtifact() const;
 
-   const SpecLibrary* GetSpecLibrary() const;
+   const CPGStableLibrary* GetLibrary() const;
    const SpecLibraryEntry* GetSpecLibraryEntry() const;
-
-   const HaulTruckLibrary* GetHaulTruckLibrary() const;
    const HaulTruckLibraryEntry* GetHaulTruckLibraryEntry() const;
-
-   const GirderLibrary* GetGirderLibrary() const;
    const GirderLibraryEntry* GetGirderLibraryEntry() const;
 
    bool IsPermittedGirderEntry(const GirderLibraryEntry* pGirderEntry) const;
@@ -169,7 +167,7 @@ protected:
 
    mutable CPGStableModel m_Model;
 
-   psgLibraryManager m_LibMgr;
+   std::shared_ptr<const CPGStableLibrary> m_pLibrary; // shared, read-only master library
 
    afx_msg void OnHelpFinder();
 	DECLARE_MESSAGE_MAP()
@@ -179,9 +179,8 @@ void CPGStableGirderView::OnInitialUpdate()
 {
    CPGStableDoc* pDoc = (CPGStableDoc*)GetDocument();
 
-   const SpecLibrary* pSpecLib = pDoc->GetSpecLibrary();
    libKeyListType keyList;
-   pSpecLib->KeyList(keyList);
+   pDoc->GetLibrary()->GetCriteriaNames(keyList);
    CComboBox* pcbSpec = (CComboBox*)GetDlgItem(IDC_SPEC);
    pcbSpec->AddString(gs_strCriteria);
    for (const auto& key : keyList)
@@ -573,9 +573,8 @@ void CPGStableHaulingView::OnInitialUpdate()
 {
    CPGStableDoc* pDoc = (CPGStableDoc*)GetDocument();
 
-   const HaulTruckLibrary* pLib = pDoc->GetHaulTruckLibrary();
    libKeyListType keyList;
-   pLib->KeyList(keyList);
+   pDoc->GetLibrary()->GetHaulTruckNames(keyList);
    CComboBox* pcbHaulTruck = (CComboBox*)GetDlgItem(IDC_HAUL_TRUCK);
    pcbHaulTruck->AddString(gs_strHaulTruck);
    for (const auto& key : keyList)
@@ -759,6 +758,23 @@ void CPGStableHaulingView::OnHaulTruckChanged()
    int curSel = pCB->GetCurSel();
    pCB->GetLBText(curSel,strHaulTruck);
 
+   // get the data for the selected haul truck. if it can't be loaded from the library, the haul truck is defined by the user
+   CPGStableDoc* pDoc = (CPGStableDoc*)GetDocument();
+   const HaulTruckLibraryEntry* pEntry = nullptr;
+   if ( strHaulTruck != gs_strHaulTruck )
+   {
+      pEntry = pDoc->GetLibrary()->GetHaulTruckEntry(strHaulTruck);
+      if ( pEntry == nullptr )
+      {
+         CString strMsg;
+         strMsg.Format(_T("The \"%s\" haul truck could not be loaded from the master library. Define the haul truck instead."),strHaulTruck);
+         AfxMessageBox(strMsg,MB_OK | MB_ICONEXCLAMATION);
+
+         pCB->SetCurSel(pCB->FindStringExact(-1,gs_strHaulTruck));
+         strHaulTruck = gs_strHaulTruck;
+      }
+   }
+
    BOOL bEnable = strHaulTruck == gs_strHaulTruck ? TRUE : FALSE;
    GetDlgItem(IDC_HGB)->EnableWindow(bEnable);
    GetDlgItem(IDC_HRC)->EnableWindow(bEnable);
@@ -770,11 +786,6 @@ void CPGStableHaulingView::OnHaulTruckChanged()
 
    if ( !bEnable )
    {
-      // get the data for the selected haul truck
-      CPGStableDoc* pDoc = (CPGStableDoc*)GetDocument();
-      const HaulTruckLibrary* pLib = pDoc->GetHaulTruckLibrary();
-      const HaulTruckLibraryEntry* pEntry = (const HaulTruckLibraryEntry*)(pLib->GetEntry(strHaulTruck));
-
       Float64 Hgb = pEntry->GetBottomOfGirderHeight();
       Float64 Hrc = pEntry->GetRollCenterHeight();
       Float64 Wcc = pEntry->GetAxleWidth();
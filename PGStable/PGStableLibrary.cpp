@@ -0,0 +1,456 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#include "stdafx.h"
+#include "PGStableLibrary.h"
+
+#include <System\System.h>
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+// Names of the library and entry units in the master library file, by LibraryType
+static const struct
+{
+   LPCSTR lpszLibrary;
+   LPCSTR lpszEntry;
+} gs_Libraries[] =
+{
+   { "SPECIFICATION_LIBRARY", "SpecificationLibraryEntry" },
+   { "HAUL_TRUCK_LIBRARY",    "HaulTruckLibraryEntry"     },
+   { "GIRDER_LIBRARY",        "GirderLibraryEntry"        },
+};
+
+// Location of an element in the master library file. Begin is the position of the start tag, ContentBegin follows
+// the start tag, ContentEnd is the position of the end tag, and End follows the end tag. For an empty element
+// ContentBegin, ContentEnd, and End are the same.
+struct XMLELEMENT
+{
+   size_t Begin;
+   size_t ContentBegin;
+   size_t ContentEnd;
+   size_t End;
+};
+
+// Skips markup that isn't a tag (comments, CDATA sections, processing instructions, and declarations)
+// that starts at pos. Returns the position following the markup, pos if there isn't any such markup at pos, or
+// std::string::npos if the markup isn't closed.
+static size_t SkipMarkup(const std::string& xml,size_t pos)
+{
+   static const struct
+   {
+      LPCSTR lpszOpen;
+      LPCSTR lpszClose;
+   } markup[] =
+   {
+      { "<!--",      "-->" },
+      { "<![CDATA[", "]]>" },
+      { "<?",        "?>"  },
+      { "<!",        ">"   },
+   };
+
+   for ( const auto& item : markup )
+   {
+      if ( xml.compare(pos,strlen(item.lpszOpen),item.lpszOpen) == 0 )
+      {
+         size_t close = xml.find(item.lpszClose,pos + strlen(item.lpszOpen));
+         return (close == std::string::npos ? std::string::npos : close + strlen(item.lpszClose));
+      }
+   }
+
+   return pos;
+}
+
+// Returns the position of the '>' that closes the tag that starts at pos. A '>' in a quoted attribute value doesn't close the tag.
+static size_t FindTagEnd(const std::string& xml,size_t pos)
+{
+   char quote = 0;
+   for ( ; pos < xml.size(); pos++ )
+   {
+      char c = xml[pos];
+      if ( quote != 0 )
+      {
+         if ( c == quote )
+         {
+            quote = 0;
+         }
+      }
+      else if ( c == '\"' || c == '\'' )
+      {
+         quote = c;
+      }
+      else if ( c == '>' )
+      {
+         return pos;
+      }
+   }
+
+   return std::string::npos;
+}
+
+// Finds the first element with the given name in the range [start,end) of xml. Only the elements
+// at the level of start are considered, the content of other elements is skipped. The search
+// stops at the end tag of the parent element.
+static bool FindElement(const std::string& xml,size_t start,size_t end,LPCSTR lpszName,XMLELEMENT* pElement)
+{
+   size_t nameLength = strlen(lpszName);
+   IndexType depth = 0; // depth of the current position below the level of start
+   bool bFound = false;
+
+   size_t pos = start;
+   while ( (pos = xml.find('<',pos)) != std::string::npos && pos < end )
+   {
+      size_t next = SkipMarkup(xml,pos);
+      if ( next == std::string::npos )
+      {
+         return false;
+      }
+      else if ( next != pos )
+      {
+         pos = next;
+         continue;
+      }
+
+      size_t tagEnd = FindTagEnd(xml,pos);
+      if ( tagEnd == std::string::npos )
+      {
+         return false;
+      }
+
+      if ( xml[pos+1] == '/' )
+      {
+         // end tag
+         if ( depth == 0 )
+         {
+            return false; // end of the parent element
+         }
+
+         depth--;
+         if ( bFound && depth == 0 )
+         {
+            pElement->ContentEnd = pos;
+            pElement->End = tagEnd + 1;
+            return true;
+         }
+      }
+      else
+      {
+         bool bEmpty = (xml[tagEnd-1] == '/');
+         if ( !bFound && depth == 0 )
+         {
+            // must be the whole element name, not the start of a longer name
+            char c = (pos + 1 + nameLength < xml.size() ? xml[pos + 1 + nameLength] : 0);
+            if ( xml.compare(pos+1,nameLength,lpszName) == 0 && (c == '>' || c == '/' || isspace((unsigned char)c)) )
+            {
+               bFound = true;
+               pElement->Begin = pos;
+               pElement->ContentBegin = tagEnd + 1;
+               if ( bEmpty )
+               {
+                  pElement->ContentEnd = tagEnd + 1;
+                  pElement->End = tagEnd + 1;
+                  return true;
+               }
+            }
+         }
+
+         if ( !bEmpty )
+         {
+            depth++;
+         }
+      }
+
+      pos = tagEnd + 1;
+   }
+
+   return false;
+}
+
+// Appends a Unicode code point to a UTF-8 string
+static void AppendUTF8(std::string& str,unsigned long code)
+{
+   if ( code < 0x80 )
+   {
+      str += (char)code;
+   }
+   else if ( code < 0x800 )
+   {
+      str += (char)(0xC0 | (code >> 6));
+      str += (char)(0x80 | (code & 0x3F));
+   }
+   else if ( code < 0x10000 )
+   {
+      str += (char)(0xE0 | (code >> 12));
+      str += (char)(0x80 | ((code >> 6) & 0x3F));
+      str += (char)(0x80 | (code & 0x3F));
+   }
+   else
+   {
+      str += (char)(0xF0 | (code >> 18));
+      str += (char)(0x80 | ((code >> 12) & 0x3F));
+      str += (char)(0x80 | ((code >> 6) & 0x3F));
+      str += (char)(0x80 | (code & 0x3F));
+   }
+}
+
+// Gets the entry name from the Name property of the entry. The Name element must be a child of the entry.
+static bool GetEntryName(const std::string& xml,const XMLELEMENT& entry,std::_tstring* pName)
+{
+   XMLELEMENT name;
+   if ( !FindElement(xml,entry.ContentBegin,entry.ContentEnd,"Name",&name) )
+   {
+      return false;
+   }
+
+   // replace the predefined entities and character references, keep the text of CDATA sections, and drop comments
+   std::string strName;
+   for ( size_t pos = name.ContentBegin; pos < name.ContentEnd; pos++ )
+   {
+      if ( xml.compare(pos,9,"<![CDATA[") == 0 )
+      {
+         size_t cdataEnd = xml.find("]]>",pos + 9);
+         if ( cdataEnd == std::string::npos || name.ContentEnd < cdataEnd + 3 )
+         {
+            return false;
+         }
+         strName.append(xml,pos + 9,cdataEnd - pos - 9);
+         pos = cdataEnd + 2;
+         continue;
+      }
+      else if ( xml[pos] == '<' )
+      {
+         size_t next = SkipMarkup(xml,pos);
+         if ( next == std::string::npos || next == pos || name.ContentEnd < next )
+         {
+            return false; // the name isn't simple text
+         }
+         pos = next - 1;
+         continue;
+      }
+      else if ( xml[pos] == '&' )
+      {
+         size_t semicolon = xml.find(';',pos);
+         if ( semicolon != std::string::npos && semicolon < name.ContentEnd )
+         {
+            std::string strEntity(xml,pos+1,semicolon-pos-1);
+            if ( strEntity == "amp" )       { strName += '&';  pos = semicolon; continue; }
+            else if ( strEntity == "lt" )   { strName += '<';  pos = semicolon; continue; }
+            else if ( strEntity == "gt" )   { strName += '>';  pos = semicolon; continue; }
+            else if ( strEntity == "quot" ) { strName += '\"'; pos = semicolon; continue; }
+            else if ( strEntity == "apos" ) { strName += '\''; pos = semicolon; continue; }
+            else if ( 1 < strEntity.size() && strEntity[0] == '#' )
+            {
+               unsigned long code = (strEntity[1] == 'x' ? strtoul(strEntity.c_str()+2,nullptr,16) : strtoul(strEntity.c_str()+1,nullptr,10));
+               AppendUTF8(strName,code);
+               pos = semicolon;
+               continue;
+            }
+         }
+      }
+
+      strName += xml[pos];
+   }
+
+   *pName = CA2T(strName.c_str(),CP_UTF8);
+   return true;
+}
+
+CPGStableLibrary::CPGStableLibrary()
+{
+}
+
+CPGStableLibrary::~CPGStableLibrary()
+{
+}
+
+BOOL CPGStableLibrary::Open(LPCTSTR lpszFile,CString& strError)
+{
+#if defined _DEBUG
+   std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::now());
+#endif
+
+   std::ifstream file(lpszFile,std::ios::in | std::ios::binary);
+   if ( !file.is_open() )
+   {
+      strError.Format(_T("Failed to open the master library file: %s"),lpszFile);
+      return FALSE;
+   }
+
+   std::string xml((std::istreambuf_iterator<char>(file)),std::istreambuf_iterator<char>());
+   file.close();
+
+   XMLELEMENT root;
+   if ( !FindElement(xml,0,xml.size(),"PGSuperLibrary",&root) )
+   {
+      strError = _T("Failed to load the PGSuper Configuration information");
+      return FALSE;
+   }
+
+   // the entries are loaded as stand alone XML documents. keep the XML declaration so they are read with the same encoding
+   size_t prologEnd = xml.find("?>");
+   if ( prologEnd != std::string::npos && prologEnd < root.Begin )
+   {
+      m_Prolog.assign(xml,0,prologEnd+2);
+   }
+
+   for ( int i = 0; i < nLibraryTypes; i++ )
+   {
+      XMLELEMENT library;
+      if ( !FindElement(xml,root.ContentBegin,root.ContentEnd,gs_Libraries[i].lpszLibrary,&library) )
+      {
+         continue; // library isn't in the file
+      }
+
+      size_t pos = library.ContentBegin;
+      XMLELEMENT entry;
+      while ( FindElement(xml,pos,library.ContentEnd,gs_Libraries[i].lpszEntry,&entry) )
+      {
+         std::_tstring strName;
+         if ( GetEntryName(xml,entry,&strName) )
+         {
+            ENTRYLOCATION location;
+            location.Offset = m_Entries.size();
+            location.Size = entry.End - entry.Begin;
+            m_Entries.append(xml,entry.Begin,location.Size);
+            m_Index[i].insert(std::make_pair(strName,location));
+         }
+         pos = entry.End;
+      }
+   }
+
+   m_Entries.shrink_to_fit();
+
+#if defined _DEBUG
+   Float64 indexTime = std::chrono::duration<Float64,std::milli>(std::chrono::steady_clock::now() - startTime).count();
+   WATCH(lpszFile << _T(" indexed in ") << indexTime << _T(" ms. ") << m_Index[Criteria].size() << _T(" criteria, ") << m_Index[HaulTruck].size() << _T(" haul trucks, ") << m_Index[Girder].size() << _T(" girders (") << m_Entries.size() << _T(" of ") << xml.size() << _T(" bytes retained)"));
+#endif
+
+   return TRUE;
+}
+
+void CPGStableLibrary::GetCriteriaNames(libKeyListType& keyList) const
+{
+   GetNames(Criteria,keyList);
+}
+
+void CPGStableLibrary::GetHaulTruckNames(libKeyListType& keyList) const
+{
+   GetNames(HaulTruck,keyList);
+}
+
+void CPGStableLibrary::GetGirderNames(libKeyListType& keyList) const
+{
+   GetNames(Girder,keyList);
+}
+
+const SpecLibraryEntry* CPGStableLibrary::GetCriteriaEntry(LPCTSTR lpszName) const
+{
+   return GetEntry(Criteria,lpszName,m_CriteriaEntries);
+}
+
+const HaulTruckLibraryEntry* CPGStableLibrary::GetHaulTruckEntry(LPCTSTR lpszName) const
+{
+   return GetEntry(HaulTruck,lpszName,m_HaulTruckEntries);
+}
+
+const GirderLibraryEntry* CPGStableLibrary::GetGirderEntry(LPCTSTR lpszName) const
+{
+   return GetEntry(Girder,lpszName,m_GirderEntries);
+}
+
+void CPGStableLibrary::GetNames(LibraryType type,libKeyListType& keyList) const
+{
+   keyList.clear();
+   keyList.reserve(m_Index[type].size());
+   for ( const auto& item : m_Index[type] )
+   {
+      keyList.push_back(item.first);
+   }
+}
+
+template <class T>
+const T* CPGStableLibrary::GetEntry(LibraryType type,LPCTSTR lpszName,std::map<std::_tstring,std::unique_ptr<T>>& entries) const
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   auto found = entries.find(lpszName);
+   if ( found != entries.end() )
+   {
+      return found->second.get();
+   }
+
+   auto location = m_Index[type].find(lpszName);
+   if ( location == m_Index[type].end() )
+   {
+      return nullptr;
+   }
+
+   std::unique_ptr<T> pEntry(std::make_unique<T>());
+   if ( !LoadEntry(location->second,pEntry.get()) )
+   {
+      WATCH(_T("Failed to load library entry ") << lpszName);
+      return nullptr;
+   }
+
+   const T* pLoadedEntry = pEntry.get();
+   entries.insert(std::make_pair(std::_tstring(lpszName),std::move(pEntry)));
+   return pLoadedEntry;
+}
+
+bool CPGStableLibrary::LoadEntry(const ENTRYLOCATION& location,libLibraryEntry* pEntry) const
+{
+   // the entry is loaded from a stand alone XML document made from its part of the master library file
+   CComPtr<IStream> pStream;
+   if ( FAILED(::CreateStreamOnHGlobal(nullptr,TRUE,&pStream)) )
+   {
+      return false;
+   }
+
+   ULONG nWritten;
+   pStream->Write(m_Prolog.data(),(ULONG)m_Prolog.size(),&nWritten);
+   pStream->Write(m_Entries.data() + location.Offset,(ULONG)location.Size,&nWritten);
+
+   LARGE_INTEGER start;
+   start.QuadPart = 0;
+   pStream->Seek(start,STREAM_SEEK_SET,nullptr);
+
+   try
+   {
+      sysStructuredLoadXmlPrs load;
+      load.BeginLoad(pStream);
+      bool bLoaded = pEntry->LoadMe(&load);
+      load.EndLoad();
+      return bLoaded;
+   }
+   catch(...)
+   {
+      return false;
+   }
+}
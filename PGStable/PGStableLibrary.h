@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <PsgLib\LibraryManager.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Read-only view of the PGSuper master library for PGStable.
+//
+// PGStable only uses the project criteria, haul truck, and girder entries of the master library.
+// When the library is opened, the master library file is scanned once to build an index of the entries in these
+// libraries. The rest of the master library is skipped. An entry is loaded the first time it is requested.
+class CPGStableLibrary
+{
+public:
+   CPGStableLibrary();
+   ~CPGStableLibrary();
+
+   // Indexes the master library file. Returns FALSE if the file can't be read and describes the problem in strError
+   BOOL Open(LPCTSTR lpszFile,CString& strError);
+
+   // Names of the entries, sorted by name
+   void GetCriteriaNames(libKeyListType& keyList) const;
+   void GetHaulTruckNames(libKeyListType& keyList) const;
+   void GetGirderNames(libKeyListType& keyList) const;
+
+   // Returns the named entry. The entry is loaded on first use. Returns nullptr if the entry
+   // isn't in the library or can't be loaded
+   const SpecLibraryEntry* GetCriteriaEntry(LPCTSTR lpszName) const;
+   const HaulTruckLibraryEntry* GetHaulTruckEntry(LPCTSTR lpszName) const;
+   const GirderLibraryEntry* GetGirderEntry(LPCTSTR lpszName) const;
+
+private:
+   CPGStableLibrary(const CPGStableLibrary&) = delete;
+   CPGStableLibrary& operator=(const CPGStableLibrary&) = delete;
+
+   enum LibraryType { Criteria, HaulTruck, Girder, nLibraryTypes };
+
+   // location of the XML for an entry in m_Entries
+   struct ENTRYLOCATION
+   {
+      size_t Offset;
+      size_t Size;
+   };
+
+   std::string m_Prolog; // XML declaration of the master library file
+   std::string m_Entries; // XML of the indexed entries, end to end
+   std::map<std::_tstring,ENTRYLOCATION> m_Index[nLibraryTypes];
+
+   mutable std::mutex m_Mutex; // protects the loaded entries
+   mutable std::map<std::_tstring,std::unique_ptr<SpecLibraryEntry>> m_CriteriaEntries;
+   mutable std::map<std::_tstring,std::unique_ptr<HaulTruckLibraryEntry>> m_HaulTruckEntries;
+   mutable std::map<std::_tstring,std::unique_ptr<GirderLibraryEntry>> m_GirderEntries;
+
+   void GetNames(LibraryType type,libKeyListType& keyList) const;
+
+   template <class T>
+   const T* GetEntry(LibraryType type,LPCTSTR lpszName,std::map<std::_tstring,std::unique_ptr<T>>& entries) const;
+
+   bool LoadEntry(const ENTRYLOCATION& location,libLibraryEntry* pEntry) const;
+};
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#include "stdafx.h"
+#include "PGStableLibraryCache.h"
+
+#include <EAF\EAFApp.h>
+#include <MFCTools\AutoRegistry.h>
+
+#include <chrono>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+CPGStableLibraryCache& CPGStableLibraryCache::GetInstance()
+{
+   // construction of a local static is thread safe
+   static CPGStableLibraryCache theCache;
+   return theCache;
+}
+
+CPGStableLibraryCache::CPGStableLibraryCache()
+{
+   m_bHasSnapshot = false;
+   m_LastWriteTime.dwLowDateTime = 0;
+   m_LastWriteTime.dwHighDateTime = 0;
+}
+
+CPGStableLibraryCache::~CPGStableLibraryCache()
+{
+}
+
+void CPGStableLibraryCache::Preload()
+{
+   LIBRARYSETTINGS settings;
+   if ( GetLibrarySettings(&settings) )
+   {
+      GetSnapshot(settings,std::launch::async);
+   }
+}
+
+std::shared_ptr<const CPGStableLibrary> CPGStableLibraryCache::GetLibrary(CString& strError)
+{
+   LIBRARYSETTINGS settings;
+   if ( !GetLibrarySettings(&settings) )
+   {
+      SNAPSHOT snapshot(EmptyLibrary(_T("Cannot ready PGSuper Configuration.\r\nProceeding without configuration information.\r\nUse the BridgeLink Configuration Wizard to update the software configuration.")));
+      strError = snapshot.strError;
+      return snapshot.pLibrary;
+   }
+
+   // if there isn't a snapshot for the current master library, it is indexed on this thread
+   std::shared_future<SNAPSHOT> future(GetSnapshot(settings,std::launch::deferred));
+   const SNAPSHOT& snapshot(future.get());
+   strError = snapshot.strError;
+   return snapshot.pLibrary;
+}
+
+void CPGStableLibraryCache::Clear()
+{
+   std::shared_future<SNAPSHOT> future;
+   {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      future = m_Snapshot;
+      m_Snapshot = std::shared_future<SNAPSHOT>();
+      m_bHasSnapshot = false;
+   }
+
+   // don't let background indexing outlive the tool. a deferred snapshot that was never requested is just discarded
+   if ( future.valid() && future.wait_for(std::chrono::seconds(0)) != std::future_status::deferred )
+   {
+      future.wait();
+   }
+}
+
+std::shared_future<CPGStableLibraryCache::SNAPSHOT> CPGStableLibraryCache::GetSnapshot(const LIBRARYSETTINGS& settings,std::launch policy)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   // a library that failed to load isn't kept. the failure may be temporary (a locked or missing file)
+   // so the next request tries again
+   bool bFailed = m_bHasSnapshot && m_Snapshot.wait_for(std::chrono::seconds(0)) == std::future_status::ready && !m_Snapshot.get().strError.IsEmpty();
+
+   if ( !m_bHasSnapshot || bFailed || m_strFile != settings.strFile || ::CompareFileTime(&m_LastWriteTime,&settings.LastWriteTime) != 0 )
+   {
+      m_Snapshot = std::async(policy,&CPGStableLibraryCache::LoadMasterLibrary,settings).share();
+      m_strFile = settings.strFile;
+      m_LastWriteTime = settings.LastWriteTime;
+      m_bHasSnapshot = true;
+   }
+
+   return m_Snapshot;
+}
+
+BOOL CPGStableLibraryCache::GetLibrarySettings(LIBRARYSETTINGS* pSettings)
+{
+   CAutoRegistry autoReg(_T("PGSuper"));
+
+   CEAFApp* pApp = EAFGetApp();
+
+   pSettings->strFile = pApp->GetProfileString(_T("Options"),_T("MasterLibraryCache2"));
+
+   if (pSettings->strFile.IsEmpty())
+   {
+      return FALSE; // there isn't a master library defined
+   }
+
+   // the modification time is part of the key. if the file can't be read, indexing will fail and report the error
+   WIN32_FILE_ATTRIBUTE_DATA attributes;
+   if ( ::GetFileAttributesEx(pSettings->strFile,GetFileExInfoStandard,&attributes) )
+   {
+      pSettings->LastWriteTime = attributes.ftLastWriteTime;
+   }
+   else
+   {
+      pSettings->LastWriteTime.dwLowDateTime = 0;
+      pSettings->LastWriteTime.dwHighDateTime = 0;
+   }
+
+   return TRUE;
+}
+
+CPGStableLibraryCache::SNAPSHOT CPGStableLibraryCache::LoadMasterLibrary(const LIBRARYSETTINGS& settings)
+{
+   SNAPSHOT snapshot;
+   std::shared_ptr<CPGStableLibrary> pLibrary(std::make_shared<CPGStableLibrary>());
+   if ( pLibrary->Open(settings.strFile,snapshot.strError) )
+   {
+      snapshot.pLibrary = pLibrary;
+   }
+   else
+   {
+      // proceed with an empty library
+      snapshot.pLibrary = std::make_shared<CPGStableLibrary>();
+   }
+
+   return snapshot;
+}
+
+CPGStableLibraryCache::SNAPSHOT CPGStableLibraryCache::EmptyLibrary(LPCTSTR lpszError)
+{
+   SNAPSHOT snapshot;
+   snapshot.pLibrary = std::make_shared<CPGStableLibrary>();
+   snapshot.strError = lpszError;
+   return snapshot;
+}
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "PGStableLibrary.h"
+
+#include <future>
+#include <memory>
+#include <mutex>
+
+// Process wide cache of the PGSuper master library.
+//
+// The master library is indexed once and shared by all PGStable documents, rather than loaded for every document.
+// A library is a read-only snapshot. The snapshot is keyed on the master library file and its modification time
+// so a new snapshot is created when the master library is updated. A snapshot of a library that failed to load is
+// replaced on the next request. Documents keep the snapshot they were created with.
+//
+// The library can be preloaded on a background thread when the tool is initialized so the first document
+// doesn't have to wait for the library to be indexed.
+class CPGStableLibraryCache
+{
+public:
+   static CPGStableLibraryCache& GetInstance();
+
+   // Starts indexing the master library on a background thread
+   void Preload();
+
+   // Returns the master library. If the library is being indexed in the background, this method waits
+   // for it to finish. If the library could not be loaded, an empty library is returned and strError
+   // describes the problem.
+   std::shared_ptr<const CPGStableLibrary> GetLibrary(CString& strError);
+
+   // Waits for a background load to finish and releases the cached library
+   void Clear();
+
+private:
+   CPGStableLibraryCache();
+   ~CPGStableLibraryCache();
+   CPGStableLibraryCache(const CPGStableLibraryCache&) = delete;
+   CPGStableLibraryCache& operator=(const CPGStableLibraryCache&) = delete;
+
+   // master library configuration, from the PGSuper registry settings
+   struct LIBRARYSETTINGS
+   {
+      CString strFile;
+      FILETIME LastWriteTime;
+   };
+
+   struct SNAPSHOT
+   {
+      std::shared_ptr<const CPGStableLibrary> pLibrary;
+      CString strError;
+   };
+
+   std::mutex m_Mutex; // protects the members below
+   bool m_bHasSnapshot;
+   CString m_strFile; // key of the current snapshot
+   FILETIME m_LastWriteTime;
+   std::shared_future<SNAPSHOT> m_Snapshot; // current snapshot. it may still be loading
+
+   // The registry settings are read by the main thread. The application profile can't be used by other threads.
+   static BOOL GetLibrarySettings(LIBRARYSETTINGS* pSettings);
+   static SNAPSHOT LoadMasterLibrary(const LIBRARYSETTINGS& settings);
+   static SNAPSHOT EmptyLibrary(LPCTSTR lpszError);
+
+   std::shared_future<SNAPSHOT> GetSnapshot(const LIBRARYSETTINGS& settings,std::launch policy);
+};
@@ -303,14 +303,14 @@ BOOL CPGStablePrismaticGirder::OnInitDialog()
    CPGStableDoc* pDoc = (CPGStableDoc*)EAFGetDocument();
    CComboBox* pcbGirders = (CComboBox*)GetDlgItem(IDC_GIRDER_LIST);
    pcbGirders->AddString(gs_strGirder);
-   const GirderLibrary* pLib = pDoc->GetGirderLibrary();
+   const CPGStableLibrary* pLibrary = pDoc->GetLibrary();
    libKeyListType keyList;
-   pLib->KeyList(keyList);
+   pLibrary->GetGirderNames(keyList);
    for (const auto& key : keyList)
    {
       // fill combo box with only the names of prismatic girders
-      const GirderLibraryEntry* pGirderEntry = (const GirderLibraryEntry*)(pLib->GetEntry(key.c_str()));
-      if ( pDoc->IsPermittedGirderEntry(pGirderEntry) )
+      const GirderLibraryEntry* pGirderEntry = pLibrary->GetGirderEntry(key.c_str());
+      if ( pGirderEntry != nullptr && pDoc->IsPermittedGirderEntry(pGirderEntry) )
       {
          pcbGirders->AddString(key.c_str());
       }
@@ -481,6 +481,23 @@ void CPGStablePrismaticGirder::OnGirderChanged()
    int curSel = pCB->GetCurSel();
    pCB->GetLBText(curSel,strGirder);
 
+   // get the data for the selected girder. if it can't be loaded from the library, the girder is defined by the user
+   CPGStableDoc* pDoc = (CPGStableDoc*)EAFGetDocument();
+   const GirderLibraryEntry* pEntry = nullptr;
+   if ( strGirder != gs_strGirder )
+   {
+      pEntry = pDoc->GetLibrary()->GetGirderEntry(strGirder);
+      if ( pEntry == nullptr )
+      {
+         CString strMsg;
+         strMsg.Format(_T("The \"%s\" girder could not be loaded from the master library. Define the girder properties instead."),strGirder);
+         AfxMessageBox(strMsg,MB_OK | MB_ICONEXCLAMATION);
+
+         pCB->SetCurSel(pCB->FindStringExact(-1,gs_strGirder));
+         strGirder = gs_strGirder;
+      }
+   }
+
    BOOL bEnable = strGirder == gs_strGirder ? TRUE : FALSE;
    GetDlgItem(IDC_HG)->EnableWindow(bEnable);
    GetDlgItem(IDC_WTF)->EnableWindow(bEnable);
@@ -495,10 +512,6 @@ void CPGStablePrismaticGirder::OnGirderChanged()
 
    if ( !bEnable )
    {
-      CPGStableDoc* pDoc = (CPGStableDoc*)EAFGetDocument();
-      const GirderLibrary* pLib = pDoc->GetGirderLibrary();
-      const GirderLibraryEntry* pEntry = (const GirderLibraryEntry*)(pLib->GetEntry(strGirder));
-
       Float64 Cd = pEntry->GetDragCoefficient();
 
       CComPtr<IBeamFactory> factory;
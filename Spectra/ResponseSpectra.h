@@ -22,35 +22,16 @@
 
 #pragma once
 
+#include "..\Engine\ResponseSpectra.h"
+
 #define SPECTRA_OK               0
 #define SPECTRA_INVALID_LOCATION 1
 #define SPECTRA_SITE_SPECIFIC    2
 
-class CResponseSpectra
+// The design response spectrum. The spectrum is part of the portable engine (see Engine\ResponseSpectra.h).
+class CResponseSpectra : public BEToolboxEngine::CResponseSpectrum
 {
 public:
-   CResponseSpectra();
-   CResponseSpectra(const CResponseSpectra& other);
-   CResponseSpectra& operator=(const CResponseSpectra& other);
-
-   void Init(Float64 PGA,Float64 Ss,Float64 S1,Float64 Fpga,Float64 Fa,Float64 Fv);
-
-   Float64 GetPGA() const;
-   Float64 GetSs() const;
-   Float64 GetS1() const;
-   Float64 GetFpga() const;
-   Float64 GetFa() const;
-   Float64 GetFv() const;
-   Float64 GetTo() const;
-   Float64 GetTs() const;
-   Float64 GetAs() const;
-   Float64 GetSds() const;
-   Float64 GetSd1() const;
+   // Seismic zone (LRFD) or seismic design category
    LPCTSTR GetSDC(SpecificationType specType) const;
-   Float64 GetSa(Float64 time) const;
-   std::vector<std::pair<Float64,Float64>> GetSpectraValues(Float64 Tmax,Float64 tStep);
-
-protected:
-   Float64 m_PGA, m_Ss, m_S1;
-   Float64 m_Fpga, m_Fa, m_Fv;
 };
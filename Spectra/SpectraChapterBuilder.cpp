@@ -267,42 +267,42 @@ rptChapter* CSpectraChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16
       SiteClass thisSiteClass = (SiteClass)i;
 
       col = 0;
-      const mathPwLinearFunction2dUsingPoints* pZeroPeriodSiteFactors = m_pDoc->GetZeroPeriodSiteFactors(specType, thisSiteClass);
+      BEToolboxEngine::CSiteFactorCurve zeroPeriodSiteFactors(m_pDoc->GetZeroPeriodSiteFactors(specType, thisSiteClass));
       (*pZeroPeriodTable)(row, col++) << strSiteClass[thisSiteClass];
-      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(pZeroPeriodSiteFactors->Evaluate(0.1));
-      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(pZeroPeriodSiteFactors->Evaluate(0.2));
-      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(pZeroPeriodSiteFactors->Evaluate(0.3));
-      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(pZeroPeriodSiteFactors->Evaluate(0.4));
-      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(pZeroPeriodSiteFactors->Evaluate(0.5));
+      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(zeroPeriodSiteFactors.Evaluate(0.1));
+      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(zeroPeriodSiteFactors.Evaluate(0.2));
+      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(zeroPeriodSiteFactors.Evaluate(0.3));
+      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(zeroPeriodSiteFactors.Evaluate(0.4));
+      (*pZeroPeriodTable)(row, col++) << table_value.SetValue(zeroPeriodSiteFactors.Evaluate(0.5));
       if (specType == WSDOT_BDM)
       {
-         (*pZeroPeriodTable)(row, col++) << table_value.SetValue(pZeroPeriodSiteFactors->Evaluate(0.6));
+         (*pZeroPeriodTable)(row, col++) << table_value.SetValue(zeroPeriodSiteFactors.Evaluate(0.6));
       }
 
       col = 0;
-      const mathPwLinearFunction2dUsingPoints* pShortPeriodSiteFactors = m_pDoc->GetShortPeriodSiteFactors(specType, thisSiteClass);
+      BEToolboxEngine::CSiteFactorCurve shortPeriodSiteFactors(m_pDoc->GetShortPeriodSiteFactors(specType, thisSiteClass));
       (*pShortPeriodTable)(row, col++) << strSiteClass[thisSiteClass];
-      (*pShortPeriodTable)(row, col++) << table_value.SetValue(pShortPeriodSiteFactors->Evaluate(0.25));
-      (*pShortPeriodTable)(row, col++) << table_value.SetValue(pShortPeriodSiteFactors->Evaluate(0.50));
-      (*pShortPeriodTable)(row, col++) << table_value.SetValue(pShortPeriodSiteFactors->Evaluate(0.75));
-      (*pShortPeriodTable)(row, col++) << table_value.SetValue(pShortPeriodSiteFactors->Evaluate(1.00));
-      (*pShortPeriodTable)(row, col++) << table_value.SetValue(pShortPeriodSiteFactors->Evaluate(1.25));
+      (*pShortPeriodTable)(row, col++) << table_value.SetValue(shortPeriodSiteFactors.Evaluate(0.25));
+      (*pShortPeriodTable)(row, col++) << table_value.SetValue(shortPeriodSiteFactors.Evaluate(0.50));
+      (*pShortPeriodTable)(row, col++) << table_value.SetValue(shortPeriodSiteFactors.Evaluate(0.75));
+      (*pShortPeriodTable)(row, col++) << table_value.SetValue(shortPeriodSiteFactors.Evaluate(1.00));
+      (*pShortPeriodTable)(row, col++) << table_value.SetValue(shortPeriodSiteFactors.Evaluate(1.25));
       if (specType == WSDOT_BDM)
       {
-         (*pShortPeriodTable)(row, col++) << table_value.SetValue(pShortPeriodSiteFactors->Evaluate(1.50));
+         (*pShortPeriodTable)(row, col++) << table_value.SetValue(shortPeriodSiteFactors.Evaluate(1.50));
       }
 
       col = 0;
-      const mathPwLinearFunction2dUsingPoints* pLongPeriodSiteFactors = m_pDoc->GetLongPeriodSiteFactors(specType, thisSiteClass);
+      BEToolboxEngine::CSiteFactorCurve longPeriodSiteFactors(m_pDoc->GetLongPeriodSiteFactors(specType, thisSiteClass));
       (*pLongPeriodTable)(row, col++) << strSiteClass[thisSiteClass];
-      (*pLongPeriodTable)(row, col++) << table_value.SetValue(pLongPeriodSiteFactors->Evaluate(0.1));
-      (*pLongPeriodTable)(row, col++) << table_value.SetValue(pLongPeriodSiteFactors->Evaluate(0.2));
-      (*pLongPeriodTable)(row, col++) << table_value.SetValue(pLongPeriodSiteFactors->Evaluate(0.3));
-      (*pLongPeriodTable)(row, col++) << table_value.SetValue(pLongPeriodSiteFactors->Evaluate(0.4));
-      (*pLongPeriodTable)(row, col++) << table_value.SetValue(pLongPeriodSiteFactors->Evaluate(0.5));
+      (*pLongPeriodTable)(row, col++) << table_value.SetValue(longPeriodSiteFactors.Evaluate(0.1));
+      (*pLongPeriodTable)(row, col++) << table_value.SetValue(longPeriodSiteFactors.Evaluate(0.2));
+      (*pLongPeriodTable)(row, col++) << table_value.SetValue(longPeriodSiteFactors.Evaluate(0.3));
+      (*pLongPeriodTable)(row, col++) << table_value.SetValue(longPeriodSiteFactors.Evaluate(0.4));
+      (*pLongPeriodTable)(row, col++) << table_value.SetValue(longPeriodSiteFactors.Evaluate(0.5));
       if (specType == WSDOT_BDM)
       {
-         (*pLongPeriodTable)(row, col++) << table_value.SetValue(pLongPeriodSiteFactors->Evaluate(0.6));
+         (*pLongPeriodTable)(row, col++) << table_value.SetValue(longPeriodSiteFactors.Evaluate(0.6));
       }
    }
    
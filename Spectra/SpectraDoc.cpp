@@ -34,7 +34,6 @@
 #include <EAF\EAFUtilities.h>
 #include <EAF\EAFApp.h>
 
-#include <WBFLGeometry.h>
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -68,7 +67,6 @@ CSpectraDoc::CSpectraDoc()
    m_Lng = -122.91888;
    m_SiteClass = scB;
 
-   m_pValues = nullptr;
 }
 
 CSpectraDoc::~CSpectraDoc()
@@ -114,448 +112,14 @@ BOOL CSpectraDoc::Init()
    if ( !LoadSpectralData() )
       return FALSE;
 
-   InitWSDOT();
-   InitLRFD();
-   InitGuideSpec();
-
    return TRUE;
 }
 
-void CSpectraDoc::InitWSDOT()
-{
-   // Zero Period Site Factors (Fpga) - BDM Table 3.4.2.3-1A
-   {
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.1, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.2,0.8);
-      //siteA->AddPoint(0.3,0.8);
-      //siteA->AddPoint(0.4,0.8);
-      //siteA->AddPoint(0.5,0.8);
-      //siteA->AddPoint(0.6,0.8);
-      m_ZeroPeriodSiteFactors[WSDOT_BDM].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.1, 0.9);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.2,0.9);
-      //siteB->AddPoint(0.3,0.9);
-      //siteB->AddPoint(0.4,0.9);
-      //siteB->AddPoint(0.5,0.9);
-      //siteB->AddPoint(0.6,0.9);
-      m_ZeroPeriodSiteFactors[WSDOT_BDM].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.1, 1.3);
-      siteC->AddPoint(0.2, 1.2);
-      siteC->AddPoint(0.3, 1.2);
-      siteC->AddPoint(0.4, 1.2);
-      siteC->AddPoint(0.5, 1.2);
-      siteC->AddPoint(0.6, 1.2);
-      m_ZeroPeriodSiteFactors[WSDOT_BDM].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.1, 1.6);
-      siteD->AddPoint(0.2, 1.4);
-      siteD->AddPoint(0.3, 1.3);
-      siteD->AddPoint(0.4, 1.2);
-      siteD->AddPoint(0.5, 1.1);
-      siteD->AddPoint(0.6, 1.1);
-      m_ZeroPeriodSiteFactors[WSDOT_BDM].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.1, 2.4);
-      siteE->AddPoint(0.2, 1.9);
-      siteE->AddPoint(0.3, 1.6);
-      siteE->AddPoint(0.4, 1.4);
-      siteE->AddPoint(0.5, 1.2);
-      siteE->AddPoint(0.6, 1.1);
-      m_ZeroPeriodSiteFactors[WSDOT_BDM].push_back(siteE);
-   }
-
-   {
-      // Short Period Site Factors (Fa for 0.2 sec period spectral acceleration) - BDM Table 3.4.2.3-1B
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.25, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.50,0.8);
-      //siteA->AddPoint(0.75,0.8);
-      //siteA->AddPoint(1.00,0.8);
-      //siteA->AddPoint(1.25,0.8);
-      //siteA->AddPoint(1.50,0.8);
-      m_ShortPeriodSiteFactors[WSDOT_BDM].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.25, 0.9);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.50,0.9);
-      //siteB->AddPoint(0.75,0.9);
-      //siteB->AddPoint(0.90,0.9);
-      //siteB->AddPoint(1.25,0.9);
-      //siteB->AddPoint(1.50,0.9);
-      m_ShortPeriodSiteFactors[WSDOT_BDM].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.25, 1.3);
-      siteC->AddPoint(0.50, 1.3);
-      siteC->AddPoint(0.75, 1.2);
-      siteC->AddPoint(1.00, 1.2);
-      siteC->AddPoint(1.25, 1.2);
-      siteC->AddPoint(1.50, 1.2);
-      m_ShortPeriodSiteFactors[WSDOT_BDM].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.25, 1.6);
-      siteD->AddPoint(0.50, 1.4);
-      siteD->AddPoint(0.75, 1.2);
-      siteD->AddPoint(1.00, 1.1);
-      siteD->AddPoint(1.25, 1.0);
-      siteD->AddPoint(1.50, 1.0);
-      m_ShortPeriodSiteFactors[WSDOT_BDM].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.25, 2.4);
-      siteE->AddPoint(0.50, 1.7);
-      siteE->AddPoint(0.75, 1.3);
-      siteE->AddPoint(1.00, 1.0);
-      siteE->AddPoint(1.25, 0.9);
-      siteE->AddPoint(1.50, 0.9);
-      m_ShortPeriodSiteFactors[WSDOT_BDM].push_back(siteE);
-   }
-
-   {
-      // Long Period Site Factors (Fv for 1.0 sec period spectral acceleration) - BDM Table 3.4.2.3.2
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.1, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.2,0.8);
-      //siteA->AddPoint(0.3,0.8);
-      //siteA->AddPoint(0.4,0.8);
-      //siteA->AddPoint(0.5,0.8);
-      //siteA->AddPoint(0.6,0.8);
-      m_LongPeriodSiteFactors[WSDOT_BDM].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.1, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.2,0.8);
-      //siteB->AddPoint(0.3,0.8);
-      //siteB->AddPoint(0.4,0.8);
-      //siteB->AddPoint(0.5,0.8);
-      //siteB->AddPoint(0.6,0.8);
-      m_LongPeriodSiteFactors[WSDOT_BDM].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.1, 1.5);
-      //siteC->AddPoint(0.2,1.5);
-      //siteC->AddPoint(0.3,1.5);
-      //siteC->AddPoint(0.4,1.5);
-      siteC->AddPoint(0.5, 1.5);
-      siteC->AddPoint(0.6, 1.4);
-      m_LongPeriodSiteFactors[WSDOT_BDM].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.1, 2.4);
-      siteD->AddPoint(0.2, 2.2);
-      siteD->AddPoint(0.3, 2.0);
-      siteD->AddPoint(0.4, 1.9);
-      siteD->AddPoint(0.5, 1.8);
-      siteD->AddPoint(0.6, 1.7);
-      m_LongPeriodSiteFactors[WSDOT_BDM].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.1, 4.2);
-      siteE->AddPoint(0.2, 3.3);
-      siteE->AddPoint(0.3, 2.8);
-      siteE->AddPoint(0.4, 2.4);
-      siteE->AddPoint(0.5, 2.2);
-      siteE->AddPoint(0.6, 2.0);
-      m_LongPeriodSiteFactors[WSDOT_BDM].push_back(siteE);
-   }
-}
-
-void CSpectraDoc::InitLRFD()
-{
-   // Zero Period Site Factors (Fpga) - Table 3.4.2.3-1
-   {
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.1, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.2,0.8);
-      //siteA->AddPoint(0.3,0.8);
-      //siteA->AddPoint(0.4,0.8);
-      //siteA->AddPoint(0.5,0.8);
-      m_ZeroPeriodSiteFactors[AASHTO_LRFD].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.1, 1.0);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.2,1.0);
-      //siteB->AddPoint(0.3,1.0);
-      //siteB->AddPoint(0.4,1.0);
-      //siteB->AddPoint(0.5,1.0);
-      m_ZeroPeriodSiteFactors[AASHTO_LRFD].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.1, 1.2);
-      siteC->AddPoint(0.2, 1.2);
-      siteC->AddPoint(0.3, 1.1);
-      siteC->AddPoint(0.4, 1.0);
-      siteC->AddPoint(0.5, 1.0);
-      m_ZeroPeriodSiteFactors[AASHTO_LRFD].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.1, 1.6);
-      siteD->AddPoint(0.2, 1.4);
-      siteD->AddPoint(0.3, 1.2);
-      siteD->AddPoint(0.4, 1.1);
-      siteD->AddPoint(0.5, 1.0);
-      m_ZeroPeriodSiteFactors[AASHTO_LRFD].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.1, 2.5);
-      siteE->AddPoint(0.2, 1.7);
-      siteE->AddPoint(0.3, 1.2);
-      siteE->AddPoint(0.4, 0.9);
-      siteE->AddPoint(0.5, 0.9);
-      m_ZeroPeriodSiteFactors[AASHTO_LRFD].push_back(siteE);
-   }
-
-   {
-      // Short Period Site Factors (Fa for 0.2 sec period spectral acceleration) - Table 3.4.2.3-1
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.25, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.50,0.8);
-      //siteA->AddPoint(0.75,0.8);
-      //siteA->AddPoint(1.00,0.8);
-      //siteA->AddPoint(1.25,0.8);
-      m_ShortPeriodSiteFactors[AASHTO_LRFD].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.25, 1.0);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.50,1.0);
-      //siteB->AddPoint(0.75,1.0);
-      //siteB->AddPoint(0.90,1.0);
-      //siteB->AddPoint(1.25,1.0);
-      m_ShortPeriodSiteFactors[AASHTO_LRFD].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.25, 1.2);
-      siteC->AddPoint(0.50, 1.2);
-      siteC->AddPoint(0.75, 1.1);
-      siteC->AddPoint(1.00, 1.0);
-      siteC->AddPoint(1.25, 1.0);
-      m_ShortPeriodSiteFactors[AASHTO_LRFD].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.25, 1.6);
-      siteD->AddPoint(0.50, 1.4);
-      siteD->AddPoint(0.75, 1.2);
-      siteD->AddPoint(1.00, 1.1);
-      siteD->AddPoint(1.25, 1.0);
-      m_ShortPeriodSiteFactors[AASHTO_LRFD].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.25, 2.5);
-      siteE->AddPoint(0.50, 1.7);
-      siteE->AddPoint(0.75, 1.2);
-      siteE->AddPoint(1.00, 0.9);
-      siteE->AddPoint(1.25, 0.9);
-      m_ShortPeriodSiteFactors[AASHTO_LRFD].push_back(siteE);
-   }
-
-   {
-      // Long Period Site Factors (Fv for 1.0 sec period spectral acceleration) - Table 3.10.3.2-3
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.1, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.2,0.8);
-      //siteA->AddPoint(0.3,0.8);
-      //siteA->AddPoint(0.4,0.8);
-      //siteA->AddPoint(0.5,0.8);
-      m_LongPeriodSiteFactors[AASHTO_LRFD].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.1, 1.0);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.2,1.0;
-      //siteB->AddPoint(0.3,1.0);
-      //siteB->AddPoint(0.4,1.0);
-      //siteB->AddPoint(0.5,1.0);
-      m_LongPeriodSiteFactors[AASHTO_LRFD].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.1,1.7);
-      siteC->AddPoint(0.2,1.6);
-      siteC->AddPoint(0.3,1.5);
-      siteC->AddPoint(0.4,1.4);
-      siteC->AddPoint(0.5,1.3);
-      m_LongPeriodSiteFactors[AASHTO_LRFD].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.1, 2.4);
-      siteD->AddPoint(0.2, 2.0);
-      siteD->AddPoint(0.3, 1.8);
-      siteD->AddPoint(0.4, 1.6);
-      siteD->AddPoint(0.5, 1.5);
-      m_LongPeriodSiteFactors[AASHTO_LRFD].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.1, 3.5);
-      siteE->AddPoint(0.2, 3.2);
-      siteE->AddPoint(0.3, 2.8);
-      siteE->AddPoint(0.4, 2.4);
-      siteE->AddPoint(0.5, 2.4);
-      m_LongPeriodSiteFactors[AASHTO_LRFD].push_back(siteE);
-   }
-}
-
-void CSpectraDoc::InitGuideSpec()
-{
-   // Zero Period Site Factors (Fpga) - Table 3.4.2.3-1
-   {
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.1, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.2,0.8);
-      //siteA->AddPoint(0.3,0.8);
-      //siteA->AddPoint(0.4,0.8);
-      //siteA->AddPoint(0.5,0.8);
-      m_ZeroPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.1, 1.0);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.2,1.0);
-      //siteB->AddPoint(0.3,1.0);
-      //siteB->AddPoint(0.4,1.0);
-      //siteB->AddPoint(0.5,1.0);
-      m_ZeroPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.1, 1.2);
-      siteC->AddPoint(0.2, 1.2);
-      siteC->AddPoint(0.3, 1.1);
-      siteC->AddPoint(0.4, 1.0);
-      siteC->AddPoint(0.5, 1.0);
-      m_ZeroPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.1, 1.6);
-      siteD->AddPoint(0.2, 1.4);
-      siteD->AddPoint(0.3, 1.2);
-      siteD->AddPoint(0.4, 1.1);
-      siteD->AddPoint(0.5, 1.0);
-      m_ZeroPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.1, 2.5);
-      siteE->AddPoint(0.2, 1.7);
-      siteE->AddPoint(0.3, 1.2);
-      siteE->AddPoint(0.4, 0.9);
-      siteE->AddPoint(0.5, 0.9);
-      m_ZeroPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteE);
-   }
-
-   {
-      // Short Period Site Factors (Fa for 0.2 sec period spectral acceleration) - Table 3.4.2.3-1
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.25, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.50,0.8);
-      //siteA->AddPoint(0.75,0.8);
-      //siteA->AddPoint(1.00,0.8);
-      //siteA->AddPoint(1.25,0.8);
-      m_ShortPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.25, 1.0);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.50,1.0);
-      //siteB->AddPoint(0.75,1.0);
-      //siteB->AddPoint(0.90,1.0);
-      //siteB->AddPoint(1.25,1.0);
-      m_ShortPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.25, 1.2);
-      siteC->AddPoint(0.50, 1.2);
-      siteC->AddPoint(0.75, 1.1);
-      siteC->AddPoint(1.00, 1.0);
-      siteC->AddPoint(1.25, 1.0);
-      m_ShortPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.25, 1.6);
-      siteD->AddPoint(0.50, 1.4);
-      siteD->AddPoint(0.75, 1.2);
-      siteD->AddPoint(1.00, 1.1);
-      siteD->AddPoint(1.25, 1.0);
-      m_ShortPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.25, 2.5);
-      siteE->AddPoint(0.50, 1.7);
-      siteE->AddPoint(0.75, 1.2);
-      siteE->AddPoint(1.00, 0.9);
-      siteE->AddPoint(1.25, 0.9);
-      m_ShortPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteE);
-   }
-
-   {
-      // Long Period Site Factors (Fv for 1.0 sec period spectral acceleration) - Table 3.4.2.3-2
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteA(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteA->AddPoint(0.1, 0.8);
-      // all points are the same so we don't actually need to add them
-      //siteA->AddPoint(0.2,0.8);
-      //siteA->AddPoint(0.3,0.8);
-      //siteA->AddPoint(0.4,0.8);
-      //siteA->AddPoint(0.5,0.8);
-      m_LongPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteA);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteB(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteB->AddPoint(0.1, 1.0);
-      // all points are the same so we don't actually need to add them
-      //siteB->AddPoint(0.2,1.0;
-      //siteB->AddPoint(0.3,1.0);
-      //siteB->AddPoint(0.4,1.0);
-      //siteB->AddPoint(0.5,1.0);
-      m_LongPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteB);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteC(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteC->AddPoint(0.1, 1.7);
-      siteC->AddPoint(0.2, 1.6);
-      siteC->AddPoint(0.3, 1.5);
-      siteC->AddPoint(0.4, 1.4);
-      siteC->AddPoint(0.5, 1.3);
-      m_LongPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteC);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteD(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteD->AddPoint(0.1, 2.4);
-      siteD->AddPoint(0.2, 2.0);
-      siteD->AddPoint(0.3, 1.8);
-      siteD->AddPoint(0.4, 1.6);
-      siteD->AddPoint(0.5, 1.5);
-      m_LongPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteD);
-
-      std::shared_ptr<mathPwLinearFunction2dUsingPoints> siteE(std::make_shared<mathPwLinearFunction2dUsingPoints>());
-      siteE->AddPoint(0.1, 3.5);
-      siteE->AddPoint(0.2, 3.2);
-      siteE->AddPoint(0.3, 2.8);
-      siteE->AddPoint(0.4, 2.4);
-      siteE->AddPoint(0.5, 2.4);
-      m_LongPeriodSiteFactors[AASHTO_SEISMIC].push_back(siteE);
-   }
-}
-
 void CSpectraDoc::OnCloseDocument()
 {
    EAFGetApp()->SetUnitsMode(eafTypes::umUS);
    
-   delete[] m_pValues;
-   m_pValues = nullptr;
+   m_Values.clear();
 
    CBEToolboxDoc::OnCloseDocument();
 }
@@ -688,16 +252,14 @@ CString CSpectraDoc::GetResourcePath()
 
 bool CSpectraDoc::LoadSpectralData()
 {
-   m_pValues = new SpectralValues[SPECTRAL_VALUE_COUNT];
    std::_tstring strResourceFile = GetResourcePath() + _T("us_hazard_7pc75.2014.bin");
    std::ifstream ifile(strResourceFile.c_str(),std::ios::binary);
-   if ( ifile.bad() || ifile.fail() )
+   if ( ifile.bad() || ifile.fail() || !BEToolboxEngine::ReadHazardGrid(ifile,m_Values) )
    {
       AFX_MANAGE_STATE(AfxGetStaticModuleState());
       AfxMessageBox(_T("Failed to load seismic hazard map data."),MB_OK | MB_ICONSTOP);
       return false;
    }
-   ifile.read(reinterpret_cast<char*>(m_pValues),SPECTRAL_VALUE_COUNT*sizeof(SpectralValues));
    ifile.close();
    return true;
 }
@@ -822,32 +384,28 @@ Uint32 CSpectraDoc::GetResponseSpectra(SpecificationType specType,Float64 lat,Fl
 
 void CSpectraDoc::GetSpectralValues(Float64 lat,Float64 lng,Float64* pS1,Float64* pSs,Float64* pPGA) const
 {
-   ::GetSpectralValues(lat,lng,m_pValues,pS1,pSs,pPGA);
+   ::GetSpectralValues(lat,lng,m_Values.data(),pS1,pSs,pPGA);
 }
 
 Uint32 CSpectraDoc::GetSiteFactors(SpecificationType specType, Float64 S1,Float64 Ss,Float64 PGA,SiteClass siteClass,Float64* pFa,Float64* pFv,Float64* pFpga) const
 {
-   if ( siteClass == scF && 0.75 < Ss )
+   if ( !BEToolboxEngine::GetSiteFactors(specType,S1,Ss,PGA,siteClass,pFa,pFv,pFpga) )
       return SPECTRA_SITE_SPECIFIC;
 
-   *pFpga = m_ZeroPeriodSiteFactors[specType][siteClass]->Evaluate(PGA);
-   *pFa   = m_ShortPeriodSiteFactors[specType][siteClass]->Evaluate(Ss);
-   *pFv   = m_LongPeriodSiteFactors[specType][siteClass]->Evaluate(S1);
-
    return SPECTRA_OK;
 }
 
-const mathPwLinearFunction2dUsingPoints* CSpectraDoc::GetZeroPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const
+BEToolboxEngine::CSiteFactorCurve CSpectraDoc::GetZeroPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const
 {
-   return m_ZeroPeriodSiteFactors[specType][siteClass].get();
+   return BEToolboxEngine::GetSiteFactorCurve(specType,BEToolboxEngine::sfZeroPeriod,siteClass);
 }
 
-const mathPwLinearFunction2dUsingPoints* CSpectraDoc::GetShortPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const
+BEToolboxEngine::CSiteFactorCurve CSpectraDoc::GetShortPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const
 {
-   return m_ShortPeriodSiteFactors[specType][siteClass].get();
+   return BEToolboxEngine::GetSiteFactorCurve(specType,BEToolboxEngine::sfShortPeriod,siteClass);
 }
 
-const mathPwLinearFunction2dUsingPoints* CSpectraDoc::GetLongPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const
+BEToolboxEngine::CSiteFactorCurve CSpectraDoc::GetLongPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const
 {
-   return m_LongPeriodSiteFactors[specType][siteClass].get();
+   return BEToolboxEngine::GetSiteFactorCurve(specType,BEToolboxEngine::sfLongPeriod,siteClass);
 }
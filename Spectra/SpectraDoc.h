@@ -28,7 +28,6 @@
 #include <WBFLUnitServer.h>
 #include <ReportManager\ReportManager.h>
 #include "ResponseSpectra.h"
-#include <Math\PwLinearFunction2dUsingPoints.h>
 
 class CSpectraDoc : public CBEToolboxDoc
 {
@@ -51,10 +50,6 @@ protected:
    /// called when a document is created (New or Open)
    virtual BOOL Init(); 
 
-   void InitWSDOT();
-   void InitLRFD();
-   void InitGuideSpec();
-
    // Called by the framework when the document is to be loaded and saved
    virtual HRESULT WriteTheDocument(IStructuredSave* pStrSave) override;
    virtual HRESULT LoadTheDocument(IStructuredLoad* pStrLoad) override;
@@ -75,10 +70,7 @@ protected:
    Float64 m_Lat, m_Lng;
    SiteClass m_SiteClass;
 
-   SpectralValues* m_pValues;
-   std::vector<std::shared_ptr<mathPwLinearFunction2dUsingPoints>> m_ZeroPeriodSiteFactors[nSpecTypes];
-   std::vector<std::shared_ptr<mathPwLinearFunction2dUsingPoints>> m_ShortPeriodSiteFactors[nSpecTypes];
-   std::vector<std::shared_ptr<mathPwLinearFunction2dUsingPoints>> m_LongPeriodSiteFactors[nSpecTypes];
+   std::vector<SpectralValues> m_Values;
 
 public:
    void SetSpecification(SpecificationType specType);
@@ -92,9 +84,9 @@ public:
    LPCTSTR GetSpectraResultExplaination(Uint32 result) const;
    Uint32 GetResponseSpectra(SpecificationType specType, Float64 lat,Float64 lng,SiteClass siteClass,CResponseSpectra* pSpectra) const;
 
-   const mathPwLinearFunction2dUsingPoints* GetZeroPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const;
-   const mathPwLinearFunction2dUsingPoints* GetShortPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const;
-   const mathPwLinearFunction2dUsingPoints* GetLongPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const;
+   BEToolboxEngine::CSiteFactorCurve GetZeroPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const;
+   BEToolboxEngine::CSiteFactorCurve GetShortPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const;
+   BEToolboxEngine::CSiteFactorCurve GetLongPeriodSiteFactors(SpecificationType specType, SiteClass siteClass) const;
 
    virtual void OnCloseDocument() override;
 
@@ -22,52 +22,43 @@
 
 #pragma once
 
-#include <math.h>
+// The hazard grid and the site factors are part of the portable engine
+// (see Engine\HazardGrid.h and Engine\ResponseSpectra.h)
+#include "..\Engine\HazardGrid.h"
+#include "..\Engine\ResponseSpectra.h"
 
-#define MIN_LATITUDE 24.6
-#define MAX_LATITUDE 50.0
-#define INC_LATITUDE 0.05
+#define MIN_LATITUDE BEToolboxEngine::HazardGridMinLatitude
+#define MAX_LATITUDE BEToolboxEngine::HazardGridMaxLatitude
+#define INC_LATITUDE BEToolboxEngine::HazardGridIncrement
 
-#define MIN_LONGITUDE -125.0
-#define MAX_LONGITUDE -65.0
-#define INC_LONGITUDE 0.05
+#define MIN_LONGITUDE BEToolboxEngine::HazardGridMinLongitude
+#define MAX_LONGITUDE BEToolboxEngine::HazardGridMaxLongitude
+#define INC_LONGITUDE BEToolboxEngine::HazardGridIncrement
 
-#define RANGE_LATITUDE 509 //((long)ceil(MAX_LATITUDE-MIN_LATITUDE)/INC_LATITUDE)+1)
-#define RANGE_LONGITUDE 1201 // ((long)ceil(MAX_LONGITUDE-MIN_LONGITUDE)/INC_LONGITUDE)+1)
+#define RANGE_LATITUDE BEToolboxEngine::HazardGridRows
+#define RANGE_LONGITUDE BEToolboxEngine::HazardGridColumns
 
-#define SPECTRAL_VALUE_COUNT 611309 //RANGE_LATITUDE*RANGE_LONGITUDE
+#define SPECTRAL_VALUE_COUNT BEToolboxEngine::HazardGridPointCount
 
 #define SPECTRUM_MAX_PERIOD 4.0 // report spectrum duration
 #define SPECTRUM_STEP_SIZE  0.2 // report spectrum data step size
 
+using BEToolboxEngine::SpecificationType;
+using BEToolboxEngine::WSDOT_BDM;
+using BEToolboxEngine::AASHTO_LRFD;
+using BEToolboxEngine::AASHTO_SEISMIC;
+using BEToolboxEngine::nSpecTypes;
 
-typedef enum SpecificationType
-{
-   WSDOT_BDM = 0, // WSDOT Bridge Design Manual
-   AASHTO_LRFD = 1, // AASHTO LRFD Bridge Design Specifications, 8th Edition
-   AASHTO_SEISMIC = 2, // AASHTO Guide Specifications for LRFD Seismic Bridge Design, 2nd Edition, 2011
-   nSpecTypes = 3  // this is always last
-} SpecificationType;
+using BEToolboxEngine::SiteClass;
+using BEToolboxEngine::scA;
+using BEToolboxEngine::scB;
+using BEToolboxEngine::scC;
+using BEToolboxEngine::scD;
+using BEToolboxEngine::scE;
+using BEToolboxEngine::scF;
+using BEToolboxEngine::nSiteClasses;
 
-typedef enum SiteClass
-{
-   scA,
-   scB,
-   scC,
-   scD,
-   scE,
-   scF,
-   nSiteClasses
-} SiteClass;
-
-typedef struct SpectralValues
-{
-   Float64 lng;
-   Float64 lat;
-   Float64 v1hz;
-   Float64 v5hz;
-   Float64 vpga;
-} SpectralValues;
+using BEToolboxEngine::SpectralValues;
 
 // returns the four indices into the spectral value vector that represent
 // the four corners of the grid that surround lat,lng
@@ -84,4 +75,3 @@ void GetSpectralValueIndies(Float64 lat,Float64 lng,long* i1,long* i2,long* i3,l
 
 // returns the spectra values for a specified lat/lng
 void GetSpectralValues(Float64 lat,Float64 lng,SpectralValues* pValues,Float64* pS1,Float64* pSs,Float64* pPGA);
-
@@ -54,6 +54,7 @@
 #include ".\PGStable\PGStableDoc.h"
 #include ".\PGStable\PGStableTabView.h"
 #include ".\PGStable\PGStableChildFrame.h"
+#include ".\PGStable\PGStableLibraryCache.h"
 
 #include ".\Spectra\SpectraDocTemplate.h"
 #include ".\Spectra\SpectraDoc.h"
@@ -122,6 +123,13 @@ class CPGStableTool : public CToolImpl<CPGStableTool, &CLSID_PGStableTool, IDR_P
 {
 public:
    virtual CString GetName() const override { return _T("PGStable"); }
+
+   // start loading the PGSuper master library in the background so it is ready for the first document
+   virtual BOOL Init(CEAFApp* pParent) override
+   {  CPGStableLibraryCache::GetInstance().Preload(); return TRUE; }
+
+   virtual void Terminate() override
+   {  CPGStableLibraryCache::GetInstance().Clear(); }
 };
 OBJECT_ENTRY_AUTO(CLSID_PGStableTool, CPGStableTool)
 
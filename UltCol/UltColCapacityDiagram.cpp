@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "UltColCapacityDiagram.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+CUltColCapacityDiagram::CUltColCapacityDiagram()
+{
+}
+
+void CUltColCapacityDiagram::Init(const std::vector<ULTCOLINTERACTIONPOINT>& points)
+{
+   m_Angle.clear();
+   m_P.clear();
+   m_M.clear();
+
+   m_Angle.reserve(points.size());
+   m_P.reserve(points.size());
+   m_M.reserve(points.size());
+
+   for ( const auto& point : points )
+   {
+      Float64 P = -point.Pr; // compression positive
+      Float64 M = fabs(point.Mr);
+      Float64 angle = atan2(M,P);
+
+      // Skip vertices that fold back on the previous vertices so the angles are strictly
+      // increasing. This only happens if the diagram isn't star-shaped about the origin.
+      ATLASSERT(m_Angle.empty() || m_Angle.back() <= angle);
+      if ( !m_Angle.empty() && angle <= m_Angle.back() )
+      {
+         continue;
+      }
+
+      m_Angle.push_back(angle);
+      m_P.push_back(P);
+      m_M.push_back(M);
+   }
+}
+
+Float64 CUltColCapacityDiagram::GetCapacityRatio(Float64 Pu,Float64 Mu,Float64* pPr,Float64* pMr) const
+{
+   ATLASSERT(2 <= m_Angle.size());
+
+   Mu = fabs(Mu);
+   Float64 D = sqrt(Pu*Pu + Mu*Mu);
+   if ( IsZero(D) )
+   {
+      if ( pPr ) *pPr = 0;
+      if ( pMr ) *pMr = 0;
+      return 0;
+   }
+
+   Float64 angle = atan2(Mu,Pu);
+
+   // find the edge (i-1,i) that contains the ray through the demand
+   auto found = std::upper_bound(m_Angle.cbegin(),m_Angle.cend(),angle);
+   IndexType i = std::distance(m_Angle.cbegin(),found);
+   i = Max((IndexType)1,Min(i,m_Angle.size()-1));
+
+   Float64 Pa = m_P[i-1], Ma = m_M[i-1];
+   Float64 Pb = m_P[i],   Mb = m_M[i];
+
+   // intersect the ray t(Mu,Pu)/D with the edge a + s(b-a)
+   Float64 dM = Mb - Ma;
+   Float64 dP = Pb - Pa;
+   Float64 uM = Mu/D;
+   Float64 uP = Pu/D;
+   Float64 denominator = uM*dP - uP*dM;
+   Float64 t;
+   if ( IsZero(denominator) )
+   {
+      // the edge is parallel to the ray... use the closer vertex
+      t = Min(sqrt(Pa*Pa + Ma*Ma),sqrt(Pb*Pb + Mb*Mb));
+   }
+   else
+   {
+      t = (Ma*dP - Pa*dM)/denominator;
+   }
+
+   if ( pPr ) *pPr = t*uP;
+   if ( pMr ) *pMr = t*uM;
+
+   return (t <= 0 ? Float64_Max : D/t);
+}
+
+bool CUltColCapacityDiagram::IsInside(Float64 Pu,Float64 Mu) const
+{
+   return GetCapacityRatio(Pu,Mu) <= 1.0;
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "UltColFiberSection.h"
+
+// The factored interaction diagram as a closed polygon for checking load case demands.
+// Axial force is compression positive in this class (the sense used in the report).
+//
+// The vertices are indexed by their angle from the compression axis, measured about the origin.
+// The diagram is star-shaped about the origin (every convex diagram that encloses the origin is)
+// so the angle increases monotonically from pure compression to pure tension. A demand is checked
+// by finding the edge its ray crosses with a binary search of the angles, which is O(log n).
+class CUltColCapacityDiagram
+{
+public:
+   CUltColCapacityDiagram();
+
+   // Builds the diagram from the factored capacities of an interaction diagram computed from
+   // pure compression to pure tension. The diagram is symmetric so moments are taken as positive.
+   void Init(const std::vector<ULTCOLINTERACTIONPOINT>& points);
+
+   // Returns the capacity ratio of a demand. The capacity ratio is the distance from the origin to the
+   // demand divided by the distance from the origin to the diagram along the same ray. The demand
+   // is inside the diagram when the ratio is not more than 1.0. If pPr and pMr are not nullptr,
+   // they receive the capacity on the ray through the demand.
+   Float64 GetCapacityRatio(Float64 Pu,Float64 Mu,Float64* pPr = nullptr,Float64* pMr = nullptr) const;
+
+   bool IsInside(Float64 Pu,Float64 Mu) const;
+
+private:
+   std::vector<Float64> m_Angle; // radial angle index, ascending
+   std::vector<Float64> m_P;
+   std::vector<Float64> m_M;
+};
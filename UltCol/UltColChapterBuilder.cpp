@@ -22,9 +22,13 @@
 
 #include "stdafx.h"
 #include "UltColChapterBuilder.h"
+#include "UltColCapacityDiagram.h"
+#include "UltColInteractionSurface.h"
+#include "UltColSchedule.h"
 #include "..\BEToolboxColors.h"
 #include <Reporter\Reporter.h>
 #include <GraphicsLib\GraphicsLib.h>
+#include <cmath>
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -97,10 +101,30 @@ rptChapter* CUltColChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
    ecl = m_pDoc->m_ecl;
    etl = m_pDoc->m_etl;
 
-   (*pLayoutTable)(0,1) << _T("Diameter = ") << length.SetValue(diameter) << rptNewLine;
-   (*pLayoutTable)(0,1) << Sub2(_T("f'"),_T("c")) << _T(" = ") << stress.SetValue(fc) << rptNewLine;
-   (*pLayoutTable)(0,1) << _T("Cover = ") << length.SetValue(cover) << rptNewLine;
-   (*pLayoutTable)(0,1) << Sub2(_T("A"),_T("s")) << _T(" = ") << area.SetValue(As) << rptNewLine;
+   bool bRectangular = (m_pDoc->m_Shape == CUltColDoc::Rectangular);
+   if ( bRectangular )
+   {
+      bool bHollow = (0 < m_pDoc->m_WallThickness);
+      IndexType nBars = 2*(m_pDoc->m_nBarsX + m_pDoc->m_nBarsY) - 4;
+      (*pLayoutTable)(0,1) << (bHollow ? _T("Hollow Rectangular Column") : _T("Rectangular Column")) << rptNewLine;
+      (*pLayoutTable)(0,1) << _T("Width = ") << length.SetValue(m_pDoc->m_Width) << rptNewLine;
+      (*pLayoutTable)(0,1) << _T("Depth = ") << length.SetValue(m_pDoc->m_Depth) << rptNewLine;
+      if ( bHollow )
+      {
+         (*pLayoutTable)(0,1) << _T("Wall Thickness = ") << length.SetValue(m_pDoc->m_WallThickness) << rptNewLine;
+      }
+      (*pLayoutTable)(0,1) << Sub2(_T("f'"),_T("c")) << _T(" = ") << stress.SetValue(fc) << rptNewLine;
+      (*pLayoutTable)(0,1) << _T("Cover = ") << length.SetValue(cover) << rptNewLine;
+      (*pLayoutTable)(0,1) << nBars << _T(" bars, ") << m_pDoc->m_nBarsX << _T(" on faces parallel to the width and ") << m_pDoc->m_nBarsY << _T(" on faces parallel to the depth") << rptNewLine;
+      (*pLayoutTable)(0,1) << Sub2(_T("A"),_T("s")) << _T(" = ") << area.SetValue(As) << _T(", ") << Sub2(_T("A"),_T("b")) << _T(" = ") << area.SetValue(As/nBars) << rptNewLine;
+   }
+   else
+   {
+      (*pLayoutTable)(0,1) << _T("Diameter = ") << length.SetValue(diameter) << rptNewLine;
+      (*pLayoutTable)(0,1) << Sub2(_T("f'"),_T("c")) << _T(" = ") << stress.SetValue(fc) << rptNewLine;
+      (*pLayoutTable)(0,1) << _T("Cover = ") << length.SetValue(cover) << rptNewLine;
+      (*pLayoutTable)(0,1) << Sub2(_T("A"),_T("s")) << _T(" = ") << area.SetValue(As) << rptNewLine;
+   }
    (*pLayoutTable)(0,1) << Sub2(_T("E"),_T("s")) << _T(" = ") << modE.SetValue(Es) << rptNewLine;
    (*pLayoutTable)(0,1) << Sub2(_T("f"),_T("y")) << _T(" = ") << stress.SetValue(fy) << rptNewLine;
    (*pLayoutTable)(0,1) << Sub2(symbol(epsilon),_T("cl")) << _T(" = ") << ecl << rptNewLine;
@@ -112,19 +136,74 @@ rptChapter* CUltColChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
    //
    // DO THE COLUMN ANALYSIS
    //
-   CComPtr<IPoint2dCollection> unfactored, factored;
-   m_pDoc->m_Column->ComputeInteractionEx(35,ecl,etl,&unfactored,&factored);
+   CUltColFiberSection section;
+   m_pDoc->InitFiberSection(&section);
 
-   (*pLayoutTable)(0,1) << CreateImage(unfactored,factored);
+   // bending about the x-axis (neutral axis parallel to the x-axis)
+   std::vector<ULTCOLINTERACTIONPOINT> points;
+   section.ComputeInteraction(0.0,ecl,etl,0.001,500,points);
+
+#if defined _DEBUG
+   if ( !bRectangular )
+   {
+      // the native fiber section must match the WBFL RoundColumn
+      CComPtr<IPoint2dCollection> unfactored, factored;
+      m_pDoc->m_Column->ComputeInteractionEx(35,ecl,etl,&unfactored,&factored);
+      AssertInteraction(points,unfactored);
+   }
+#endif
+
+   if ( bRectangular )
+   {
+      (*pLayoutTable)(0,0) << Bold(_T("Bending about the X axis")) << rptNewLine;
+   }
+   (*pLayoutTable)(0,1) << CreateImage(points,bRectangular ? _T("Interaction Diagram - Bending about the X Axis") : _T("Interaction Diagram"));
+   (*pLayoutTable)(0,0) << CreateInteractionTable(points);
+
+   if ( bRectangular )
+   {
+      // bending about the y-axis
+      std::vector<ULTCOLINTERACTIONPOINT> pointsY;
+      section.ComputeInteraction(M_PI/2,ecl,etl,0.001,500,pointsY);
+
+      pPara = new rptParagraph;
+      (*pChapter) << pPara;
+
+      pLayoutTable = rptStyleManager::CreateLayoutTable(2);
+      (*pPara) << pLayoutTable;
+
+      (*pLayoutTable)(0,0) << Bold(_T("Bending about the Y axis")) << rptNewLine;
+      (*pLayoutTable)(0,0) << CreateInteractionTable(pointsY);
+      (*pLayoutTable)(0,1) << CreateImage(pointsY,_T("Interaction Diagram - Bending about the Y Axis"));
+   }
+
+   if ( !m_pDoc->m_LoadCases.empty() )
+   {
+      ReportLoadCases(pChapter,section,points);
+   }
+
+   if ( !m_pDoc->m_AxialLoads.empty() )
+   {
+      ReportMomentCurvature(pChapter,section);
+   }
+
+   if ( !m_pDoc->m_Schedule.empty() )
+   {
+      ReportSchedule(pChapter);
+   }
+
+   return pChapter;
+}
+
+rptRcTable* CUltColChapterBuilder::CreateInteractionTable(const std::vector<ULTCOLINTERACTIONPOINT>& points) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
 
-   //
-   // Create the table
-   //
    INIT_UV_PROTOTYPE( rptForceUnitValue,  axial,  pDispUnits->GeneralForce, false);
    INIT_UV_PROTOTYPE( rptMomentUnitValue, moment, pDispUnits->Moment,  false);
 
    rptRcTable* pTable = rptStyleManager::CreateDefaultTable(5);
-   (*pLayoutTable)(0,0) << pTable;
 
    (*pTable)(0,0) << COLHDR(Sub2(_T("M"),_T("n")), rptMomentUnitTag, pDispUnits->Moment);
    (*pTable)(0,1) << COLHDR(Sub2(_T("P"),_T("n")), rptForceUnitTag,  pDispUnits->GeneralForce);
@@ -134,39 +213,437 @@ rptChapter* CUltColChapterBuilder::Build(CReportSpecification* pRptSpec,Uint16 l
 
 
    RowIndexType row = pTable->GetNumberOfHeaderRows();
+   for ( const auto& point : points )
+   {
+      (*pTable)(row,0) << moment.SetValue(point.Mn);
+      (*pTable)(row,1) << axial.SetValue(-point.Pn); // minus because we want tension to be < 0
+      (*pTable)(row,2) << point.phi;
+      (*pTable)(row,3) << moment.SetValue(point.Mr);
+      (*pTable)(row,4) << axial.SetValue(-point.Pr); // minus because we want tension to be < 0
 
-   CollectionIndexType nPoints;
-   unfactored->get_Count(&nPoints);
-   for ( CollectionIndexType i = 0; i < nPoints; i++ )
+      row++;
+   }
+
+   return pTable;
+}
+
+void CUltColChapterBuilder::ReportLoadCases(rptChapter* pChapter,const CUltColFiberSection& section,const std::vector<ULTCOLINTERACTIONPOINT>& points) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   INIT_UV_PROTOTYPE( rptForceUnitValue,  axial,  pDispUnits->GeneralForce, false);
+   INIT_UV_PROTOTYPE( rptMomentUnitValue, moment, pDispUnits->Moment,  false);
+
+   // Axisymmetric (round) sections are checked for the resultant moment with the interaction diagram.
+   // Other sections are checked with the biaxial interaction surface.
+   bool bBiaxial = !section.IsAxisymmetric();
+   CUltColCapacityDiagram diagram;
+   CUltColInteractionSurface surface;
+   if ( bBiaxial )
    {
-      CComPtr<IPoint2d> pn;
-      unfactored->get_Item(i,&pn);
+      surface.Init(section,m_pDoc->m_ecl,m_pDoc->m_etl);
+   }
+   else
+   {
+      diagram.Init(points);
+   }
 
-      CComPtr<IPoint2d> pr;
-      factored->get_Item(i,&pr);
+   // Returns the capacity ratio and the capacity on the ray through the demand
+   auto getCapacityRatio = [bBiaxial,&diagram,&surface](const ULTCOLLOADCASE& loadCase,Float64* pPr,Float64* pMrx,Float64* pMry)
+   {
+      if ( bBiaxial )
+      {
+         return surface.GetCapacityRatio(loadCase.Pu,loadCase.Mux,loadCase.Muy,pPr,pMrx,pMry);
+      }
+
+      Float64 Mu = sqrt(loadCase.Mux*loadCase.Mux + loadCase.Muy*loadCase.Muy);
+      Float64 Mr;
+      Float64 ratio = diagram.GetCapacityRatio(loadCase.Pu,Mu,pPr,&Mr);
+      *pMrx = (IsZero(Mu) ? Mr : Mr*loadCase.Mux/Mu);
+      *pMry = (IsZero(Mu) ? 0  : Mr*loadCase.Muy/Mu);
+      return ratio;
+   };
+
+   // capacity ratio of every load case, sorted so the governing load cases are first
+   const std::vector<ULTCOLLOADCASE>& loadCases(m_pDoc->m_LoadCases);
+   IndexType nLoadCases = loadCases.size();
+   std::vector<Float64> ratio(nLoadCases);
+   std::vector<IndexType> order(nLoadCases);
+   IndexType nFail = 0;
+   IndexType nNotEvaluated = 0; // the ray through the demand missed the interaction surface
+   for ( IndexType i = 0; i < nLoadCases; i++ )
+   {
+      Float64 Pr, Mrx, Mry;
+      ratio[i] = getCapacityRatio(loadCases[i],&Pr,&Mrx,&Mry);
+      order[i] = i;
+      if ( std::isnan(ratio[i]) )
+      {
+         nNotEvaluated++;
+      }
+      else if ( 1.0 < ratio[i] )
+      {
+         nFail++;
+      }
+   }
 
-      Float64 Mn,Pn;
-      pn->get_X(&Mn);
-      pn->get_Y(&Pn);
+   // load cases that could not be evaluated are listed first
+   std::sort(order.begin(),order.end(),[&ratio](IndexType a,IndexType b)
+   {
+      bool bNaNa = std::isnan(ratio[a]);
+      bool bNaNb = std::isnan(ratio[b]);
+      if ( bNaNa || bNaNb )
+      {
+         return bNaNa && !bNaNb;
+      }
+      return ratio[b] < ratio[a];
+   });
+
+   rptParagraph* pPara = new rptParagraph(rptStyleManager::GetHeadingStyle());
+   *pChapter << pPara;
+   *pPara << _T("Load Case Demands") << rptNewLine;
 
-      Float64 Mr,Pr;
-      pr->get_X(&Mr);
-      pr->get_Y(&Pr);
+   pPara = new rptParagraph;
+   *pChapter << pPara;
+   if ( bBiaxial )
+   {
+      *pPara << _T("The capacity ratio is the distance from the origin to the demand divided by the distance from the origin to the factored interaction surface along the same line.") << rptNewLine;
+      *pPara << _T("The interaction surface has ") << surface.GetVertexCount() << _T(" points and ") << surface.GetTriangleCount() << _T(" triangles.") << rptNewLine;
+      *pPara << nLoadCases << _T(" load cases, ") << (nLoadCases - nFail - nNotEvaluated) << _T(" inside the interaction surface, ") << nFail << _T(" outside the interaction surface") << rptNewLine;
+      if ( 0 < nNotEvaluated )
+      {
+         *pPara << color(Red) << nNotEvaluated << _T(" load cases could not be evaluated because the line through the demand does not intersect the interaction surface") << color(Black) << rptNewLine;
+      }
+   }
+   else
+   {
+      *pPara << _T("The capacity ratio is the distance from the origin to the demand divided by the distance from the origin to the factored interaction diagram along the same line. ");
+      *pPara << _T("The moment demand is the resultant of ") << Sub2(_T("M"),_T("ux")) << _T(" and ") << Sub2(_T("M"),_T("uy")) << _T(".") << rptNewLine;
+      *pPara << nLoadCases << _T(" load cases, ") << (nLoadCases - nFail) << _T(" inside the interaction diagram, ") << nFail << _T(" outside the interaction diagram") << rptNewLine;
+   }
 
-      Float64 phi = Pr/Pn;
-      ATLASSERT( IsEqual(phi,Mr/Mn) );
+   // list the governing load cases
+   const IndexType nMaxRows = 100;
+   IndexType nRows = Min(nLoadCases,nMaxRows);
+   if ( nRows < nLoadCases )
+   {
+      *pPara << _T("The ") << nRows << _T(" load cases with the greatest capacity ratio are listed") << rptNewLine;
+   }
 
-      (*pTable)(row,0) << moment.SetValue(Mn);
-      (*pTable)(row,1) << axial.SetValue(-Pn); // minus because we want tension to be < 0
-      (*pTable)(row,2) << phi;
-      (*pTable)(row,3) << moment.SetValue(Mr);
-      (*pTable)(row,4) << axial.SetValue(-Pr); // minus because we want tension to be < 0
+   rptRcTable* pTable = rptStyleManager::CreateDefaultTable(9);
+   *pPara << pTable << rptNewLine;
 
-      row++;
+   (*pTable)(0,0) << _T("Load Case");
+   (*pTable)(0,1) << COLHDR(Sub2(_T("P"),_T("u")),  rptForceUnitTag,  pDispUnits->GeneralForce);
+   (*pTable)(0,2) << COLHDR(Sub2(_T("M"),_T("ux")), rptMomentUnitTag, pDispUnits->Moment);
+   (*pTable)(0,3) << COLHDR(Sub2(_T("M"),_T("uy")), rptMomentUnitTag, pDispUnits->Moment);
+   (*pTable)(0,4) << COLHDR(Sub2(_T("P"),_T("r")),  rptForceUnitTag,  pDispUnits->GeneralForce);
+   (*pTable)(0,5) << COLHDR(Sub2(_T("M"),_T("rx")), rptMomentUnitTag, pDispUnits->Moment);
+   (*pTable)(0,6) << COLHDR(Sub2(_T("M"),_T("ry")), rptMomentUnitTag, pDispUnits->Moment);
+   (*pTable)(0,7) << _T("Capacity") << rptNewLine << _T("Ratio");
+   (*pTable)(0,8) << _T("Status");
+
+   RowIndexType row = pTable->GetNumberOfHeaderRows();
+   for ( IndexType i = 0; i < nRows; i++, row++ )
+   {
+      const ULTCOLLOADCASE& loadCase(loadCases[order[i]]);
+      Float64 Pr, Mrx, Mry;
+      getCapacityRatio(loadCase,&Pr,&Mrx,&Mry);
+
+      (*pTable)(row,0) << loadCase.Name;
+      (*pTable)(row,1) << axial.SetValue(loadCase.Pu);
+      (*pTable)(row,2) << moment.SetValue(loadCase.Mux);
+      (*pTable)(row,3) << moment.SetValue(loadCase.Muy);
+
+      if ( std::isnan(ratio[order[i]]) )
+      {
+         (*pTable)(row,4) << _T("-");
+         (*pTable)(row,5) << _T("-");
+         (*pTable)(row,6) << _T("-");
+         (*pTable)(row,7) << _T("-");
+         (*pTable)(row,8) << color(Red) << _T("Not Evaluated") << color(Black);
+         continue;
+      }
+
+      (*pTable)(row,4) << axial.SetValue(Pr);
+      (*pTable)(row,5) << moment.SetValue(Mrx);
+      (*pTable)(row,6) << moment.SetValue(Mry);
+
+      if ( 1.0 < ratio[order[i]] )
+      {
+         (*pTable)(row,7) << color(Red) << ratio[order[i]] << color(Black);
+         (*pTable)(row,8) << color(Red) << _T("Fail") << color(Black);
+      }
+      else
+      {
+         (*pTable)(row,7) << ratio[order[i]];
+         (*pTable)(row,8) << _T("Pass");
+      }
    }
+}
+
+void CUltColChapterBuilder::ReportSchedule(rptChapter* pChapter) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   INIT_UV_PROTOTYPE( rptLengthUnitValue, length, pDispUnits->ComponentDim, false);
+   INIT_UV_PROTOTYPE( rptAreaUnitValue,   area,   pDispUnits->Area,         false);
+   INIT_UV_PROTOTYPE( rptStressUnitValue, stress, pDispUnits->Stress,       false);
+   INIT_UV_PROTOTYPE( rptForceUnitValue,  axial,  pDispUnits->GeneralForce, false);
+   INIT_UV_PROTOTYPE( rptMomentUnitValue, moment, pDispUnits->Moment,       false);
 
+   const std::vector<ULTCOLSCHEDULEITEM>& schedule(m_pDoc->m_Schedule);
+   IndexType nColumns = schedule.size();
 
-   return pChapter;
+   Float64 Es;
+   m_pDoc->m_Column->get_Es(&Es);
+
+   std::vector<std::vector<ULTCOLINTERACTIONPOINT>> curves;
+   IndexType nMeshes = CUltColSchedule::ComputeInteraction(schedule,Es,m_pDoc->m_ecl,m_pDoc->m_etl,curves);
+
+   rptParagraph* pPara = new rptParagraph(rptStyleManager::GetHeadingStyle());
+   *pChapter << pPara;
+   *pPara << _T("Column Schedule") << rptNewLine;
+
+   pPara = new rptParagraph;
+   *pChapter << pPara;
+   *pPara << nColumns << _T(" round columns. ") << Sub2(_T("E"),_T("s")) << _T(", ") << Sub2(symbol(epsilon),_T("cl")) << _T(", and ") << Sub2(symbol(epsilon),_T("tl")) << _T(" are the same as the column above.") << rptNewLine;
+   *pPara << _T("Columns with the same diameter and cover share a fiber model. ") << nMeshes << _T(" fiber models were used.") << rptNewLine;
+
+   bool bLoadCases = !m_pDoc->m_LoadCases.empty();
+   if ( bLoadCases )
+   {
+      *pPara << _T("The governing load case has the greatest capacity ratio. The moment demand is the resultant of ") << Sub2(_T("M"),_T("ux")) << _T(" and ") << Sub2(_T("M"),_T("uy")) << _T(".") << rptNewLine;
+   }
+
+   rptRcTable* pTable = rptStyleManager::CreateDefaultTable(bLoadCases ? 11 : 8);
+   *pPara << pTable << rptNewLine;
+
+   ColumnIndexType col = 0;
+   (*pTable)(0,col++) << _T("Column");
+   (*pTable)(0,col++) << COLHDR(_T("Diameter"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << COLHDR(_T("Cover"), rptLengthUnitTag, pDispUnits->ComponentDim);
+   (*pTable)(0,col++) << COLHDR(Sub2(_T("A"),_T("s")), rptAreaUnitTag, pDispUnits->Area);
+   (*pTable)(0,col++) << COLHDR(Sub2(_T("f'"),_T("c")), rptStressUnitTag, pDispUnits->Stress);
+   (*pTable)(0,col++) << COLHDR(Sub2(_T("f"),_T("y")), rptStressUnitTag, pDispUnits->Stress);
+   (*pTable)(0,col++) << COLHDR(_T("Max ") << symbol(phi) << Sub2(_T("P"),_T("n")), rptForceUnitTag, pDispUnits->GeneralForce);
+   (*pTable)(0,col++) << COLHDR(_T("Max ") << symbol(phi) << Sub2(_T("M"),_T("n")), rptMomentUnitTag, pDispUnits->Moment);
+   if ( bLoadCases )
+   {
+      (*pTable)(0,col++) << _T("Governing") << rptNewLine << _T("Load Case");
+      (*pTable)(0,col++) << _T("Capacity") << rptNewLine << _T("Ratio");
+      (*pTable)(0,col++) << _T("Status");
+   }
+
+   RowIndexType row = pTable->GetNumberOfHeaderRows();
+   for ( IndexType columnIdx = 0; columnIdx < nColumns; columnIdx++, row++ )
+   {
+      const ULTCOLSCHEDULEITEM& column(schedule[columnIdx]);
+      const std::vector<ULTCOLINTERACTIONPOINT>& points(curves[columnIdx]);
+
+      Float64 Prmax = 0;
+      Float64 Mrmax = 0;
+      for ( const auto& point : points )
+      {
+         Prmax = Max(Prmax,-point.Pr);
+         Mrmax = Max(Mrmax,point.Mr);
+      }
+
+      col = 0;
+      (*pTable)(row,col++) << column.Name;
+      (*pTable)(row,col++) << length.SetValue(column.Diameter);
+      (*pTable)(row,col++) << length.SetValue(column.Cover);
+      (*pTable)(row,col++) << area.SetValue(column.As);
+      (*pTable)(row,col++) << stress.SetValue(column.fc);
+      (*pTable)(row,col++) << stress.SetValue(column.fy);
+      (*pTable)(row,col++) << axial.SetValue(Prmax);
+      (*pTable)(row,col++) << moment.SetValue(Mrmax);
+
+      if ( bLoadCases )
+      {
+         CUltColCapacityDiagram diagram;
+         diagram.Init(points);
+
+         const ULTCOLLOADCASE* pGoverning = nullptr;
+         Float64 maxRatio = -Float64_Max;
+         for ( const auto& loadCase : m_pDoc->m_LoadCases )
+         {
+            Float64 ratio = diagram.GetCapacityRatio(loadCase.Pu,sqrt(loadCase.Mux*loadCase.Mux + loadCase.Muy*loadCase.Muy));
+            if ( maxRatio < ratio )
+            {
+               maxRatio = ratio;
+               pGoverning = &loadCase;
+            }
+         }
+
+         (*pTable)(row,col++) << pGoverning->Name;
+         if ( 1.0 < maxRatio )
+         {
+            (*pTable)(row,col++) << color(Red) << maxRatio << color(Black);
+            (*pTable)(row,col++) << color(Red) << _T("Fail") << color(Black);
+         }
+         else
+         {
+            (*pTable)(row,col++) << maxRatio;
+            (*pTable)(row,col++) << _T("Pass");
+         }
+      }
+   }
+
+   // interaction diagram of each column
+   for ( IndexType columnIdx = 0; columnIdx < nColumns; columnIdx++ )
+   {
+      pPara = new rptParagraph;
+      *pChapter << pPara;
+
+      rptRcTable* pLayoutTable = rptStyleManager::CreateLayoutTable(2);
+      *pPara << pLayoutTable;
+
+      CString strTitle;
+      strTitle.Format(_T("Interaction Diagram - %s"),schedule[columnIdx].Name.c_str());
+
+      (*pLayoutTable)(0,0) << Bold(schedule[columnIdx].Name.c_str()) << rptNewLine;
+      (*pLayoutTable)(0,0) << CreateInteractionTable(curves[columnIdx]);
+      (*pLayoutTable)(0,1) << CreateImage(curves[columnIdx],strTitle);
+   }
+}
+
+void CUltColChapterBuilder::ReportMomentCurvature(rptChapter* pChapter,const CUltColFiberSection& section) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   INIT_UV_PROTOTYPE( rptStressUnitValue, stress, pDispUnits->Stress,       true);
+   INIT_UV_PROTOTYPE( rptForceUnitValue,  axial,  pDispUnits->GeneralForce, false);
+   INIT_UV_PROTOTYPE( rptMomentUnitValue, moment, pDispUnits->Moment,       false);
+
+   rptRcScalar scalar;
+   scalar.SetFormat(sysNumericFormatTool::Fixed);
+   scalar.SetWidth(6);
+   scalar.SetPrecision(2);
+
+   rptRcScalar curvature;
+   curvature.SetFormat(sysNumericFormatTool::Scientific);
+   curvature.SetWidth(9);
+   curvature.SetPrecision(3);
+
+   rptRcScalar stiffness;
+   stiffness.SetFormat(sysNumericFormatTool::Scientific);
+   stiffness.SetWidth(9);
+   stiffness.SetPrecision(3);
+
+   // curvature is reported per unit of component dimension and flexural stiffness in force x component dimension squared
+   Float64 length = ::ConvertToSysUnits(1.0,pDispUnits->ComponentDim.UnitOfMeasure);
+   const std::_tstring& strLength(pDispUnits->ComponentDim.UnitOfMeasure.UnitTag());
+   const std::_tstring& strForce(pDispUnits->GeneralForce.UnitOfMeasure.UnitTag());
+
+   rptParagraph* pPara = new rptParagraph(rptStyleManager::GetHeadingStyle());
+   *pChapter << pPara;
+   *pPara << _T("Moment-Curvature") << rptNewLine;
+
+   // bending about the x-axis, and the y-axis for sections that aren't axisymmetric
+   std::vector<Float64> angles{0.0};
+   if ( !section.IsAxisymmetric() )
+   {
+      angles.push_back(M_PI/2);
+   }
+
+   for ( auto angle : angles )
+   {
+      CUltColMomentCurvature analysis;
+      m_pDoc->InitMomentCurvature(section,angle,&analysis);
+
+      std::vector<ULTCOLMOMENTCURVATURE> results;
+      analysis.Compute(m_pDoc->m_AxialLoads,results);
+
+      pPara = new rptParagraph;
+      *pChapter << pPara;
+
+      if ( angle == 0.0 )
+      {
+         *pPara << _T("The concrete inside the center of the reinforcement is confined and is modeled with Mander's stress-strain relationship. The unconfined concrete spalls at a strain of 0.005.") << rptNewLine;
+         *pPara << Sub2(_T("f'"),_T("cc")) << _T(" = ") << stress.SetValue(analysis.GetConfinedStrength()) << _T(", ");
+         *pPara << Sub2(symbol(epsilon),_T("cc")) << _T(" = ") << analysis.GetConfinedStrain() << _T(", ");
+         *pPara << Sub2(symbol(epsilon),_T("cu")) << _T(" = ") << analysis.GetUltimateConcreteStrain() << rptNewLine;
+         *pPara << _T("The reinforcement is elastic-perfectly plastic to the onset of strain hardening and then hardens parabolically to its tensile strength. ");
+         *pPara << Sub2(_T("f"),_T("u")) << _T(" = ") << stress.SetValue(m_pDoc->m_fu) << _T(", ");
+         *pPara << Sub2(symbol(epsilon),_T("sh")) << _T(" = ") << m_pDoc->m_esh << _T(", ");
+         *pPara << Sub2(symbol(epsilon),_T("su")) << _T(" = ") << m_pDoc->m_esu << rptNewLine;
+         *pPara << _T("First yield is when the extreme tension reinforcement yields or the extreme concrete fiber reaches a strain of 0.002. ");
+         *pPara << Sub2(_T("EI"),_T("eff")) << _T(" = ") << Sub2(_T("M"),_T("y")) << _T("/") << Sub2(symbol(phi),_T("y")) << _T(". ");
+         *pPara << _T("The idealized plastic moment, ") << Sub2(_T("M"),_T("p")) << _T(", is from an elastic-perfectly plastic curve with the same area as the moment-curvature curve up to the ultimate curvature, ") << Sub2(symbol(phi),_T("u")) << _T(".") << rptNewLine;
+      }
+
+      if ( !section.IsAxisymmetric() )
+      {
+         *pPara << Bold(angle == 0.0 ? _T("Bending about the X axis") : _T("Bending about the Y axis")) << rptNewLine;
+      }
+
+      rptRcTable* pTable = rptStyleManager::CreateDefaultTable(11);
+      *pPara << pTable << rptNewLine;
+
+      std::_tstring strCurvature(_T("(1/") + strLength + _T(")"));
+      ColumnIndexType col = 0;
+      (*pTable)(0,col++) << COLHDR(_T("P"), rptForceUnitTag, pDispUnits->GeneralForce);
+      (*pTable)(0,col++) << COLHDR(Sub2(_T("M"),_T("y")), rptMomentUnitTag, pDispUnits->Moment);
+      (*pTable)(0,col++) << Sub2(symbol(phi),_T("y")) << rptNewLine << strCurvature;
+      (*pTable)(0,col++) << Sub2(_T("EI"),_T("eff")) << rptNewLine << _T("(") << strForce << _T("-") << strLength << Super(_T("2")) << _T(")");
+      (*pTable)(0,col++) << Sub2(_T("EI"),_T("eff")) << _T("/") << Sub2(_T("E"),_T("c")) << Sub2(_T("I"),_T("g"));
+      (*pTable)(0,col++) << COLHDR(Sub2(_T("M"),_T("p")), rptMomentUnitTag, pDispUnits->Moment);
+      (*pTable)(0,col++) << Sub2(symbol(phi),_T("yi")) << rptNewLine << strCurvature;
+      (*pTable)(0,col++) << COLHDR(Sub2(_T("M"),_T("u")), rptMomentUnitTag, pDispUnits->Moment);
+      (*pTable)(0,col++) << Sub2(symbol(phi),_T("u")) << rptNewLine << strCurvature;
+      (*pTable)(0,col++) << Sub2(symbol(mu),symbol(phi)) << rptNewLine << _T("= ") << Sub2(symbol(phi),_T("u")) << _T("/") << Sub2(symbol(phi),_T("yi"));
+      (*pTable)(0,col++) << _T("Limit State");
+
+      Float64 EIg = analysis.GetGrossStiffness();
+      RowIndexType row = pTable->GetNumberOfHeaderRows();
+      for ( const auto& result : results )
+      {
+         col = 0;
+         (*pTable)(row,col++) << axial.SetValue(result.P);
+         if ( !result.bValid )
+         {
+            (*pTable)(row,col++) << color(Red) << _T("The column cannot resist this axial force") << color(Black);
+            pTable->SetColumnSpan(row,1,10);
+            row++;
+            continue;
+         }
+
+         (*pTable)(row,col++) << moment.SetValue(result.My);
+         (*pTable)(row,col++) << curvature.SetValue(result.PhiY*length);
+         (*pTable)(row,col++) << stiffness.SetValue(::ConvertFromSysUnits(result.EIeff,pDispUnits->GeneralForce.UnitOfMeasure)/(length*length));
+         (*pTable)(row,col++) << scalar.SetValue(result.EIeff/EIg);
+         (*pTable)(row,col++) << moment.SetValue(result.Mp);
+         (*pTable)(row,col++) << curvature.SetValue(result.PhiYi*length);
+         (*pTable)(row,col++) << moment.SetValue(result.Mu);
+         (*pTable)(row,col++) << curvature.SetValue(result.PhiU*length);
+         (*pTable)(row,col++) << scalar.SetValue(result.PhiU/result.PhiYi);
+         switch ( result.Limit )
+         {
+         case mcConcreteCrushing:
+            (*pTable)(row,col++) << _T("Concrete Crushing");
+            break;
+
+         case mcSteelFracture:
+            (*pTable)(row,col++) << _T("Reinforcement Fracture");
+            break;
+
+         case mcEquilibrium:
+            (*pTable)(row,col++) << _T("Equilibrium");
+            break;
+
+         default:
+            (*pTable)(row,col++) << _T("Step Limit");
+            break;
+         }
+
+         row++;
+      }
+
+      *pPara << CreateMomentCurvatureImage(results,angle == 0.0 ? _T("Moment-Curvature - Bending about the X Axis") : _T("Moment-Curvature - Bending about the Y Axis")) << rptNewLine;
+   }
 }
 
 CChapterBuilder* CUltColChapterBuilder::Clone() const
@@ -174,7 +651,44 @@ CChapterBuilder* CUltColChapterBuilder::Clone() const
    return new CUltColChapterBuilder(m_pDoc);
 }
 
-rptRcImage* CUltColChapterBuilder::CreateImage(IPoint2dCollection* unfactored,IPoint2dCollection* factored) const
+#if defined _DEBUG
+void CUltColChapterBuilder::AssertInteraction(const std::vector<ULTCOLINTERACTIONPOINT>& points,IPoint2dCollection* unfactored) const
+{
+   // The native curve has more points than the WBFL curve. Compare the moment capacity at the
+   // axial capacity of each WBFL point, relative to the peak moment capacity.
+   Float64 Mmax = 0;
+   for ( const auto& point : points )
+   {
+      Mmax = Max(Mmax,point.Mn);
+   }
+
+   CollectionIndexType nPoints;
+   unfactored->get_Count(&nPoints);
+   for ( CollectionIndexType i = 0; i < nPoints; i++ )
+   {
+      CComPtr<IPoint2d> pn;
+      unfactored->get_Item(i,&pn);
+
+      Float64 Mn,Pn;
+      pn->get_X(&Mn);
+      pn->get_Y(&Pn);
+
+      // the native curve goes from pure compression to pure tension so Pn increases
+      auto found = std::find_if(points.cbegin()+1,points.cend(),[Pn](const auto& point) {return Pn <= point.Pn;});
+      if ( found == points.cend() )
+      {
+         continue;
+      }
+
+      const auto& p1(*(found-1));
+      const auto& p2(*found);
+      Float64 M = IsEqual(p1.Pn,p2.Pn) ? p2.Mn : p1.Mn + (p2.Mn - p1.Mn)*(Pn - p1.Pn)/(p2.Pn - p1.Pn);
+      ATLASSERT(fabs(M - Mn) <= 0.02*Mmax);
+   }
+}
+#endif
+
+rptRcImage* CUltColChapterBuilder::CreateImage(const std::vector<ULTCOLINTERACTIONPOINT>& points,LPCTSTR lpszTitle) const
 {
    CEAFApp* pApp = EAFGetApp();
    const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
@@ -199,7 +713,7 @@ rptRcImage* CUltColChapterBuilder::CreateImage(IPoint2dCollection* unfactored,IP
    graph.SetClientAreaColor(GRAPH_BACKGROUND);
    graph.SetGridPenStyle(GRAPH_GRID_PEN_STYLE, GRAPH_GRID_PEN_WEIGHT, GRAPH_GRID_COLOR);
 
-   graph.SetTitle(_T("Interaction Diagram"));
+   graph.SetTitle(lpszTitle);
 
    // Setup X-axis
    CString strMoment;
@@ -223,32 +737,99 @@ rptRcImage* CUltColChapterBuilder::CreateImage(IPoint2dCollection* unfactored,IP
    IndexType series1 = graph.CreateDataSeries(_T(""),PS_SOLID,1,BLUE);
    IndexType series2 = graph.CreateDataSeries(_T(""),PS_SOLID,1,GREEN);
 
-   CollectionIndexType nPoints;
-   unfactored->get_Count(&nPoints);
-   for ( CollectionIndexType i = 0; i < nPoints; i++ )
+   for ( const auto& point : points )
    {
-      CComPtr<IPoint2d> pn;
-      unfactored->get_Item(i,&pn);
+      Float64 Mn = ::ConvertFromSysUnits(point.Mn,pDispUnits->Moment.UnitOfMeasure);
+      Float64 Pn = ::ConvertFromSysUnits(point.Pn,pDispUnits->GeneralForce.UnitOfMeasure);
 
-      Float64 Mn,Pn;
-      pn->get_X(&Mn);
-      pn->get_Y(&Pn);
+      Float64 Mr = ::ConvertFromSysUnits(point.Mr,pDispUnits->Moment.UnitOfMeasure);
+      Float64 Pr = ::ConvertFromSysUnits(point.Pr,pDispUnits->GeneralForce.UnitOfMeasure);
 
-      Mn = ::ConvertFromSysUnits(Mn,pDispUnits->Moment.UnitOfMeasure);
-      Pn = ::ConvertFromSysUnits(Pn,pDispUnits->GeneralForce.UnitOfMeasure);
+      graph.AddPoint(series1,gpPoint2d(Mn,-Pn));      
+      graph.AddPoint(series2,gpPoint2d(Mr,-Pr));      
+   }
 
-      CComPtr<IPoint2d> pr;
-      factored->get_Item(i,&pr);
+   graph.UpdateGraphMetrics(pDC->GetSafeHdc());
+   graph.Draw(pDC->GetSafeHdc());
 
-      Float64 Mr,Pr;
-      pr->get_X(&Mr);
-      pr->get_Y(&Pr);
+   image.ReleaseDC();
 
-      Mr = ::ConvertFromSysUnits(Mr,pDispUnits->Moment.UnitOfMeasure);
-      Pr = ::ConvertFromSysUnits(Pr,pDispUnits->GeneralForce.UnitOfMeasure);
+   return SaveImage(image);
+}
 
-      graph.AddPoint(series1,gpPoint2d(Mn,-Pn));      
-      graph.AddPoint(series2,gpPoint2d(Mr,-Pr));      
+rptRcImage* CUltColChapterBuilder::CreateMomentCurvatureImage(const std::vector<ULTCOLMOMENTCURVATURE>& results,LPCTSTR lpszTitle) const
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   CImage image;
+   image.Create(500,500,32);
+   CRect rect(CPoint(0,0),CSize(image.GetWidth(),image.GetHeight()));
+
+   CDC* pDC = CDC::FromHandle(image.GetDC());
+
+   // fill the background of the image (otherwise it will be black)
+   CBrush brush(GRAPH_BACKGROUND);
+   CBrush* pOldBrush = pDC->SelectObject(&brush);
+   pDC->Rectangle(rect);
+   pDC->SelectObject(pOldBrush);
+
+   // curvature is plotted per unit of component dimension
+   ScalarTool curvatureTool(pDispUnits->Scalar);
+   MomentTool momentTool(pDispUnits->Moment);
+   grGraphXY graph(curvatureTool,momentTool);
+
+   graph.SetOutputRect(rect);
+   graph.SetClientAreaColor(GRAPH_BACKGROUND);
+   graph.SetGridPenStyle(GRAPH_GRID_PEN_STYLE, GRAPH_GRID_PEN_WEIGHT, GRAPH_GRID_COLOR);
+
+   graph.SetTitle(lpszTitle);
+
+   CString strCurvature;
+   strCurvature.Format(_T("Curvature (1/%s)"),pDispUnits->ComponentDim.UnitOfMeasure.UnitTag().c_str());
+   graph.SetXAxisTitle(strCurvature.LockBuffer());
+   strCurvature.UnlockBuffer();
+   graph.SetXAxisNiceRange(true);
+   graph.SetXAxisNumberOfMinorTics(0);
+   graph.SetXAxisNumberOfMajorTics(11);
+   graph.SetXAxisLabelAngle(350); // 35 degrees
+
+   CString strMoment;
+   strMoment.Format(_T("Moment (%s)"),pDispUnits->Moment.UnitOfMeasure.UnitTag().c_str());
+   graph.SetYAxisTitle(strMoment.LockBuffer());
+   strMoment.UnlockBuffer();
+   graph.SetYAxisNiceRange(true);
+   graph.SetYAxisNumberOfMinorTics(5);
+   graph.SetYAxisNumberOfMajorTics(21);
+
+   // the moment-curvature curve is solid and the idealized curve is dashed
+   const COLORREF colors[] = {BLUE,GREEN,RED,ORANGE,PURPLE,BROWN};
+   const IndexType nColors = sizeof(colors)/sizeof(colors[0]);
+   Float64 length = ::ConvertToSysUnits(1.0,pDispUnits->ComponentDim.UnitOfMeasure);
+   IndexType i = 0;
+   for ( const auto& result : results )
+   {
+      if ( !result.bValid )
+      {
+         continue;
+      }
+
+      CString strLabel;
+      strLabel.Format(_T("P = %s"),::FormatDimension(result.P,pDispUnits->GeneralForce).GetString());
+      COLORREF color = colors[i++ % nColors];
+      IndexType curve = graph.CreateDataSeries(strLabel,PS_SOLID,1,color);
+      IndexType idealized = graph.CreateDataSeries(_T(""),PS_DASH,1,color);
+
+      graph.AddPoint(curve,gpPoint2d(0,0));
+      for ( const auto& point : result.Points )
+      {
+         graph.AddPoint(curve,gpPoint2d(point.Curvature*length,::ConvertFromSysUnits(point.M,pDispUnits->Moment.UnitOfMeasure)));
+      }
+
+      Float64 Mp = ::ConvertFromSysUnits(result.Mp,pDispUnits->Moment.UnitOfMeasure);
+      graph.AddPoint(idealized,gpPoint2d(0,0));
+      graph.AddPoint(idealized,gpPoint2d(result.PhiYi*length,Mp));
+      graph.AddPoint(idealized,gpPoint2d(result.PhiU*length,Mp));
    }
 
    graph.UpdateGraphMetrics(pDC->GetSafeHdc());
@@ -256,7 +837,11 @@ rptRcImage* CUltColChapterBuilder::CreateImage(IPoint2dCollection* unfactored,IP
 
    image.ReleaseDC();
 
+   return SaveImage(image);
+}
 
+rptRcImage* CUltColChapterBuilder::SaveImage(CImage& image) const
+{
    // get a temporary file name for the image
    TCHAR temp_path[ _MAX_PATH ];
    TCHAR temp_file[ _MAX_PATH ];
@@ -23,6 +23,8 @@
 #pragma once
 #include <ReportManager\ChapterBuilder.h>
 #include "UltColDoc.h"
+#include "UltColFiberSection.h"
+#include "UltColMomentCurvature.h"
 
 class CUltColChapterBuilder :
    public CChapterBuilder
@@ -44,5 +46,15 @@ private:
    // Delete them in the destructor
    std::vector<std::_tstring> m_TemporaryFiles;
 
-   rptRcImage* CreateImage(IPoint2dCollection* unfactored,IPoint2dCollection* factored) const;
+   rptRcImage* CreateImage(const std::vector<ULTCOLINTERACTIONPOINT>& points,LPCTSTR lpszTitle) const;
+   rptRcTable* CreateInteractionTable(const std::vector<ULTCOLINTERACTIONPOINT>& points) const;
+   void ReportLoadCases(rptChapter* pChapter,const CUltColFiberSection& section,const std::vector<ULTCOLINTERACTIONPOINT>& points) const;
+   void ReportSchedule(rptChapter* pChapter) const;
+   void ReportMomentCurvature(rptChapter* pChapter,const CUltColFiberSection& section) const;
+   rptRcImage* CreateMomentCurvatureImage(const std::vector<ULTCOLMOMENTCURVATURE>& results,LPCTSTR lpszTitle) const;
+   rptRcImage* SaveImage(CImage& image) const;
+
+#if defined _DEBUG
+   void AssertInteraction(const std::vector<ULTCOLINTERACTIONPOINT>& points,IPoint2dCollection* unfactored) const;
+#endif
 };
@@ -47,6 +47,20 @@ BEGIN_MESSAGE_MAP(CUltColChildFrame, CEAFChildFrame)
    ON_BN_CLICKED(IDC_UPDATE,OnUpdate)
    ON_BN_CLICKED(IDC_US,OnUSUnits)
    ON_BN_CLICKED(IDC_SI,OnSIUnits)
+   ON_BN_CLICKED(IDC_IMPORT_LOADS,OnImportLoads)
+   ON_BN_CLICKED(IDC_CLEAR_LOADS,OnClearLoads)
+   ON_UPDATE_COMMAND_UI(IDC_CLEAR_LOADS,OnUpdateClearLoads)
+   ON_BN_CLICKED(IDC_IMPORT_SCHEDULE,OnImportSchedule)
+   ON_BN_CLICKED(IDC_EXPORT_CURVES,OnExportCurves)
+   ON_BN_CLICKED(IDC_CLEAR_SCHEDULE,OnClearSchedule)
+   ON_UPDATE_COMMAND_UI(IDC_EXPORT_CURVES,OnUpdateSchedule)
+   ON_UPDATE_COMMAND_UI(IDC_CLEAR_SCHEDULE,OnUpdateSchedule)
+   ON_UPDATE_COMMAND_UI(IDC_DIAMETER,OnUpdateRoundInput)
+   ON_UPDATE_COMMAND_UI(IDC_WIDTH,OnUpdateRectangularInput)
+   ON_UPDATE_COMMAND_UI(IDC_DEPTH,OnUpdateRectangularInput)
+   ON_UPDATE_COMMAND_UI(IDC_WALL,OnUpdateRectangularInput)
+   ON_UPDATE_COMMAND_UI(IDC_BARS_X,OnUpdateRectangularInput)
+   ON_UPDATE_COMMAND_UI(IDC_BARS_Y,OnUpdateRectangularInput)
    ON_NOTIFY_EX(TTN_NEEDTEXT,0,OnToolTipNotify)
 	ON_MESSAGE(WM_HELP, OnCommandHelp)
 END_MESSAGE_MAP()
@@ -57,6 +71,26 @@ LRESULT CUltColChildFrame::OnCommandHelp(WPARAM, LPARAM lParam)
    return TRUE;
 }
 
+void CUltColChildFrame::SetShapeParameters(int shape,Float64 width,Float64 depth,Float64 wallThickness,IndexType nBarsX,IndexType nBarsY)
+{
+   m_DlgBar.m_Shape = shape;
+   m_DlgBar.m_Width = width;
+   m_DlgBar.m_Depth = depth;
+   m_DlgBar.m_WallThickness = wallThickness;
+   m_DlgBar.m_nBarsX = (UINT)nBarsX;
+   m_DlgBar.m_nBarsY = (UINT)nBarsY;
+}
+
+void CUltColChildFrame::SetMomentCurvatureParameters(Float64 rho_s,Float64 fyh,Float64 fu,Float64 esh,Float64 esu,const std::vector<Float64>& axialLoads)
+{
+   m_DlgBar.m_rho_s = rho_s;
+   m_DlgBar.m_fyh = fyh;
+   m_DlgBar.m_fu = fu;
+   m_DlgBar.m_esh = esh;
+   m_DlgBar.m_esu = esu;
+   m_DlgBar.m_AxialLoads = axialLoads;
+}
+
 void CUltColChildFrame::SetColumnParameters(Float64 diameter, Float64 fc, Float64 cover, Float64 As, Float64 Es, Float64 fy,Float64 ecl,Float64 etl)
 {
    m_DlgBar.m_Diameter = diameter;
@@ -107,7 +141,10 @@ int CUltColChildFrame::OnCreate(LPCREATESTRUCT lpCreateStruct)
 
 void CUltColChildFrame::OnUpdate()
 {
-   m_DlgBar.UpdateData(TRUE);
+   if ( !m_DlgBar.UpdateData(TRUE) )
+   {
+      return;
+   }
 
    CUltColDoc* pDoc = (CUltColDoc*)GetActiveDocument();
    if ( pDoc )
@@ -129,7 +166,19 @@ void CUltColChildFrame::OnUpdate()
            !IsEqual(es,m_DlgBar.m_Es) ||
            !IsEqual(fy,m_DlgBar.m_Fy) ||
            !IsEqual(ecl,m_DlgBar.m_ecl) ||
-           !IsEqual(etl,m_DlgBar.m_etl))
+           !IsEqual(etl,m_DlgBar.m_etl) ||
+           pDoc->m_Shape != (CUltColDoc::Shape)m_DlgBar.m_Shape ||
+           !IsEqual(pDoc->m_Width,m_DlgBar.m_Width) ||
+           !IsEqual(pDoc->m_Depth,m_DlgBar.m_Depth) ||
+           !IsEqual(pDoc->m_WallThickness,m_DlgBar.m_WallThickness) ||
+           pDoc->m_nBarsX != m_DlgBar.m_nBarsX ||
+           pDoc->m_nBarsY != m_DlgBar.m_nBarsY ||
+           !IsEqual(pDoc->m_rho_s,m_DlgBar.m_rho_s) ||
+           !IsEqual(pDoc->m_fyh,m_DlgBar.m_fyh) ||
+           !IsEqual(pDoc->m_fu,m_DlgBar.m_fu) ||
+           !IsEqual(pDoc->m_esh,m_DlgBar.m_esh) ||
+           !IsEqual(pDoc->m_esu,m_DlgBar.m_esu) ||
+           pDoc->m_AxialLoads != m_DlgBar.m_AxialLoads )
       {
          bModified = TRUE;
       }
@@ -142,6 +191,18 @@ void CUltColChildFrame::OnUpdate()
       pDoc->m_Column->put_fy(       m_DlgBar.m_Fy );
       pDoc->m_ecl = m_DlgBar.m_ecl;
       pDoc->m_etl = m_DlgBar.m_etl;
+      pDoc->m_Shape = (CUltColDoc::Shape)m_DlgBar.m_Shape;
+      pDoc->m_Width = m_DlgBar.m_Width;
+      pDoc->m_Depth = m_DlgBar.m_Depth;
+      pDoc->m_WallThickness = m_DlgBar.m_WallThickness;
+      pDoc->m_nBarsX = m_DlgBar.m_nBarsX;
+      pDoc->m_nBarsY = m_DlgBar.m_nBarsY;
+      pDoc->m_rho_s = m_DlgBar.m_rho_s;
+      pDoc->m_fyh = m_DlgBar.m_fyh;
+      pDoc->m_fu = m_DlgBar.m_fu;
+      pDoc->m_esh = m_DlgBar.m_esh;
+      pDoc->m_esu = m_DlgBar.m_esu;
+      pDoc->m_AxialLoads = m_DlgBar.m_AxialLoads;
 
       if ( pDoc->IsModified() || bModified )
          pDoc->SetModifiedFlag();
@@ -168,6 +229,127 @@ void CUltColChildFrame::OnSIUnits()
    OnUpdate();
 }
 
+void CUltColChildFrame::OnImportLoads()
+{
+   CUltColDoc* pDoc = (CUltColDoc*)GetActiveDocument();
+   if ( pDoc == nullptr )
+   {
+      return;
+   }
+
+   CFileDialog fileDlg(TRUE,_T("csv"),nullptr,OFN_HIDEREADONLY | OFN_FILEMUSTEXIST,_T("Comma Separated Value Files (*.csv)|*.csv|All Files (*.*)|*.*||"));
+   if ( fileDlg.DoModal() != IDOK )
+   {
+      return;
+   }
+
+   CWaitCursor wait;
+   CString strError;
+   if ( !pDoc->ImportLoadCases(fileDlg.GetPathName(),&strError) )
+   {
+      AFX_MANAGE_STATE(AfxGetStaticModuleState());
+      AfxMessageBox(strError,MB_OK | MB_ICONEXCLAMATION);
+      return;
+   }
+
+   pDoc->SetModifiedFlag();
+   pDoc->UpdateAllViews(nullptr);
+}
+
+void CUltColChildFrame::OnClearLoads()
+{
+   CUltColDoc* pDoc = (CUltColDoc*)GetActiveDocument();
+   if ( pDoc )
+   {
+      pDoc->m_LoadCases.clear();
+      pDoc->SetModifiedFlag();
+      pDoc->UpdateAllViews(nullptr);
+   }
+}
+
+void CUltColChildFrame::OnUpdateClearLoads(CCmdUI* pCmdUI)
+{
+   CUltColDoc* pDoc = (CUltColDoc*)GetActiveDocument();
+   pCmdUI->Enable(pDoc != nullptr && !pDoc->m_LoadCases.empty());
+}
+
+void CUltColChildFrame::OnImportSchedule()
+{
+   CUltColDoc* pDoc = (CUltColDoc*)GetActiveDocument();
+   if ( pDoc == nullptr )
+   {
+      return;
+   }
+
+   CFileDialog fileDlg(TRUE,_T("csv"),nullptr,OFN_HIDEREADONLY | OFN_FILEMUSTEXIST,_T("Comma Separated Value Files (*.csv)|*.csv|All Files (*.*)|*.*||"));
+   if ( fileDlg.DoModal() != IDOK )
+   {
+      return;
+   }
+
+   CWaitCursor wait;
+   CString strError;
+   if ( !pDoc->ImportSchedule(fileDlg.GetPathName(),&strError) )
+   {
+      AFX_MANAGE_STATE(AfxGetStaticModuleState());
+      AfxMessageBox(strError,MB_OK | MB_ICONEXCLAMATION);
+      return;
+   }
+
+   pDoc->SetModifiedFlag();
+   pDoc->UpdateAllViews(nullptr);
+}
+
+void CUltColChildFrame::OnExportCurves()
+{
+   CUltColDoc* pDoc = (CUltColDoc*)GetActiveDocument();
+   if ( pDoc == nullptr )
+   {
+      return;
+   }
+
+   CFileDialog fileDlg(FALSE,_T("csv"),nullptr,OFN_HIDEREADONLY | OFN_OVERWRITEPROMPT,_T("Comma Separated Value Files (*.csv)|*.csv|All Files (*.*)|*.*||"));
+   if ( fileDlg.DoModal() != IDOK )
+   {
+      return;
+   }
+
+   CWaitCursor wait;
+   CString strError;
+   if ( !pDoc->ExportScheduleCurves(fileDlg.GetPathName(),&strError) )
+   {
+      AFX_MANAGE_STATE(AfxGetStaticModuleState());
+      AfxMessageBox(strError,MB_OK | MB_ICONEXCLAMATION);
+   }
+}
+
+void CUltColChildFrame::OnClearSchedule()
+{
+   CUltColDoc* pDoc = (CUltColDoc*)GetActiveDocument();
+   if ( pDoc )
+   {
+      pDoc->m_Schedule.clear();
+      pDoc->SetModifiedFlag();
+      pDoc->UpdateAllViews(nullptr);
+   }
+}
+
+void CUltColChildFrame::OnUpdateSchedule(CCmdUI* pCmdUI)
+{
+   CUltColDoc* pDoc = (CUltColDoc*)GetActiveDocument();
+   pCmdUI->Enable(pDoc != nullptr && !pDoc->m_Schedule.empty());
+}
+
+void CUltColChildFrame::OnUpdateRoundInput(CCmdUI* pCmdUI)
+{
+   pCmdUI->Enable(!m_DlgBar.IsRectangularSelected());
+}
+
+void CUltColChildFrame::OnUpdateRectangularInput(CCmdUI* pCmdUI)
+{
+   pCmdUI->Enable(m_DlgBar.IsRectangularSelected());
+}
+
 void CUltColChildFrame::SetUnitsMode(eafTypes::UnitMode um)
 {
    CEAFApp* pApp = EAFGetApp();
@@ -188,6 +370,30 @@ BOOL CUltColChildFrame::OnToolTipNotify(UINT id,NMHDR* pNMHDR, LRESULT* pResult)
          _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Column Diameter"));
          break;
 
+      case IDC_SHAPE:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Column Shape"));
+         break;
+
+      case IDC_WIDTH:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Width of Rectangular Column (parallel to the X axis)"));
+         break;
+
+      case IDC_DEPTH:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Depth of Rectangular Column (parallel to the Y axis)"));
+         break;
+
+      case IDC_WALL:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Wall Thickness of Hollow Column (zero for a solid column)"));
+         break;
+
+      case IDC_BARS_X:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Number of Bars on Faces Parallel to the Width, Including Corner Bars"));
+         break;
+
+      case IDC_BARS_Y:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Number of Bars on Faces Parallel to the Depth, Including Corner Bars"));
+         break;
+
       case IDC_FC:
          _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Concrete Strength"));
          break;
@@ -216,6 +422,50 @@ BOOL CUltColChildFrame::OnToolTipNotify(UINT id,NMHDR* pNMHDR, LRESULT* pResult)
          _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Tension Strain Limit"));
          break;
 
+      case IDC_IMPORT_LOADS:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Import load cases from a CSV file (Name,P,Mx,My)"));
+         break;
+
+      case IDC_CLEAR_LOADS:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Remove all load cases"));
+         break;
+
+      case IDC_RHO_S:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Volumetric Ratio of Transverse Reinforcement"));
+         break;
+
+      case IDC_FYH:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Yield Strength of Transverse Reinforcement"));
+         break;
+
+      case IDC_FU:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Tensile Strength of Reinforcement"));
+         break;
+
+      case IDC_ESH:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Strain at the Onset of Strain Hardening"));
+         break;
+
+      case IDC_ESU:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Ultimate Strain of Reinforcement"));
+         break;
+
+      case IDC_AXIAL_LOADS:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Axial loads for moment-curvature analysis, separated by commas (compression is positive)"));
+         break;
+
+      case IDC_IMPORT_SCHEDULE:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Import a schedule of round columns from a CSV file (Name,Diameter,Cover,As,fc,fy)"));
+         break;
+
+      case IDC_EXPORT_CURVES:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Export the interaction diagrams of the scheduled columns to a CSV file"));
+         break;
+
+      case IDC_CLEAR_SCHEDULE:
+         _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Remove all columns from the schedule"));
+         break;
+
       case IDC_US:
          _tcscpy_s(pTTT->szText,sizeof(pTTT->szText)/sizeof(TCHAR),_T("Display US Units"));
          break;
@@ -31,6 +31,9 @@ class CUltColChildFrame :
 public:
 	DECLARE_DYNCREATE(CUltColChildFrame)
 
+   // Call SetShapeParameters and SetMomentCurvatureParameters before SetColumnParameters. SetColumnParameters updates the dialog bar
+   void SetShapeParameters(int shape,Float64 width,Float64 depth,Float64 wallThickness,IndexType nBarsX,IndexType nBarsY);
+   void SetMomentCurvatureParameters(Float64 rho_s,Float64 fyh,Float64 fu,Float64 esh,Float64 esu,const std::vector<Float64>& axialLoads);
    void SetColumnParameters(Float64 diameter, Float64 fc, Float64 cover, Float64 As, Float64 Es, Float64 fy,Float64 ecl,Float64 etl);
    void SetUnitsMode(eafTypes::UnitMode um);
 
@@ -41,6 +44,15 @@ protected:
    afx_msg void OnUpdate();
    afx_msg void OnUSUnits();
    afx_msg void OnSIUnits();
+   afx_msg void OnImportLoads();
+   afx_msg void OnClearLoads();
+   afx_msg void OnUpdateClearLoads(CCmdUI* pCmdUI);
+   afx_msg void OnImportSchedule();
+   afx_msg void OnExportCurves();
+   afx_msg void OnClearSchedule();
+   afx_msg void OnUpdateSchedule(CCmdUI* pCmdUI);
+   afx_msg void OnUpdateRoundInput(CCmdUI* pCmdUI);
+   afx_msg void OnUpdateRectangularInput(CCmdUI* pCmdUI);
 
    afx_msg BOOL OnToolTipNotify(UINT id,NMHDR* pNMHDR, LRESULT* pResult);
    
@@ -27,6 +27,7 @@
 #include "..\resource.h"
 #include <EAF\EAFApp.h>
 #include "UltColDlgBar.h"
+#include "UltColDoc.h"
 #include <MFCTools\CustomDDX.h>
 
 #ifdef _DEBUG
@@ -76,4 +77,140 @@ void CUltColDlgBar::DoDataExchange(CDataExchange* pDX)
    DDX_UnitValueAndTag(pDX,IDC_FY,      IDC_FY_UNIT,      m_Fy,      pDispUnits->Stress);
    DDX_Text(pDX, IDC_ECL, m_ecl);
    DDX_Text(pDX, IDC_ETL, m_etl);
+
+   DDX_CBIndex(pDX,IDC_SHAPE,m_Shape);
+   DDX_UnitValueAndTag(pDX,IDC_WIDTH,IDC_WIDTH_UNIT,m_Width,        pDispUnits->ComponentDim);
+   DDX_UnitValueAndTag(pDX,IDC_DEPTH,IDC_DEPTH_UNIT,m_Depth,        pDispUnits->ComponentDim);
+   DDX_UnitValueAndTag(pDX,IDC_WALL, IDC_WALL_UNIT, m_WallThickness,pDispUnits->ComponentDim);
+   DDX_Text(pDX,IDC_BARS_X,m_nBarsX);
+   DDX_Text(pDX,IDC_BARS_Y,m_nBarsY);
+
+   if ( pDX->m_bSaveAndValidate && m_Shape == CUltColDoc::Rectangular )
+   {
+      DDV_UnitValueGreaterThanZero(pDX,IDC_WIDTH,m_Width,pDispUnits->ComponentDim);
+      DDV_UnitValueGreaterThanZero(pDX,IDC_DEPTH,m_Depth,pDispUnits->ComponentDim);
+      DDV_UnitValueZeroOrMore(pDX,IDC_WALL,m_WallThickness,pDispUnits->ComponentDim);
+      pDX->PrepareEditCtrl(IDC_BARS_X);
+      DDV_MinMaxUInt(pDX,m_nBarsX,2,100);
+      pDX->PrepareEditCtrl(IDC_BARS_Y);
+      DDV_MinMaxUInt(pDX,m_nBarsY,2,100);
+
+      if ( Min(m_Width,m_Depth) <= 2*m_WallThickness )
+      {
+         pDX->PrepareEditCtrl(IDC_WALL);
+         AfxMessageBox(_T("The wall thickness must be less than half the width and depth of the column. Use a wall thickness of zero for a solid column."),MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+
+      // the bars are at the cover, so they must be inside the section and outside the void
+      if ( Min(m_Width,m_Depth) <= 2*m_Cover )
+      {
+         pDX->PrepareEditCtrl(IDC_COVER);
+         AfxMessageBox(_T("The cover must be less than half the width and depth of the column."),MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+
+      if ( 0 < m_WallThickness && m_WallThickness <= m_Cover )
+      {
+         pDX->PrepareEditCtrl(IDC_COVER);
+         AfxMessageBox(_T("The cover must be less than the wall thickness of a hollow column."),MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+   }
+
+   DDX_Text(pDX,IDC_RHO_S,m_rho_s);
+   DDX_UnitValueAndTag(pDX,IDC_FYH,IDC_FYH_UNIT,m_fyh,pDispUnits->Stress);
+   DDX_UnitValueAndTag(pDX,IDC_FU, IDC_FU_UNIT, m_fu, pDispUnits->Stress);
+   DDX_Text(pDX,IDC_ESH,m_esh);
+   DDX_Text(pDX,IDC_ESU,m_esu);
+   DDX_AxialLoads(pDX);
+
+   if ( pDX->m_bSaveAndValidate )
+   {
+      pDX->PrepareEditCtrl(IDC_RHO_S);
+      DDV_MinMaxDouble(pDX,m_rho_s,0.0,0.1);
+      DDV_UnitValueGreaterThanZero(pDX,IDC_FYH,m_fyh,pDispUnits->Stress);
+
+      if ( m_fu < m_Fy )
+      {
+         pDX->PrepareEditCtrl(IDC_FU);
+         AfxMessageBox(_T("The tensile strength of the reinforcement, fu, must not be less than the yield strength, fy."),MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+
+      if ( m_esh < m_Fy/m_Es )
+      {
+         pDX->PrepareEditCtrl(IDC_ESH);
+         AfxMessageBox(_T("The strain at the onset of strain hardening, e sh, must not be less than the yield strain of the reinforcement."),MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+
+      if ( m_esu <= m_esh )
+      {
+         pDX->PrepareEditCtrl(IDC_ESU);
+         AfxMessageBox(_T("The ultimate strain of the reinforcement, e su, must be greater than the strain at the onset of strain hardening, e sh."),MB_OK | MB_ICONEXCLAMATION);
+         pDX->Fail();
+      }
+   }
+}
+
+void CUltColDlgBar::DDX_AxialLoads(CDataExchange* pDX)
+{
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtForceData& forceUnit(pApp->GetDisplayUnits()->GeneralForce);
+   SetDlgItemText(IDC_AXIAL_LOADS_UNIT,forceUnit.UnitOfMeasure.UnitTag().c_str());
+
+   CString strAxialLoads;
+   if ( pDX->m_bSaveAndValidate )
+   {
+      DDX_Text(pDX,IDC_AXIAL_LOADS,strAxialLoads);
+
+      std::vector<Float64> axialLoads;
+      int pos = 0;
+      CString strValue(strAxialLoads.Tokenize(_T(", "),pos));
+      while ( !strValue.IsEmpty() )
+      {
+         LPTSTR pEnd;
+         Float64 value = _tcstod(strValue,&pEnd);
+         if ( *pEnd != _T('\0') )
+         {
+            pDX->PrepareEditCtrl(IDC_AXIAL_LOADS);
+            AfxMessageBox(_T("Enter the axial loads for the moment-curvature analysis as a list of numbers separated by commas. Compression is positive."),MB_OK | MB_ICONEXCLAMATION);
+            pDX->Fail();
+         }
+         axialLoads.push_back(::ConvertToSysUnits(value,forceUnit.UnitOfMeasure));
+         strValue = strAxialLoads.Tokenize(_T(", "),pos);
+      }
+      m_AxialLoads.swap(axialLoads);
+   }
+   else
+   {
+      for ( auto P : m_AxialLoads )
+      {
+         CString strValue;
+         strValue.Format(_T("%g"),::ConvertFromSysUnits(P,forceUnit.UnitOfMeasure));
+         strAxialLoads += (strAxialLoads.IsEmpty() ? _T("") : _T(", ")) + strValue;
+      }
+      DDX_Text(pDX,IDC_AXIAL_LOADS,strAxialLoads);
+   }
+}
+
+bool CUltColDlgBar::IsRectangularSelected()
+{
+   CComboBox* pcbShape = (CComboBox*)GetDlgItem(IDC_SHAPE);
+   return pcbShape->GetCurSel() == CUltColDoc::Rectangular;
+}
+
+BOOL CUltColDlgBar::Create(CWnd* pParentWnd, UINT nIDTemplate, UINT nStyle, UINT nID)
+{
+   if ( !CDialogBar::Create(pParentWnd, nIDTemplate, nStyle, nID) )
+      return FALSE;
+
+   // order must match CUltColDoc::Shape
+   CComboBox* pcbShape = (CComboBox*)GetDlgItem(IDC_SHAPE);
+   pcbShape->AddString(_T("Round"));
+   pcbShape->AddString(_T("Rectangular"));
+   pcbShape->SetCurSel(0);
+
+   return TRUE;
 }
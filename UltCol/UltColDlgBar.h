@@ -40,7 +40,28 @@ public:
    Float64 m_ecl;
    Float64 m_etl;
 
+   int m_Shape; // index of CUltColDoc::Shape
+   Float64 m_Width;
+   Float64 m_Depth;
+   Float64 m_WallThickness;
+   UINT m_nBarsX;
+   UINT m_nBarsY;
+
+   Float64 m_rho_s;
+   Float64 m_fyh;
+   Float64 m_fu;
+   Float64 m_esh;
+   Float64 m_esu;
+   std::vector<Float64> m_AxialLoads; // entered as a list of values separated by commas
+
+   // Returns true if the rectangular shape is selected (the selection may not be applied yet)
+   bool IsRectangularSelected();
+
 protected:
 	DECLARE_MESSAGE_MAP()
    virtual void DoDataExchange(CDataExchange* pDX) override;
+   void DDX_AxialLoads(CDataExchange* pDX);
+
+public:
+   virtual BOOL Create(CWnd* pParentWnd, UINT nIDTemplate, UINT nStyle, UINT nID) override;
 };
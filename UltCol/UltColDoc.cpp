@@ -28,6 +28,8 @@
 #include "UltColDoc.h"
 #include "UltColTitlePageBuilder.h"
 #include "UltColChapterBuilder.h"
+#include "UltColFiberSection.h"
+#include "UltColMomentCurvature.h"
 #include "..\BEToolboxStatusBar.h"
 
 #include <EAF\EAFUtilities.h>
@@ -40,6 +42,20 @@ static char THIS_FILE[] = __FILE__;
 #endif
 
 
+static bool ParseNumber(const CString& strValue,Float64* pValue)
+{
+   CString str(strValue);
+   str.Trim();
+   if ( str.IsEmpty() )
+   {
+      return false;
+   }
+
+   LPTSTR pEnd;
+   *pValue = _tcstod(str,&pEnd);
+   return *pEnd == _T('\0');
+}
+
 // CUltColDoc
 
 IMPLEMENT_DYNCREATE(CUltColDoc, CBEToolboxDoc)
@@ -122,6 +138,23 @@ BOOL CUltColDoc::Init()
    m_ecl = 0.0020;
    m_etl = 0.0050;
 
+   m_Shape = Round;
+   m_Width = ::ConvertToSysUnits(36.0,unitMeasure::Inch);
+   m_Depth = ::ConvertToSysUnits(48.0,unitMeasure::Inch);
+   m_WallThickness = 0;
+   m_nBarsX = 6;
+   m_nBarsY = 8;
+
+   m_rho_s = 0.01;
+   m_fyh = ::ConvertToSysUnits(60.0,unitMeasure::KSI);
+   m_fu  = ::ConvertToSysUnits(90.0,unitMeasure::KSI);
+   m_esh = 0.0125;
+   m_esu = 0.06;
+   m_AxialLoads.clear();
+
+   m_LoadCases.clear();
+   m_Schedule.clear();
+
    return TRUE;
 }
 
@@ -131,6 +164,247 @@ void CUltColDoc::OnCloseDocument()
    CBEToolboxDoc::OnCloseDocument();
 }
 
+BOOL CUltColDoc::ImportLoadCases(LPCTSTR lpszPathName,CString* pstrError)
+{
+   CStdioFile file;
+   CFileException ex;
+   if ( !file.Open(lpszPathName,CFile::modeRead | CFile::shareDenyWrite | CFile::typeText,&ex) )
+   {
+      TCHAR szCause[256];
+      ex.GetErrorMessage(szCause,256);
+      pstrError->Format(_T("Unable to open %s\n%s"),lpszPathName,szCause);
+      return FALSE;
+   }
+
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   std::vector<ULTCOLLOADCASE> loadCases;
+   CString strLine;
+   while ( file.ReadString(strLine) )
+   {
+      int pos = 0;
+      CString strName(strLine.Tokenize(_T(","),pos));
+      CString strP(strLine.Tokenize(_T(","),pos));
+      CString strMx(strLine.Tokenize(_T(","),pos));
+      CString strMy(strLine.Tokenize(_T(","),pos));
+      strName.Trim();
+      strMy.Trim();
+
+      Float64 P, Mx, My = 0;
+      if ( strName.IsEmpty() || !ParseNumber(strP,&P) || !ParseNumber(strMx,&Mx) || (!strMy.IsEmpty() && !ParseNumber(strMy,&My)) )
+      {
+         continue;
+      }
+
+      ULTCOLLOADCASE loadCase;
+      loadCase.Name = strName.GetString();
+      loadCase.Pu  = ::ConvertToSysUnits(P, pDispUnits->GeneralForce.UnitOfMeasure);
+      loadCase.Mux = ::ConvertToSysUnits(Mx,pDispUnits->Moment.UnitOfMeasure);
+      loadCase.Muy = ::ConvertToSysUnits(My,pDispUnits->Moment.UnitOfMeasure);
+      loadCases.push_back(loadCase);
+   }
+
+   if ( loadCases.empty() )
+   {
+      pstrError->Format(_T("%s does not contain any load cases. Each load case must be on a separate line in the form Name,P,Mx,My"),lpszPathName);
+      return FALSE;
+   }
+
+   m_LoadCases.swap(loadCases);
+   return TRUE;
+}
+
+BOOL CUltColDoc::ImportSchedule(LPCTSTR lpszPathName,CString* pstrError)
+{
+   CStdioFile file;
+   CFileException ex;
+   if ( !file.Open(lpszPathName,CFile::modeRead | CFile::shareDenyWrite | CFile::typeText,&ex) )
+   {
+      TCHAR szCause[256];
+      ex.GetErrorMessage(szCause,256);
+      pstrError->Format(_T("Unable to open %s\n%s"),lpszPathName,szCause);
+      return FALSE;
+   }
+
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+
+   std::vector<ULTCOLSCHEDULEITEM> schedule;
+   CString strLine;
+   while ( file.ReadString(strLine) )
+   {
+      int pos = 0;
+      CString strName(strLine.Tokenize(_T(","),pos));
+      CString strDiameter(strLine.Tokenize(_T(","),pos));
+      CString strCover(strLine.Tokenize(_T(","),pos));
+      CString strAs(strLine.Tokenize(_T(","),pos));
+      CString strFc(strLine.Tokenize(_T(","),pos));
+      CString strFy(strLine.Tokenize(_T(","),pos));
+      strName.Trim();
+
+      Float64 diameter, cover, As, fc, fy;
+      if ( strName.IsEmpty() || !ParseNumber(strDiameter,&diameter) || !ParseNumber(strCover,&cover) || !ParseNumber(strAs,&As) || !ParseNumber(strFc,&fc) || !ParseNumber(strFy,&fy) )
+      {
+         continue;
+      }
+
+      ULTCOLSCHEDULEITEM column;
+      column.Name     = strName.GetString();
+      column.Diameter = ::ConvertToSysUnits(diameter,pDispUnits->ComponentDim.UnitOfMeasure);
+      column.Cover    = ::ConvertToSysUnits(cover,   pDispUnits->ComponentDim.UnitOfMeasure);
+      column.As       = ::ConvertToSysUnits(As,      pDispUnits->Area.UnitOfMeasure);
+      column.fc       = ::ConvertToSysUnits(fc,      pDispUnits->Stress.UnitOfMeasure);
+      column.fy       = ::ConvertToSysUnits(fy,      pDispUnits->Stress.UnitOfMeasure);
+
+      if ( column.Diameter <= 0 || column.Cover <= 0 || column.Diameter <= 2*column.Cover || column.As <= 0 || column.fc <= 0 || column.fy <= 0 )
+      {
+         pstrError->Format(_T("Column %s is not valid. The diameter, cover, As, f'c, and fy must be greater than zero and the cover must be less than the radius"),strName.GetString());
+         return FALSE;
+      }
+
+      schedule.push_back(column);
+   }
+
+   if ( schedule.empty() )
+   {
+      pstrError->Format(_T("%s does not contain any columns. Each column must be on a separate line in the form Name,Diameter,Cover,As,fc,fy"),lpszPathName);
+      return FALSE;
+   }
+
+   m_Schedule.swap(schedule);
+   return TRUE;
+}
+
+BOOL CUltColDoc::ExportScheduleCurves(LPCTSTR lpszPathName,CString* pstrError) const
+{
+   CStdioFile file;
+   CFileException ex;
+   if ( !file.Open(lpszPathName,CFile::modeCreate | CFile::modeWrite | CFile::shareExclusive | CFile::typeText,&ex) )
+   {
+      TCHAR szCause[256];
+      ex.GetErrorMessage(szCause,256);
+      pstrError->Format(_T("Unable to create %s\n%s"),lpszPathName,szCause);
+      return FALSE;
+   }
+
+   Float64 Es;
+   m_Column->get_Es(&Es);
+
+   std::vector<std::vector<ULTCOLINTERACTIONPOINT>> curves;
+   CUltColSchedule::ComputeInteraction(m_Schedule,Es,m_ecl,m_etl,curves);
+
+   CEAFApp* pApp = EAFGetApp();
+   const unitmgtIndirectMeasure* pDispUnits = pApp->GetDisplayUnits();
+   const unitMoment& momentUnit(pDispUnits->Moment.UnitOfMeasure);
+   const unitForce& forceUnit(pDispUnits->GeneralForce.UnitOfMeasure);
+
+   // Axial force is tension negative, the same as the report
+   CString strLine;
+   strLine.Format(_T("Column,Mn (%s),Pn (%s),phi,phi Mn (%s),phi Pn (%s)\n"),
+      momentUnit.UnitTag().c_str(),forceUnit.UnitTag().c_str(),momentUnit.UnitTag().c_str(),forceUnit.UnitTag().c_str());
+   file.WriteString(strLine);
+
+   IndexType nColumns = m_Schedule.size();
+   for ( IndexType columnIdx = 0; columnIdx < nColumns; columnIdx++ )
+   {
+      for ( const auto& point : curves[columnIdx] )
+      {
+         strLine.Format(_T("%s,%f,%f,%f,%f,%f\n"),m_Schedule[columnIdx].Name.c_str(),
+            ::ConvertFromSysUnits(point.Mn,momentUnit),
+            ::ConvertFromSysUnits(-point.Pn,forceUnit),
+            point.phi,
+            ::ConvertFromSysUnits(point.Mr,momentUnit),
+            ::ConvertFromSysUnits(-point.Pr,forceUnit));
+         file.WriteString(strLine);
+      }
+   }
+
+   return TRUE;
+}
+
+void CUltColDoc::InitFiberSection(CUltColFiberSection* pSection) const
+{
+   Float64 diameter, cover, As, fc, fy, Es;
+   m_Column->get_Diameter(&diameter);
+   m_Column->get_Cover(&cover);
+   m_Column->get_As(&As);
+   m_Column->get_fc(&fc);
+   m_Column->get_fy(&fy);
+   m_Column->get_Es(&Es);
+
+   if ( m_Shape == Round )
+   {
+      pSection->InitRoundSection(diameter,cover,As);
+   }
+   else
+   {
+      // outline, and the void of a hollow column, centered on the origin
+      Float64 w = m_Width/2;
+      Float64 d = m_Depth/2;
+      std::vector<Float64> x{-w, w, w,-w};
+      std::vector<Float64> y{-d,-d, d, d};
+      std::vector<IndexType> offsets{0,4};
+      std::vector<Float64> n{1.0};
+
+      Float64 t = m_WallThickness;
+      if ( 0 < t && 2*t < Min(m_Width,m_Depth) )
+      {
+         x.insert(x.end(),{-w+t, w-t, w-t,-w+t});
+         y.insert(y.end(),{-d+t,-d+t, d-t, d-t});
+         offsets.push_back(8);
+         n.push_back(-1.0);
+      }
+
+      // bars on the perimeter, at the cover. the dialog bar makes sure the bars are inside
+      // the section and outside the void
+      ATLASSERT(cover < Min(w,d));
+      ATLASSERT(t <= 0 || cover < t);
+      IndexType nx = Max(m_nBarsX,(IndexType)2);
+      IndexType ny = Max(m_nBarsY,(IndexType)2);
+      Float64 xb = w - cover;
+      Float64 yb = d - cover;
+      std::vector<Float64> barX, barY;
+      for ( IndexType i = 0; i < nx; i++ )
+      {
+         Float64 xi = -xb + 2*xb*i/(nx-1);
+         barX.insert(barX.end(),{xi,xi});
+         barY.insert(barY.end(),{-yb,yb});
+      }
+
+      for ( IndexType i = 1; i < ny-1; i++ )
+      {
+         Float64 yi = -yb + 2*yb*i/(ny-1);
+         barX.insert(barX.end(),{-xb,xb});
+         barY.insert(barY.end(),{yi,yi});
+      }
+
+      // the confined core is inside the center of the bars
+      Float64 core[] = {-xb,-yb,xb,yb};
+
+      std::vector<Float64> barA(barX.size(),As/barX.size());
+      pSection->InitSection(x.data(),y.data(),offsets.data(),n.data(),n.size(),barX.data(),barY.data(),barA.data(),barA.size(),core);
+   }
+
+   pSection->SetMaterials(fc,fy,Es);
+}
+
+void CUltColDoc::InitMomentCurvature(const CUltColFiberSection& section,Float64 angle,CUltColMomentCurvature* pAnalysis) const
+{
+   Float64 fc, fy, Es;
+   m_Column->get_fc(&fc);
+   m_Column->get_fy(&fy);
+   m_Column->get_Es(&Es);
+
+   // Ec = 57000 sqrt(f'c) psi, and the confinement effectiveness coefficient is 0.95 for spirals and 0.75 for rectangular hoops
+   Float64 Ec = ::ConvertToSysUnits(57000.0*sqrt(::ConvertFromSysUnits(fc,unitMeasure::PSI)),unitMeasure::PSI);
+   Float64 ke = (m_Shape == Round ? 0.95 : 0.75);
+
+   pAnalysis->Init(section,angle);
+   pAnalysis->SetReinforcement(Es,fy,m_fu,m_esh,m_esu);
+   pAnalysis->SetConcrete(fc,Ec,m_rho_s,m_fyh,ke);
+}
+
 void CUltColDoc::OnRefreshReport()
 {
    UpdateAllViews(nullptr);
@@ -138,7 +412,7 @@ void CUltColDoc::OnRefreshReport()
 
 HRESULT CUltColDoc::WriteTheDocument(IStructuredSave* pStrSave)
 {
-   HRESULT hr = pStrSave->BeginUnit(_T("UltCol"),2.0);
+   HRESULT hr = pStrSave->BeginUnit(_T("UltCol"),3.0);
    if ( FAILED(hr) )
       return hr;
 
@@ -190,6 +464,140 @@ HRESULT CUltColDoc::WriteTheDocument(IStructuredSave* pStrSave)
    if ( FAILED(hr) )
       return hr;
 
+   // added in version 3.0
+   hr = pStrSave->put_Property(_T("Shape"),CComVariant(m_Shape == Round ? _T("Round") : _T("Rectangular")));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("Width"),CComVariant(m_Width));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("Depth"),CComVariant(m_Depth));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("WallThickness"),CComVariant(m_WallThickness));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("BarsX"),CComVariant((long)m_nBarsX));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("BarsY"),CComVariant((long)m_nBarsY));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->BeginUnit(_T("LoadCases"),1.0);
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("Count"),CComVariant((long)m_LoadCases.size()));
+   if ( FAILED(hr) )
+      return hr;
+
+   for ( const auto& loadCase : m_LoadCases )
+   {
+      hr = pStrSave->put_Property(_T("Name"),CComVariant(loadCase.Name.c_str()));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("Pu"),CComVariant(loadCase.Pu));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("Mux"),CComVariant(loadCase.Mux));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("Muy"),CComVariant(loadCase.Muy));
+      if ( FAILED(hr) )
+         return hr;
+   }
+
+   hr = pStrSave->EndUnit(); // LoadCases
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->BeginUnit(_T("Schedule"),1.0);
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("Count"),CComVariant((long)m_Schedule.size()));
+   if ( FAILED(hr) )
+      return hr;
+
+   for ( const auto& column : m_Schedule )
+   {
+      hr = pStrSave->put_Property(_T("Name"),CComVariant(column.Name.c_str()));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("Diameter"),CComVariant(column.Diameter));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("Cover"),CComVariant(column.Cover));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("As"),CComVariant(column.As));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("fc"),CComVariant(column.fc));
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrSave->put_Property(_T("fy"),CComVariant(column.fy));
+      if ( FAILED(hr) )
+         return hr;
+   }
+
+   hr = pStrSave->EndUnit(); // Schedule
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->BeginUnit(_T("MomentCurvature"),1.0);
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("rho_s"),CComVariant(m_rho_s));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("fyh"),CComVariant(m_fyh));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("fu"),CComVariant(m_fu));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("esh"),CComVariant(m_esh));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("esu"),CComVariant(m_esu));
+   if ( FAILED(hr) )
+      return hr;
+
+   hr = pStrSave->put_Property(_T("Count"),CComVariant((long)m_AxialLoads.size()));
+   if ( FAILED(hr) )
+      return hr;
+
+   for ( auto P : m_AxialLoads )
+   {
+      hr = pStrSave->put_Property(_T("P"),CComVariant(P));
+      if ( FAILED(hr) )
+         return hr;
+   }
+
+   hr = pStrSave->EndUnit(); // MomentCurvature
+   if ( FAILED(hr) )
+      return hr;
+
    hr = pStrSave->EndUnit();
    if ( FAILED(hr) )
       return hr;
@@ -259,6 +667,202 @@ HRESULT CUltColDoc::LoadTheDocument(IStructuredLoad* pStrLoad)
       m_etl = var.dblVal;
    }
 
+   m_Shape = Round;
+   m_LoadCases.clear();
+   m_Schedule.clear();
+   m_AxialLoads.clear();
+   if ( 2 < version )
+   {
+      var.Clear();
+      var.vt = VT_BSTR;
+      hr = pStrLoad->get_Property(_T("Shape"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_Shape = (CString(var.bstrVal) == _T("Rectangular") ? Rectangular : Round);
+
+      var.Clear();
+      var.vt = VT_R8;
+      hr = pStrLoad->get_Property(_T("Width"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_Width = var.dblVal;
+
+      hr = pStrLoad->get_Property(_T("Depth"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_Depth = var.dblVal;
+
+      hr = pStrLoad->get_Property(_T("WallThickness"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_WallThickness = var.dblVal;
+
+      var.vt = VT_I4;
+      hr = pStrLoad->get_Property(_T("BarsX"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_nBarsX = (IndexType)var.lVal;
+
+      hr = pStrLoad->get_Property(_T("BarsY"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_nBarsY = (IndexType)var.lVal;
+
+      hr = pStrLoad->BeginUnit(_T("LoadCases"));
+      if ( FAILED(hr) )
+         return hr;
+
+      var.vt = VT_I4;
+      hr = pStrLoad->get_Property(_T("Count"),&var);
+      if ( FAILED(hr) )
+         return hr;
+
+      long nLoadCases = var.lVal;
+      m_LoadCases.reserve(nLoadCases);
+      for ( long i = 0; i < nLoadCases; i++ )
+      {
+         ULTCOLLOADCASE loadCase;
+
+         var.Clear();
+         var.vt = VT_BSTR;
+         hr = pStrLoad->get_Property(_T("Name"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         loadCase.Name = CString(var.bstrVal).GetString();
+
+         var.Clear();
+         var.vt = VT_R8;
+         hr = pStrLoad->get_Property(_T("Pu"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         loadCase.Pu = var.dblVal;
+
+         hr = pStrLoad->get_Property(_T("Mux"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         loadCase.Mux = var.dblVal;
+
+         hr = pStrLoad->get_Property(_T("Muy"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         loadCase.Muy = var.dblVal;
+
+         m_LoadCases.push_back(loadCase);
+      }
+
+      hr = pStrLoad->EndUnit(); // LoadCases
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrLoad->BeginUnit(_T("Schedule"));
+      if ( FAILED(hr) )
+         return hr;
+
+      var.Clear();
+      var.vt = VT_I4;
+      hr = pStrLoad->get_Property(_T("Count"),&var);
+      if ( FAILED(hr) )
+         return hr;
+
+      long nColumns = var.lVal;
+      m_Schedule.reserve(nColumns);
+      for ( long i = 0; i < nColumns; i++ )
+      {
+         ULTCOLSCHEDULEITEM column;
+
+         var.Clear();
+         var.vt = VT_BSTR;
+         hr = pStrLoad->get_Property(_T("Name"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         column.Name = CString(var.bstrVal).GetString();
+
+         var.Clear();
+         var.vt = VT_R8;
+         hr = pStrLoad->get_Property(_T("Diameter"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         column.Diameter = var.dblVal;
+
+         hr = pStrLoad->get_Property(_T("Cover"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         column.Cover = var.dblVal;
+
+         hr = pStrLoad->get_Property(_T("As"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         column.As = var.dblVal;
+
+         hr = pStrLoad->get_Property(_T("fc"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         column.fc = var.dblVal;
+
+         hr = pStrLoad->get_Property(_T("fy"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         column.fy = var.dblVal;
+
+         m_Schedule.push_back(column);
+      }
+
+      hr = pStrLoad->EndUnit(); // Schedule
+      if ( FAILED(hr) )
+         return hr;
+
+      hr = pStrLoad->BeginUnit(_T("MomentCurvature"));
+      if ( FAILED(hr) )
+         return hr;
+
+      var.Clear();
+      var.vt = VT_R8;
+      hr = pStrLoad->get_Property(_T("rho_s"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_rho_s = var.dblVal;
+
+      hr = pStrLoad->get_Property(_T("fyh"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_fyh = var.dblVal;
+
+      hr = pStrLoad->get_Property(_T("fu"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_fu = var.dblVal;
+
+      hr = pStrLoad->get_Property(_T("esh"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_esh = var.dblVal;
+
+      hr = pStrLoad->get_Property(_T("esu"),&var);
+      if ( FAILED(hr) )
+         return hr;
+      m_esu = var.dblVal;
+
+      var.vt = VT_I4;
+      hr = pStrLoad->get_Property(_T("Count"),&var);
+      if ( FAILED(hr) )
+         return hr;
+
+      long nAxialLoads = var.lVal;
+      m_AxialLoads.reserve(nAxialLoads);
+      var.vt = VT_R8;
+      for ( long i = 0; i < nAxialLoads; i++ )
+      {
+         hr = pStrLoad->get_Property(_T("P"),&var);
+         if ( FAILED(hr) )
+            return hr;
+         m_AxialLoads.push_back(var.dblVal);
+      }
+
+      hr = pStrLoad->EndUnit(); // MomentCurvature
+      if ( FAILED(hr) )
+         return hr;
+   }
+
    hr = pStrLoad->EndUnit();
    if ( FAILED(hr) )
       return hr;
@@ -29,6 +29,19 @@
 #include <WBFLUnitServer.h>
 #include <WBFLRCCapacity.h>
 #include <ReportManager\ReportManager.h>
+#include "UltColSchedule.h"
+
+class CUltColFiberSection;
+class CUltColMomentCurvature;
+
+// A column demand. Axial force is compression positive
+struct ULTCOLLOADCASE
+{
+   std::_tstring Name;
+   Float64 Pu;
+   Float64 Mux; // moment about the x-axis
+   Float64 Muy; // moment about the y-axis
+};
 
 class CUltColDoc : public CBEToolboxDoc
 {
@@ -71,8 +84,49 @@ public:
    // over-ride default behavior by destroying column
    virtual void OnCloseDocument();
 
+   // Reads load cases from a CSV file with lines of Name,P,Mx,My in display units. My is optional.
+   // Lines that don't start with a name and two numbers, such as a header, are skipped. Replaces the current load cases.
+   BOOL ImportLoadCases(LPCTSTR lpszPathName,CString* pstrError);
+
+   // Reads a column schedule from a CSV file with lines of Name,Diameter,Cover,As,fc,fy in display units.
+   // Lines that don't start with a name and five numbers, such as a header, are skipped. Replaces the current schedule.
+   BOOL ImportSchedule(LPCTSTR lpszPathName,CString* pstrError);
+
+   // Writes the interaction diagrams of the columns in the schedule to a CSV file in display units
+   BOOL ExportScheduleCurves(LPCTSTR lpszPathName,CString* pstrError) const;
+
+   // Discretizes the column for the native fiber section model
+   void InitFiberSection(CUltColFiberSection* pSection) const;
+
+   // Initializes a moment-curvature analysis of the column for a neutral axis at angle
+   void InitMomentCurvature(const CUltColFiberSection& section,Float64 angle,CUltColMomentCurvature* pAnalysis) const;
+
+   // The diameter of round columns, and the cover, reinforcement, and materials of all columns, are stored in m_Column
    CComPtr<IRoundColumn> m_Column;
    Float64 m_ecl;
    Float64 m_etl;
+
+   // Rectangular columns. The reinforcement, As, is divided equally among bars spaced evenly around
+   // the perimeter. There are m_nBarsX bars on the faces parallel to the width and m_nBarsY bars on
+   // the faces parallel to the depth. The corner bars are counted on both faces.
+   enum Shape {Round,Rectangular};
+   Shape m_Shape;
+   Float64 m_Width; // dimension parallel to the x-axis
+   Float64 m_Depth; // dimension parallel to the y-axis
+   Float64 m_WallThickness; // the column is hollow if the wall thickness is greater than zero
+   IndexType m_nBarsX;
+   IndexType m_nBarsY;
+   std::vector<ULTCOLLOADCASE> m_LoadCases;
+
+   // Moment-curvature analysis. The concrete inside the center of the reinforcement is confined by transverse reinforcement.
+   Float64 m_rho_s; // volumetric ratio of transverse reinforcement
+   Float64 m_fyh;   // yield strength of the transverse reinforcement
+   Float64 m_fu;    // tensile strength of the reinforcement
+   Float64 m_esh;   // strain at the onset of strain hardening
+   Float64 m_esu;   // ultimate strain of the reinforcement
+   std::vector<Float64> m_AxialLoads; // the moment-curvature analysis is done for each axial force (compression is positive)
+
+   // Round columns that are evaluated in addition to m_Column. Es and the strain limits are the same as m_Column
+   std::vector<ULTCOLSCHEDULEITEM> m_Schedule;
    CReportBuilderManager m_RptMgr;
 };
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+// Native fiber section model for UltCol. Used in place of the WBFL RoundColumn object
+// so the interaction diagram can be computed with many points, and for sections the
+// RoundColumn can't model. The section is part of the portable engine (see Engine\FiberSection.h).
+
+#include "..\Engine\FiberSection.h"
+
+typedef BEToolboxEngine::INTERACTIONPOINT ULTCOLINTERACTIONPOINT;
+typedef BEToolboxEngine::FIBERS ULTCOLFIBERS;
+
+class CUltColFiberSection : public BEToolboxEngine::CFiberSection
+{
+public:
+   // Sets the materials in system units. The stress block factor is computed from fc.
+   void SetMaterials(Float64 fc,Float64 fy,Float64 Es);
+};
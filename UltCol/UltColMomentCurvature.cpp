@@ -0,0 +1,504 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "UltColMomentCurvature.h"
+#include "..\BEToolboxUtilities.h"
+#include <numeric>
+#include <functional>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+namespace
+{
+   const Float64 ConcreteYieldStrain = 0.002; // concrete strain that defines first yield
+   const IndexType nMaxSteps = 2000;
+   const IndexType nMaxIterations = 50;
+   const IndexType nRefinements = 30;
+
+   // Mander's stress-strain relationship. Returns the stress and tangent modulus for strain e (compression is positive)
+   inline void Mander(Float64 e,Float64 fcc,Float64 ecc,Float64 Ec,Float64* pf,Float64* pEt)
+   {
+      if ( e <= 0 )
+      {
+         // tension is ignored
+         *pf = 0;
+         *pEt = 0;
+         return;
+      }
+
+      Float64 Esec = fcc/ecc;
+      Float64 r = Ec/(Ec - Min(Esec,0.99*Ec));
+      Float64 x = e/ecc;
+      Float64 xr = pow(x,r);
+      Float64 D = r - 1 + xr;
+      *pf = fcc*r*x/D;
+      *pEt = (fcc/ecc)*r*(r - 1)*(1 - xr)/(D*D);
+   }
+
+   // Unconfined concrete follows Mander's curve to twice the strain at peak stress, then
+   // decreases linearly to zero at the spalling strain
+   inline void Unconfined(Float64 e,Float64 fc,Float64 eco,Float64 esp,Float64 Ec,Float64* pf,Float64* pEt)
+   {
+      if ( e <= 2*eco )
+      {
+         Mander(e,fc,eco,Ec,pf,pEt);
+      }
+      else if ( e < esp )
+      {
+         Float64 f2, Et2;
+         Mander(2*eco,fc,eco,Ec,&f2,&Et2);
+         *pEt = -f2/(esp - 2*eco);
+         *pf = f2 + (*pEt)*(e - 2*eco);
+      }
+      else
+      {
+         *pf = 0;
+         *pEt = 0;
+      }
+   }
+
+   // Reinforcement is the same in tension and compression
+   inline void Steel(Float64 e,Float64 Es,Float64 fy,Float64 fu,Float64 esh,Float64 esu,Float64* pf,Float64* pEt)
+   {
+      Float64 sign = (e < 0 ? -1.0 : 1.0);
+      Float64 a = fabs(e);
+      if ( a*Es <= fy )
+      {
+         *pf = Es*e;
+         *pEt = Es;
+      }
+      else if ( a <= esh )
+      {
+         *pf = sign*fy;
+         *pEt = 0;
+      }
+      else if ( a < esu )
+      {
+         Float64 x = (esu - a)/(esu - esh);
+         *pf = sign*(fu - (fu - fy)*x*x);
+         *pEt = 2*(fu - fy)*x/(esu - esh);
+      }
+      else
+      {
+         *pf = sign*fu;
+         *pEt = 0;
+      }
+   }
+}
+
+CUltColMomentCurvature::CUltColMomentCurvature()
+{
+   m_yMaxConfined = 0;
+   m_yMinSteel = 0;
+   m_As = 0;
+   m_Ac = 0;
+   m_fc = 0;
+   m_Ec = 0;
+   m_eco = 0.002;
+   m_esp = 0.005;
+   m_fcc = 0;
+   m_ecc = 0.002;
+   m_ecu = 0.004;
+   m_Es = 0;
+   m_fy = 0;
+   m_fu = 0;
+   m_esh = 0;
+   m_esu = 0;
+}
+
+void CUltColMomentCurvature::Init(const CUltColFiberSection& section,Float64 angle)
+{
+   section.GetFibers(angle,&m_Fibers);
+
+   // the extreme confined fiber is used to detect crushing. if there isn't a confined core, the extreme concrete fiber is used.
+   m_yMaxConfined = -Float64_Max;
+   IndexType nFibers = m_Fibers.ConcreteY.size();
+   for ( IndexType i = 0; i < nFibers; i++ )
+   {
+      if ( 0 < m_Fibers.ConfinedA[i] )
+      {
+         m_yMaxConfined = Max(m_yMaxConfined,m_Fibers.ConcreteY[i]);
+      }
+   }
+   if ( m_yMaxConfined == -Float64_Max )
+   {
+      m_yMaxConfined = m_Fibers.Ytop;
+   }
+
+   m_As = std::accumulate(m_Fibers.SteelA.cbegin(),m_Fibers.SteelA.cend(),0.0);
+   m_Ac = std::accumulate(m_Fibers.ConfinedA.cbegin(),m_Fibers.ConfinedA.cend(),0.0) + std::accumulate(m_Fibers.UnconfinedA.cbegin(),m_Fibers.UnconfinedA.cend(),0.0);
+
+   m_yMinSteel = (m_Fibers.SteelY.empty() ? m_Fibers.Ytop - m_Fibers.Height : *std::min_element(m_Fibers.SteelY.cbegin(),m_Fibers.SteelY.cend()));
+}
+
+void CUltColMomentCurvature::SetConcrete(Float64 fc,Float64 Ec,Float64 rho_s,Float64 fyh,Float64 ke)
+{
+   m_fc = fc;
+   m_Ec = Ec;
+   m_eco = 0.002;
+   m_esp = 0.005;
+
+   // Mander's confined strength for equal confining pressure in both directions
+   Float64 fl = 0.5*ke*rho_s*fyh;
+   m_fcc = fc*(-1.254 + 2.254*sqrt(1 + 7.94*fl/fc) - 2*fl/fc);
+   m_ecc = m_eco*(1 + 5*(m_fcc/fc - 1));
+   m_ecu = 0.004 + 1.4*rho_s*fyh*m_esu/m_fcc;
+}
+
+void CUltColMomentCurvature::SetReinforcement(Float64 Es,Float64 fy,Float64 fu,Float64 esh,Float64 esu)
+{
+   ATLASSERT(fy <= fu && fy/Es <= esh && esh < esu);
+   m_Es = Es;
+   m_fy = fy;
+   m_fu = fu;
+   m_esh = esh;
+   m_esu = esu;
+}
+
+Float64 CUltColMomentCurvature::GetConfinedStrength() const
+{
+   return m_fcc;
+}
+
+Float64 CUltColMomentCurvature::GetConfinedStrain() const
+{
+   return m_ecc;
+}
+
+Float64 CUltColMomentCurvature::GetUltimateConcreteStrain() const
+{
+   return m_ecu;
+}
+
+Float64 CUltColMomentCurvature::GetGrossStiffness() const
+{
+   Float64 Ig = 0;
+   IndexType nFibers = m_Fibers.ConcreteY.size();
+   for ( IndexType i = 0; i < nFibers; i++ )
+   {
+      Float64 y = m_Fibers.ConcreteY[i];
+      Ig += (m_Fibers.ConfinedA[i] + m_Fibers.UnconfinedA[i])*y*y;
+   }
+   return m_Ec*Ig;
+}
+
+void CUltColMomentCurvature::Evaluate(Float64 phi,Float64 c,Float64* pN,Float64* pM,Float64* pdNdc) const
+{
+   // strain at elevation y is phi*(y - yNA) where yNA is the elevation of the neutral axis
+   Float64 yNA = m_Fibers.Ytop - c;
+   Float64 N = 0, M = 0, K = 0;
+
+   const Float64* pY  = m_Fibers.ConcreteY.data();
+   const Float64* pAc = m_Fibers.ConfinedA.data();
+   const Float64* pAu = m_Fibers.UnconfinedA.data();
+   IndexType nFibers = m_Fibers.ConcreteY.size();
+   for ( IndexType i = 0; i < nFibers; i++ )
+   {
+      Float64 e = phi*(pY[i] - yNA);
+      if ( e <= 0 )
+      {
+         continue;
+      }
+
+      Float64 fcc, Etc, fc, Etu;
+      Mander(e,m_fcc,m_ecc,m_Ec,&fcc,&Etc);
+      Unconfined(e,m_fc,m_eco,m_esp,m_Ec,&fc,&Etu);
+      Float64 F = fcc*pAc[i] + fc*pAu[i];
+      N += F;
+      M += F*pY[i];
+      K += Etc*pAc[i] + Etu*pAu[i];
+   }
+
+   // the reinforcement displaces confined concrete
+   IndexType nBars = m_Fibers.SteelY.size();
+   for ( IndexType i = 0; i < nBars; i++ )
+   {
+      Float64 y = m_Fibers.SteelY[i];
+      Float64 e = phi*(y - yNA);
+      Float64 fs, Ets, fcc, Etc;
+      Steel(e,m_Es,m_fy,m_fu,m_esh,m_esu,&fs,&Ets);
+      Mander(e,m_fcc,m_ecc,m_Ec,&fcc,&Etc);
+      Float64 A = m_Fibers.SteelA[i];
+      Float64 F = (fs - fcc)*A;
+      N += F;
+      M += F*y;
+      K += (Ets - Etc)*A;
+   }
+
+   *pN = N;
+   *pM = M;
+   *pdNdc = phi*K; // de/dc = phi
+}
+
+bool CUltColMomentCurvature::SolveDepth(Float64 P,Float64 phi,Float64* pC) const
+{
+   Float64 H = m_Fibers.Height;
+   Float64 tolerance = 1.0e-8*(m_fcc*m_Ac + m_fu*m_As);
+
+   // Safeguarded Newton iteration. The residual increases with c except where the concrete is softening, so the
+   // last depths with a negative and positive residual bracket the solution. When a Newton step leaves the bracket
+   // or the tangent isn't positive, the bracket is bisected.
+   Float64 c = *pC;
+   Float64 cLow = 0, cHigh = 0;
+   bool bLow = false, bHigh = false;
+   for ( IndexType iter = 0; iter < nMaxIterations; iter++ )
+   {
+      Float64 N, M, dN;
+      Evaluate(phi,c,&N,&M,&dN);
+      Float64 R = N - P;
+      if ( fabs(R) < tolerance )
+      {
+         *pC = c;
+         return true;
+      }
+
+      if ( R < 0 )
+      {
+         cLow = c;
+         bLow = true;
+      }
+      else
+      {
+         cHigh = c;
+         bHigh = true;
+      }
+
+      Float64 cNext;
+      if ( 0 < dN )
+      {
+         cNext = c - R/dN;
+         cNext = Max(c - H,Min(cNext,c + H)); // limit the step
+      }
+      else
+      {
+         cNext = c + (R < 0 ? H/4 : -H/4);
+      }
+
+      if ( bLow && bHigh && (cNext <= Min(cLow,cHigh) || Max(cLow,cHigh) <= cNext) )
+      {
+         cNext = (cLow + cHigh)/2;
+      }
+
+      c = cNext;
+   }
+
+   return false;
+}
+
+ULTCOLMOMENTCURVATUREPOINT CUltColMomentCurvature::GetPoint(Float64 phi,Float64 c) const
+{
+   Float64 N, dN;
+   ULTCOLMOMENTCURVATUREPOINT point;
+   point.Curvature = phi;
+   point.c = c;
+   Evaluate(phi,c,&N,&point.M,&dN);
+   point.ec = phi*(m_yMaxConfined - m_Fibers.Ytop + c);
+   point.es = phi*(m_Fibers.Ytop - c - m_yMinSteel);
+   return point;
+}
+
+void CUltColMomentCurvature::Compute(Float64 P,ULTCOLMOMENTCURVATURE* pResult) const
+{
+   pResult->P = P;
+   pResult->bValid = false;
+   pResult->Points.clear();
+   pResult->Limit = mcMaxSteps;
+   pResult->My = 0;
+   pResult->PhiY = 0;
+   pResult->EIeff = 0;
+   pResult->Mp = 0;
+   pResult->PhiYi = 0;
+   pResult->Mu = 0;
+   pResult->PhiU = 0;
+
+   Float64 H = m_Fibers.Height;
+   Float64 ey = m_fy/m_Es;
+
+   // ratios of the strains to the strains that define first yield and the ultimate limit state
+   auto yieldRatio = [this,ey](Float64 phi,Float64 c)
+   {
+      return Max(phi*(m_Fibers.Ytop - c - m_yMinSteel)/ey,phi*c/ConcreteYieldStrain);
+   };
+   auto ultimateRatio = [this](Float64 phi,Float64 c)
+   {
+      return Max(phi*(m_yMaxConfined - m_Fibers.Ytop + c)/m_ecu,phi*(m_Fibers.Ytop - c - m_yMinSteel)/m_esu);
+   };
+
+   // Finds the curvature between phi1 (ratio < 1) and phi2 (ratio >= 1) where the ratio is 1
+   auto refine = [this,P](Float64 phi1,Float64 c1,Float64 phi2,Float64 c2,const std::function<Float64(Float64,Float64)>& ratio,Float64* pPhi,Float64* pC)
+   {
+      for ( IndexType i = 0; i < nRefinements; i++ )
+      {
+         Float64 phi = (phi1 + phi2)/2;
+         Float64 c = (c1 + c2)/2;
+         if ( SolveDepth(P,phi,&c) && ratio(phi,c) < 1.0 )
+         {
+            phi1 = phi;
+            c1 = c;
+         }
+         else
+         {
+            phi2 = phi;
+            c2 = c;
+         }
+      }
+      *pPhi = phi1;
+      *pC = c1;
+   };
+
+   // curvature increments are based on an estimate of the yield curvature
+   Float64 phiYieldEstimate = 2.2*ey/H;
+   Float64 dPhiElastic = phiYieldEstimate/20;
+   Float64 dPhiPlastic = phiYieldEstimate/5;
+
+   // initial depth of the neutral axis from an elastic estimate of the uniform strain. there isn't an
+   // axial stiffness if the section is in tension and doesn't have reinforcement
+   Float64 EA = (0 < P ? m_Ec*m_Ac : 0.0) + m_Es*m_As;
+   Float64 e0 = (IsZero(EA) ? 0.0 : P/EA);
+   Float64 phi = dPhiElastic;
+   Float64 c = m_Fibers.Ytop + e0/phi;
+   if ( !SolveDepth(P,phi,&c) )
+   {
+      return;
+   }
+
+   pResult->bValid = true;
+
+   bool bYield = false;
+   Float64 phiPrev = 0;
+   Float64 cPrev = c;
+   for ( IndexType step = 0; step < nMaxSteps; step++ )
+   {
+      bool bEquilibrium = (0 < step ? SolveDepth(P,phi,&c) : true);
+
+      if ( !bEquilibrium )
+      {
+         // the last point on the curve is the previous step, and it has already been added
+         pResult->Limit = mcEquilibrium;
+         break;
+      }
+
+      if ( 1.0 <= ultimateRatio(phi,c) )
+      {
+         Float64 phiU, cU;
+         refine(phiPrev,cPrev,phi,c,ultimateRatio,&phiU,&cU);
+
+         if ( !bYield && 0 < phiU )
+         {
+            // the section reached its ultimate limit state before first yield
+            ULTCOLMOMENTCURVATUREPOINT point = GetPoint(phiU,cU);
+            pResult->PhiY = phiU;
+            pResult->My = point.M;
+         }
+
+         if ( 0 < phiU )
+         {
+            pResult->Points.push_back(GetPoint(phiU,cU));
+         }
+
+         // the limit state is the strain that is closest to its ultimate value
+         ULTCOLMOMENTCURVATUREPOINT point = GetPoint(phi,c);
+         pResult->Limit = (point.ec/m_ecu < point.es/m_esu ? mcSteelFracture : mcConcreteCrushing);
+         break;
+      }
+
+      if ( !bYield && 1.0 <= yieldRatio(phi,c) )
+      {
+         // add the first yield point
+         Float64 phiY, cY;
+         refine(phiPrev,cPrev,phi,c,yieldRatio,&phiY,&cY);
+         if ( 0 < phiY )
+         {
+            pResult->Points.push_back(GetPoint(phiY,cY));
+            pResult->PhiY = phiY;
+            pResult->My = pResult->Points.back().M;
+         }
+         bYield = true;
+      }
+
+      pResult->Points.push_back(GetPoint(phi,c));
+
+      phiPrev = phi;
+      cPrev = c;
+      phi += (bYield ? dPhiPlastic : dPhiElastic);
+   }
+
+   if ( pResult->Points.empty() )
+   {
+      pResult->bValid = false;
+      return;
+   }
+
+   Idealize(pResult);
+}
+
+void CUltColMomentCurvature::Idealize(ULTCOLMOMENTCURVATURE* pResult) const
+{
+   const ULTCOLMOMENTCURVATUREPOINT& last(pResult->Points.back());
+   pResult->PhiU = last.Curvature;
+   pResult->Mu = last.M;
+
+   if ( IsZero(pResult->PhiY) )
+   {
+      // the analysis ended before first yield
+      pResult->PhiY = pResult->PhiU;
+      pResult->My = pResult->Mu;
+   }
+
+   pResult->EIeff = pResult->My/pResult->PhiY;
+
+   // area under the moment-curvature curve, starting from the origin
+   Float64 area = 0;
+   Float64 phiPrev = 0, Mprev = 0;
+   for ( const auto& point : pResult->Points )
+   {
+      area += 0.5*(point.M + Mprev)*(point.Curvature - phiPrev);
+      phiPrev = point.Curvature;
+      Mprev = point.M;
+   }
+
+   // area under the idealized curve is Mp*PhiU - Mp^2/(2 EIeff). Mp is the smaller root
+   Float64 EI = pResult->EIeff;
+   Float64 phiU = pResult->PhiU;
+   Float64 d = Max(0.0,phiU*phiU - 2*area/EI);
+   pResult->Mp = EI*(phiU - sqrt(d));
+   pResult->PhiYi = pResult->Mp/EI;
+}
+
+void CUltColMomentCurvature::Compute(const std::vector<Float64>& vP,std::vector<ULTCOLMOMENTCURVATURE>& results) const
+{
+   // Each axial force is independent and written to its own result
+   IndexType nCases = vP.size();
+   results.resize(nCases);
+   ParallelFor(nCases,[&](IndexType /*threadIdx*/,IndexType begin,IndexType end)
+   {
+      for ( IndexType i = begin; i < end; i++ )
+      {
+         Compute(vP[i],&results[i]);
+      }
+   });
+}
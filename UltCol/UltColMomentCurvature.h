@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "UltColFiberSection.h"
+
+// A point on a moment-curvature curve
+struct ULTCOLMOMENTCURVATUREPOINT
+{
+   Float64 Curvature;
+   Float64 M;  // moment
+   Float64 c;  // depth of the neutral axis measured from the extreme compression fiber
+   Float64 ec; // strain in the extreme confined concrete fiber (compression is positive)
+   Float64 es; // strain in the extreme tension reinforcement (tension is positive)
+};
+
+// The limit state that ends a moment-curvature analysis
+enum UltColMomentCurvatureLimit
+{
+   mcConcreteCrushing, // the confined concrete reached its ultimate strain
+   mcSteelFracture,    // the reinforcement reached its ultimate strain
+   mcEquilibrium,      // the section can't resist the axial force at a greater curvature
+   mcMaxSteps          // the analysis ended after the maximum number of curvature steps
+};
+
+// Moment-curvature relationship and its bilinear idealization for an axial force
+struct ULTCOLMOMENTCURVATURE
+{
+   Float64 P; // axial force, compression is positive
+   bool bValid; // false if the section can't resist P
+   std::vector<ULTCOLMOMENTCURVATUREPOINT> Points;
+   UltColMomentCurvatureLimit Limit;
+
+   // First yield is when the extreme tension reinforcement yields or the extreme concrete fiber
+   // reaches a strain of 0.002, whichever comes first.
+   Float64 My;   // moment at first yield
+   Float64 PhiY; // curvature at first yield
+   Float64 EIeff; // effective flexural stiffness (My/PhiY)
+
+   // Elastic-perfectly plastic idealization. The elastic branch passes through the first yield point and
+   // Mp is chosen so the area under the idealized curve is equal to the area under the computed curve.
+   Float64 Mp;    // idealized plastic moment
+   Float64 PhiYi; // idealized yield curvature (Mp/EIeff)
+   Float64 Mu;    // moment at the ultimate curvature
+   Float64 PhiU;  // ultimate curvature
+};
+
+// Moment-curvature analysis of a fiber section.
+//
+// The concrete in the confined core is modeled with Mander's confined concrete model. The concrete outside of the
+// core (cover) is unconfined and spalls. The reinforcement is elastic-perfectly plastic up to the onset of strain
+// hardening and then hardens parabolically to its tensile strength (the Caltrans SDC model).
+//
+// The fibers are taken from the section once, and the curvature is increased step by step. At each step the
+// depth of the neutral axis is found with a Newton iteration, starting from the depth of the previous step.
+class CUltColMomentCurvature
+{
+public:
+   CUltColMomentCurvature();
+
+   // Takes the fibers from a section for a neutral axis at angle (as for CUltColFiberSection::ComputeCapacity)
+   void Init(const CUltColFiberSection& section,Float64 angle);
+
+   // Concrete with strength fc and modulus of elasticity Ec. The confinement is defined by the volumetric ratio of transverse
+   // reinforcement, rho_s, its yield strength, fyh, and the confinement effectiveness coefficient, ke. The ultimate strain
+   // of the confined concrete is 0.004 + 1.4 rho_s fyh esu/f'cc where esu is the ultimate strain of the reinforcement.
+   void SetConcrete(Float64 fc,Float64 Ec,Float64 rho_s,Float64 fyh,Float64 ke);
+
+   // Reinforcement with modulus of elasticity Es, yield strength fy, tensile strength fu, strain at the onset
+   // of strain hardening esh, and ultimate strain esu. Call before SetConcrete.
+   void SetReinforcement(Float64 Es,Float64 fy,Float64 fu,Float64 esh,Float64 esu);
+
+   Float64 GetConfinedStrength() const;    // f'cc
+   Float64 GetConfinedStrain() const;      // strain at f'cc
+   Float64 GetUltimateConcreteStrain() const;
+
+   // Returns Ec*Ig of the gross concrete section
+   Float64 GetGrossStiffness() const;
+
+   // Computes the moment-curvature relationship for axial force P (compression is positive)
+   void Compute(Float64 P,ULTCOLMOMENTCURVATURE* pResult) const;
+
+   // Computes the moment-curvature relationships for several axial forces in parallel
+   void Compute(const std::vector<Float64>& vP,std::vector<ULTCOLMOMENTCURVATURE>& results) const;
+
+private:
+   ULTCOLFIBERS m_Fibers;
+   Float64 m_yMaxConfined; // elevation of the extreme confined concrete fiber
+   Float64 m_yMinSteel;    // elevation of the extreme tension reinforcement
+   Float64 m_As; // total area of reinforcement
+   Float64 m_Ac; // total area of concrete
+
+   Float64 m_fc, m_Ec, m_eco, m_esp; // unconfined concrete
+   Float64 m_fcc, m_ecc, m_ecu;      // confined concrete
+   Float64 m_Es, m_fy, m_fu, m_esh, m_esu;
+
+   // Axial force and moment (about the centroid), and the derivative of the axial force with respect to
+   // the depth of the neutral axis, for curvature phi and neutral axis depth c
+   void Evaluate(Float64 phi,Float64 c,Float64* pN,Float64* pM,Float64* pdNdc) const;
+
+   // Finds the depth of the neutral axis for axial force P and curvature phi starting from the depth c.
+   // Returns false if equilibrium can't be found
+   bool SolveDepth(Float64 P,Float64 phi,Float64* pC) const;
+
+   ULTCOLMOMENTCURVATUREPOINT GetPoint(Float64 phi,Float64 c) const;
+   void Idealize(ULTCOLMOMENTCURVATURE* pResult) const;
+};
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "UltColSchedule.h"
+#include "..\BEToolboxUtilities.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+IndexType CUltColSchedule::ComputeInteraction(const std::vector<ULTCOLSCHEDULEITEM>& columns,Float64 Es,Float64 ecl,Float64 etl,std::vector<std::vector<ULTCOLINTERACTIONPOINT>>& curves)
+{
+   // Create a section for each column. Columns with the same diameter and cover are copied from
+   // the first column with those dimensions so they share its fiber mesh. Schedules have a handful
+   // of distinct sections so a linear search of the meshes is sufficient.
+   IndexType nColumns = columns.size();
+   std::vector<CUltColFiberSection> sections;
+   sections.reserve(nColumns);
+   std::vector<IndexType> meshes; // index of the first column with each distinct mesh
+   for ( const auto& column : columns )
+   {
+      auto found = std::find_if(meshes.begin(),meshes.end(),[&columns,&column](IndexType columnIdx)
+      {
+         return IsEqual(columns[columnIdx].Diameter,column.Diameter) && IsEqual(columns[columnIdx].Cover,column.Cover);
+      });
+
+      if ( found == meshes.end() )
+      {
+         meshes.push_back(sections.size());
+         sections.emplace_back();
+         sections.back().InitRoundSection(column.Diameter,column.Cover,column.As);
+      }
+      else
+      {
+         sections.push_back(sections[*found]);
+         sections.back().SetReinforcementArea(column.As);
+      }
+
+      sections.back().SetMaterials(column.fc,column.fy,Es);
+   }
+
+   // Integrate the interaction diagrams. Each diagram is written to its own element of curves.
+   curves.clear();
+   curves.resize(nColumns);
+   ParallelFor(nColumns,[&](IndexType /*threadIdx*/,IndexType begin,IndexType end)
+   {
+      for ( IndexType columnIdx = begin; columnIdx < end; columnIdx++ )
+      {
+         sections[columnIdx].ComputeInteraction(0.0,ecl,etl,0.001,500,curves[columnIdx]);
+      }
+   });
+
+   return meshes.size();
+}
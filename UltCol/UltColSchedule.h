@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////
+// BEToolbox
+// Copyright  1999-2021  Washington State Department of Transportation
+//                        Bridge and Structures Office
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the Alternate Route Open Source License as 
+// published by the Washington State Department of Transportation, 
+// Bridge and Structures Office.
+//
+// This program is distributed in the hope that it will be useful, but 
+// distribution is AS IS, WITHOUT ANY WARRANTY; without even the implied 
+// warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See 
+// the Alternate Route Open Source License for more details.
+//
+// You should have received a copy of the Alternate Route Open Source 
+// License along with this program; if not, write to the Washington 
+// State Department of Transportation, Bridge and Structures Office, 
+// P.O. Box  47340, Olympia, WA 98503, USA or e-mail 
+// Bridge_Support@wsdot.wa.gov
+///////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "UltColFiberSection.h"
+
+// A round column in a column schedule. The modulus of elasticity of the reinforcement and the strain
+// limits are common to all of the columns in a schedule.
+struct ULTCOLSCHEDULEITEM
+{
+   std::_tstring Name;
+   Float64 Diameter;
+   Float64 Cover;
+   Float64 As;
+   Float64 fc;
+   Float64 fy;
+};
+
+// Evaluates the interaction diagrams of the columns in a column schedule.
+//
+// Discretizing a section is the expensive part of creating a fiber section and it only depends on the
+// diameter and cover. Columns with the same diameter and cover share a fiber mesh, and only the area of
+// reinforcement and the materials are changed before the interaction diagram is integrated.
+class CUltColSchedule
+{
+public:
+   // Computes the interaction diagram for bending about the x-axis of every column. The diagrams are
+   // computed in parallel. curves[i] is the interaction diagram of columns[i].
+   // Returns the number of fiber meshes that were created.
+   static IndexType ComputeInteraction(const std::vector<ULTCOLSCHEDULEITEM>& columns,Float64 Es,Float64 ecl,Float64 etl,std::vector<std::vector<ULTCOLINTERACTIONPOINT>>& curves);
+};
@@ -139,5 +139,7 @@ void CUltColView::OnInitialUpdate()
    etl = pDoc->m_etl;
 
    CUltColChildFrame* pFrame = (CUltColChildFrame*)GetParentFrame();
+   pFrame->SetShapeParameters(pDoc->m_Shape,pDoc->m_Width,pDoc->m_Depth,pDoc->m_WallThickness,pDoc->m_nBarsX,pDoc->m_nBarsY);
+   pFrame->SetMomentCurvatureParameters(pDoc->m_rho_s,pDoc->m_fyh,pDoc->m_fu,pDoc->m_esh,pDoc->m_esu,pDoc->m_AxialLoads);
    pFrame->SetColumnParameters(diameter, fc, cover, As, Es, fy, ecl, etl);
 }
@@ -27,6 +27,9 @@
 #define IDD_SPECTRA                     115
 #define IDR_SPECTRA                     116
 #define IDB_SPECTRA                     117
+#define IDD_BOXGDR_SWEEP                225
+#define IDD_CURVEL_DECK_GRID            226
+#define IDD_BETOOLBOX_PROGRESS          227
 #define IDI_WSDOT                       200
 #define IDC_UPDATE                      201
 #define IDC_EXPORT                      202
@@ -347,6 +350,47 @@
 #define IDC_SPECIFICATION               473
 #define IDC_NWC                         474
 #define IDC_LWC                         475
+#define IDC_SWEEP                       476
+#define IDC_SWEEP_DIMENSIONS            477
+#define IDC_ENABLE_SWEEP                478
+#define IDC_SWEEP_COUNT                 479
+#define IDC_SWEEP_COUNT_LABEL           480
+#define IDC_PIECE                       481
+#define IDC_ADD_PIECE                   482
+#define IDC_REMOVE_PIECE                483
+#define IDC_IMPORT_LOADS                484
+#define IDC_CLEAR_LOADS                 485
+#define IDC_SHAPE                       486
+#define IDC_WIDTH                       487
+#define IDC_WIDTH_UNIT                  488
+#define IDC_DEPTH                       489
+#define IDC_DEPTH_UNIT                  490
+#define IDC_WALL                        491
+#define IDC_WALL_UNIT                   492
+#define IDC_BARS_X                      493
+#define IDC_BARS_Y                      494
+#define IDC_IMPORT_SCHEDULE             495
+#define IDC_EXPORT_CURVES               496
+#define IDC_CLEAR_SCHEDULE              497
+#define IDC_RHO_S                       498
+#define IDC_FYH                         499
+#define IDC_FYH_UNIT                    500
+#define IDC_FU                          501
+#define IDC_FU_UNIT                     502
+#define IDC_ESH                         503
+#define IDC_ESU                         504
+#define IDC_AXIAL_LOADS                 505
+#define IDC_AXIAL_LOADS_UNIT            506
+#define IDC_GRID_START_STATION          507
+#define IDC_GRID_END_STATION            508
+#define IDC_GRID_SPACING                509
+#define IDC_GRID_SPACING_UNIT           510
+#define IDC_GRID_OFFSETS                511
+#define IDC_GRID_OFFSETS_UNIT           512
+#define IDC_GRID_CSV                    513
+#define IDC_GRID_BINARY                 514
+#define IDC_PROGRESS_MESSAGE            515
+#define IDC_PROGRESS_BAR                516
 #define IDC_CONSTANT_FPE                500
 #define IDR_PGSTABLE                    500
 #define IDC_VARIABLE_FPE                501
@@ -395,14 +439,16 @@
 #define IDC_GIRDER                      1781
 #define ID_REFRESH_REPORT               36864
 #define ID_HELP_ABOUTBETOOLBOX          36865
+#define ID_EXPORT_DECK_GRID             36871
+#define ID_FILE_BINARY_FORMAT           36872
 
 // Next default values for new objects
 // 
 #ifdef APSTUDIO_INVOKED
 #ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NEXT_RESOURCE_VALUE        225
-#define _APS_NEXT_COMMAND_VALUE         36871
-#define _APS_NEXT_CONTROL_VALUE         476
+#define _APS_NEXT_RESOURCE_VALUE        228
+#define _APS_NEXT_COMMAND_VALUE         36873
+#define _APS_NEXT_CONTROL_VALUE         517
 #define _APS_NEXT_SYMED_VALUE           114
 #endif
 #endif